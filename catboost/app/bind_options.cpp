@@ -172,6 +172,10 @@ inline static void BindPoolLoadParams(NLastGetopt::TOpts* parser, NCatboostOptio
     parser->AddLongOption("input-borders-file", "file with borders")
             .RequiredArgument("PATH")
             .StoreResult(&loadParamsPtr->BordersFile);
+
+    parser->AddLongOption("quantized-pool-cache-dir", "directory to cache quantized learn pools between runs")
+            .RequiredArgument("PATH")
+            .StoreResult(&loadParamsPtr->QuantizedPoolCacheDir);
 }
 
 static void BindMetricParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* plainJsonPtr) {
@@ -234,6 +238,15 @@ static void BindOutputParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* p
             })
             .Help(BuildModelFormatHelpMessage() + " Corresponding extensions will be added to model-file if more than one format is set.");
 
+    const auto leafValuesPrecisionDescription = TString::Join(
+        "Precision of leaf values in the saved model. Should be one of: ",
+        GetEnumAllNames<ELeafValuesPrecision>());
+    parser.AddLongOption("model-leaf-values-precision", leafValuesPrecisionDescription)
+        .RequiredArgument("precision")
+        .Handler1T<ELeafValuesPrecision>([plainJsonPtr](const auto precision) {
+            (*plainJsonPtr)["model_leaf_values_precision"] = ToString(precision);
+        });
+
     parser.AddLongOption("eval-file", "eval output file name")
         .RequiredArgument("PATH")
         .Handler1T<TString>([plainJsonPtr](const TString& name) {
@@ -296,6 +309,12 @@ static void BindOutputParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* p
             (*plainJsonPtr)["profile_log"] = name;
         });
 
+    parser.AddLongOption("chromium-trace-file", "file to write per-thread timeline of training stages in Chromium trace format")
+        .RequiredArgument("file")
+        .Handler1T<TString>([plainJsonPtr](const TString& name) {
+            (*plainJsonPtr)["chromium_trace_file"] = name;
+        });
+
     parser.AddLongOption("trace-log", "path for trace log")
         .RequiredArgument("file")
         .Handler1T<TString>([](const TString& name) {
@@ -684,6 +703,23 @@ static void BindTreeParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* pla
                 (*plainJsonPtr)["dev_efb_max_buckets"] = maxBuckets;
             });
 
+    parser.AddLongOption("dev-efb-sample-size",
+                         "CPU only. If positive estimate exclusive features bundles conflicts on a random sample "
+                         "of this number of objects and bundle features in parallel. "
+                         "Used for datasets with a large number of sparse features.")
+            .RequiredArgument("INT")
+            .Handler1T<ui32>([plainJsonPtr](ui32 sampleSize) {
+                (*plainJsonPtr)["dev_efb_sample_size"] = sampleSize;
+            });
+
+    parser.AddLongOption("dev-efb-time-budget",
+                         "CPU only. Time limit in seconds for sampled exclusive features bundling, "
+                         "features not processed within it are left unbundled. 0 means unlimited.")
+            .RequiredArgument("float")
+            .Handler1T<double>([plainJsonPtr](double timeBudget) {
+                (*plainJsonPtr)["dev_efb_time_budget"] = timeBudget;
+            });
+
     parser.AddLongOption("sparse-features-conflict-fraction",
                          "CPU only. Maximum allowed fraction of conflicting non-default values for features in exclusive features bundle."
                          "Should be a real value in [0, 1) interval.")
@@ -1033,6 +1069,26 @@ static void BindDataProcessingParams(NLastGetopt::TOpts* parserPtr, NJson::TJson
         .Handler0([plainJsonPtr]() {
             (*plainJsonPtr)["dev_group_features"] = true;
         });
+
+    parser
+        .AddLongOption(
+            "dev-nibble-pack-features",
+            "CPU only. Store float features with less than 16 borders using 4 bits per value"
+        )
+        .NoArgument()
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["dev_nibble_pack_features"] = true;
+        });
+
+    parser
+        .AddLongOption(
+            "tokenized-text-cache-dir",
+            "Directory to save dictionaries and tokenized text features to and to load them from in the following runs"
+        )
+        .RequiredArgument("PATH")
+        .Handler1T<TString>([plainJsonPtr](const TString& dir) {
+            (*plainJsonPtr)["tokenized_text_cache_dir"] = dir;
+        });
 }
 
 static void BindDistributedTrainingParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* plainJsonPtr) {
@@ -1129,6 +1185,17 @@ static void BindBinarizationParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonVa
             (*plainJsonPtr)["feature_border_type"] = ToString(type);
         });
 
+    parser
+        .AddLongOption(
+            "dev-border-sketch-rank-error",
+            "Build float feature borders from quantile sketches with this rank error instead of sorted values,"
+            " all objects are used. Default: 0 (exact borders on a subsample)"
+        )
+        .RequiredArgument("float")
+        .Handler1T<double>([plainJsonPtr](double rankError) {
+            (*plainJsonPtr)["dev_border_sketch_rank_error"] = rankError;
+        });
+
     const auto nanModeHelp = TString::Join(
         "Must be one of: ",
         GetEnumAllNames<ENanMode>(),
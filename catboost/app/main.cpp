@@ -52,9 +52,11 @@ int main(int argc, const char* argv[]) {
         modChooser.AddMode("eval-feature", mode_eval_feature, "evaluate features");
         modChooser.AddMode("metadata", mode_metadata, "get/set/dump metainfo fields from model");
         modChooser.AddMode("model-sum", mode_model_sum, "sum model files");
+        modChooser.AddMode("reorder-trees", mode_reorder_trees, "reorder model trees for faster evaluation");
         modChooser.AddMode("run-worker", mode_run_worker, "run worker");
         modChooser.AddMode("roc", mode_roc, "evaluate data for roc curve");
         modChooser.AddMode("model-based-eval", mode_model_based_eval, "model-based eval");
+        modChooser.AddMode("convert-pool", mode_convert_pool, "convert dsv pool to columnar binary format, or recompress quantized pool");
         modChooser.DisableSvnRevisionOption();
         modChooser.SetVersionHandler(PrintProgramSvnVersion);
         return modChooser.Run(argc, argv);
@@ -0,0 +1,69 @@
+#include "modes.h"
+
+#include <catboost/libs/data/columnar_pool.h>
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/private/libs/options/analytical_mode_params.h>
+#include <catboost/private/libs/quantized_pool/pool.h>
+#include <catboost/private/libs/quantized_pool/serialization.h>
+
+#include <library/getopt/small/last_getopt.h>
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/stream/file.h>
+#include <util/system/info.h>
+
+
+using namespace NCB;
+
+
+int mode_convert_pool(int argc, const char* argv[]) {
+    NCatboostOptions::TColumnarPoolFormatParams columnarPoolFormatParams;
+    TSaveQuantizedPoolParameters saveQuantizedPoolParams;
+    TPathWithScheme inputPath;
+    TString outputPath;
+    int threadCount = NSystemInfo::CachedNumberOfCpus();
+
+    auto parser = NLastGetopt::TOpts();
+    parser.AddHelpOption();
+    BindColumnarPoolFormatParams(&parser, &columnarPoolFormatParams);
+    parser.AddLongOption('f', "input-path", "dsv pool path, directories and globs of shards are supported, or quantized pool path")
+        .Required()
+        .RequiredArgument("[SCHEME://]PATH")
+        .Handler1T<TStringBuf>([&](const TStringBuf& pathWithScheme) {
+            inputPath = TPathWithScheme(pathWithScheme, "dsv");
+        });
+    parser.AddLongOption('o', "output-path", "columnar pool path for dsv input, load it with 'columnar://' scheme, quantized pool path for quantized input")
+        .Required()
+        .RequiredArgument("PATH")
+        .StoreResult(&outputPath);
+    parser.AddLongOption("quantized-chunk-codec", "block codec of quantized pool chunks, for quantized input")
+        .RequiredArgument("None|Lz4|Zstd")
+        .StoreResult(&saveQuantizedPoolParams.ChunkCodec);
+    parser.AddLongOption("quantized-pack-bits", "store quantized pool features with 1, 2 or 4 bits per object if their values fit, for quantized input")
+        .NoArgument()
+        .SetFlag(&saveQuantizedPoolParams.PackBits);
+    parser.AddLongOption('T', "thread-count", "worker thread count (default: core count)")
+        .RequiredArgument("INT")
+        .StoreResult(&threadCount);
+    parser.SetFreeArgsNum(0);
+    NLastGetopt::TOptsParseResult parserResult{&parser, argc, argv};
+
+    NPar::TLocalExecutor localExecutor;
+    localExecutor.RunAdditionalThreads(threadCount - 1);
+
+    if (inputPath.Scheme == "quantized") {
+        // pools saved with a codec or packed bits can't be read by older versions
+        const auto pool = LoadQuantizedPool(
+            inputPath,
+            {/*LockMemory*/ false, /*Precharge*/ false, TDatasetSubset::MakeColumns(), &localExecutor});
+        CB_ENSURE(!pool.HasStringColumns, "Quantized pools with string ids are not supported");
+        TFileOutput output(outputPath);
+        SaveQuantizedPool(pool, &output, saveQuantizedPoolParams);
+        output.Finish();
+        return 0;
+    }
+
+    CB_ENSURE(inputPath.Scheme == "dsv", "Only dsv and quantized pools can be converted");
+    ConvertDsvToColumnarPool(inputPath, columnarPoolFormatParams, outputPath, &localExecutor);
+    return 0;
+}
@@ -2,6 +2,7 @@
 
 #include <catboost/libs/model/model.h>
 #include <catboost/libs/model/model_export/model_exporter.h>
+#include <catboost/private/libs/options/system_options.h>
 
 #include <library/getopt/small/last_getopt.h>
 
@@ -12,6 +13,7 @@ int mode_model_sum(int argc, const char* argv[]) {
     TString outputModelPath;
     EModelType outputModelFormat = EModelType::CatboostBinary;
     ECtrTableMergePolicy ctrMergePolicy = ECtrTableMergePolicy::IntersectingCountersAverage;
+    ui64 ctrTablesRamLimit = 1ull << 30;
 
     auto parser = NLastGetopt::TOpts();
     parser.AddHelpOption();
@@ -39,17 +41,20 @@ int mode_model_sum(int argc, const char* argv[]) {
             GetEnumAllNames<ECtrTableMergePolicy>()))
         .Optional()
         .StoreResult(&ctrMergePolicy);
+    parser.AddLongOption("ctr-tables-ram-limit", "Limit memory used by ctr tables loaded at once while merging.\nAllowed suffixes: GB, MB, KB in different cases")
+        .RequiredArgument("SIZE")
+        .Handler1T<TString>([&ctrTablesRamLimit](const TString& limit) {
+            ctrTablesRamLimit = ParseMemorySizeDescription(limit);
+        });
     parser.SetFreeArgsNum(0);
     NLastGetopt::TOptsParseResult parserResult{&parser, argc, argv};
-    TVector<THolder<TFullModel>> models;
-    TVector<const TFullModel*> modelPtrs;
+    TVector<TString> modelPaths;
     TVector<double> weights;
     for (const auto& [path, weight] : modelPathsWithWeights) {
-        models.emplace_back(MakeHolder<TFullModel>(ReadModel(path)));
-        modelPtrs.emplace_back(models.back().Get());
+        modelPaths.emplace_back(path);
         weights.emplace_back(weight);
     }
-    TFullModel result = SumModels(modelPtrs, weights, ctrMergePolicy);
+    TFullModel result = SumModelsFromFiles(modelPaths, weights, ctrMergePolicy, ctrTablesRamLimit);
     NCB::ExportModel(result, outputModelPath, outputModelFormat);
     return 0;
 }
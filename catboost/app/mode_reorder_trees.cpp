@@ -0,0 +1,117 @@
+#include "modes.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/logging/logging.h>
+#include <catboost/libs/model/model.h>
+#include <catboost/libs/model/model_export/model_exporter.h>
+
+#include <library/getopt/small/last_getopt.h>
+
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/system/hp_timer.h>
+
+namespace {
+    struct TReorderTreesBenchmark {
+        TVector<TVector<float>> Features;
+        TVector<TConstArrayRef<float>> FeatureRefs;
+
+        // feature values are taken from model borders so that all tree branches are visited
+        TReorderTreesBenchmark(const TFullModel& model, size_t docCount, ui64 seed) {
+            TFastRng64 rng(seed);
+            size_t flatFeatureCount = 0;
+            for (const auto& floatFeature : model.ModelTrees->GetFloatFeatures()) {
+                flatFeatureCount = Max<size_t>(flatFeatureCount, floatFeature.Position.FlatIndex + 1);
+            }
+            Features.resize(docCount, TVector<float>(flatFeatureCount));
+            for (const auto& floatFeature : model.ModelTrees->GetFloatFeatures()) {
+                const auto& borders = floatFeature.Borders;
+                for (auto& doc : Features) {
+                    const size_t borderIdx = rng.Uniform(borders.size() + 1);
+                    doc[floatFeature.Position.FlatIndex] = borderIdx < borders.size() ? borders[borderIdx] : 1e9f;
+                }
+            }
+            FeatureRefs.assign(Features.begin(), Features.end());
+        }
+
+        // best of several runs, in seconds
+        double Measure(const TFullModel& model, size_t runCount, TVector<double>* predictions) const {
+            predictions->resize(FeatureRefs.size() * model.GetDimensionsCount());
+            double bestTime = Max<double>();
+            for (size_t run = 0; run < runCount; ++run) {
+                THPTimer timer;
+                model.CalcFlat(FeatureRefs, *predictions);
+                bestTime = Min(bestTime, timer.Passed());
+            }
+            return bestTime;
+        }
+    };
+}
+
+int mode_reorder_trees(int argc, const char* argv[]) {
+    TString inputModelPath;
+    TString outputModelPath;
+    EModelType outputModelFormat = EModelType::CatboostBinary;
+    size_t lookahead = 256;
+    bool keepSummationOrder = false;
+    size_t benchmarkDocCount = 100000;
+    size_t benchmarkRunCount = 5;
+
+    auto parser = NLastGetopt::TOpts();
+    parser.AddHelpOption();
+    parser.AddLongOption('m', "model-file", "Model path")
+        .Required()
+        .RequiredArgument("PATH")
+        .StoreResult(&inputModelPath);
+    parser.AddLongOption('o', "output-path")
+        .Required()
+        .RequiredArgument("PATH")
+        .StoreResult(&outputModelPath);
+    parser.AddLongOption("output-model-format")
+        .OptionalArgument("output model format")
+        .Handler1T<TString>([&outputModelFormat](const TString& format) {
+            outputModelFormat = FromString<EModelType>(format);
+        });
+    parser.AddLongOption("lookahead", "Count of next trees considered when choosing the next tree")
+        .RequiredArgument("INT")
+        .StoreResult(&lookahead);
+    parser.AddLongOption(
+        "keep-summation-order",
+        "Add leaf values in the original tree order so that predictions are bit-identical to the input model")
+        .NoArgument()
+        .SetFlag(&keepSummationOrder);
+    parser.AddLongOption("benchmark-doc-count", "Count of random documents used to measure speedup, 0 to skip")
+        .RequiredArgument("INT")
+        .StoreResult(&benchmarkDocCount);
+    parser.AddLongOption("benchmark-run-count")
+        .RequiredArgument("INT")
+        .StoreResult(&benchmarkRunCount);
+    parser.SetFreeArgsNum(0);
+    NLastGetopt::TOptsParseResult parserResult{&parser, argc, argv};
+
+    const TFullModel model = ReadModel(inputModelPath);
+    CB_ENSURE(model.IsOblivious(), "Only models with symmetric trees can be reordered");
+    TFullModel reorderedModel = model;
+    reorderedModel.ReorderTreesByFeatureLocality(lookahead, keepSummationOrder);
+
+    const bool canBenchmark = model.GetUsedCatFeaturesCount() == 0 && model.GetUsedTextFeaturesCount() == 0;
+    if (benchmarkDocCount > 0 && canBenchmark) {
+        const TReorderTreesBenchmark benchmark(model, benchmarkDocCount, /*seed*/ 0);
+        TVector<double> predictions;
+        TVector<double> reorderedPredictions;
+        const double time = benchmark.Measure(model, benchmarkRunCount, &predictions);
+        const double reorderedTime = benchmark.Measure(reorderedModel, benchmarkRunCount, &reorderedPredictions);
+        double maxDiff = 0.0;
+        for (auto idx : xrange(predictions.size())) {
+            maxDiff = Max(maxDiff, Abs(predictions[idx] - reorderedPredictions[idx]));
+        }
+        CATBOOST_NOTICE_LOG << "Evaluation time of " << benchmarkDocCount << " documents: "
+            << time << "s original, " << reorderedTime << "s reordered, speedup " << time / reorderedTime << Endl;
+        CATBOOST_NOTICE_LOG << "Max prediction difference: " << maxDiff << Endl;
+    } else if (benchmarkDocCount > 0) {
+        CATBOOST_NOTICE_LOG << "Speedup is not measured for models with categorical or text features" << Endl;
+    }
+
+    NCB::ExportModel(reorderedModel, outputModelPath, outputModelFormat);
+    return 0;
+}
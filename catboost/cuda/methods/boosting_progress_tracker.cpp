@@ -160,7 +160,7 @@ namespace NCatboostCuda {
         }
 
         try {
-            TProgressHelper(GpuProgressLabel()).CheckedLoad(OutputFiles.SnapshotFile, [&](TIFStream* in) {
+            TProgressHelper(GpuProgressLabel()).CheckedLoad(OutputFiles.SnapshotFile, [&](IInputStream* in) {
                 TString taskOptionsStr;
                 ::Load(in, taskOptionsStr);
                 const bool paramsCompatible = NCatboostOptions::IsParamsCompatible(CatBoostOptionsStr, taskOptionsStr);
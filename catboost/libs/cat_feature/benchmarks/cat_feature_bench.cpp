@@ -0,0 +1,50 @@
+#include <catboost/libs/cat_feature/cat_feature.h>
+
+#include <library/testing/benchmark/bench.h>
+
+#include <util/generic/singleton.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/string/cast.h>
+
+const size_t ValuesCount = 100000;
+
+namespace {
+    // typical categorical values: short identifiers and numbers
+    struct TValues {
+        TVector<TString> Values;
+        TVector<ui32> Hashes;
+
+        TValues() {
+            TFastRng64 rand(0);
+            Values.reserve(ValuesCount);
+            for (auto i : xrange(ValuesCount)) {
+                Y_UNUSED(i);
+                Values.push_back(ToString(rand.Uniform(1000000)));
+            }
+            Hashes.yresize(ValuesCount);
+        }
+    };
+}
+
+Y_CPU_BENCHMARK(CalcCatFeatureHash, iface) {
+    auto& values = *Singleton<TValues>();
+    for (auto i : xrange(iface.Iterations())) {
+        Y_UNUSED(i);
+        for (auto valueIdx : xrange(values.Values.size())) {
+            values.Hashes[valueIdx] = CalcCatFeatureHash(values.Values[valueIdx]);
+        }
+        Y_DO_NOT_OPTIMIZE_AWAY(values.Hashes.data());
+    }
+}
+
+Y_CPU_BENCHMARK(CalcCatFeatureHashes, iface) {
+    auto& values = *Singleton<TValues>();
+    for (auto i : xrange(iface.Iterations())) {
+        Y_UNUSED(i);
+        CalcCatFeatureHashes(values.Values, values.Hashes);
+        Y_DO_NOT_OPTIMIZE_AWAY(values.Hashes.data());
+    }
+}
@@ -2,7 +2,64 @@
 
 #include <util/digest/city.h>
 #include <util/generic/strbuf.h>
+#include <util/system/compiler.h>
+#include <util/system/unaligned_mem.h>
+#include <util/system/yassert.h>
+
 
 ui32 CalcCatFeatureHash(const TStringBuf feature) noexcept {
     return CityHash64(feature) & 0xffffffff;
 }
+
+
+namespace {
+    constexpr ui64 K2 = 0x9ae16a3b2f90404fULL;
+    constexpr ui64 K3 = 0xc949d7c7509e6557ULL;
+
+    // copy of HashLen0to16 from util/digest/city.cpp (CityHash 1.0), results must be bit-identical
+    Y_FORCE_INLINE ui64 CityHash64Len0to16(const char* s, size_t len) noexcept {
+        if (len > 8) {
+            const ui64 a = ReadUnaligned<ui64>(s);
+            const ui64 b = ReadUnaligned<ui64>(s + len - 8);
+            const ui64 rotatedB = ((b + len) >> len) | ((b + len) << (64 - len));
+            return Hash128to64(uint128(a, rotatedB)) ^ b;
+        }
+        if (len >= 4) {
+            const ui64 a = ReadUnaligned<ui32>(s);
+            return Hash128to64(uint128(len + (a << 3), ReadUnaligned<ui32>(s + len - 4)));
+        }
+        if (len > 0) {
+            const ui8 a = s[0];
+            const ui8 b = s[len >> 1];
+            const ui8 c = s[len - 1];
+            const ui32 y = static_cast<ui32>(a) + (static_cast<ui32>(b) << 8);
+            const ui32 z = static_cast<ui32>(len) + (static_cast<ui32>(c) << 2);
+            const ui64 v = y * K2 ^ z * K3;
+            return (v ^ (v >> 47)) * K2;
+        }
+        return K2;
+    }
+
+    Y_FORCE_INLINE ui32 CalcCatFeatureHashInlined(TStringBuf feature) noexcept {
+        if (Y_LIKELY(feature.size() <= 16)) {
+            return CityHash64Len0to16(feature.data(), feature.size()) & 0xffffffff;
+        }
+        return CalcCatFeatureHash(feature);
+    }
+
+    template <class TStringLike>
+    void CalcCatFeatureHashesImpl(TConstArrayRef<TStringLike> features, TArrayRef<ui32> hashes) noexcept {
+        Y_ASSERT(features.size() == hashes.size());
+        for (size_t idx = 0; idx < features.size(); ++idx) {
+            hashes[idx] = CalcCatFeatureHashInlined(features[idx]);
+        }
+    }
+}
+
+void CalcCatFeatureHashes(TConstArrayRef<TStringBuf> features, TArrayRef<ui32> hashes) noexcept {
+    CalcCatFeatureHashesImpl(features, hashes);
+}
+
+void CalcCatFeatureHashes(TConstArrayRef<TString> features, TArrayRef<ui32> hashes) noexcept {
+    CalcCatFeatureHashesImpl(features, hashes);
+}
@@ -1,10 +1,19 @@
 #pragma once
 
+#include <util/generic/array_ref.h>
 #include <util/generic/strbuf.h>
+#include <util/generic/string.h>
 #include <util/system/types.h>
 
 ui32 CalcCatFeatureHash(const TStringBuf feature) noexcept;
 
+/* Batched version of CalcCatFeatureHash, hashes[i] = CalcCatFeatureHash(features[i]).
+ * The hashing of values up to 16 bytes (typical categorical values) is inlined into the loop
+ * instead of an out-of-line CityHash64 call per value.
+ */
+void CalcCatFeatureHashes(TConstArrayRef<TStringBuf> features, TArrayRef<ui32> hashes) noexcept;
+void CalcCatFeatureHashes(TConstArrayRef<TString> features, TArrayRef<ui32> hashes) noexcept;
+
 // deprecated, for compatibility, prefer CalcCatFeatureHash in new code
 inline int CalcCatFeatureHashInt(const TStringBuf feature) noexcept {
     ui32 hashVal = CalcCatFeatureHash(feature);
@@ -0,0 +1,47 @@
+#include <catboost/libs/cat_feature/cat_feature.h>
+
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+#include <library/unittest/registar.h>
+
+
+Y_UNIT_TEST_SUITE(CatFeatureHash) {
+    Y_UNIT_TEST(BatchedEqualsSingle) {
+        TFastRng64 rand(0);
+        TVector<TString> features;
+        // all lengths of the inlined short string path and longer ones, with a tail not divisible by lane count
+        for (auto length : xrange(100)) {
+            for (auto i : xrange(3)) {
+                Y_UNUSED(i);
+                TString feature;
+                for (auto charIdx : xrange(length)) {
+                    Y_UNUSED(charIdx);
+                    feature.push_back(static_cast<char>(rand.Uniform(256)));
+                }
+                features.push_back(std::move(feature));
+            }
+        }
+        features.push_back("");
+
+        TVector<ui32> hashes(features.size());
+        CalcCatFeatureHashes(features, hashes);
+
+        TVector<TStringBuf> featureBufs(features.begin(), features.end());
+        TVector<ui32> bufHashes(features.size());
+        CalcCatFeatureHashes(featureBufs, bufHashes);
+
+        for (auto i : xrange(features.size())) {
+            UNIT_ASSERT_VALUES_EQUAL(hashes[i], CalcCatFeatureHash(features[i]));
+            UNIT_ASSERT_VALUES_EQUAL(bufHashes[i], CalcCatFeatureHash(features[i]));
+        }
+    }
+
+    Y_UNIT_TEST(BatchedEmpty) {
+        TVector<ui32> hashes;
+        CalcCatFeatureHashes(TConstArrayRef<TStringBuf>(), hashes);
+        UNIT_ASSERT(hashes.empty());
+    }
+}
@@ -0,0 +1,92 @@
+#include <catboost/libs/data/load_data.h>
+
+#include <catboost/libs/data/data_provider.h>
+
+#include <library/testing/benchmark/bench.h>
+
+#include <util/folder/path.h>
+#include <util/folder/tempdir.h>
+#include <util/generic/singleton.h>
+#include <util/generic/xrange.h>
+#include <util/stream/file.h>
+#include <util/stream/zlib.h>
+
+using namespace NCB;
+
+const size_t ShardCount = 16;
+const size_t ShardObjectCount = 2000;
+const size_t FeaturesCount = 100;
+
+// the same objects as a single plain file and as gzipped shards
+struct TShardedPool {
+    TTempDir TempDir;
+    TString CdPath;
+    TString SingleFilePath;
+    TString ShardsDir;
+
+    TShardedPool() {
+        CdPath = JoinFsPaths(TempDir(), "pool.cd");
+        TOFStream cd(CdPath);
+        cd << "0\tTarget\n";
+        for (size_t feature = 0; feature < FeaturesCount; ++feature) {
+            cd << feature + 1 << "\tNum\n";
+        }
+
+        SingleFilePath = JoinFsPaths(TempDir(), "pool.tsv");
+        ShardsDir = JoinFsPaths(TempDir(), "shards");
+        TFsPath(ShardsDir).MkDir();
+
+        TOFStream singleFile(SingleFilePath);
+        for (auto shardIdx : xrange(ShardCount)) {
+            TString data;
+            for (auto objectIdx : xrange(ShardObjectCount)) {
+                data += ToString(objectIdx % 2);
+                for (auto feature : xrange(FeaturesCount)) {
+                    data += "\t" + ToString((shardIdx * ShardObjectCount + objectIdx + feature) % 1000 * 0.001);
+                }
+                data += '\n';
+            }
+            singleFile << data;
+
+            TOFStream shard(JoinFsPaths(ShardsDir, "part-" + ToString(shardIdx) + ".tsv.gz"));
+            TZLibCompress compressed(&shard, ZLib::GZip);
+            compressed << data;
+            compressed.Finish();
+        }
+    }
+};
+
+static void LoadPool(const TString& path, size_t iterations) {
+    const auto& pool = *Singleton<TShardedPool>();
+    NCatboostOptions::TColumnarPoolFormatParams columnarPoolFormatParams;
+    columnarPoolFormatParams.CdFilePath = TPathWithScheme(pool.CdPath);
+    NPar::TLocalExecutor localExecutor;
+    localExecutor.RunAdditionalThreads(3);
+
+    for (size_t i = 0; i < iterations; ++i) {
+        auto dataProvider = ReadDataset(
+            TPathWithScheme(path),
+            TPathWithScheme(),
+            TPathWithScheme(),
+            TPathWithScheme(),
+            columnarPoolFormatParams,
+            TVector<ui32>{},
+            EObjectsOrder::Undefined,
+            TDatasetSubset::MakeColumns(),
+            /*classNames*/ Nothing(),
+            &localExecutor);
+        Y_DO_NOT_OPTIMIZE_AWAY(dataProvider);
+    }
+}
+
+Y_CPU_BENCHMARK(DsvLoaderSingleFile, iface) {
+    LoadPool(Singleton<TShardedPool>()->SingleFilePath, iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(DsvLoaderGzipShardsDir, iface) {
+    LoadPool(Singleton<TShardedPool>()->ShardsDir, iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(DsvLoaderGzipShardsGlob, iface) {
+    LoadPool(JoinFsPaths(Singleton<TShardedPool>()->ShardsDir, "part-*.tsv.gz"), iface.Iterations());
+}
@@ -10,6 +10,7 @@
 
 #include <util/generic/strbuf.h>
 #include <util/generic/vector.h>
+#include <util/generic/xrange.h>
 #include <util/stream/file.h>
 #include <util/string/split.h>
 #include <util/system/guard.h>
@@ -21,7 +22,11 @@ namespace NCB {
     TCBDsvDataLoader::TCBDsvDataLoader(TDatasetLoaderPullArgs&& args)
         : TCBDsvDataLoader(
             TLineDataLoaderPushArgs {
-                GetLineDataReader(args.PoolPath, args.CommonArgs.PoolFormat),
+                GetLineDataReader(
+                    args.PoolPath,
+                    args.CommonArgs.PoolFormat,
+                    args.CommonArgs.LocalExecutor->GetThreadCount() + 1
+                ),
                 std::move(args.CommonArgs)
             }
         )
@@ -124,6 +129,12 @@ namespace NCB {
             TVector<ui32> catFeatures;
             catFeatures.yresize(featuresLayout.GetCatFeatureCount());
 
+            // categorical values are hashed for the whole line at once
+            TVector<ui32> catFeatureFlatIndices;
+            catFeatureFlatIndices.reserve(catFeatures.size());
+            TVector<TStringBuf> catFeatureValues;
+            catFeatureValues.reserve(catFeatures.size());
+
             TVector<TString> textFeatures;
             textFeatures.yresize(featuresLayout.GetTextFeatureCount());
 
@@ -140,8 +151,8 @@ namespace NCB {
                         switch (columnsDescription[tokenCount].Type) {
                             case EColumn::Categ: {
                                 if (!FeatureIgnored[featureId]) {
-                                    const ui32 catFeatureIdx = featuresLayout.GetInternalFeatureIdx(featureId);
-                                    catFeatures[catFeatureIdx] = visitor->GetCatFeatureValue(featureId, token);
+                                    catFeatureFlatIndices.push_back(featureId);
+                                    catFeatureValues.push_back(token);
                                 }
                                 ++featureId;
                                 break;
@@ -232,6 +243,15 @@ namespace NCB {
                 if (!floatFeatures.empty()) {
                     visitor->AddAllFloatFeatures(lineIdx, floatFeatures);
                 }
+                if (!catFeatureValues.empty()) {
+                    TVector<ui32> catFeatureHashes;
+                    catFeatureHashes.yresize(catFeatureValues.size());
+                    visitor->GetCatFeatureValues(catFeatureFlatIndices, catFeatureValues, catFeatureHashes);
+                    for (auto i : xrange(catFeatureValues.size())) {
+                        catFeatures[featuresLayout.GetInternalFeatureIdx(catFeatureFlatIndices[i])]
+                            = catFeatureHashes[i];
+                    }
+                }
                 if (!catFeatures.empty()) {
                     visitor->AddAllCatFeatures(lineIdx, catFeatures);
                 }
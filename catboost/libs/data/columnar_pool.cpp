@@ -0,0 +1,331 @@
+#include "columnar_pool.h"
+
+#include "loader.h"
+
+#include <catboost/libs/column_description/cd_parser.h>
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/logging/logging.h>
+#include <catboost/private/libs/data_types/groupid.h>
+#include <catboost/private/libs/data_util/line_data_reader.h>
+
+#include <library/string_utils/csv/csv.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/array_ref.h>
+#include <util/generic/cast.h>
+#include <util/generic/hash.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ylimits.h>
+#include <util/stream/buffer.h>
+#include <util/stream/file.h>
+#include <util/stream/mem.h>
+#include <util/string/cast.h>
+#include <util/system/hp_timer.h>
+
+
+namespace NCB {
+
+    static constexpr size_t ColumnarPoolPrefixSize = sizeof(ColumnarPoolMagic) + 2 * sizeof(ui32) + sizeof(ui64);
+
+    static ui64 AlignColumnarPoolOffset(ui64 offset) {
+        return (offset + ColumnarPoolAlignment - 1) / ColumnarPoolAlignment * ColumnarPoolAlignment;
+    }
+
+    static size_t GetStorageElementSize(EColumnarPoolStorage storage) {
+        switch (storage) {
+            case EColumnarPoolStorage::None:
+                return 0;
+            case EColumnarPoolStorage::Float:
+                return sizeof(float);
+            case EColumnarPoolStorage::UI32:
+            case EColumnarPoolStorage::Dictionary:
+                return sizeof(ui32);
+            case EColumnarPoolStorage::UI64:
+                return sizeof(ui64);
+        }
+        Y_UNREACHABLE();
+    }
+
+    EColumnarPoolStorage GetColumnarPoolStorage(EColumn columnType) {
+        switch (columnType) {
+            case EColumn::Num:
+            case EColumn::Weight:
+            case EColumn::GroupWeight:
+            case EColumn::Baseline:
+                return EColumnarPoolStorage::Float;
+            case EColumn::SubgroupId:
+                return EColumnarPoolStorage::UI32;
+            case EColumn::GroupId:
+            case EColumn::Timestamp:
+                return EColumnarPoolStorage::UI64;
+            case EColumn::Label:
+            case EColumn::Categ:
+            case EColumn::Text:
+                return EColumnarPoolStorage::Dictionary;
+            case EColumn::Auxiliary:
+            case EColumn::SampleId:
+                return EColumnarPoolStorage::None;
+            default:
+                CB_ENSURE(false, "Column type " << columnType << " is not supported in columnar pools");
+        }
+    }
+
+    TColumnarPoolHeader ReadColumnarPoolHeader(TStringBuf data) {
+        CB_ENSURE(
+            data.size() >= ColumnarPoolPrefixSize
+                && TStringBuf(data.data(), sizeof(ColumnarPoolMagic)) == TStringBuf(ColumnarPoolMagic, sizeof(ColumnarPoolMagic)),
+            "Data is not a columnar pool"
+        );
+        TMemoryInput prefix(data.data() + sizeof(ColumnarPoolMagic), ColumnarPoolPrefixSize - sizeof(ColumnarPoolMagic));
+        ui32 version;
+        ui32 reserved;
+        ui64 headerSize;
+        ::Load(&prefix, version);
+        ::Load(&prefix, reserved);
+        ::Load(&prefix, headerSize);
+        CB_ENSURE(version == ColumnarPoolVersion, "Unsupported columnar pool version " << version);
+        CB_ENSURE(ColumnarPoolPrefixSize + headerSize <= data.size(), "Columnar pool header is truncated");
+
+        TColumnarPoolHeader header;
+        TMemoryInput headerInput(data.data() + ColumnarPoolPrefixSize, headerSize);
+        ::Load(&headerInput, header);
+
+        CB_ENSURE(header.ColumnInfos.size() == header.Columns.size(), "Columnar pool header is inconsistent");
+        for (auto columnIdx : xrange(header.Columns.size())) {
+            const auto& columnInfo = header.ColumnInfos[columnIdx];
+            CB_ENSURE(
+                columnInfo.Storage == GetColumnarPoolStorage(header.Columns[columnIdx].Type),
+                "Columnar pool column " << columnIdx << " has storage " << static_cast<ui32>(columnInfo.Storage)
+                    << " incompatible with its type " << header.Columns[columnIdx].Type
+            );
+            CB_ENSURE(
+                columnInfo.Size == header.ObjectCount * GetStorageElementSize(columnInfo.Storage)
+                    && columnInfo.Offset % ColumnarPoolAlignment == 0
+                    && columnInfo.Offset + columnInfo.Size <= data.size(),
+                "Columnar pool data for column " << columnIdx << " is truncated or inconsistent"
+            );
+        }
+        return header;
+    }
+
+
+    namespace {
+
+        struct TColumnBuffer {
+            TVector<float> Floats;
+            TVector<ui32> UI32s; // also indices for Dictionary
+            TVector<ui64> UI64s;
+            TVector<TString> Tokens; // for Dictionary, freed after dictionary is built
+
+        public:
+            TStringBuf GetData(EColumnarPoolStorage storage) const {
+                switch (storage) {
+                    case EColumnarPoolStorage::None:
+                        return {};
+                    case EColumnarPoolStorage::Float:
+                        return TStringBuf((const char*)Floats.data(), Floats.size() * sizeof(float));
+                    case EColumnarPoolStorage::UI32:
+                    case EColumnarPoolStorage::Dictionary:
+                        return TStringBuf((const char*)UI32s.data(), UI32s.size() * sizeof(ui32));
+                    case EColumnarPoolStorage::UI64:
+                        return TStringBuf((const char*)UI64s.data(), UI64s.size() * sizeof(ui64));
+                }
+                Y_UNREACHABLE();
+            }
+        };
+
+    }
+
+    static void ParseDsvLine(
+        TString& line,
+        char delimiter,
+        char quote,
+        const TVector<TColumn>& columns,
+        size_t objectIdx,
+        TVector<TColumnBuffer>* columnBuffers
+    ) {
+        auto splitter = NCsvFormat::CsvSplitter(line, delimiter, quote);
+        size_t tokenCount = 0;
+        do {
+            TStringBuf token = splitter.Consume();
+            CB_ENSURE(
+                tokenCount < columns.size(),
+                "wrong column count: expected " << columns.size() << ", found " << tokenCount
+            );
+            auto& buffer = (*columnBuffers)[tokenCount];
+            try {
+                switch (columns[tokenCount].Type) {
+                    case EColumn::Num:
+                        CB_ENSURE(
+                            TryParseFloatFeatureValue(token, &buffer.Floats[objectIdx]),
+                            "Factor cannot be parsed as float. Try correcting column description file."
+                        );
+                        break;
+                    case EColumn::Weight:
+                    case EColumn::GroupWeight:
+                    case EColumn::Baseline:
+                        CB_ENSURE(token.length() != 0, "empty values not supported");
+                        buffer.Floats[objectIdx] = FromString<float>(token);
+                        break;
+                    case EColumn::GroupId:
+                        CB_ENSURE(token.length() != 0, "empty values not supported for GroupId");
+                        buffer.UI64s[objectIdx] = CalcGroupIdFor(token);
+                        break;
+                    case EColumn::SubgroupId:
+                        CB_ENSURE(token.length() != 0, "empty values not supported for SubgroupId");
+                        buffer.UI32s[objectIdx] = CalcSubgroupIdFor(token);
+                        break;
+                    case EColumn::Timestamp:
+                        CB_ENSURE(token.length() != 0, "empty values not supported for Timestamp");
+                        buffer.UI64s[objectIdx] = FromString<ui64>(token);
+                        break;
+                    case EColumn::Label:
+                        CB_ENSURE(token.length() != 0, "empty values not supported for Label");
+                        buffer.Tokens[objectIdx] = TString(token);
+                        break;
+                    case EColumn::Categ:
+                    case EColumn::Text:
+                        buffer.Tokens[objectIdx] = TString(token);
+                        break;
+                    default:
+                        break;
+                }
+            } catch (yexception& e) {
+                throw TCatBoostException() << "Column " << tokenCount << " (type "
+                    << columns[tokenCount].Type << ", value = \"" << token
+                    << "\"): " << e.what();
+            }
+            ++tokenCount;
+        } while (splitter.Step());
+        CB_ENSURE(
+            tokenCount == columns.size(),
+            "wrong column count: expected " << columns.size() << ", found " << tokenCount
+        );
+    }
+
+    // replaces Tokens with indices in dictionary, values are numbered in the order of appearance
+    static TVector<TString> BuildDictionary(TColumnBuffer* buffer) {
+        TVector<TString> dictionary;
+        THashMap<TString, ui32> valueToIndex;
+        buffer->UI32s.yresize(buffer->Tokens.size());
+        for (auto objectIdx : xrange(buffer->Tokens.size())) {
+            auto& token = buffer->Tokens[objectIdx];
+            auto it = valueToIndex.find(token);
+            if (it == valueToIndex.end()) {
+                it = valueToIndex.emplace(token, SafeIntegerCast<ui32>(dictionary.size())).first;
+                dictionary.push_back(std::move(token));
+            }
+            buffer->UI32s[objectIdx] = it->second;
+        }
+        TVector<TString>().swap(buffer->Tokens);
+        return dictionary;
+    }
+
+    void ConvertDsvToColumnarPool(
+        const TPathWithScheme& poolPath,
+        const NCatboostOptions::TColumnarPoolFormatParams& poolFormatParams,
+        const TString& outputPath,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        THPTimer timer;
+        const char delimiter = poolFormatParams.DsvFormat.Delimiter;
+
+        TColumnarPoolHeader header;
+        auto reader = GetLineDataReader(poolPath, poolFormatParams.DsvFormat, localExecutor->GetThreadCount() + 1);
+        if (auto headerLine = reader->GetHeader()) {
+            header.ColumnNames = TVector<TString>(NCsvFormat::CsvSplitter(*headerLine, delimiter, '"'));
+        }
+
+        TVector<TString> lines;
+        for (TString line; reader->ReadLine(&line);) {
+            lines.push_back(std::move(line));
+        }
+        CB_ENSURE(!lines.empty(), "ConvertDsvToColumnarPool: no data rows in pool");
+        CB_ENSURE(lines.size() <= Max<ui32>(), "CatBoost does not support datasets with more than " << Max<ui32>() << " objects");
+        header.ObjectCount = lines.size();
+
+        const ui32 columnCount = TVector<TString>(NCsvFormat::CsvSplitter(lines[0], delimiter, '"')).size();
+        header.Columns = MakeCdProviderFromFile(poolFormatParams.CdFilePath)->GetColumnsDescription(columnCount);
+        header.ColumnInfos.resize(header.Columns.size());
+
+        TVector<TColumnBuffer> columnBuffers(header.Columns.size());
+        bool hasCatFeatures = false;
+        for (auto columnIdx : xrange(header.Columns.size())) {
+            const EColumn columnType = header.Columns[columnIdx].Type;
+            const EColumnarPoolStorage storage = GetColumnarPoolStorage(columnType);
+            header.ColumnInfos[columnIdx].Storage = storage;
+            auto& buffer = columnBuffers[columnIdx];
+            switch (storage) {
+                case EColumnarPoolStorage::Float:
+                    buffer.Floats.yresize(header.ObjectCount);
+                    break;
+                case EColumnarPoolStorage::UI32:
+                    buffer.UI32s.yresize(header.ObjectCount);
+                    break;
+                case EColumnarPoolStorage::UI64:
+                    buffer.UI64s.yresize(header.ObjectCount);
+                    break;
+                case EColumnarPoolStorage::Dictionary:
+                    buffer.Tokens.resize(header.ObjectCount);
+                    break;
+                case EColumnarPoolStorage::None:
+                    break;
+            }
+            hasCatFeatures |= (columnType == EColumn::Categ);
+        }
+
+        // same quoting as in TCBDsvDataLoader
+        const char quote = hasCatFeatures ? '"' : '\0';
+        NPar::ParallelFor(*localExecutor, 0, SafeIntegerCast<ui32>(lines.size()), [&] (ui32 lineIdx) {
+            try {
+                ParseDsvLine(lines[lineIdx], delimiter, quote, header.Columns, lineIdx, &columnBuffers);
+            } catch (yexception& e) {
+                throw TCatBoostException() << "Error in dsv data. Line " << lineIdx + 1 << ": " << e.what();
+            }
+        });
+        TVector<TString>().swap(lines);
+
+        NPar::ParallelFor(*localExecutor, 0, SafeIntegerCast<ui32>(header.Columns.size()), [&] (ui32 columnIdx) {
+            if (header.ColumnInfos[columnIdx].Storage == EColumnarPoolStorage::Dictionary) {
+                header.ColumnInfos[columnIdx].Dictionary = BuildDictionary(&columnBuffers[columnIdx]);
+            }
+        });
+
+        // offsets do not change the size of serialized header, so it can be computed before offsets are set
+        TBufferOutput headerOutput;
+        ::Save(&headerOutput, header);
+        const ui64 headerSize = headerOutput.Buffer().Size();
+        ui64 offset = AlignColumnarPoolOffset(ColumnarPoolPrefixSize + headerSize);
+        for (auto columnIdx : xrange(header.Columns.size())) {
+            auto& columnInfo = header.ColumnInfos[columnIdx];
+            columnInfo.Offset = offset;
+            columnInfo.Size = columnBuffers[columnIdx].GetData(columnInfo.Storage).size();
+            offset = AlignColumnarPoolOffset(offset + columnInfo.Size);
+        }
+
+        headerOutput.Buffer().Clear();
+        ::Save(&headerOutput, header);
+        Y_VERIFY(headerOutput.Buffer().Size() == headerSize);
+
+        TOFStream output(outputPath);
+        output.Write(ColumnarPoolMagic, sizeof(ColumnarPoolMagic));
+        ::Save(&output, ColumnarPoolVersion);
+        ::Save(&output, ui32(0));
+        ::Save(&output, headerSize);
+        output.Write(headerOutput.Buffer().Data(), headerOutput.Buffer().Size());
+
+        const TVector<char> padding(ColumnarPoolAlignment, 0);
+        ui64 written = ColumnarPoolPrefixSize + headerSize;
+        for (auto columnIdx : xrange(header.Columns.size())) {
+            const auto& columnInfo = header.ColumnInfos[columnIdx];
+            output.Write(padding.data(), columnInfo.Offset - written);
+            output.Write(columnBuffers[columnIdx].GetData(columnInfo.Storage));
+            written = columnInfo.Offset + columnInfo.Size;
+        }
+        output.Finish();
+
+        CATBOOST_INFO_LOG << "Converted " << header.ObjectCount << " objects to columnar pool "
+            << outputPath << " in " << timer.Passed() << " sec" << Endl;
+    }
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <catboost/libs/column_description/column.h>
+#include <catboost/private/libs/data_util/path_with_scheme.h>
+#include <catboost/private/libs/options/load_options.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/string.h>
+#include <util/generic/strbuf.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+#include <util/ysaveload.h>
+
+
+namespace NCB {
+
+    /* Columnar binary pool format ('columnar://' scheme)
+     *
+     * 8 bytes     : ColumnarPoolMagic (with terminating zero)
+     * ui32        : version
+     * ui32        : reserved
+     * ui64        : header size
+     * header      : TColumnarPoolHeader serialized with ysaveload
+     * column data : each column starts at offset aligned to ColumnarPoolAlignment,
+     *               data of all types is stored little-endian, so it can be used directly from mapped memory
+     */
+
+    constexpr char ColumnarPoolMagic[] = "CBCOLPL";
+    constexpr ui32 ColumnarPoolVersion = 1;
+    constexpr ui64 ColumnarPoolAlignment = 64;
+
+    enum class EColumnarPoolStorage : ui32 {
+        None,       // column is not stored (Auxiliary, SampleId)
+        Float,      // float32 value per object
+        UI32,       // ui32 value per object
+        UI64,       // ui64 value per object
+        Dictionary  // ui32 index in Dictionary per object
+    };
+
+    struct TColumnarPoolColumnInfo {
+        EColumnarPoolStorage Storage = EColumnarPoolStorage::None;
+        ui64 Offset = 0; // from the beginning of the file
+        ui64 Size = 0; // in bytes
+        TVector<TString> Dictionary;
+
+    public:
+        Y_SAVELOAD_DEFINE(Storage, Offset, Size, Dictionary);
+    };
+
+    struct TColumnarPoolHeader {
+        ui64 ObjectCount = 0;
+        TVector<TColumn> Columns;
+        TVector<TString> ColumnNames; // from dsv header, empty if there was no header
+        TVector<TColumnarPoolColumnInfo> ColumnInfos; // [columnIdx]
+
+    public:
+        Y_SAVELOAD_DEFINE(ObjectCount, Columns, ColumnNames, ColumnInfos);
+    };
+
+    /* Storage types by column type:
+     *   Num, Weight, GroupWeight, Baseline -> Float
+     *   SubgroupId (hashed)                -> UI32
+     *   GroupId (hashed), Timestamp        -> UI64
+     *   Label, Categ, Text                 -> Dictionary
+     */
+    EColumnarPoolStorage GetColumnarPoolStorage(EColumn columnType);
+
+    // reads header, data is not read
+    TColumnarPoolHeader ReadColumnarPoolHeader(TStringBuf data);
+
+    void ConvertDsvToColumnarPool(
+        const TPathWithScheme& poolPath,
+        const NCatboostOptions::TColumnarPoolFormatParams& poolFormatParams,
+        const TString& outputPath,
+        NPar::TLocalExecutor* localExecutor
+    );
+
+}
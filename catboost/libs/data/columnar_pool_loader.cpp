@@ -0,0 +1,218 @@
+#include "baseline.h"
+#include "columnar_pool.h"
+#include "loader.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/helpers/maybe_owning_array_holder.h>
+#include <catboost/libs/helpers/polymorphic_type_containers.h>
+#include <catboost/libs/helpers/resource_holder.h>
+#include <catboost/private/libs/data_util/exists_checker.h>
+
+#include <library/object_factory/object_factory.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/array_ref.h>
+#include <util/generic/cast.h>
+#include <util/generic/ptr.h>
+#include <util/generic/xrange.h>
+#include <util/memory/blob.h>
+
+
+namespace NCB {
+
+    namespace {
+
+        struct TBlobHolder : public IResourceHolder {
+            TBlob Blob;
+
+        public:
+            explicit TBlobHolder(TBlob blob)
+                : Blob(std::move(blob))
+            {}
+        };
+
+
+        // columns of numeric types are passed to the builder directly from the mapped file
+        class TColumnarPoolDataLoader : public IRawFeaturesOrderDatasetLoader {
+        public:
+            explicit TColumnarPoolDataLoader(TDatasetLoaderPullArgs&& args)
+                : Args(std::move(args.CommonArgs))
+                , Data(MakeIntrusive<TBlobHolder>(TBlob::FromFile(args.PoolPath.Path)))
+                , Header(ReadColumnarPoolHeader(TStringBuf(Data->Blob.AsCharPtr(), Data->Blob.Size())))
+            {
+                CB_ENSURE(!Args.PairsFilePath.Inited() || CheckExists(Args.PairsFilePath),
+                          "TColumnarPoolDataLoader:PairsFilePath does not exist");
+                CB_ENSURE(!Args.GroupWeightsFilePath.Inited() || CheckExists(Args.GroupWeightsFilePath),
+                          "TColumnarPoolDataLoader:GroupWeightsFilePath does not exist");
+                CB_ENSURE(!Args.BaselineFilePath.Inited() || CheckExists(Args.BaselineFilePath),
+                          "TColumnarPoolDataLoader:BaselineFilePath does not exist");
+
+                const auto& range = Args.DatasetSubset.Range;
+                const ui32 poolObjectCount = SafeIntegerCast<ui32>(Header.ObjectCount);
+                ObjectOffset = Min(range.Begin, poolObjectCount);
+                ObjectCount = Min(range.End, poolObjectCount) - ObjectOffset;
+
+                // column description is stored in the pool, so Args.CdProvider is not used
+                auto columnsDescription = TDataColumnsMetaInfo{Header.Columns};
+                TMaybe<TVector<TString>> headerColumns;
+                if (!Header.ColumnNames.empty()) {
+                    headerColumns = Header.ColumnNames;
+                }
+                auto featureIds = columnsDescription.GenerateFeatureIds(headerColumns);
+
+                TBaselineReader baselineReader(Args.BaselineFilePath, Args.ClassNames);
+                DataMetaInfo = TDataMetaInfo(
+                    std::move(columnsDescription),
+                    Args.GroupWeightsFilePath.Inited(),
+                    Args.PairsFilePath.Inited(),
+                    baselineReader.GetBaselineCount(),
+                    &featureIds,
+                    Args.ClassNames
+                );
+
+                ProcessIgnoredFeaturesList(Args.IgnoredFeatures, &DataMetaInfo, &FeatureIgnored);
+            }
+
+            void Do(IRawFeaturesOrderDataVisitor* visitor) override {
+                visitor->Start(DataMetaInfo, ObjectCount, Args.ObjectsOrder, {Data});
+
+                ui32 featureId = 0;
+                ui32 targetId = 0;
+                ui32 baselineIdx = 0;
+                for (auto columnIdx : xrange(Header.Columns.size())) {
+                    switch (Header.Columns[columnIdx].Type) {
+                        case EColumn::Num: {
+                            if (IsFeatureLoaded(featureId)) {
+                                const auto values = GetColumn<float>(columnIdx);
+                                visitor->AddFloatFeature(
+                                    featureId,
+                                    MakeNonOwningTypeCastArrayHolder<float, float>(values.begin(), values.end())
+                                );
+                            }
+                            ++featureId;
+                            break;
+                        }
+                        case EColumn::Categ: {
+                            if (IsFeatureLoaded(featureId)) {
+                                TVector<ui32> dictionaryHashes;
+                                for (const auto& value : Header.ColumnInfos[columnIdx].Dictionary) {
+                                    dictionaryHashes.push_back(visitor->GetCatFeatureValue(featureId, value));
+                                }
+                                visitor->AddCatFeature(
+                                    featureId,
+                                    TMaybeOwningConstArrayHolder<ui32>::CreateOwning(
+                                        Decode(columnIdx, MakeConstArrayRef(dictionaryHashes))
+                                    )
+                                );
+                            }
+                            ++featureId;
+                            break;
+                        }
+                        case EColumn::Text: {
+                            if (IsFeatureLoaded(featureId)) {
+                                visitor->AddTextFeature(
+                                    featureId,
+                                    TMaybeOwningConstArrayHolder<TString>::CreateOwning(
+                                        Decode(columnIdx, MakeConstArrayRef(Header.ColumnInfos[columnIdx].Dictionary))
+                                    )
+                                );
+                            }
+                            ++featureId;
+                            break;
+                        }
+                        case EColumn::Label: {
+                            const auto target = Decode(columnIdx, MakeConstArrayRef(Header.ColumnInfos[columnIdx].Dictionary));
+                            visitor->AddTarget(targetId, target);
+                            ++targetId;
+                            break;
+                        }
+                        case EColumn::Weight: {
+                            visitor->AddWeights(GetColumn<float>(columnIdx));
+                            break;
+                        }
+                        case EColumn::GroupWeight: {
+                            visitor->AddGroupWeights(GetColumn<float>(columnIdx));
+                            break;
+                        }
+                        case EColumn::Baseline: {
+                            visitor->AddBaseline(baselineIdx, GetColumn<float>(columnIdx));
+                            ++baselineIdx;
+                            break;
+                        }
+                        case EColumn::GroupId: {
+                            const auto groupIds = GetColumn<ui64>(columnIdx);
+                            for (auto objectIdx : xrange(ObjectCount)) {
+                                visitor->AddGroupId(objectIdx, groupIds[objectIdx]);
+                            }
+                            break;
+                        }
+                        case EColumn::SubgroupId: {
+                            const auto subgroupIds = GetColumn<ui32>(columnIdx);
+                            for (auto objectIdx : xrange(ObjectCount)) {
+                                visitor->AddSubgroupId(objectIdx, subgroupIds[objectIdx]);
+                            }
+                            break;
+                        }
+                        case EColumn::Timestamp: {
+                            const auto timestamps = GetColumn<ui64>(columnIdx);
+                            for (auto objectIdx : xrange(ObjectCount)) {
+                                visitor->AddTimestamp(objectIdx, timestamps[objectIdx]);
+                            }
+                            break;
+                        }
+                        default:
+                            break;
+                    }
+                }
+
+                SetGroupWeights(Args.GroupWeightsFilePath, ObjectCount, Args.DatasetSubset, visitor);
+                SetPairs(Args.PairsFilePath, ObjectCount, Args.DatasetSubset, visitor);
+                SetBaseline(Args.BaselineFilePath, ObjectCount, Args.DatasetSubset, Args.ClassNames, visitor);
+                visitor->Finish();
+            }
+
+        private:
+            bool IsFeatureLoaded(ui32 featureId) const {
+                return Args.DatasetSubset.HasFeatures && !FeatureIgnored[featureId];
+            }
+
+            // objects of the loaded subset only
+            template <class T>
+            TConstArrayRef<T> GetColumn(size_t columnIdx) const {
+                const auto& columnInfo = Header.ColumnInfos[columnIdx];
+                const T* columnBegin = reinterpret_cast<const T*>(Data->Blob.AsCharPtr() + columnInfo.Offset);
+                return TConstArrayRef<T>(columnBegin + ObjectOffset, ObjectCount);
+            }
+
+            template <class T>
+            TVector<T> Decode(size_t columnIdx, TConstArrayRef<T> dictionary) const {
+                const auto indices = GetColumn<ui32>(columnIdx);
+                CB_ENSURE(
+                    indices.empty() || *MaxElement(indices.begin(), indices.end()) < dictionary.size(),
+                    "Columnar pool column " << columnIdx << " has dictionary indices out of range"
+                );
+                TVector<T> result;
+                result.yresize(indices.size());
+                NPar::ParallelFor(*Args.LocalExecutor, 0, SafeIntegerCast<ui32>(indices.size()), [&] (ui32 objectIdx) {
+                    result[objectIdx] = dictionary[indices[objectIdx]];
+                });
+                return result;
+            }
+
+        private:
+            TDatasetLoaderCommonArgs Args;
+            TIntrusivePtr<TBlobHolder> Data;
+            TColumnarPoolHeader Header;
+            TDataMetaInfo DataMetaInfo;
+            TVector<bool> FeatureIgnored; // [flatFeatureIdx]
+            ui32 ObjectOffset = 0;
+            ui32 ObjectCount = 0;
+        };
+
+    }
+
+    namespace {
+        TDatasetLoaderFactory::TRegistrator<TColumnarPoolDataLoader> ColumnarPoolDataLoaderReg("columnar");
+        TExistsCheckerFactory::TRegistrator<TFSExistsChecker> ColumnarPoolExistsCheckerReg("columnar");
+    }
+}
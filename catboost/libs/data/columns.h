@@ -327,6 +327,22 @@ namespace NCB {
         }
     }
 
+    /* same as DispatchBitsPerKeyToDataType but also supports 4 bits per key,
+     * data is passed to f as TConstNibbleArrayPtr in this case, so f can access it only by operator[]
+     */
+    template <class F>
+    inline void DispatchBitsPerKeyToDataTypeOrNibbles(
+        const TCompressedArray& compressedArray,
+        const TStringBuf errorMessagePrefix,
+        F&& f
+    ) {
+        if (compressedArray.GetBitsPerKey() == 4) {
+            f(TConstNibbleArrayPtr((const ui8*)compressedArray.GetRawPtr()));
+        } else {
+            DispatchBitsPerKeyToDataType(compressedArray, errorMessagePrefix, std::forward<F>(f));
+        }
+    }
+
 
     template <class T, EFeatureValuesType TType>
     class TCompressedValuesHolderImpl : public TCloneableWithSubsetIndexingValuesHolder<T, TType> {
@@ -383,6 +399,13 @@ namespace NCB {
                 featuresSubsetIndexing = SubsetIndexing;
             }
             switch (SrcData.GetBitsPerKey()) {
+            case 4:
+                NCB::TConstCompressedArraySubset(&SrcData, featuresSubsetIndexing).ForEach(
+                    [&f] (ui32 idx, ui32 value) {
+                        f(idx, (ui8)value);
+                    }
+                );
+                break;
             case 8:
                 NCB::TConstPtrArraySubset<ui8>(
                     GetArrayData<ui8>().GetSrc(),
@@ -167,20 +167,21 @@ namespace NCB {
         }
 
         ui32 GetCatFeatureValue(ui32 flatFeatureIdx, TStringBuf feature) override {
-            auto catFeatureIdx = GetInternalFeatureIdx<EFeatureType::Categorical>(flatFeatureIdx);
             ui32 hashVal = CalcCatFeatureHash(feature);
-            int hashPartIdx = LocalExecutor->GetWorkerThreadId();
-            CB_ENSURE(hashPartIdx < CB_THREAD_LIMIT, "Internal error: thread ID exceeds CB_THREAD_LIMIT");
-            auto& catFeatureHashes = HashMapParts[hashPartIdx].CatFeatureHashes;
-            catFeatureHashes.resize(CatFeatureCount);
-            auto& catFeatureHash = catFeatureHashes[*catFeatureIdx];
-
-            THashMap<ui32, TString>::insert_ctx insertCtx;
-            if (!catFeatureHash.contains(hashVal, insertCtx)) {
-                catFeatureHash.emplace_direct(insertCtx, hashVal, feature);
-            }
+            AddCatFeatureHashToString(GetCatFeatureHashesPart(), flatFeatureIdx, hashVal, feature);
             return hashVal;
         }
+        void GetCatFeatureValues(
+            TConstArrayRef<ui32> flatFeatureIndices,
+            TConstArrayRef<TStringBuf> features,
+            TArrayRef<ui32> values
+        ) override {
+            CalcCatFeatureHashes(features, values);
+            auto& catFeatureHashes = GetCatFeatureHashesPart();
+            for (auto i : xrange(features.size())) {
+                AddCatFeatureHashToString(catFeatureHashes, flatFeatureIndices[i], values[i], features[i]);
+            }
+        }
         void AddCatFeature(ui32 localObjectIdx, ui32 flatFeatureIdx, TStringBuf feature) override {
             auto catFeatureIdx = GetInternalFeatureIdx<EFeatureType::Categorical>(flatFeatureIdx);
             CatFeaturesStorage.Set(
@@ -465,6 +466,30 @@ namespace NCB {
             return Data.MetaInfo.FeaturesLayout->GetExpandingInternalFeatureIdx<FeatureType>(flatFeatureIdx);
         }
 
+        // hash to string maps of the current thread
+        TVector<THashMap<ui32, TString>>& GetCatFeatureHashesPart() {
+            int hashPartIdx = LocalExecutor->GetWorkerThreadId();
+            CB_ENSURE(hashPartIdx < CB_THREAD_LIMIT, "Internal error: thread ID exceeds CB_THREAD_LIMIT");
+            auto& catFeatureHashes = HashMapParts[hashPartIdx].CatFeatureHashes;
+            catFeatureHashes.resize(CatFeatureCount);
+            return catFeatureHashes;
+        }
+
+        void AddCatFeatureHashToString(
+            TVector<THashMap<ui32, TString>>& catFeatureHashes,
+            ui32 flatFeatureIdx,
+            ui32 hashVal,
+            TStringBuf feature
+        ) {
+            auto catFeatureIdx = GetInternalFeatureIdx<EFeatureType::Categorical>(flatFeatureIdx);
+            auto& catFeatureHash = catFeatureHashes[*catFeatureIdx];
+
+            THashMap<ui32, TString>::insert_ctx insertCtx;
+            if (!catFeatureHash.contains(hashVal, insertCtx)) {
+                catFeatureHash.emplace_direct(insertCtx, hashVal, feature);
+            }
+        }
+
     private:
         struct THashPart {
             TVector<THashMap<ui32, TString>> CatFeatureHashes;
@@ -1098,9 +1123,8 @@ namespace NCB {
                     auto blockIterator = stringValues.GetBlockIterator(subRange);
                     ui32 objectIdx = subRange.Begin;
                     while (auto block = blockIterator->Next()) {
-                        for (auto stringValue : block) {
-                            hashedCatValuesRef[objectIdx++] = CalcCatFeatureHash(stringValue);
-                        }
+                        CalcCatFeatureHashes(block, hashedCatValuesRef.Slice(objectIdx, block.size()));
+                        objectIdx += block.size();
                     }
                 },
                 0,
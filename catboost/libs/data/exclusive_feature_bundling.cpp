@@ -7,10 +7,12 @@
 #include <catboost/libs/helpers/array_subset.h>
 #include <catboost/libs/helpers/double_array_iterator.h>
 #include <catboost/libs/helpers/parallel_tasks.h>
+#include <catboost/libs/logging/logging.h>
 
 #include <library/pop_count/popcount.h>
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/datetime/base.h>
 #include <util/generic/algorithm.h>
 #include <util/generic/array_ref.h>
 #include <util/generic/cast.h>
@@ -90,6 +92,91 @@ namespace NCB {
         return intersectionCount;
     }
 
+    // because 0 bin is common for all features in the bundle
+    static ui32 GetBinCountInBundleNeeded(
+        const TQuantizedFeaturesInfo& quantizedFeaturesInfo,
+        ui32 flatFeatureIdx
+    ) {
+        const auto& featuresLayout = *quantizedFeaturesInfo.GetFeaturesLayout();
+        const auto featureType = featuresLayout.GetExternalFeatureType(flatFeatureIdx);
+        const auto perTypeFeatureIdx = featuresLayout.GetInternalFeatureIdx(flatFeatureIdx);
+
+        const ui32 featureBinCount
+            = (featureType == EFeatureType::Float) ?
+                quantizedFeaturesInfo.GetBinCount(TFloatFeatureIdx(perTypeFeatureIdx)) :
+                quantizedFeaturesInfo.GetUniqueValuesCounts(TCatFeatureIdx(perTypeFeatureIdx)).OnAll;
+
+        return featureBinCount - 1;
+    }
+
+    // quick check by bin and non default value counts only
+    static bool IsCandidateBundle(
+        const TExclusiveFeaturesBundle& bundle,
+        const TExclusiveFeatureBundleForMerging& bundleForMerging,
+        ui32 binCountInBundleNeeded,
+        ui32 featureNonDefaultCount,
+        ui32 objectCount,
+        ui32 maxObjectIntersection,
+        ui32 maxBuckets
+    ) {
+        if (bundle.GetUsedByPartsBinCount() + binCountInBundleNeeded >= maxBuckets) {
+            return false;
+        }
+        auto maxRemaininingIntersectionCount = maxObjectIntersection - bundleForMerging.IntersectionCount;
+        return (bundleForMerging.NonDefaultCount + featureNonDefaultCount)
+            <= (objectCount + maxRemaininingIntersectionCount);
+    }
+
+    static TVector<TExclusiveFeaturesBundle> SelectBundlesForResult(TVector<TExclusiveFeaturesBundle>&& bundles) {
+        TVector<ui32> bundlesForResult;
+
+        // less than sizeof(TBinaryFeaturesPack) * CHAR_BIT binary features
+        TVector<ui32> smallBinaryFeaturesOnlyBundles;
+
+        size_t binaryFeaturesInSmallBundlesCount = 0;
+
+        for (auto i : xrange(bundles.size())) {
+            auto partCount = bundles[i].Parts.size();
+
+            // 2 is an empiric relative performance constant
+            if (bundles[i].IsBinaryFeaturesOnly()
+                && (2 * partCount < (sizeof(TBinaryFeaturesPack) * CHAR_BIT)))
+            {
+                binaryFeaturesInSmallBundlesCount += partCount;
+                smallBinaryFeaturesOnlyBundles.push_back(i);
+            } else if (partCount > 1) { // don't save bundles with only one feature
+                bundlesForResult.push_back(i);
+            }
+        }
+
+        if (CeilDiv(binaryFeaturesInSmallBundlesCount, sizeof(TBinaryFeaturesPack) * CHAR_BIT)
+            >= 2 * smallBinaryFeaturesOnlyBundles.size()) // 2 is an empiric relative performance constant
+        {
+            // no reason to repack bundles with binary features to packed binary histograms
+
+            for (auto i : smallBinaryFeaturesOnlyBundles) {
+                if (bundles[i].Parts.size() > 1) {
+                    bundlesForResult.push_back(i);
+                }
+            }
+        }
+
+        if (bundlesForResult.size() == bundles.size()) {
+            return std::move(bundles);
+        }
+
+        Sort(bundlesForResult);
+
+        TVector<TExclusiveFeaturesBundle> result;
+        result.reserve(bundlesForResult.size());
+
+        for (auto bundleIdx : bundlesForResult) {
+            result.push_back(std::move(bundles[bundleIdx]));
+        }
+
+        return result;
+    }
+
     static TVector<TExclusiveFeaturesBundle> CreateExclusiveFeatureBundlesImpl(
         ui32 objectCount,
         const TQuantizedFeaturesInfo& quantizedFeaturesInfo,
@@ -112,18 +199,7 @@ namespace NCB {
         TFastRng64 rng(0);
 
         for (auto flatFeatureIdx : flatFeatureIndicesToCalc) {
-            const auto featureMetaInfo = featuresLayout.GetExternalFeaturesMetaInfo()[flatFeatureIdx];
-
-            const auto featureType = featuresLayout.GetExternalFeatureType(flatFeatureIdx);
-            const auto perTypeFeatureIdx = featuresLayout.GetInternalFeatureIdx(flatFeatureIdx);
-
-            const ui32 featureBinCount
-                = (featureType == EFeatureType::Float) ?
-                    quantizedFeaturesInfo.GetBinCount(TFloatFeatureIdx(perTypeFeatureIdx)) :
-                    quantizedFeaturesInfo.GetUniqueValuesCounts(TCatFeatureIdx(perTypeFeatureIdx)).OnAll;
-
-            // because 0 bin is common for all features in the bundle
-            const ui32 binCountInBundleNeeded = featureBinCount - 1;
+            const ui32 binCountInBundleNeeded = GetBinCountInBundleNeeded(quantizedFeaturesInfo, flatFeatureIdx);
 
             if (binCountInBundleNeeded >= options.MaxBuckets) {
                 continue;
@@ -134,21 +210,15 @@ namespace NCB {
             auto featureNonDefaultCount = featuresNonDefaultCounts[flatFeatureIdx];
 
             auto isCandidateBundle = [&] (ui32 bundleIdx) -> bool {
-                auto& bundle = bundles[bundleIdx];
-
-                if (bundle.GetUsedByPartsBinCount() + binCountInBundleNeeded >= options.MaxBuckets) {
-                    return false;
-                }
-
-                auto& bundleForMerging = bundlesForMerging[bundleIdx];
-                auto maxRemaininingIntersectionCount
-                    = maxObjectIntersection - bundleForMerging.IntersectionCount;
-                if ((bundleForMerging.NonDefaultCount + featuresNonDefaultCounts[flatFeatureIdx])
-                     > (objectCount + maxRemaininingIntersectionCount))
-                {
-                    return false;
-                }
-                return true;
+                return IsCandidateBundle(
+                    bundles[bundleIdx],
+                    bundlesForMerging[bundleIdx],
+                    binCountInBundleNeeded,
+                    featureNonDefaultCount,
+                    objectCount,
+                    maxObjectIntersection,
+                    options.MaxBuckets
+                );
             };
 
             auto tryAddToBundle = [&] (ui32 bundleIdx) -> bool {
@@ -252,61 +322,271 @@ namespace NCB {
             }
         }
 
-        TVector<ui32> bundlesForResult;
+        return SelectBundlesForResult(std::move(bundles));
+    }
 
-        // less than sizeof(TBinaryFeaturesPack) * CHAR_BIT binary features
-        TVector<ui32> smallBinaryFeaturesOnlyBundles;
+    static size_t CalcHistogramReduction(TConstArrayRef<TExclusiveFeaturesBundle> bundles) {
+        size_t bundledFeaturesCount = 0;
+        for (const auto& bundle : bundles) {
+            bundledFeaturesCount += bundle.Parts.size();
+        }
+        return bundledFeaturesCount - bundles.size();
+    }
 
-        size_t binaryFeaturesInSmallBundlesCount = 0;
+    /* leave masks only for a random subset of 64-object blocks, block indices are renumbered
+     * returns the number of objects in the sampled blocks
+     * if fullFeaturesNonDefaultMasks is not null and masks are sampled, it receives the original masks
+     */
+    static ui32 SampleNonDefaultMasks(
+        ui32 objectCount,
+        ui32 maxSampledObjectCount,
+        TConstArrayRef<ui32> flatFeatureIndices,
+        TFeaturesNonDefaultMasks* featuresNonDefaultMasks,
+        TArrayRef<ui32> featuresNonDefaultCounts,
+        TFeaturesNonDefaultMasks* fullFeaturesNonDefaultMasks,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        constexpr ui32 blockSize = CHAR_BIT * sizeof(ui64);
 
-        for (auto i : xrange(bundles.size())) {
-            auto partCount = bundles[i].Parts.size();
+        const ui32 blockCount = CeilDiv(objectCount, blockSize);
+        const ui32 sampledBlockCount = Min(blockCount, CeilDiv(maxSampledObjectCount, blockSize));
+        if (sampledBlockCount == blockCount) {
+            return objectCount;
+        }
 
-            // 2 is an empiric relative performance constant
-            if (bundles[i].IsBinaryFeaturesOnly()
-                && (2 * partCount < (sizeof(TBinaryFeaturesPack) * CHAR_BIT)))
-            {
-                binaryFeaturesInSmallBundlesCount += partCount;
-                smallBinaryFeaturesOnlyBundles.push_back(i);
-            } else if (partCount > 1) { // don't save bundles with only one feature
-                bundlesForResult.push_back(i);
-            }
+        TVector<ui32> sampledBlocks(blockCount);
+        Iota(sampledBlocks.begin(), sampledBlocks.end(), ui32(0));
+
+        TFastRng64 rng(0);
+        for (auto i : xrange(sampledBlockCount)) {
+            std::swap(sampledBlocks[i], sampledBlocks[rng.Uniform(i, blockCount)]);
         }
+        sampledBlocks.resize(sampledBlockCount);
+        Sort(sampledBlocks);
 
-        if (CeilDiv(binaryFeaturesInSmallBundlesCount, sizeof(TBinaryFeaturesPack) * CHAR_BIT)
-            >= 2 * smallBinaryFeaturesOnlyBundles.size()) // 2 is an empiric relative performance constant
-        {
-            // no reason to repack bundles with binary features to packed binary histograms
+        if (fullFeaturesNonDefaultMasks) {
+            fullFeaturesNonDefaultMasks->resize(featuresNonDefaultMasks->size());
+        }
 
-            for (auto i : smallBinaryFeaturesOnlyBundles) {
-                if (bundles[i].Parts.size() > 1) {
-                    bundlesForResult.push_back(i);
+        TVector<ui32> blockToSampledBlock(blockCount, Max<ui32>());
+        ui32 sampledObjectCount = 0;
+        for (auto sampledBlockIdx : xrange(sampledBlockCount)) {
+            const ui32 blockIdx = sampledBlocks[sampledBlockIdx];
+            blockToSampledBlock[blockIdx] = sampledBlockIdx;
+            sampledObjectCount += Min(blockSize, objectCount - blockIdx * blockSize);
+        }
+
+        NPar::ParallelFor(
+            *localExecutor,
+            0,
+            SafeIntegerCast<ui32>(flatFeatureIndices.size()),
+            [&] (ui32 i) {
+                const ui32 flatFeatureIdx = flatFeatureIndices[i];
+                auto& masks = (*featuresNonDefaultMasks)[flatFeatureIdx];
+                if (fullFeaturesNonDefaultMasks) {
+                    (*fullFeaturesNonDefaultMasks)[flatFeatureIdx] = masks;
+                }
+
+                ui32 nonDefaultCount = 0;
+                size_t dstIdx = 0;
+                for (auto [blockIdx, mask] : masks) {
+                    const ui32 sampledBlockIdx = blockToSampledBlock[blockIdx];
+                    if (sampledBlockIdx != Max<ui32>()) {
+                        masks[dstIdx++] = std::make_pair(sampledBlockIdx, mask);
+                        nonDefaultCount += (ui32)PopCount(mask);
+                    }
                 }
+                masks.resize(dstIdx);
+                masks.shrink_to_fit();
+                featuresNonDefaultCounts[flatFeatureIdx] = nonDefaultCount;
             }
-        }
+        );
 
-        if (bundlesForResult.size() == bundles.size()) {
-            return bundles;
-        }
+        return sampledObjectCount;
+    }
 
-        Sort(bundlesForResult);
+    /* Greedy first-fit as in CreateExclusiveFeatureBundlesImpl but features are processed in batches:
+     *  candidate bundles for all features in the batch are searched in parallel among bundles existing
+     *  at the batch start, then the features are added sequentially, rechecking only bundles modified
+     *  in the current batch.
+     * If fullFeaturesNonDefaultMasks is not null (masks are sampled and no conflicts are allowed) a bundle
+     *  that fits on the sample is accepted only if it has no conflicts on all objects.
+     */
+    static TVector<TExclusiveFeaturesBundle> CreateExclusiveFeatureBundlesScalableImpl(
+        ui32 objectCount,
+        const TQuantizedFeaturesInfo& quantizedFeaturesInfo,
+        const TFeaturesNonDefaultMasks& featuresNonDefaultMasks,
+        TConstArrayRef<ui32> featuresNonDefaultCounts,
+        ui32 fullObjectCount,
+        const TFeaturesNonDefaultMasks* fullFeaturesNonDefaultMasks,
+        TConstArrayRef<ui32> flatFeatureIndicesToCalc,
+        const TExclusiveFeaturesBundlingOptions& options,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        const TInstant startTime = Now();
 
-        TVector<TExclusiveFeaturesBundle> result;
-        result.reserve(bundlesForResult.size());
+        const ui32 maxObjectIntersection = ui32(options.MaxConflictFraction * float(objectCount));
 
-        for (auto bundleIdx : bundlesForResult) {
-            result.push_back(std::move(bundles[bundleIdx]));
+        TVector<ui32> featuresToBundle; // flatFeatureIdx
+        TVector<ui32> binCountsInBundleNeeded; // [idx in featuresToBundle]
+        for (auto flatFeatureIdx : flatFeatureIndicesToCalc) {
+            const ui32 binCountInBundleNeeded = GetBinCountInBundleNeeded(quantizedFeaturesInfo, flatFeatureIdx);
+            if (binCountInBundleNeeded < options.MaxBuckets) {
+                featuresToBundle.push_back(flatFeatureIdx);
+                binCountsInBundleNeeded.push_back(binCountInBundleNeeded);
+            }
         }
 
-        return result;
-    }
+        TVector<TExclusiveFeaturesBundle> bundles;
+        TVector<TExclusiveFeatureBundleForMerging> bundlesForMerging;
 
-    static size_t CalcHistogramReduction(TConstArrayRef<TExclusiveFeaturesBundle> bundles) {
-        size_t bundledFeaturesCount = 0;
-        for (const auto& bundle : bundles) {
-            bundledFeaturesCount += bundle.Parts.size();
+        // [bundleIdx] -> block non default masks on all objects, used only with fullFeaturesNonDefaultMasks
+        TVector<TVector<ui64>> bundlesFullUsedObjects;
+
+        // bundles that still have free bins and free objects
+        TVector<ui32> openBundles;
+
+        auto calcIntersectionIfFits = [&] (ui32 bundleIdx, size_t featureIdx, ui32* intersectionCount) -> bool {
+            const ui32 flatFeatureIdx = featuresToBundle[featureIdx];
+            const auto& bundleForMerging = bundlesForMerging[bundleIdx];
+            if (!IsCandidateBundle(
+                    bundles[bundleIdx],
+                    bundleForMerging,
+                    binCountsInBundleNeeded[featureIdx],
+                    featuresNonDefaultCounts[flatFeatureIdx],
+                    objectCount,
+                    maxObjectIntersection,
+                    options.MaxBuckets))
+            {
+                return false;
+            }
+            const ui32 maxRemaininingIntersectionCount
+                = maxObjectIntersection - bundleForMerging.IntersectionCount;
+            *intersectionCount = CalcIntersectionCount(
+                bundleForMerging.UsedObjects,
+                featuresNonDefaultMasks[flatFeatureIdx],
+                maxRemaininingIntersectionCount);
+            if (*intersectionCount > maxRemaininingIntersectionCount) {
+                return false;
+            }
+            // the sample can miss conflicts
+            return !fullFeaturesNonDefaultMasks
+                || (CalcIntersectionCount(
+                        bundlesFullUsedObjects[bundleIdx],
+                        (*fullFeaturesNonDefaultMasks)[flatFeatureIdx],
+                        /*maxIntersectionCount*/ 0) == 0);
+        };
+
+        const size_t batchSize = 64 * SafeIntegerCast<size_t>(localExecutor->GetThreadCount() + 1);
+
+        for (size_t batchBegin = 0; batchBegin < featuresToBundle.size(); batchBegin += batchSize) {
+            if (Now() - startTime >= options.TimeBudget) {
+                CATBOOST_INFO_LOG << "Exclusive features bundling time budget exceeded, "
+                    << (featuresToBundle.size() - batchBegin) << " features are left unbundled" << Endl;
+                break;
+            }
+
+            const size_t batchEnd = Min(batchBegin + batchSize, featuresToBundle.size());
+
+            // bundleIdx, intersectionCount
+            TVector<std::pair<ui32, ui32>> proposals(batchEnd - batchBegin, std::make_pair(Max<ui32>(), ui32(0)));
+
+            NPar::ParallelFor(
+                *localExecutor,
+                0,
+                SafeIntegerCast<ui32>(proposals.size()),
+                [&] (ui32 i) {
+                    const size_t featureIdx = batchBegin + i;
+                    const bool sampleCandidates = openBundles.size() > options.MaxBundleCandidates;
+                    TFastRng64 rng(featuresToBundle[featureIdx]);
+
+                    for (auto candidateIdx : xrange(Min(openBundles.size(), options.MaxBundleCandidates))) {
+                        const ui32 bundleIdx
+                            = openBundles[sampleCandidates ? rng.Uniform(openBundles.size()) : candidateIdx];
+                        ui32 intersectionCount = 0;
+                        if (calcIntersectionIfFits(bundleIdx, featureIdx, &intersectionCount)) {
+                            proposals[i] = std::make_pair(bundleIdx, intersectionCount);
+                            return;
+                        }
+                    }
+                }
+            );
+
+            const size_t bundleCountAtBatchStart = bundles.size();
+            TVector<bool> modifiedInBatch(bundleCountAtBatchStart, false);
+
+            for (auto i : xrange(proposals.size())) {
+                const size_t featureIdx = batchBegin + i;
+                const ui32 flatFeatureIdx = featuresToBundle[featureIdx];
+
+                auto [bundleIdx, intersectionCount] = proposals[i];
+                if ((bundleIdx != Max<ui32>())
+                    && modifiedInBatch[bundleIdx]
+                    && !calcIntersectionIfFits(bundleIdx, featureIdx, &intersectionCount))
+                {
+                    bundleIdx = Max<ui32>();
+                }
+
+                if (bundleIdx == Max<ui32>()) {
+                    // bundles created in this batch are not visible to the parallel search
+                    const size_t newBundlesToCheckBegin = Max(
+                        bundleCountAtBatchStart,
+                        bundles.size() - Min(bundles.size(), options.MaxBundleCandidates)
+                    );
+                    for (auto newBundleIdx : xrange(newBundlesToCheckBegin, bundles.size())) {
+                        if (calcIntersectionIfFits(newBundleIdx, featureIdx, &intersectionCount)) {
+                            bundleIdx = newBundleIdx;
+                            break;
+                        }
+                    }
+                }
+
+                if (bundleIdx == Max<ui32>()) {
+                    bundleIdx = SafeIntegerCast<ui32>(bundles.size());
+                    intersectionCount = 0;
+                    bundles.emplace_back();
+                    bundlesForMerging.emplace_back(objectCount, localExecutor);
+                    if (fullFeaturesNonDefaultMasks) {
+                        bundlesFullUsedObjects.emplace_back(
+                            CeilDiv((size_t)fullObjectCount, CHAR_BIT * sizeof(ui64)),
+                            ui64(0)
+                        );
+                    }
+                } else if (bundleIdx < bundleCountAtBatchStart) {
+                    modifiedInBatch[bundleIdx] = true;
+                }
+
+                AddFeatureToBundle(
+                    quantizedFeaturesInfo,
+                    flatFeatureIdx,
+                    featuresNonDefaultMasks[flatFeatureIdx],
+                    featuresNonDefaultCounts[flatFeatureIdx],
+                    binCountsInBundleNeeded[featureIdx],
+                    intersectionCount,
+                    &bundles[bundleIdx],
+                    &bundlesForMerging[bundleIdx]
+                );
+                if (fullFeaturesNonDefaultMasks) {
+                    auto& bundleFullUsedObjects = bundlesFullUsedObjects[bundleIdx];
+                    for (auto [blockIdx, mask] : (*fullFeaturesNonDefaultMasks)[flatFeatureIdx]) {
+                        bundleFullUsedObjects[blockIdx] |= mask;
+                    }
+                }
+            }
+
+            openBundles.clear();
+            for (auto bundleIdx : xrange(bundles.size())) {
+                const auto& bundleForMerging = bundlesForMerging[bundleIdx];
+                if ((bundles[bundleIdx].GetUsedByPartsBinCount() + 1 < options.MaxBuckets)
+                    && (bundleForMerging.NonDefaultCount
+                        < (objectCount + maxObjectIntersection - bundleForMerging.IntersectionCount)))
+                {
+                    openBundles.push_back(bundleIdx);
+                }
+            }
         }
-        return bundledFeaturesCount - bundles.size();
+
+        return SelectBundlesForResult(std::move(bundles));
     }
 
 
@@ -318,6 +598,8 @@ namespace NCB {
         const TExclusiveFeaturesBundlingOptions& options,
         NPar::TLocalExecutor* localExecutor
     ) {
+        const TInstant startTime = Now();
+
         const ui32 objectCount = rawObjectsDataIncrementalIndexing.SrcSubsetIndexing.Size();
 
         if (objectCount == 0) {
@@ -356,6 +638,10 @@ namespace NCB {
             }
         }
 
+        if (featureIndicesToCalc.empty()) {
+            return {};
+        }
+
         TFeaturesArraySubsetInvertedIndexing invertedIncrementalIndexing(TFullSubset<ui32>(0));
 
         if (hasSparseFeatures) {
@@ -400,6 +686,24 @@ namespace NCB {
             NPar::TLocalExecutor::WAIT_COMPLETE
         );
 
+        const bool scalableBundling = options.MaxSampledObjectCount > 0;
+
+        // conflicts missed by the sample are not allowed, original masks are needed to find them
+        TFeaturesNonDefaultMasks fullFeaturesNonDefaultMasks;
+        const bool checkFullMasks = scalableBundling && (options.MaxConflictFraction == 0.0f);
+
+        const ui32 objectCountForBundling = scalableBundling ?
+            SampleNonDefaultMasks(
+                objectCount,
+                options.MaxSampledObjectCount,
+                featureIndicesToCalc,
+                &featuresNonDefaultMasks,
+                featuresNonDefaultCount,
+                checkFullMasks ? &fullFeaturesNonDefaultMasks : nullptr,
+                localExecutor
+            )
+            : objectCount;
+
         TVector<ui32> featureIndicesToCalcByNonDefaultCount = featureIndicesToCalc;
 
         Sort(
@@ -409,6 +713,29 @@ namespace NCB {
             }
         );
 
+        if (scalableBundling) {
+            auto result = CreateExclusiveFeatureBundlesScalableImpl(
+                objectCountForBundling,
+                quantizedFeaturesInfo,
+                featuresNonDefaultMasks,
+                featuresNonDefaultCount,
+                objectCount,
+                (checkFullMasks && (objectCountForBundling < objectCount)) ? &fullFeaturesNonDefaultMasks : nullptr,
+                featureIndicesToCalcByNonDefaultCount,
+                options,
+                localExecutor
+            );
+
+            const size_t histogramReduction = CalcHistogramReduction(result);
+            CATBOOST_INFO_LOG << "Exclusive features bundling: " << (histogramReduction + result.size())
+                << " features in " << result.size() << " bundles, column count reduced by "
+                << histogramReduction << " of " << featureIndicesToCalc.size() << " ("
+                << (100.0 * histogramReduction / featureIndicesToCalc.size()) << "%) in "
+                << (Now() - startTime) << Endl;
+
+            return result;
+        }
+
         TVector<TExclusiveFeaturesBundle> results[2];
 
         TVector<std::function<void()>> tasks;
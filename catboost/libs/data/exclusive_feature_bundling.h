@@ -11,6 +11,7 @@
 #include <library/binsaver/bin_saver.h>
 #include <library/dbg_output/dump.h>
 
+#include <util/datetime/base.h>
 #include <util/generic/bitops.h>
 #include <util/generic/vector.h>
 #include <util/generic/ymath.h>
@@ -135,6 +136,15 @@ namespace NCB {
         ui32 MaxBuckets = 1 << 10;
         float MaxConflictFraction = 0.0f;
         size_t MaxBundleCandidates = 100;
+
+        /* if > 0 use scalable bundling: conflicts are estimated on a random sample of objects
+         * (rounded up to 64-object blocks) and features are assigned to bundles in parallel batches,
+         * if MaxConflictFraction is 0 bundles are additionally checked for conflicts on all objects
+         */
+        ui32 MaxSampledObjectCount = 0;
+
+        // scalable bundling only: features that are not processed within this time are left unbundled
+        TDuration TimeBudget = TDuration::Max();
     };
 
 
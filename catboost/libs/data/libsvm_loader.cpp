@@ -26,7 +26,11 @@ namespace NCB {
     TLibSvmDataLoader::TLibSvmDataLoader(TDatasetLoaderPullArgs&& args)
         : TLibSvmDataLoader(
             TLineDataLoaderPushArgs {
-                GetLineDataReader(args.PoolPath, args.CommonArgs.PoolFormat),
+                GetLineDataReader(
+                    args.PoolPath,
+                    args.CommonArgs.PoolFormat,
+                    args.CommonArgs.LocalExecutor->GetThreadCount() + 1
+                ),
                 std::move(args.CommonArgs)
             }
         )
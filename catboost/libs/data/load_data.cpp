@@ -150,6 +150,46 @@ namespace NCB {
         return dataProviderBuilder->GetResult();
     }
 
+    TVector<TDataProviderPtr> ReadTestDatasets(
+        const NCatboostOptions::TPoolLoadParams& loadOptions,
+        EObjectsOrder objectsOrder,
+        TMaybe<TVector<TString>*> classNames,
+        NPar::TLocalExecutor* const executor,
+        TProfileInfo* const profile
+    ) {
+        TVector<TDataProviderPtr> testDataProviders;
+
+        CATBOOST_DEBUG_LOG << "Loading test..." << Endl;
+        for (int testIdx = 0; testIdx < loadOptions.TestSetPaths.ysize(); ++testIdx) {
+            const NCB::TPathWithScheme& testSetPath = loadOptions.TestSetPaths[testIdx];
+            const NCB::TPathWithScheme& testPairsFilePath =
+                    testIdx == 0 ? loadOptions.TestPairsFilePath : NCB::TPathWithScheme();
+            const NCB::TPathWithScheme& testGroupWeightsFilePath =
+                testIdx == 0 ? loadOptions.TestGroupWeightsFilePath : NCB::TPathWithScheme();
+            const NCB::TPathWithScheme& testBaselineFilePath =
+                testIdx == 0 ? loadOptions.TestBaselineFilePath : NCB::TPathWithScheme();
+
+            TDataProviderPtr testDataProvider = ReadDataset(
+                testSetPath,
+                testPairsFilePath,
+                testGroupWeightsFilePath,
+                testBaselineFilePath,
+                loadOptions.ColumnarPoolFormatParams,
+                loadOptions.IgnoredFeatures,
+                objectsOrder,
+                TDatasetSubset::MakeColumns(),
+                classNames,
+                executor
+            );
+            testDataProviders.push_back(std::move(testDataProvider));
+            if (profile && (testIdx + 1 == loadOptions.TestSetPaths.ysize())) {
+                profile->AddOperation("Build test pool");
+            }
+        }
+
+        return testDataProviders;
+    }
+
     TDataProviders ReadTrainDatasets(
         const NCatboostOptions::TPoolLoadParams& loadOptions,
         EObjectsOrder objectsOrder,
@@ -190,33 +230,7 @@ namespace NCB {
         dataProviders.Test.resize(0);
 
         if (readTestData) {
-            CATBOOST_DEBUG_LOG << "Loading test..." << Endl;
-            for (int testIdx = 0; testIdx < loadOptions.TestSetPaths.ysize(); ++testIdx) {
-                const NCB::TPathWithScheme& testSetPath = loadOptions.TestSetPaths[testIdx];
-                const NCB::TPathWithScheme& testPairsFilePath =
-                        testIdx == 0 ? loadOptions.TestPairsFilePath : NCB::TPathWithScheme();
-                const NCB::TPathWithScheme& testGroupWeightsFilePath =
-                    testIdx == 0 ? loadOptions.TestGroupWeightsFilePath : NCB::TPathWithScheme();
-                const NCB::TPathWithScheme& testBaselineFilePath =
-                    testIdx == 0 ? loadOptions.TestBaselineFilePath : NCB::TPathWithScheme();
-
-                TDataProviderPtr testDataProvider = ReadDataset(
-                    testSetPath,
-                    testPairsFilePath,
-                    testGroupWeightsFilePath,
-                    testBaselineFilePath,
-                    loadOptions.ColumnarPoolFormatParams,
-                    loadOptions.IgnoredFeatures,
-                    objectsOrder,
-                    TDatasetSubset::MakeColumns(),
-                    classNames,
-                    executor
-                );
-                dataProviders.Test.push_back(std::move(testDataProvider));
-                if (profile && (testIdx + 1 == loadOptions.TestSetPaths.ysize())) {
-                    profile->AddOperation("Build test pool");
-                }
-            }
+            dataProviders.Test = ReadTestDatasets(loadOptions, objectsOrder, classNames, executor, profile);
         }
 
         return dataProviders;
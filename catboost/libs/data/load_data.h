@@ -61,6 +61,15 @@ namespace NCB {
         NPar::TLocalExecutor* localExecutor
     );
 
+    // reads loadOptions.TestSetPaths, test pairs, group weights and baseline apply to the first one
+    TVector<TDataProviderPtr> ReadTestDatasets(
+        const NCatboostOptions::TPoolLoadParams& loadOptions,
+        EObjectsOrder objectsOrder,
+        TMaybe<TVector<TString>*> classNames,
+        NPar::TLocalExecutor* executor,
+        TProfileInfo* profile
+    );
+
     TDataProviders ReadTrainDatasets(
         const NCatboostOptions::TPoolLoadParams& loadOptions,
         EObjectsOrder objectsOrder,
@@ -99,7 +99,13 @@ namespace NCB {
 
     struct IRawFeaturesOrderDatasetLoader : public IDatasetLoader {
         virtual EDatasetVisitorType GetVisitorType() const override {
-            return EDatasetVisitorType::RawObjectsOrder;
+            return EDatasetVisitorType::RawFeaturesOrder;
+        }
+
+        void DoIfCompatible(IDatasetVisitor* visitor) override {
+            auto compatibleVisitor = dynamic_cast<IRawFeaturesOrderDataVisitor*>(visitor);
+            CB_ENSURE_INTERNAL(compatibleVisitor, "visitor is incompatible with dataset loader");
+            Do(compatibleVisitor);
         }
 
         // Process all data
@@ -1217,7 +1217,7 @@ static ui32 CalcCompressedFeatureChecksum(
 
     auto consecutiveSubsetBegin = compressedDataSubset.GetSubsetIndexing()->GetConsecutiveSubsetBegin();
     const ui32 columnValuesBitWidth = columnData.GetBitsPerKey();
-    if (consecutiveSubsetBegin.Defined()) {
+    if (consecutiveSubsetBegin.Defined() && (columnValuesBitWidth >= CHAR_BIT)) {
         ui8 byteSize = columnValuesBitWidth / 8;
         return UpdateCheckSum(
             checkSum,
@@ -1227,7 +1227,7 @@ static ui32 CalcCompressedFeatureChecksum(
         );
     }
 
-    if (columnValuesBitWidth == 8) {
+    if ((columnValuesBitWidth == 4) || (columnValuesBitWidth == 8)) {
         columnData.ForEach([&](ui32 /*idx*/, ui8 element) {
             checkSum = UpdateCheckSum(checkSum, element);
         });
@@ -2280,6 +2280,20 @@ static void MakeConsecutiveIfDenseColumnDataWithScheduling(
             [srcCompressedValuesHolder, newSubsetIndexing, localExecutor, dst]() {
                 const ui32 objectCount = srcCompressedValuesHolder->GetSize();
                 const ui32 bitsPerKey = srcCompressedValuesHolder->GetBitsPerKey();
+
+                if (bitsPerKey == 4) {
+                    // two values share a byte, so they can't be written in parallel directly
+                    *dst = MakeHolder<TDenseHolder>(
+                        srcCompressedValuesHolder->GetId(),
+                        CompressToNibbles(
+                            *srcCompressedValuesHolder->template ExtractValuesT<ui8>(localExecutor),
+                            localExecutor
+                        ),
+                        newSubsetIndexing
+                    );
+                    return;
+                }
+
                 TIndexHelper<ui64> indexHelper(bitsPerKey);
                 const ui32 dstStorageSize = indexHelper.CompressedSize(objectCount);
 
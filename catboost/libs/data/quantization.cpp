@@ -20,6 +20,8 @@
 #include <catboost/private/libs/options/plain_options_helper.h>
 #include <catboost/private/libs/options/system_options.h>
 #include <catboost/private/libs/text_processing/text_column_builder.h>
+#include <catboost/private/libs/text_processing/tokenized_text_cache.h>
+#include <catboost/private/libs/quantization/quantile_sketch.h>
 #include <catboost/private/libs/quantization/utils.h>
 #include <catboost/private/libs/quantization_schema/quantize.h>
 
@@ -147,14 +149,17 @@ namespace NCB {
     ) {
         if (NeedToCalcBorders(featuresLayoutForQuantization, quantizedFeaturesInfo)) {
             const ui32 objectCount = srcIndexing.Size();
-            const ui32 sampleSize = GetSampleSizeForBorderSelectionType(
-                objectCount,
-                /*TODO(kirillovs): iterate through all per feature binarization settings and select smallest
-                 * sample size
-                 */
-                quantizedFeaturesInfo.GetFloatFeatureBinarization(Max<ui32>()).BorderSelectionType,
-                options.MaxSubsetSizeForBuildBordersAlgorithms
-            );
+            // sketches are built in bounded memory, so they use all objects
+            const ui32 sampleSize = (options.BorderSketchRankError > 0.0) ?
+                objectCount :
+                GetSampleSizeForBorderSelectionType(
+                    objectCount,
+                    /*TODO(kirillovs): iterate through all per feature binarization settings and select smallest
+                     * sample size
+                     */
+                    quantizedFeaturesInfo.GetFloatFeatureBinarization(Max<ui32>()).BorderSelectionType,
+                    options.MaxSubsetSizeForBuildBordersAlgorithms
+                );
             TFeaturesArraySubsetIndexing subsetIndexing;
             if (sampleSize < objectCount) {
                 if (srcObjectsOrder == EObjectsOrder::RandomShuffled) {
@@ -207,7 +212,25 @@ namespace NCB {
         const TFloatFeatureIdx floatFeatureIdx
             = quantizedFeaturesInfo.GetPerTypeFeatureIdx<EFeatureType::Float>(srcFeature);
 
-        if (!quantizedFeaturesInfo.HasBorders(floatFeatureIdx)) {
+        if (!quantizedFeaturesInfo.HasBorders(floatFeatureIdx) && (options.BorderSketchRankError > 0.0)) {
+            const auto& floatFeatureBinarizationSettings
+                = quantizedFeaturesInfo.GetFloatFeatureBinarization(srcFeature.GetId());
+
+            borderCount = floatFeatureBinarizationSettings.BorderCount.Get();
+
+            // sketch levels retain up to 3 * sketchSize items, borders are selected on a resample of twice that
+            const ui64 retainedItemCount
+                = 3 * ui64(TQuantileSketch::GetSizeForRankError(options.BorderSketchRankError));
+
+            // retained items and their sorted copy with weights
+            result += retainedItemCount * (2 * sizeof(float) + sizeof(ui64) + sizeof(std::pair<float, ui64>));
+            result += NSplitSelection::CalcMemoryForFindBestSplit(
+                SafeIntegerCast<int>(borderCount),
+                2 * retainedItemCount,
+                /*defaultValue*/ Nothing(),
+                floatFeatureBinarizationSettings.BorderSelectionType
+            );
+        } else if (!quantizedFeaturesInfo.HasBorders(floatFeatureIdx)) {
             // sampleSize is computed using defaultBinarizationSettings for now
             const auto& defaultBinarizationSettings
                 = quantizedFeaturesInfo.GetFloatFeatureBinarization(Max<ui32>());
@@ -273,6 +296,7 @@ namespace NCB {
         const TQuantizedFeaturesInfo& quantizedFeaturesInfo,
         const TMaybe<TVector<float>>& initialBorders,
         TMaybe<float> quantizedDefaultBinFraction,
+        double borderSketchRankError, // if > 0 borders are built from a quantile sketch
         ENanMode* nanMode,
         NSplitSelection::TQuantization* quantization
     ) {
@@ -285,11 +309,19 @@ namespace NCB {
         // featureValues.Values will not contain nans
         NSplitSelection::TFeatureValues featureValues{TVector<float>()};
 
+        // values are added to the sketch instead of featureValues, initial borders and default bin need exact values
+        TMaybe<TQuantileSketch> sketch;
+        if ((borderSketchRankError > 0.0) && !initialBorders && !quantizedDefaultBinFraction) {
+            sketch.ConstructInPlace(TQuantileSketch::GetSizeForRankError(borderSketchRankError));
+        }
+
         bool hasNans = false;
 
         auto processNonDefaultValue = [&] (ui32 /*idx*/, float value) {
             if (IsNan(value)) {
                 hasNans = true;
+            } else if (sketch) {
+                sketch->Add(value);
             } else {
                 featureValues.Values.push_back(value);
             }
@@ -302,8 +334,10 @@ namespace NCB {
                 &subsetIndexingForBuildBorders.ComposedSubset
             );
 
-            // does not contain nans
-            featureValues.Values.reserve(sampleCount);
+            if (!sketch) {
+                // does not contain nans
+                featureValues.Values.reserve(sampleCount);
+            }
 
             srcDataForBuildBorders->ForEach(processNonDefaultValue);
         } else if (const auto* sparseSrcFeature = dynamic_cast<const TFloatSparseValuesHolder*>(&srcFeature)) {
@@ -336,6 +370,8 @@ namespace NCB {
             if (defaultValuesSampleCount) {
                 if (IsNan(sparseData.GetDefaultValue())) {
                     hasNans = true;
+                } else if (sketch) {
+                    sketch->Add(sparseData.GetDefaultValue(), defaultValuesSampleCount);
                 } else {
                     featureValues.DefaultValue.ConstructInPlace(
                         sparseData.GetDefaultValue(),
@@ -362,7 +398,13 @@ namespace NCB {
             *nanMode = ENanMode::Forbidden;
         }
 
-        if (nonNanValuesBorderCount > 0) {
+        if ((nonNanValuesBorderCount > 0) && sketch) {
+            quantization->Borders = BuildBordersFromSketch(
+                *sketch,
+                nonNanValuesBorderCount,
+                binarizationOptions.BorderSelectionType
+            );
+        } else if (nonNanValuesBorderCount > 0) {
             *quantization = NSplitSelection::BestSplit(
                 std::move(featureValues),
                 /*featureValuesMayContainNans*/ false,
@@ -1100,6 +1142,30 @@ namespace NCB {
         }
     }
 
+    static bool NeedToNibblePackFloatFeature(const TQuantizationOptions& options, size_t borderCount) {
+        return options.NibblePackFeaturesForCpu
+            && options.CpuCompatibleFormat
+            && !options.GpuCompatibleFormat
+            && (borderCount < 16);
+    }
+
+    // sparse columns are left as is
+    static void NibblePackQuantizedFloatColumn(
+        NPar::TLocalExecutor* localExecutor,
+        THolder<IQuantizedFloatValuesHolder>* column
+    ) {
+        const auto* denseColumn = dynamic_cast<const TQuantizedFloatValuesHolder*>(column->Get());
+        if (!denseColumn || (denseColumn->GetBitsPerKey() != CHAR_BIT)) {
+            return;
+        }
+        const auto compressedData = denseColumn->GetCompressedData();
+        *column = MakeHolder<TQuantizedFloatValuesHolder>(
+            denseColumn->GetId(),
+            CompressToNibbles(compressedData.GetSrc()->GetRawArray<ui8>(), localExecutor),
+            compressedData.GetSubsetIndexing()
+        );
+    }
+
     TMaybe<ui32> GetDefaultQuantizedValue(
         const TQuantizedFeaturesInfo& quantizedFeaturesInfo,
         TFeatureIdxWithType featureWithType
@@ -1183,10 +1249,18 @@ namespace NCB {
         }
 
         void QuantizeAndClearSrcData(TFloatFeatureIdx floatFeatureIdx) const {
-            QuantizeAndClearSrcData(
-                &(RawObjectsData->FloatFeatures[*floatFeatureIdx]),
-                &(QuantizedObjectsData->Data.FloatFeatures[*floatFeatureIdx])
-            );
+            auto* dstColumn = &(QuantizedObjectsData->Data.FloatFeatures[*floatFeatureIdx]);
+            QuantizeAndClearSrcData(&(RawObjectsData->FloatFeatures[*floatFeatureIdx]), dstColumn);
+
+            const auto& quantizedFeaturesInfo = *QuantizedObjectsData->Data.QuantizedFeaturesInfo;
+            size_t borderCount;
+            {
+                TReadGuard guard(quantizedFeaturesInfo.GetRWMutex());
+                borderCount = quantizedFeaturesInfo.GetBorders(floatFeatureIdx).size();
+            }
+            if (NeedToNibblePackFloatFeature(Options, borderCount)) {
+                NibblePackQuantizedFloatColumn(LocalExecutor, dstColumn);
+            }
         }
 
         void QuantizeAndClearSrcData(TCatFeatureIdx catFeatureIdx) const {
@@ -1813,6 +1887,7 @@ namespace NCB {
                 *quantizedFeaturesInfo,
                 initialBordersForFeature,
                 options.DefaultValueFractionToEnableSparseStorage,
+                options.BorderSketchRankError,
                 &nanMode,
                 &calculatedQuantization
             );
@@ -1861,6 +1936,9 @@ namespace NCB {
                     localExecutor,
                     dstQuantizedFeature
                 );
+                if (NeedToNibblePackFloatFeature(options, borderCount)) {
+                    NibblePackQuantizedFloatColumn(localExecutor, dstQuantizedFeature);
+                }
             }
         }
     }
@@ -2001,11 +2079,37 @@ namespace NCB {
     }
 
 
+    // [textFeatureIdx], 0 for unavailable features
+    static TVector<ui64> CalcTextDataHashes(
+        TConstArrayRef<THolder<TStringTextValuesHolder>> textFeatures,
+        const TFeaturesLayout& featuresLayout,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        TVector<ui64> textDataHashes(textFeatures.size(), 0);
+        for (auto textFeatureIdx : xrange(textFeatures.size())) {
+            if (!featuresLayout.GetInternalFeatureMetaInfo(textFeatureIdx, EFeatureType::Text).IsAvailable) {
+                continue;
+            }
+            const auto& srcDenseFeature = dynamic_cast<const TStringTextArrayValuesHolder&>(
+                *textFeatures[textFeatureIdx]
+            );
+            textDataHashes[textFeatureIdx] = TTokenizedTextCache::CalcTextDataHash(
+                *srcDenseFeature.GetData(),
+                localExecutor
+            );
+        }
+        return textDataHashes;
+    }
+
+
     static void CreateDictionaries(
         TConstArrayRef<THolder<TStringTextValuesHolder>> textFeatures,
         const TFeaturesLayout& featuresLayout,
         const NCatboostOptions::TRuntimeTextOptions& textOptions,
-        TTextDigitizers* textDigitizers
+        const TTokenizedTextCache* tokenizedTextCache, // can be nullptr
+        TConstArrayRef<ui64> textDataHashes, // used only if tokenizedTextCache is not nullptr
+        TTextDigitizers* textDigitizers,
+        NPar::TLocalExecutor* localExecutor
     ) {
         for (ui32 tokenizedFeatureIdx: xrange(textOptions.TokenizedFeatureCount())) {
             const auto& featureDescription = textOptions.GetTokenizedFeatureDescription(tokenizedFeatureIdx);
@@ -2016,16 +2120,28 @@ namespace NCB {
                 continue;
             }
 
-            const auto& srcDenseFeature = dynamic_cast<const TStringTextArrayValuesHolder&>(
-                *textFeatures[textFeatureIdx]
-            );
-            ITypedArraySubsetPtr<TString> textFeature = srcDenseFeature.GetData();
+            const auto& dictionaryOptions = textOptions.GetDictionaryOptions(featureDescription.DictionaryId.Get());
 
-            auto dictionary = CreateDictionary(
-                TIterableTextFeature(textFeature),
-                textOptions.GetDictionaryOptions(featureDescription.DictionaryId.Get()),
-                textDigitizers->GetTokenizer()
-            );
+            TDictionaryPtr dictionary;
+            if (tokenizedTextCache) {
+                dictionary = tokenizedTextCache->LoadDictionary(textDataHashes[textFeatureIdx], dictionaryOptions);
+            }
+            if (!dictionary) {
+                const auto& srcDenseFeature = dynamic_cast<const TStringTextArrayValuesHolder&>(
+                    *textFeatures[textFeatureIdx]
+                );
+                ITypedArraySubsetPtr<TString> textFeature = srcDenseFeature.GetData();
+
+                dictionary = CreateDictionary(
+                    TIterableTextFeature(textFeature),
+                    dictionaryOptions,
+                    textDigitizers->GetTokenizer(),
+                    localExecutor
+                );
+                if (tokenizedTextCache) {
+                    tokenizedTextCache->SaveDictionary(textDataHashes[textFeatureIdx], dictionaryOptions, *dictionary);
+                }
+            }
             textDigitizers->AddDictionary(textFeatureIdx, tokenizedFeatureIdx, dictionary);
         }
     }
@@ -2078,23 +2194,49 @@ namespace NCB {
         TConstArrayRef<THolder<TStringTextValuesHolder>> textFeatures,
         const TFeaturesArraySubsetIndexing* dstSubsetIndexing,
         const TTextDigitizers& textDigitizers,
+        const TTokenizedTextCache* tokenizedTextCache, // can be nullptr
+        TConstArrayRef<ui64> textDataHashes, // used only if tokenizedTextCache is not nullptr
         TArrayRef<THolder<TTokenizedTextValuesHolder>> dstQuantizedFeatures,
         NPar::TLocalExecutor* localExecutor
     ) {
-        textDigitizers.Apply(
-            [textFeatures](ui32 textFeatureIdx) {
-                const TStringTextValuesHolder& srcFeature = *textFeatures[textFeatureIdx];
-                const auto& srcDenseFeature = dynamic_cast<const TStringTextArrayValuesHolder&>(srcFeature);
-                return TIterableTextFeature<ITypedArraySubsetPtr<TString>>(srcDenseFeature.GetData());
-            },
-            [&](ui32 tokenizedFeatureIdx, TVector<TText>&& tokenizedFeature) {
+        textDigitizers.ForEachDigitizedText(
+            [&](ui32 textFeatureIdx, ui32 tokenizedFeatureIdx, const TDictionaryPtr& dictionary) {
+                TMaybe<TTokenizedTextColumnView> cachedTokenizedFeature;
+                if (tokenizedTextCache) {
+                    cachedTokenizedFeature = tokenizedTextCache->LoadTokenizedColumn(
+                        textDataHashes[textFeatureIdx],
+                        dictionary->Id()
+                    );
+                }
+
+                TVector<TText> tokenizedFeature;
+                if (cachedTokenizedFeature) {
+                    tokenizedFeature = cachedTokenizedFeature->ToTexts(localExecutor);
+                } else {
+                    const auto& srcDenseFeature = dynamic_cast<const TStringTextArrayValuesHolder&>(
+                        *textFeatures[textFeatureIdx]
+                    );
+                    tokenizedFeature = textDigitizers.Digitize(
+                        TIterableTextFeature<ITypedArraySubsetPtr<TString>>(srcDenseFeature.GetData()),
+                        tokenizedFeatureIdx,
+                        localExecutor
+                    );
+                    if (tokenizedTextCache) {
+                        tokenizedTextCache->SaveTokenizedColumn(
+                            textDataHashes[textFeatureIdx],
+                            dictionary->Id(),
+                            tokenizedFeature,
+                            localExecutor
+                        );
+                    }
+                }
+
                 dstQuantizedFeatures[tokenizedFeatureIdx] = MakeHolder<TTokenizedTextArrayValuesHolder>(
                     tokenizedFeatureIdx,
                     TTextColumn::CreateOwning(std::move(tokenizedFeature)),
                     dstSubsetIndexing
                 );
-            },
-            localExecutor
+            }
         );
     }
 
@@ -2387,17 +2529,35 @@ namespace NCB {
                     );
 
 
+                    TMaybe<TTokenizedTextCache> tokenizedTextCache;
+                    TVector<ui64> textDataHashes;
+                    if (!options.TokenizedTextCacheDir.empty() &&
+                        !rawDataProvider->ObjectsData->Data.TextFeatures.empty())
+                    {
+                        tokenizedTextCache.ConstructInPlace(options.TokenizedTextCacheDir);
+                        textDataHashes = CalcTextDataHashes(
+                            MakeConstArrayRef(rawDataProvider->ObjectsData->Data.TextFeatures),
+                            *quantizedFeaturesInfo->GetFeaturesLayout(),
+                            localExecutor
+                        );
+                    }
+
                     CreateDictionaries(
                         MakeConstArrayRef(rawDataProvider->ObjectsData->Data.TextFeatures),
                         *quantizedFeaturesInfo->GetFeaturesLayout(),
                         quantizedFeaturesInfo->GetTextProcessingOptions(),
-                        quantizedFeaturesInfo->GetTextDigitizersMutable()
+                        tokenizedTextCache.Get(),
+                        textDataHashes,
+                        quantizedFeaturesInfo->GetTextDigitizersMutable(),
+                        localExecutor
                     );
 
                     ProcessTextFeatures(
                         rawDataProvider->ObjectsData->Data.TextFeatures,
                         subsetIndexing.Get(),
                         quantizedFeaturesInfo->GetTextDigitizers(),
+                        tokenizedTextCache.Get(),
+                        textDataHashes,
                         data->ObjectsData.Data.TextFeatures,
                         localExecutor
                     );
@@ -2634,6 +2794,10 @@ namespace NCB {
 
         TQuantizationOptions quantizationOptions;
         quantizationOptions.GroupFeaturesForCpu = params->DataProcessingOptions->DevGroupFeatures.GetUnchecked();
+        quantizationOptions.NibblePackFeaturesForCpu
+            = params->DataProcessingOptions->DevNibblePackFeatures.GetUnchecked();
+        quantizationOptions.TokenizedTextCacheDir = params->DataProcessingOptions->TokenizedTextCacheDir.Get();
+        quantizationOptions.BorderSketchRankError = params->DataProcessingOptions->DevBorderSketchRankError.Get();
         if (params->GetTaskType() == ETaskType::CPU) {
             quantizationOptions.GpuCompatibleFormat = false;
 
@@ -2641,6 +2805,13 @@ namespace NCB {
                 = params->ObliviousTreeOptions->DevExclusiveFeaturesBundleMaxBuckets.Get();
             quantizationOptions.ExclusiveFeaturesBundlingOptions.MaxConflictFraction
                 = params->ObliviousTreeOptions->SparseFeaturesConflictFraction.Get();
+            quantizationOptions.ExclusiveFeaturesBundlingOptions.MaxSampledObjectCount
+                = params->ObliviousTreeOptions->DevExclusiveFeaturesBundleSampleSize.Get();
+            const double efbTimeBudget = params->ObliviousTreeOptions->DevExclusiveFeaturesBundleTimeBudget.Get();
+            if (efbTimeBudget > 0.0) {
+                quantizationOptions.ExclusiveFeaturesBundlingOptions.TimeBudget
+                    = TDuration::Seconds(efbTimeBudget);
+            }
 
             /* TODO(kirillovs): Sparse features support for GPU
              * TODO(akhropov): Enable when sparse column scoring is supported
@@ -37,13 +37,26 @@ namespace NCB {
         bool GpuCompatibleFormat = true;
         ui64 CpuRamLimit = Max<ui64>();
         ui32 MaxSubsetSizeForBuildBordersAlgorithms = 200000;
+
+        /* if > 0 float feature borders are built from quantile sketches with this rank error
+         * over all objects instead of sorting a copy of the subset for building borders
+         */
+        double BorderSketchRankError = 0.0;
         bool BundleExclusiveFeaturesForCpu = true;
         TExclusiveFeaturesBundlingOptions ExclusiveFeaturesBundlingOptions{};
         bool PackBinaryFeaturesForCpu = true;
         bool GroupFeaturesForCpu = false;
+
+        /* store dense float features with less than 16 borders using 4 bits per value,
+         * used only if format is CPU-compatible but not GPU-compatible
+         */
+        bool NibblePackFeaturesForCpu = false;
         TFeaturesGroupingOptions FeaturesGroupingOptions{};
         bool AllowWriteFiles = true;
 
+        // directory to load and save dictionaries and tokenized text features, not used if empty
+        TString TokenizedTextCacheDir;
+
         TMaybe<float> DefaultValueFractionToEnableSparseStorage = Nothing();
         ESparseArrayIndexingType SparseArrayIndexingType = ESparseArrayIndexingType::Indices;
     };
@@ -0,0 +1,168 @@
+#include <catboost/libs/data/ut/lib/for_loader.h>
+
+#include <catboost/libs/data/columnar_pool.h>
+#include <catboost/libs/data/data_provider.h>
+#include <catboost/libs/data/load_data.h>
+
+#include <library/threading/local_executor/local_executor.h>
+#include <library/unittest/registar.h>
+
+#include <util/stream/buffer.h>
+#include <util/stream/file.h>
+#include <util/system/mktemp.h>
+#include <util/system/tempfile.h>
+
+
+using namespace NCB;
+using namespace NCB::NDataNewUT;
+
+
+static TDataProviderPtr ReadDatasetFromPath(
+    const TPathWithScheme& poolPath,
+    const TReadDatasetMainParams& params,
+    const TVector<ui32>& ignoredFeatures,
+    EObjectsOrder objectsOrder,
+    NPar::TLocalExecutor* localExecutor
+) {
+    return ReadDataset(
+        poolPath,
+        params.PairsFilePath,
+        params.GroupWeightsFilePath,
+        params.BaselineFilePath,
+        params.ColumnarPoolFormatParams,
+        ignoredFeatures,
+        objectsOrder,
+        TDatasetSubset::MakeColumns(),
+        /*classNames*/ Nothing(),
+        localExecutor
+    );
+}
+
+// data loaded from columnar pool must be the same as data loaded from the source dsv
+static void TestConvertedPool(const TSrcData& srcData) {
+    TReadDatasetMainParams params;
+    TVector<THolder<TTempFile>> srcDataFiles;
+    SaveSrcData(srcData, &params, &srcDataFiles);
+
+    NPar::TLocalExecutor localExecutor;
+    localExecutor.RunAdditionalThreads(3);
+
+    TTempFile columnarPoolFile(MakeTempName());
+    ConvertDsvToColumnarPool(params.PoolPath, params.ColumnarPoolFormatParams, columnarPoolFile.Name(), &localExecutor);
+
+    auto dsvData = ReadDatasetFromPath(
+        params.PoolPath, params, srcData.IgnoredFeatures, srcData.ObjectsOrder, &localExecutor
+    );
+    auto columnarData = ReadDatasetFromPath(
+        TPathWithScheme(columnarPoolFile.Name(), "columnar"),
+        params,
+        srcData.IgnoredFeatures,
+        srcData.ObjectsOrder,
+        &localExecutor
+    );
+    UNIT_ASSERT(*dsvData == *columnarData);
+}
+
+
+Y_UNIT_TEST_SUITE(LoadDataFromColumnar) {
+    Y_UNIT_TEST(AllColumnTypes) {
+        TSrcData srcData;
+        srcData.CdFileData = AsStringBuf(
+            "0\tTarget\n"
+            "1\tGroupId\n"
+            "2\tSubgroupId\n"
+            "3\tWeight\n"
+            "4\tNum\tf0\n"
+            "5\tCateg\tc0\n"
+            "6\tText\tt0\n"
+            "7\tAuxiliary\n"
+            "8\tTimestamp\n"
+            "9\tNum\tf1\n"
+        );
+        srcData.DatasetFileData = AsStringBuf(
+            "Target\tGroup\tSubgroup\tWeight\tF0\tC0\tT0\tAux\tTime\tF1\n"
+            "0.12\tquery0\tsite1\t0.12\t0.1\tMale\tthe cat\tx\t10\t0.2\n"
+            "0.22\tquery0\tsite22\t0.18\t0.97\tFemale\ta dog\ty\t11\tnan\n"
+            "0.34\tquery1\tSite9\t1.0\t0.13\tMale\t\tz\t12\t0.22\n"
+            "0.42\tQuery 2\tsite12\t0.45\t0.14\tMale\tthe cat\tx\t13\t0.18\n"
+            "0.01\tQuery 2\tsite22\t1.0\t0.9\tFemale\tbird\ty\t14\t0.67\n"
+        );
+        srcData.DsvFileHasHeader = true;
+        srcData.ObjectsOrder = EObjectsOrder::Ordered;
+
+        TestConvertedPool(srcData);
+
+        srcData.IgnoredFeatures = {0, 2};
+        TestConvertedPool(srcData);
+    }
+
+    Y_UNIT_TEST(StringLabelsAndBaseline) {
+        TSrcData srcData;
+        srcData.CdFileData = AsStringBuf(
+            "0\tTarget\n"
+            "1\tBaseline\n"
+            "2\tBaseline\n"
+        );
+        srcData.DatasetFileData = AsStringBuf(
+            "a\t0.1\t-0.1\t1\n"
+            "b\t0.2\t-0.2\t2\n"
+            "1.0\t0.3\t-0.3\t3\n"
+            "a\t0.4\t-0.4\t4\n"
+        );
+
+        TestConvertedPool(srcData);
+    }
+
+    Y_UNIT_TEST(CorruptedPool) {
+        TSrcData srcData;
+        srcData.CdFileData = AsStringBuf(
+            "0\tTarget\n"
+            "1\tCateg\n"
+        );
+        srcData.DatasetFileData = AsStringBuf(
+            "0.1\ta\n"
+            "0.2\tb\n"
+        );
+        TReadDatasetMainParams params;
+        TVector<THolder<TTempFile>> srcDataFiles;
+        SaveSrcData(srcData, &params, &srcDataFiles);
+
+        NPar::TLocalExecutor localExecutor;
+        TTempFile columnarPoolFile(MakeTempName());
+        ConvertDsvToColumnarPool(params.PoolPath, params.ColumnarPoolFormatParams, columnarPoolFile.Name(), &localExecutor);
+        const TString data = TUnbufferedFileInput(columnarPoolFile.Name()).ReadAll();
+        const auto header = ReadColumnarPoolHeader(data);
+        UNIT_ASSERT_EQUAL(header.ColumnInfos[1].Storage, EColumnarPoolStorage::Dictionary);
+
+        const auto readCorrupted = [&] (const TString& corruptedData) {
+            TTempFile corruptedFile(MakeTempName());
+            TFixedBufferFileOutput(corruptedFile.Name()).Write(corruptedData);
+            ReadDatasetFromPath(
+                TPathWithScheme(corruptedFile.Name(), "columnar"),
+                params,
+                /*ignoredFeatures*/ {},
+                EObjectsOrder::Undefined,
+                &localExecutor
+            );
+        };
+
+        // storage of the same size as Dictionary, but incompatible with Categ
+        auto mismatchedHeader = header;
+        mismatchedHeader.ColumnInfos[1].Storage = EColumnarPoolStorage::UI32;
+        TBuffer headerBuffer;
+        {
+            TBufferOutput headerOutput(headerBuffer);
+            ::Save(&headerOutput, mismatchedHeader);
+        }
+        const size_t prefixSize = sizeof(ColumnarPoolMagic) + 2 * sizeof(ui32) + sizeof(ui64);
+        TString mismatchedData = data;
+        mismatchedData.replace(prefixSize, headerBuffer.Size(), headerBuffer.Data(), headerBuffer.Size());
+        UNIT_ASSERT_EXCEPTION(ReadColumnarPoolHeader(mismatchedData), TCatBoostException);
+        UNIT_ASSERT_EXCEPTION(readCorrupted(mismatchedData), TCatBoostException);
+
+        const ui32 outOfRangeIndex = header.ColumnInfos[1].Dictionary.size();
+        TString outOfRangeData = data;
+        outOfRangeData.replace(header.ColumnInfos[1].Offset, sizeof(ui32), (const char*)&outOfRangeIndex, sizeof(ui32));
+        UNIT_ASSERT_EXCEPTION(readCorrupted(outOfRangeData), TCatBoostException);
+    }
+}
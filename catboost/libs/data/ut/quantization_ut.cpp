@@ -5,10 +5,15 @@
 #include <catboost/libs/data/ut/lib/for_data_provider.h>
 #include <catboost/libs/data/ut/lib/for_objects.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/xrange.h>
+#include <util/random/fast.h>
 
 #include <library/unittest/registar.h>
 
+#include <iterator>
+#include <limits>
+
 
 using namespace NCB;
 using namespace NCB::NDataNewUT;
@@ -1357,4 +1362,317 @@ Y_UNIT_TEST_SUITE(Quantization) {
 
         Test(std::move(generateTestCase));
    }
+
+    Y_UNIT_TEST(TestFloatFeaturesWithSketchBorders) {
+        const ui32 objectCount = 50000;
+        const double rankError = 0.005;
+
+        TFastRng64 rng(0);
+        TVector<TVector<float>> floatFeatures(1);
+        for (auto objectIdx : xrange(objectCount)) {
+            floatFeatures[0].push_back(
+                (objectIdx % 100 == 0) ? std::numeric_limits<float>::quiet_NaN() : float(rng.GenRandReal1() * 10)
+            );
+        }
+        TVector<float> sortedValues;
+        CopyIf(
+            floatFeatures[0].begin(),
+            floatFeatures[0].end(),
+            std::back_inserter(sortedValues),
+            [] (float value) { return !IsNan(value); }
+        );
+        Sort(sortedValues);
+        const auto getRank = [&] (float value) {
+            return double(UpperBound(sortedValues.begin(), sortedValues.end(), value) - sortedValues.begin())
+                / sortedValues.size();
+        };
+
+        TDataColumnsMetaInfo dataColumnsMetaInfo;
+        dataColumnsMetaInfo.Columns = {TColumn{EColumn::Label, ""}, TColumn{EColumn::Num, ""}};
+
+        TVector<TVector<float>> borders; // [exact/sketch]
+        for (double borderSketchRankError : {0.0, rankError}) {
+            TRawBuilderData srcData;
+            srcData.MetaInfo = TDataMetaInfo(TDataColumnsMetaInfo(dataColumnsMetaInfo), false, false);
+            srcData.TargetData.Target = {TVector<TString>(objectCount, "0")};
+            srcData.TargetData.SetTrivialWeights(objectCount);
+            srcData.CommonObjectsData.FeaturesLayout = srcData.MetaInfo.FeaturesLayout;
+            srcData.CommonObjectsData.SubsetIndexing = MakeAtomicShared<TArraySubsetIndexing<ui32>>(
+                TFullSubset<ui32>(objectCount)
+            );
+            ui32 featureIdx = 0;
+            InitFeatures(
+                floatFeatures,
+                *srcData.CommonObjectsData.SubsetIndexing,
+                &featureIdx,
+                &srcData.ObjectsData.FloatFeatures
+            );
+
+            auto quantizedFeaturesInfo = MakeIntrusive<TQuantizedFeaturesInfo>(
+                *srcData.MetaInfo.FeaturesLayout,
+                TConstArrayRef<ui32>(),
+                NCatboostOptions::TBinarizationOptions(EBorderSelectionType::GreedyLogSum, 16, ENanMode::Min)
+            );
+
+            TQuantizationOptions quantizationOptions{true, false};
+            quantizationOptions.MaxSubsetSizeForBuildBordersAlgorithms = objectCount;
+            quantizationOptions.BorderSketchRankError = borderSketchRankError;
+
+            TRestorableFastRng64 rand(0);
+            NPar::TLocalExecutor localExecutor;
+            localExecutor.RunAdditionalThreads(3);
+
+            Quantize(
+                quantizationOptions,
+                MakeDataProvider<TRawObjectsDataProvider>(Nothing(), std::move(srcData), false, &localExecutor),
+                quantizedFeaturesInfo,
+                &rand,
+                &localExecutor
+            );
+            UNIT_ASSERT_EQUAL(quantizedFeaturesInfo->GetNanMode(TFloatFeatureIdx(0)), ENanMode::Min);
+            borders.push_back(quantizedFeaturesInfo->GetBorders(TFloatFeatureIdx(0)));
+        }
+
+        const auto& exactBorders = borders[0];
+        const auto& sketchBorders = borders[1];
+        UNIT_ASSERT_VALUES_EQUAL(sketchBorders.size(), exactBorders.size());
+        UNIT_ASSERT_VALUES_EQUAL(sketchBorders[0], std::numeric_limits<float>::lowest());
+        for (auto i : xrange<size_t>(1, exactBorders.size())) {
+            UNIT_ASSERT_DOUBLES_EQUAL(getRank(sketchBorders[i]), getRank(exactBorders[i]), 2 * rankError);
+        }
+    }
+
+    TVector<TExclusiveFeaturesBundle> CreateBundles(
+        const TVector<TVector<float>>& floatFeatures,
+        const TExclusiveFeaturesBundlingOptions& bundlingOptions,
+        int additionalThreadCount = 3
+    ) {
+        const ui32 featureCount = floatFeatures.size();
+        const ui32 objectCount = floatFeatures[0].size();
+
+        TDataColumnsMetaInfo dataColumnsMetaInfo;
+        dataColumnsMetaInfo.Columns.push_back(TColumn{EColumn::Label, ""});
+        dataColumnsMetaInfo.Columns.insert(
+            dataColumnsMetaInfo.Columns.end(),
+            featureCount,
+            TColumn{EColumn::Num, ""}
+        );
+
+        NCatboostOptions::TBinarizationOptions binarizationOptions(
+            EBorderSelectionType::GreedyLogSum,
+            4,
+            ENanMode::Min
+        );
+
+        TRawBuilderData srcData;
+        srcData.MetaInfo = TDataMetaInfo(std::move(dataColumnsMetaInfo), false, false);
+        srcData.TargetData.Target = {TVector<TString>(objectCount, "0")};
+        srcData.TargetData.SetTrivialWeights(objectCount);
+
+        srcData.CommonObjectsData.FeaturesLayout = srcData.MetaInfo.FeaturesLayout;
+        srcData.CommonObjectsData.SubsetIndexing = MakeAtomicShared<TArraySubsetIndexing<ui32>>(
+            TFullSubset<ui32>(objectCount)
+        );
+
+        ui32 featureIdx = 0;
+        InitFeatures(
+            floatFeatures,
+            *srcData.CommonObjectsData.SubsetIndexing,
+            &featureIdx,
+            &srcData.ObjectsData.FloatFeatures
+        );
+
+        auto quantizedFeaturesInfo = MakeIntrusive<TQuantizedFeaturesInfo>(
+            *srcData.MetaInfo.FeaturesLayout,
+            TConstArrayRef<ui32>(),
+            binarizationOptions
+        );
+
+        TQuantizationOptions quantizationOptions{true, false};
+        quantizationOptions.PackBinaryFeaturesForCpu = false;
+        quantizationOptions.ExclusiveFeaturesBundlingOptions = bundlingOptions;
+
+        TRestorableFastRng64 rand(0);
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(additionalThreadCount);
+
+        TRawDataProviderPtr rawDataProvider = MakeDataProvider<TRawObjectsDataProvider>(
+            Nothing(),
+            std::move(srcData),
+            false,
+            &localExecutor
+        );
+
+        TQuantizedDataProviderPtr quantizedDataProvider = Quantize(
+            quantizationOptions,
+            std::move(rawDataProvider),
+            quantizedFeaturesInfo,
+            &rand,
+            &localExecutor
+        );
+
+        const auto& objectsData
+            = dynamic_cast<const TQuantizedForCPUObjectsDataProvider&>(*quantizedDataProvider->ObjectsData);
+        const auto bundles = objectsData.GetExclusiveFeatureBundlesMetaData();
+        return TVector<TExclusiveFeaturesBundle>(bundles.begin(), bundles.end());
+    }
+
+    // counted as in bundling: an object with non-default values in k bundle parts adds k - 1 conflicts
+    ui32 CalcConflictCount(const TVector<TVector<float>>& floatFeatures, const TExclusiveFeaturesBundle& bundle) {
+        ui32 conflictCount = 0;
+        for (auto objectIdx : xrange(floatFeatures[0].size())) {
+            ui32 nonDefaultCount = 0;
+            for (const auto& part : bundle.Parts) {
+                nonDefaultCount += floatFeatures[part.FeatureIdx][objectIdx] != 0.0f;
+            }
+            conflictCount += nonDefaultCount ? (nonDefaultCount - 1) : 0;
+        }
+        return conflictCount;
+    }
+
+    // each object has non-default value in feature (objectIdx % featureCount)
+    TVector<TVector<float>> GenerateExclusiveFeatures(ui32 objectCount, ui32 featureCount) {
+        TVector<TVector<float>> floatFeatures(featureCount, TVector<float>(objectCount, 0.0f));
+        for (auto objectIdx : xrange(objectCount)) {
+            floatFeatures[objectIdx % featureCount][objectIdx] = float(1 + (objectIdx / featureCount) % 2);
+        }
+        return floatFeatures;
+    }
+
+    Y_UNIT_TEST(TestBundleMutuallyExclusiveFeatures) {
+        const ui32 featureCount = 48;
+        const auto floatFeatures = GenerateExclusiveFeatures(1000, featureCount);
+
+        // exact and sampled bundling
+        for (auto maxSampledObjectCount : {0, 256}) {
+            TExclusiveFeaturesBundlingOptions bundlingOptions;
+            bundlingOptions.MaxSampledObjectCount = maxSampledObjectCount;
+            const auto bundles = CreateBundles(floatFeatures, bundlingOptions);
+
+            UNIT_ASSERT_VALUES_EQUAL(bundles.size(), 1);
+            UNIT_ASSERT_VALUES_EQUAL(bundles[0].Parts.size(), featureCount);
+        }
+    }
+
+    Y_UNIT_TEST(TestBundleFeaturesWithConflicts) {
+        const ui32 objectCount = 6400;
+        const ui32 featureCount = 8;
+
+        // each 50th object also has non-default value in the next feature, 2% of objects conflict in total
+        auto floatFeatures = GenerateExclusiveFeatures(objectCount, featureCount);
+        for (ui32 objectIdx = 1; objectIdx < objectCount; objectIdx += 50) {
+            floatFeatures[(objectIdx + 1) % featureCount][objectIdx] = 1.0f;
+        }
+
+        // exact and sampled bundling, the sample has 32 of 100 blocks, each of them has 1 or 2 conflicts
+        for (auto maxSampledObjectCount : {0, 2048}) {
+            {
+                TExclusiveFeaturesBundlingOptions bundlingOptions;
+                bundlingOptions.MaxConflictFraction = 0.05f;
+                bundlingOptions.MaxSampledObjectCount = maxSampledObjectCount;
+                const auto bundles = CreateBundles(floatFeatures, bundlingOptions);
+
+                UNIT_ASSERT_VALUES_EQUAL(bundles.size(), 1);
+                UNIT_ASSERT_VALUES_EQUAL(bundles[0].Parts.size(), featureCount);
+                UNIT_ASSERT_VALUES_EQUAL(CalcConflictCount(floatFeatures, bundles[0]), objectCount / 50);
+            }
+            {
+                TExclusiveFeaturesBundlingOptions bundlingOptions;
+                bundlingOptions.MaxConflictFraction = 0.01f;
+                bundlingOptions.MaxSampledObjectCount = maxSampledObjectCount;
+                const auto bundles = CreateBundles(floatFeatures, bundlingOptions);
+
+                // the sampled estimate of conflicts is within 2 times of the real conflict count
+                const ui32 maxConflictCount = (maxSampledObjectCount ? 2 : 1) * objectCount / 100;
+                for (const auto& bundle : bundles) {
+                    UNIT_ASSERT_LT(bundle.Parts.size(), featureCount);
+                    UNIT_ASSERT_LE(CalcConflictCount(floatFeatures, bundle), maxConflictCount);
+                }
+            }
+        }
+    }
+
+    Y_UNIT_TEST(TestBundleFeaturesWithConflictsMissedBySample) {
+        const ui32 objectCount = 6400;
+        const ui32 featureCount = 8;
+
+        // single conflicts between features k and k + 1 in 7 different blocks
+        auto floatFeatures = GenerateExclusiveFeatures(objectCount, featureCount);
+        for (auto k : xrange(featureCount - 1)) {
+            const ui32 objectIdx = 64 * (10 + 13 * k) + k;
+            UNIT_ASSERT_VALUES_UNEQUAL(floatFeatures[k][objectIdx], 0.0f);
+            floatFeatures[k + 1][objectIdx] = 1.0f;
+        }
+
+        // the sample has only 10 of 100 blocks, conflicts are allowed neither on it nor on all objects
+        for (auto maxSampledObjectCount : {0, 640}) {
+            TExclusiveFeaturesBundlingOptions bundlingOptions;
+            bundlingOptions.MaxSampledObjectCount = maxSampledObjectCount;
+            const auto bundles = CreateBundles(floatFeatures, bundlingOptions);
+
+            UNIT_ASSERT(!bundles.empty());
+            for (const auto& bundle : bundles) {
+                UNIT_ASSERT_VALUES_EQUAL(CalcConflictCount(floatFeatures, bundle), 0);
+            }
+        }
+    }
+
+    Y_UNIT_TEST(TestBundleRecheckInBatch) {
+        const ui32 bigFeatureCount = 64;
+        const ui32 bigFeatureSize = 64;
+        const ui32 featurePairCount = 8;
+        const ui32 featurePairSize = 32;
+        const ui32 objectCount = bigFeatureCount * bigFeatureSize + featurePairCount * featurePairSize;
+
+        /* big features are mutually exclusive and fill the first batch (64 features without additional threads),
+         * so they form a single bundle. Features in each pair have the same objects, both of them fit
+         * into this bundle in the parallel search, only the first one fits after the bundle is modified.
+         */
+        TVector<TVector<float>> floatFeatures(
+            bigFeatureCount + 2 * featurePairCount,
+            TVector<float>(objectCount, 0.0f)
+        );
+        for (auto objectIdx : xrange(bigFeatureCount * bigFeatureSize)) {
+            floatFeatures[objectIdx / bigFeatureSize][objectIdx] = float(1 + objectIdx % 2);
+        }
+        for (auto pairIdx : xrange(featurePairCount)) {
+            const ui32 objectsBegin = bigFeatureCount * bigFeatureSize + pairIdx * featurePairSize;
+            for (auto objectIdx : xrange(objectsBegin, objectsBegin + featurePairSize)) {
+                floatFeatures[bigFeatureCount + 2 * pairIdx][objectIdx] = float(1 + objectIdx % 2);
+                floatFeatures[bigFeatureCount + 2 * pairIdx + 1][objectIdx] = float(1 + objectIdx % 2);
+            }
+        }
+
+        TExclusiveFeaturesBundlingOptions bundlingOptions;
+        bundlingOptions.MaxSampledObjectCount = objectCount; // scalable bundling without sampling
+        const auto bundles = CreateBundles(floatFeatures, bundlingOptions, /*additionalThreadCount*/ 0);
+
+        UNIT_ASSERT_VALUES_EQUAL(bundles.size(), 2);
+        size_t bundledFeatureCount = 0;
+        for (const auto& bundle : bundles) {
+            UNIT_ASSERT_VALUES_EQUAL(CalcConflictCount(floatFeatures, bundle), 0);
+            bundledFeatureCount += bundle.Parts.size();
+        }
+        UNIT_ASSERT_VALUES_EQUAL(bundledFeatureCount, bigFeatureCount + 2 * featurePairCount);
+
+        const auto bigFeaturesBundle = FindIf(
+            bundles,
+            [] (const auto& bundle) {
+                return AnyOf(bundle.Parts, [] (const auto& part) { return part.FeatureIdx == 0; });
+            }
+        );
+        UNIT_ASSERT(bigFeaturesBundle != bundles.end());
+        UNIT_ASSERT_VALUES_EQUAL(bigFeaturesBundle->Parts.size(), bigFeatureCount + featurePairCount);
+    }
+
+    Y_UNIT_TEST(TestBundleTimeBudgetExpiry) {
+        const auto floatFeatures = GenerateExclusiveFeatures(1000, 48);
+
+        TExclusiveFeaturesBundlingOptions bundlingOptions;
+        bundlingOptions.MaxSampledObjectCount = 256;
+        bundlingOptions.TimeBudget = TDuration::Zero();
+
+        // all features are left unbundled
+        UNIT_ASSERT(CreateBundles(floatFeatures, bundlingOptions).empty());
+    }
 }
@@ -101,6 +101,12 @@ namespace NCB {
         // for sparse float features default value is always assumed to be 0.0f
 
         virtual ui32 GetCatFeatureValue(ui32 flatFeatureIdx, TStringBuf feature) = 0;
+        // values[i] = GetCatFeatureValue(flatFeatureIndices[i], features[i]), hashes are calculated in a batch
+        virtual void GetCatFeatureValues(
+            TConstArrayRef<ui32> flatFeatureIndices,
+            TConstArrayRef<TStringBuf> features,
+            TArrayRef<ui32> values
+        ) = 0;
         virtual void AddCatFeature(ui32 localObjectIdx, ui32 flatFeatureIdx, TStringBuf feature) = 0;
         virtual void AddAllCatFeatures(ui32 localObjectIdx, TConstArrayRef<ui32> features) = 0;
         virtual void AddAllCatFeatures(
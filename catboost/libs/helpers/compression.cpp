@@ -1 +1,27 @@
 #include "compression.h"
+
+
+TCompressedArray CompressToNibbles(TConstArrayRef<ui8> src, NPar::TLocalExecutor* localExecutor) {
+    auto dst = TCompressedArray::CreateWithUninitializedData(src.size(), /*bitsPerKey*/ 4);
+
+    // whole ui64 words are filled to keep unused tail bits zero
+    const size_t dstByteCount = CeilDiv<size_t>(src.size(), 16) * sizeof(ui64);
+    ui8* dstBytes = reinterpret_cast<ui8*>(dst.GetRawPtr());
+
+    NPar::TLocalExecutor::TExecRangeParams params(0, SafeIntegerCast<int>(dstByteCount));
+    params.SetBlockSize(1 << 16);
+
+    localExecutor->ExecRange(
+        [&] (int byteIdx) {
+            const size_t lowIdx = 2 * size_t(byteIdx);
+            const ui8 low = (lowIdx < src.size()) ? src[lowIdx] : 0;
+            const ui8 high = (lowIdx + 1 < src.size()) ? src[lowIdx + 1] : 0;
+            Y_ASSERT((low < 16) && (high < 16));
+            dstBytes[byteIdx] = low | (high << 4);
+        },
+        params,
+        NPar::TLocalExecutor::WAIT_COMPLETE
+    );
+
+    return dst;
+}
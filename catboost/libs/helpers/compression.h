@@ -258,6 +258,36 @@ NCB::IDynamicBlockWithExactIteratorPtr<T> TCompressedArray::GetBlockIterator(ui6
 }
 
 
+/* Random access to TCompressedArray data with 4 bits per key.
+ * Keys are packed two per byte, the key with even index is in the low half of the byte.
+ */
+class TConstNibbleArrayPtr {
+public:
+    explicit TConstNibbleArrayPtr(const ui8* data)
+        : Data(data)
+    {
+#if defined(_big_endian_)
+        static_assert(false, "TCompressedArray's data with 4 bits per key has different layout on big-endian architecture");
+#endif
+    }
+
+    Y_FORCE_INLINE ui8 operator[](size_t index) const {
+        return (Data[index >> 1] >> ((index & 1) << 2)) & 0xF;
+    }
+
+    // contains keys with indices (2 * byteIdx, 2 * byteIdx + 1)
+    Y_FORCE_INLINE ui8 GetByte(size_t byteIdx) const {
+        return Data[byteIdx];
+    }
+
+private:
+    const ui8* Data;
+};
+
+// all src values must be less than 16
+TCompressedArray CompressToNibbles(TConstArrayRef<ui8> src, NPar::TLocalExecutor* localExecutor);
+
+
 template <class TStorageType, class T>
 inline TVector<TStorageType> CompressVector(const T* data, ui32 size, ui32 bitsPerKey) {
     CB_ENSURE(bitsPerKey <= 32);
@@ -4,13 +4,17 @@
 
 #include <catboost/libs/logging/logging.h>
 
+#include <util/stream/buffer.h>
 #include <util/stream/output.h>
 #include <util/stream/file.h>
 #include <util/folder/path.h>
+#include <util/generic/buffer.h>
 #include <util/generic/guid.h>
 #include <util/system/fs.h>
 #include <util/ysaveload.h>
 
+#include <library/blockcodecs/codecs.h>
+#include <library/blockcodecs/stream.h>
 #include <library/digest/md5/md5.h>
 
 class TMD5Output : public IOutputStream {
@@ -53,12 +57,67 @@ public:
 
     template <class TWriter>
     void Write(const TFsPath& path, TWriter&& writer) {
+        WriteWithLabel(path, Label, writer);
+    }
+
+    // data written by writer is compressed with codecName block codec, CheckedLoad decompresses it
+    template <class TWriter>
+    void WriteCompressed(const TFsPath& path, TStringBuf codecName, TWriter&& writer) {
+        const NBlockCodecs::ICodec* codec = NBlockCodecs::Codec(codecName);
+        WriteWithLabel(
+            path,
+            Label + CompressedLabelSuffix,
+            [&](IOutputStream* out) {
+                NBlockCodecs::TCodedOutput codedOut(out, codec, CompressionBlockSize);
+                writer(&codedOut);
+                codedOut.Finish();
+            }
+        );
+    }
+
+    // data written by writer is compressed with codecName block codec to memory,
+    // the result is saved by WriteCompressed(path, compressed)
+    template <class TWriter>
+    static void Compress(TStringBuf codecName, TBuffer* compressed, TWriter&& writer) {
+        TBufferOutput out(*compressed);
+        NBlockCodecs::TCodedOutput codedOut(&out, NBlockCodecs::Codec(codecName), CompressionBlockSize);
+        writer(&codedOut);
+        codedOut.Finish();
+    }
+
+    void WriteCompressed(const TFsPath& path, const TBuffer& compressed) {
+        WriteWithLabel(
+            path,
+            Label + CompressedLabelSuffix,
+            [&](IOutputStream* out) {
+                out->Write(compressed.Data(), compressed.Size());
+            }
+        );
+    }
+
+    template <class TReader>
+    void CheckedLoad(const TFsPath& path, TReader&& reader) {
+        TString label;
+        TIFStream input(path);
+        ::Load(&input, label);
+        if (label == Label + CompressedLabelSuffix) {
+            NBlockCodecs::TDecodedInput decodedInput(&input);
+            reader(&decodedInput);
+            return;
+        }
+        CB_ENSURE(Label == label, "Error: expect " << Label << " progress. Got " << label);
+        reader(&input);
+    }
+
+private:
+    template <class TWriter>
+    void WriteWithLabel(const TFsPath& path, const TString& label, TWriter&& writer) {
         TString tempName = JoinFsPaths(path.Dirname(), CreateGuidAsString()) + ".tmp";
         try {
             {
                 TOFStream out(tempName);
                 TMD5Output md5out(&out);
-                ::Save(&md5out, Label);
+                ::Save(&md5out, label);
                 writer(&md5out);
                 char md5buf[33];
                 if (CalcMd5) {
@@ -72,16 +131,11 @@ public:
         }
     }
 
-    template <class TReader>
-    void CheckedLoad(const TFsPath& path, TReader&& reader) {
-        TString label;
-        TIFStream input(path);
-        ::Load(&input, label);
-        CB_ENSURE(Label == label, "Error: expect " << Label << " progress. Got " << label);
-        reader(&input);
-    }
-
 private:
+    static constexpr const char* CompressedLabelSuffix = ":blockcodecs";
+    static constexpr size_t CompressionBlockSize = 1 << 20;
+
+
     TString Label;
     TString ExceptionMessage;
     TString SavedMessage;
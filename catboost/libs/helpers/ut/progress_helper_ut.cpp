@@ -0,0 +1,65 @@
+#include <catboost/libs/helpers/progress_helper.h>
+
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+
+#include <library/unittest/registar.h>
+
+enum class EWriteMode {
+    Plain,
+    Compressed,
+    CompressedInMemory
+};
+
+static void CheckWriteAndLoad(EWriteMode mode) {
+    const TString snapshotPath = "snapshot.bin";
+    TVector<ui32> data(100000);
+    for (auto i : xrange(data.size())) {
+        data[i] = i % 17;
+    }
+    auto writer = [&](IOutputStream* out) {
+        ::Save(out, data);
+    };
+    TProgressHelper progressHelper("CPU");
+    switch (mode) {
+        case EWriteMode::Plain:
+            progressHelper.Write(snapshotPath, writer);
+            break;
+        case EWriteMode::Compressed:
+            progressHelper.WriteCompressed(snapshotPath, "lz4", writer);
+            break;
+        case EWriteMode::CompressedInMemory: {
+            TBuffer compressed;
+            TProgressHelper::Compress("lz4", &compressed, writer);
+            UNIT_ASSERT(compressed.Size() < data.size() * sizeof(ui32));
+            progressHelper.WriteCompressed(snapshotPath, compressed);
+            break;
+        }
+    }
+    TVector<ui32> loaded;
+    progressHelper.CheckedLoad(snapshotPath, [&](IInputStream* in) {
+        ::Load(in, loaded);
+    });
+    UNIT_ASSERT_VALUES_EQUAL(loaded, data);
+}
+
+Y_UNIT_TEST_SUITE(TProgressHelperTest) {
+    Y_UNIT_TEST(TestWriteAndLoad) {
+        CheckWriteAndLoad(EWriteMode::Plain);
+    }
+
+    Y_UNIT_TEST(TestWriteCompressedAndLoad) {
+        CheckWriteAndLoad(EWriteMode::Compressed);
+    }
+
+    Y_UNIT_TEST(TestCompressInMemoryAndLoad) {
+        CheckWriteAndLoad(EWriteMode::CompressedInMemory);
+    }
+
+    Y_UNIT_TEST(TestLabelMismatch) {
+        TProgressHelper("GPU").Write("snapshot.bin", [](IOutputStream* out) { ::Save(out, 0); });
+        UNIT_ASSERT_EXCEPTION(
+            TProgressHelper("CPU").CheckedLoad("snapshot.bin", [](IInputStream*) {}),
+            TCatBoostException);
+    }
+}
@@ -0,0 +1,96 @@
+#include <catboost/libs/model/model.h>
+#include <catboost/libs/model/ut/lib/model_test_helpers.h>
+#include <catboost/private/libs/text_features/ut/lib/text_features_data.h>
+
+#include <library/testing/benchmark/bench.h>
+
+#include <util/generic/singleton.h>
+#include <util/generic/xrange.h>
+
+using namespace NCB;
+
+const ui32 DocCount = 100000;
+
+namespace {
+    // model with a tree for each BoW, NaiveBayes and BM25 feature of the test text data
+    struct TTextModel {
+        TFullModel Model;
+        TVector<TString> Texts; // [textFeatureId * DocCount + docId]
+        TVector<TVector<TStringBuf>> Docs;
+
+        TTextModel() {
+            TVector<NCBTest::TTextFeature> features;
+            TVector<NCBTest::TTokenizedTextFeature> tokenizedFeatures;
+            TVector<TTextFeatureCalcerPtr> calcers;
+            TVector<TDictionaryPtr> dictionaries;
+            TTokenizerPtr tokenizer;
+            TVector<TVector<ui32>> perFeatureDictionaries;
+            TVector<TVector<ui32>> perTokenizedFeatureCalcers;
+
+            NCBTest::CreateTextDataForTest(
+                &features,
+                &tokenizedFeatures,
+                &calcers,
+                &dictionaries,
+                &tokenizer,
+                &perFeatureDictionaries,
+                &perTokenizedFeatureCalcers
+            );
+
+            auto textProcessingCollection = MakeIntrusive<TTextProcessingCollection>(
+                calcers,
+                dictionaries,
+                perFeatureDictionaries,
+                perTokenizedFeatureCalcers,
+                tokenizer
+            );
+
+            const ui32 textFeatureCount = features.size();
+            const ui32 sourceDocCount = features[0].size();
+            TVector<TVector<TStringBuf>> textFeatures;
+            for (const auto& feature : features) {
+                textFeatures.emplace_back(feature.begin(), feature.end());
+            }
+            TVector<double> expectedResults(
+                textProcessingCollection->TotalNumberOfOutputFeatures() * sourceDocCount
+            );
+            Model = SimpleTextModel(textProcessingCollection, textFeatures, expectedResults);
+
+            // source texts are repeated to get a large dataset
+            Texts.reserve(textFeatureCount * DocCount);
+            for (auto textFeatureId : xrange(textFeatureCount)) {
+                for (auto docId : xrange(DocCount)) {
+                    Texts.push_back(features[textFeatureId][docId % sourceDocCount]);
+                }
+            }
+            Docs.resize(DocCount);
+            for (auto docId : xrange(DocCount)) {
+                for (auto textFeatureId : xrange(textFeatureCount)) {
+                    Docs[docId].push_back(Texts[textFeatureId * DocCount + docId]);
+                }
+            }
+        }
+    };
+}
+
+Y_CPU_BENCHMARK(CalcTextModel, iface) {
+    const auto& textModel = *Singleton<TTextModel>();
+    TVector<double> results(DocCount);
+    for (auto i : xrange(iface.Iterations())) {
+        Y_UNUSED(i);
+        textModel.Model.Calc({}, {}, textModel.Docs, results);
+        Y_DO_NOT_OPTIMIZE_AWAY(results);
+    }
+}
+
+Y_CPU_BENCHMARK(CalcTextModelSingleDocs, iface) {
+    const auto& textModel = *Singleton<TTextModel>();
+    TVector<double> result(1);
+    for (auto i : xrange(iface.Iterations())) {
+        Y_UNUSED(i);
+        for (auto docId : xrange(1000)) {
+            textModel.Model.Calc({}, {}, TConstArrayRef<TVector<TStringBuf>>(&textModel.Docs[docId], 1), result);
+            Y_DO_NOT_OPTIMIZE_AWAY(result);
+        }
+    }
+}
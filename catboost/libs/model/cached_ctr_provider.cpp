@@ -0,0 +1,125 @@
+#include "cached_ctr_provider.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/xrange.h>
+
+
+TCachedCtrProvider::TCachedCtrProvider(
+    TIntrusivePtr<ICtrProvider> ctrProvider,
+    const TModelTrees& trees,
+    TIntrusivePtr<TCtrValueCache> cache
+)
+    : CtrProvider(std::move(ctrProvider))
+    , Cache(std::move(cache))
+{
+    // used categorical features are packed in hashedCatFeatures in the same order as in BinarizeFeatures
+    THashMap<int, ui32> catFeatureIndexToUsedIdx;
+    for (const auto& catFeature : trees.GetCatFeatures()) {
+        if (catFeature.UsedInModel()) {
+            catFeatureIndexToUsedIdx[catFeature.Position.Index] = UsedCatFeatureCount++;
+        }
+    }
+
+    const auto& usedModelCtrs = trees.GetUsedModelCtrs();
+    NeededCtrCount = usedModelCtrs.size();
+    THashMap<ui32, size_t> usedCatFeatureIdxToGroup;
+    for (auto ctrIdx : xrange(usedModelCtrs.size())) {
+        const auto& ctr = usedModelCtrs[ctrIdx];
+        if (!ctr.Base.Projection.IsSingleCatFeature()) {
+            OtherCtrs.push_back(ctr);
+            OtherCtrNeededIndexes.push_back(ctrIdx);
+            continue;
+        }
+        const ui32 usedCatFeatureIdx = catFeatureIndexToUsedIdx.at(ctr.Base.Projection.CatFeatures[0]);
+        auto [it, inserted] = usedCatFeatureIdxToGroup.emplace(usedCatFeatureIdx, SingleFeatureCtrs.size());
+        if (inserted) {
+            SingleFeatureCtrs.emplace_back();
+            SingleFeatureCtrs.back().UsedCatFeatureIdx = usedCatFeatureIdx;
+        }
+        auto& group = SingleFeatureCtrs[it->second];
+        // used model ctrs are sorted, so group ctrs stay sorted as the wrapped provider expects
+        group.Ctrs.push_back(ctr);
+        group.NeededCtrIndexes.push_back(ctrIdx);
+    }
+}
+
+void TCachedCtrProvider::CalcCtrs(
+    const TVector<TModelCtr>& neededCtrs,
+    const TConstArrayRef<ui8>& binarizedFeatures,
+    const TConstArrayRef<ui32>& hashedCatFeatures,
+    size_t docCount,
+    TArrayRef<float> result,
+    TCtrProviderBuffers* buffers
+) {
+    CB_ENSURE_INTERNAL(
+        neededCtrs.size() == NeededCtrCount,
+        "Cached CTR provider supports only model used CTRs, got " << neededCtrs.size() << " CTRs");
+
+    TCtrProviderBuffers localBuffers;
+    if (!buffers) {
+        buffers = &localBuffers;
+    }
+    if (!OtherCtrs.empty()) {
+        auto& otherCtrValues = buffers->OtherCtrValues;
+        otherCtrValues.yresize(OtherCtrs.size() * docCount);
+        CtrProvider->CalcCtrs(OtherCtrs, binarizedFeatures, hashedCatFeatures, docCount, otherCtrValues, buffers);
+        for (auto i : xrange(OtherCtrs.size())) {
+            Copy(
+                otherCtrValues.begin() + i * docCount,
+                otherCtrValues.begin() + (i + 1) * docCount,
+                result.begin() + OtherCtrNeededIndexes[i] * docCount);
+        }
+    }
+    for (const auto& singleFeatureCtrs : SingleFeatureCtrs) {
+        CalcSingleFeatureCtrs(singleFeatureCtrs, hashedCatFeatures, docCount, result, buffers);
+    }
+}
+
+void TCachedCtrProvider::CalcSingleFeatureCtrs(
+    const TSingleFeatureCtrs& singleFeatureCtrs,
+    const TConstArrayRef<ui32>& hashedCatFeatures,
+    size_t docCount,
+    TArrayRef<float> result,
+    TCtrProviderBuffers* buffers
+) {
+    const size_t ctrCount = singleFeatureCtrs.Ctrs.size();
+    const ui32 usedCatFeatureIdx = singleFeatureCtrs.UsedCatFeatureIdx;
+    const auto featureHashes = hashedCatFeatures.Slice(usedCatFeatureIdx * docCount, docCount);
+
+    auto& docValues = buffers->CachedCtrValues;
+    docValues.yresize(ctrCount);
+    auto& missedDocs = buffers->MissedDocs;
+    missedDocs.clear();
+    for (auto docIdx : xrange(docCount)) {
+        if (Cache->Find(usedCatFeatureIdx, featureHashes[docIdx], docValues)) {
+            for (auto i : xrange(ctrCount)) {
+                result[singleFeatureCtrs.NeededCtrIndexes[i] * docCount + docIdx] = docValues[i];
+            }
+        } else {
+            missedDocs.push_back(docIdx);
+        }
+    }
+    if (missedDocs.empty()) {
+        return;
+    }
+
+    // binarized features are not used by single categorical feature projections
+    const size_t missedDocCount = missedDocs.size();
+    auto& missedHashes = buffers->MissedHashes;
+    missedHashes.assign(UsedCatFeatureCount * missedDocCount, 0);
+    for (auto i : xrange(missedDocCount)) {
+        missedHashes[usedCatFeatureIdx * missedDocCount + i] = featureHashes[missedDocs[i]];
+    }
+    auto& missedValues = buffers->MissedValues;
+    missedValues.yresize(ctrCount * missedDocCount);
+    CtrProvider->CalcCtrs(singleFeatureCtrs.Ctrs, {}, missedHashes, missedDocCount, missedValues, buffers);
+
+    for (auto i : xrange(missedDocCount)) {
+        for (auto ctrIdx : xrange(ctrCount)) {
+            docValues[ctrIdx] = missedValues[ctrIdx * missedDocCount + i];
+            result[singleFeatureCtrs.NeededCtrIndexes[ctrIdx] * docCount + missedDocs[i]] = docValues[ctrIdx];
+        }
+        Cache->Insert(usedCatFeatureIdx, featureHashes[missedDocs[i]], docValues);
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "ctr_provider.h"
+#include "ctr_value_cache.h"
+#include "model.h"
+
+#include <util/generic/ptr.h>
+#include <util/generic/vector.h>
+
+
+/**
+ * Evaluation-only wrapper over model CTR provider that takes CTRs depending on a single categorical feature
+ *  from TCtrValueCache and calculates only the missing values and the other CTRs with the wrapped provider.
+ * Needed CTRs passed to CalcCtrs should be the model's used CTRs.
+ */
+class TCachedCtrProvider final : public ICtrProvider {
+public:
+    TCachedCtrProvider(
+        TIntrusivePtr<ICtrProvider> ctrProvider,
+        const TModelTrees& trees,
+        TIntrusivePtr<TCtrValueCache> cache);
+
+    bool HasNeededCtrs(const TVector<TModelCtr>& neededCtrs) const override {
+        return CtrProvider->HasNeededCtrs(neededCtrs);
+    }
+
+    void CalcCtrs(
+        const TVector<TModelCtr>& neededCtrs,
+        const TConstArrayRef<ui8>& binarizedFeatures,
+        const TConstArrayRef<ui32>& hashedCatFeatures,
+        size_t docCount,
+        TArrayRef<float> result,
+        TCtrProviderBuffers* buffers = nullptr) override;
+
+    void SetupBinFeatureIndexes(
+        const TConstArrayRef<TFloatFeature>,
+        const TConstArrayRef<TOneHotFeature>,
+        const TConstArrayRef<TCatFeature>) override {
+        Y_FAIL("Cached CTR provider can't be modified");
+    }
+
+    void AddCtrCalcerData(TCtrValueTable&&) override {
+        Y_FAIL("Cached CTR provider can't be modified");
+    }
+
+    void DropUnusedTables(TConstArrayRef<TModelCtrBase>) override {
+        Y_FAIL("Cached CTR provider can't be modified");
+    }
+
+    TString ModelPartIdentifier() const override {
+        return CtrProvider->ModelPartIdentifier();
+    }
+
+private:
+    // CTRs with projection consisting of one categorical feature
+    struct TSingleFeatureCtrs {
+        ui32 UsedCatFeatureIdx = 0;
+        TVector<TModelCtr> Ctrs;
+        TVector<size_t> NeededCtrIndexes;
+    };
+
+private:
+    void CalcSingleFeatureCtrs(
+        const TSingleFeatureCtrs& singleFeatureCtrs,
+        const TConstArrayRef<ui32>& hashedCatFeatures,
+        size_t docCount,
+        TArrayRef<float> result,
+        TCtrProviderBuffers* buffers);
+
+private:
+    TIntrusivePtr<ICtrProvider> CtrProvider;
+    TIntrusivePtr<TCtrValueCache> Cache;
+    size_t UsedCatFeatureCount = 0;
+    size_t NeededCtrCount = 0;
+    TVector<TSingleFeatureCtrs> SingleFeatureCtrs;
+    TVector<TModelCtr> OtherCtrs;
+    TVector<size_t> OtherCtrNeededIndexes;
+};
@@ -34,6 +34,24 @@ namespace NCB::NModelEvaluation {
         size_t docCountInBlock,
         bool calcIndexesOnly = false);
 
+    /**
+     * Scratch buffers of ProcessDocsInBlocks. Evaluators that keep them between calls avoid allocations per call,
+     *  such evaluators can't be used from several threads at once.
+     * Single document predictions use per-thread instances of these buffers.
+     */
+    struct TCPUEvaluatorBuffers {
+        TVector<ui8> QuantizedData;
+        TVector<ui32> TransposedHash;
+        TVector<float> Ctrs;
+        TVector<float> EstimatedFeatures;
+        TVector<TCalcerIndexType> Indexes;
+        TVector<TStringBuf> CatFeatureValues;
+        TVector<ui32> CatFeatureHashes;
+        NCB::TTextProcessingBuffers TextProcessing;
+        TCtrProviderBuffers CtrProvider;
+        TVector<double> IntermediateBlockResults;
+    };
+
     template <class X>
     inline X* GetAligned(X* val) {
         uintptr_t off = ((uintptr_t)val) & 0xf;
@@ -92,12 +110,17 @@ namespace NCB::NModelEvaluation {
         size_t docCount,
         size_t blockSize,
         TFunctor callback,
-        const NCB::NModelEvaluation::TFeatureLayout* featureInfo
+        const NCB::NModelEvaluation::TFeatureLayout* featureInfo,
+        TCPUEvaluatorBuffers* buffers = nullptr
     ) {
         const size_t binSlots = blockSize * trees.GetEffectiveBinaryFeaturesBucketsCount();
 
+        TCPUEvaluatorBuffers localBuffers;
         TCPUEvaluatorQuantizedData quantizedData;
-        if (binSlots < 65536) { // 65KB of stack maximum
+        if (buffers) {
+            buffers->QuantizedData.yresize(binSlots);
+            quantizedData.QuantizedData = NCB::TMaybeOwningArrayHolder<ui8>::CreateNonOwning(buffers->QuantizedData);
+        } else if (binSlots < 65536) { // 65KB of stack maximum
             quantizedData.QuantizedData = NCB::TMaybeOwningArrayHolder<ui8>::CreateNonOwning(
                 MakeArrayRef(GetAligned((ui8*)(alloca(binSlots + 0x20))), binSlots));
         } else {
@@ -105,13 +128,21 @@ namespace NCB::NModelEvaluation {
             binFeaturesHolder.yresize(binSlots);
             quantizedData.QuantizedData = NCB::TMaybeOwningArrayHolder<ui8>::CreateOwning(std::move(binFeaturesHolder));
         }
+        if (!buffers) {
+            buffers = &localBuffers;
+        }
 
-        TVector<ui32> transposedHash(blockSize * trees.GetUsedCatFeaturesCount());
-        TVector<float> ctrs(trees.GetUsedModelCtrs().size() * blockSize);
-        TVector<float> estimatedFeatures;
+        // hashes and ctrs are written by BinarizeFeatures before they are read
+        auto& transposedHash = buffers->TransposedHash;
+        transposedHash.yresize(blockSize * trees.GetUsedCatFeaturesCount());
+        auto& ctrs = buffers->Ctrs;
+        ctrs.yresize(trees.GetUsedModelCtrs().size() * blockSize);
+        auto& estimatedFeatures = buffers->EstimatedFeatures;
         if (textProcessingCollection) {
             // TODO(d-kruchinin): replace to GetUsedEstimatedFeatures.size() after creation TrimFeatures
-            estimatedFeatures = TVector<float>(textProcessingCollection->TotalNumberOfOutputFeatures() * blockSize);
+            estimatedFeatures.assign(textProcessingCollection->TotalNumberOfOutputFeatures() * blockSize, 0.0f);
+        } else {
+            estimatedFeatures.clear();
         }
 
         for (size_t blockStart = 0; blockStart < docCount; blockStart += blockSize) {
@@ -129,7 +160,9 @@ namespace NCB::NModelEvaluation {
                 transposedHash,
                 ctrs,
                 estimatedFeatures,
-                featureInfo
+                featureInfo,
+                &buffers->TextProcessing,
+                &buffers->CtrProvider
             );
             callback(docCountInBlock, &quantizedData);
         }
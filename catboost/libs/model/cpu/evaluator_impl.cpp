@@ -5,14 +5,30 @@
 #include <util/generic/algorithm.h>
 #include <util/stream/format.h>
 #include <util/system/compiler.h>
+#include <util/thread/singleton.h>
 
 #include <cstring>
+#include <type_traits>
 
 namespace NCB::NModelEvaluation {
 
     constexpr size_t SSE_BLOCK_SIZE = 16;
     static_assert(SSE_BLOCK_SIZE * 8 == FORMULA_EVALUATION_BLOCK_SIZE);
 
+    // leafs are gathered from float32 table for models with reduced leaf values precision,
+    // results are accumulated in double anyway
+    template <bool UseFloatLeaves>
+    using TLeafValue = std::conditional_t<UseFloatLeaves, float, double>;
+
+    template <bool UseFloatLeaves>
+    Y_FORCE_INLINE const TLeafValue<UseFloatLeaves>* GetLeafValuesPtr(const TModelTrees& trees) {
+        if constexpr (UseFloatLeaves) {
+            return trees.GetFloatLeafValues().data();
+        } else {
+            return trees.GetLeafValues().data();
+        }
+    }
+
     template <bool NeedXorMask, size_t START_BLOCK, typename TIndexType>
     Y_FORCE_INLINE void CalcIndexesBasic(
             const ui8* __restrict binFeatures,
@@ -147,8 +163,8 @@ namespace NCB::NModelEvaluation {
 
     #endif
 
-    template <typename TIndexType>
-    Y_FORCE_INLINE void CalculateLeafValues(const size_t docCountInBlock, const double* __restrict treeLeafPtr, const TIndexType* __restrict indexesPtr, double* __restrict writePtr) {
+    template <typename TLeafType, typename TIndexType>
+    Y_FORCE_INLINE void CalculateLeafValues(const size_t docCountInBlock, const TLeafType* __restrict treeLeafPtr, const TIndexType* __restrict indexesPtr, double* __restrict writePtr) {
         Y_PREFETCH_READ(treeLeafPtr, 3);
         Y_PREFETCH_READ(treeLeafPtr + 128, 3);
         const auto docCountInBlock4 = (docCountInBlock | 0x3) ^ 0x3;
@@ -168,8 +184,8 @@ namespace NCB::NModelEvaluation {
     }
 
     #ifdef _sse3_
-    template <int SSEBlockCount>
-    Y_FORCE_INLINE static void GatherAddLeafSSE(const double* __restrict treeLeafPtr, const ui8* __restrict indexesPtr, __m128d* __restrict writePtr) {
+    template <int SSEBlockCount, typename TLeafType>
+    Y_FORCE_INLINE static void GatherAddLeafSSE(const TLeafType* __restrict treeLeafPtr, const ui8* __restrict indexesPtr, __m128d* __restrict writePtr) {
         _mm_prefetch((const char*)(treeLeafPtr + 64), _MM_HINT_T2);
 
         for (size_t blockId = 0; blockId < SSEBlockCount; ++blockId) {
@@ -200,13 +216,13 @@ namespace NCB::NModelEvaluation {
     #undef ADD_LEAFS
     }
 
-    template <int SSEBlockCount>
+    template <int SSEBlockCount, typename TLeafType>
     Y_FORCE_INLINE void CalculateLeafValues4(
         const size_t docCountInBlock,
-        const double* __restrict treeLeafPtr0,
-        const double* __restrict treeLeafPtr1,
-        const double* __restrict treeLeafPtr2,
-        const double* __restrict treeLeafPtr3,
+        const TLeafType* __restrict treeLeafPtr0,
+        const TLeafType* __restrict treeLeafPtr1,
+        const TLeafType* __restrict treeLeafPtr2,
+        const TLeafType* __restrict treeLeafPtr3,
         const ui8* __restrict indexesPtr0,
         const ui8* __restrict indexesPtr1,
         const ui8* __restrict indexesPtr2,
@@ -239,8 +255,8 @@ namespace NCB::NModelEvaluation {
     }
     #endif
 
-    template <typename TIndexType>
-    Y_FORCE_INLINE void CalculateLeafValuesMulti(const size_t docCountInBlock, const double* __restrict leafPtr, const TIndexType* __restrict indexesVec, const int approxDimension, double* __restrict writePtr) {
+    template <typename TLeafType, typename TIndexType>
+    Y_FORCE_INLINE void CalculateLeafValuesMulti(const size_t docCountInBlock, const TLeafType* __restrict leafPtr, const TIndexType* __restrict indexesVec, const int approxDimension, double* __restrict writePtr) {
         for (size_t docId = 0; docId < docCountInBlock; ++docId) {
             auto leafValuePtr = leafPtr + indexesVec[docId] * approxDimension;
             for (int classId = 0; classId < approxDimension; ++classId) {
@@ -250,7 +266,8 @@ namespace NCB::NModelEvaluation {
         }
     }
 
-    template <bool IsSingleClassModel, bool NeedXorMask, int SSEBlockCount, bool CalcLeafIndexesOnly = false>
+    template <bool IsSingleClassModel, bool NeedXorMask, int SSEBlockCount, bool CalcLeafIndexesOnly = false,
+        bool UseFloatLeaves = false>
     Y_FORCE_INLINE void CalcTreesBlockedImpl(
         const TModelTrees& trees,
         const ui8* __restrict binFeatures,
@@ -263,7 +280,7 @@ namespace NCB::NModelEvaluation {
             trees.GetRepackedBins().data() + trees.GetTreeStartOffsets()[treeStart];
 
         ui8* __restrict indexesVec = (ui8*)indexesVecUI32;
-        const auto treeLeafPtr = trees.GetLeafValues().data();
+        const auto treeLeafPtr = GetLeafValuesPtr<UseFloatLeaves>(trees);
         auto firstLeafOffsetsPtr = trees.GetFirstLeafOffsets().data();
     #ifdef _sse3_
         bool allTreesAreShallow = AllOf(
@@ -355,7 +372,7 @@ namespace NCB::NModelEvaluation {
         }
     }
 
-    template <bool IsSingleClassModel, bool NeedXorMask, bool CalcLeafIndexesOnly = false>
+    template <bool IsSingleClassModel, bool NeedXorMask, bool CalcLeafIndexesOnly = false, bool UseFloatLeaves = false>
     Y_FORCE_INLINE void CalcTreesBlocked(
         const TModelTrees& trees,
         const TCPUEvaluatorQuantizedData* quantizedData,
@@ -367,39 +384,39 @@ namespace NCB::NModelEvaluation {
         const ui8* __restrict binFeatures = quantizedData->QuantizedData.data();
         switch (docCountInBlock / SSE_BLOCK_SIZE) {
             case 0:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 0, CalcLeafIndexesOnly>(
+                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 0, CalcLeafIndexesOnly, UseFloatLeaves>(
                     trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             case 1:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 1, CalcLeafIndexesOnly>(
+                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 1, CalcLeafIndexesOnly, UseFloatLeaves>(
                     trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             case 2:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 2, CalcLeafIndexesOnly>(
+                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 2, CalcLeafIndexesOnly, UseFloatLeaves>(
                     trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             case 3:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 3, CalcLeafIndexesOnly>(
+                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 3, CalcLeafIndexesOnly, UseFloatLeaves>(
                     trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             case 4:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 4, CalcLeafIndexesOnly>(
+                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 4, CalcLeafIndexesOnly, UseFloatLeaves>(
                     trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             case 5:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 5, CalcLeafIndexesOnly>(
+                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 5, CalcLeafIndexesOnly, UseFloatLeaves>(
                     trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             case 6:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 6, CalcLeafIndexesOnly>(
+                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 6, CalcLeafIndexesOnly, UseFloatLeaves>(
                     trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             case 7:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 7, CalcLeafIndexesOnly>(
+                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 7, CalcLeafIndexesOnly, UseFloatLeaves>(
                     trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             case 8:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 8, CalcLeafIndexesOnly>(
+                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 8, CalcLeafIndexesOnly, UseFloatLeaves>(
                     trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             default:
@@ -407,7 +424,7 @@ namespace NCB::NModelEvaluation {
         }
     }
 
-    template <bool IsSingleClassModel, bool NeedXorMask, bool calcIndexesOnly = false>
+    template <bool IsSingleClassModel, bool NeedXorMask, bool calcIndexesOnly = false, bool UseFloatLeaves = false>
     inline void CalcTreesSingleDocImpl(
         const TModelTrees& trees,
         const TCPUEvaluatorQuantizedData* quantizedData,
@@ -423,7 +440,7 @@ namespace NCB::NModelEvaluation {
                                                       [](double value) { return value == 0.0; })));
         const TRepackedBin* treeSplitsCurPtr =
             trees.GetRepackedBins().data() + trees.GetTreeStartOffsets()[treeStart];
-        const double* treeLeafPtr = trees.GetFirstLeafPtrForTree(treeStart);
+        const auto* treeLeafPtr = GetLeafValuesPtr<UseFloatLeaves>(trees) + trees.GetFirstLeafOffsets()[treeStart];
         for (size_t treeId = treeStart; treeId < treeEnd; ++treeId) {
             const auto curTreeSize = trees.GetTreeSizes()[treeId];
             TCalcerIndexType index = 0;
@@ -485,7 +502,7 @@ namespace NCB::NModelEvaluation {
         }
     }
 #if defined(_sse4_1_)
-    template <bool IsSingleClassModel, bool NeedXorMask, bool CalcLeafIndexesOnly = false>
+    template <bool IsSingleClassModel, bool NeedXorMask, bool CalcLeafIndexesOnly = false, bool UseFloatLeaves = false>
     inline void CalcNonSymmetricTrees(
         const TModelTrees& trees,
         const TCPUEvaluatorQuantizedData* quantizedData,
@@ -499,7 +516,7 @@ namespace NCB::NModelEvaluation {
         const TRepackedBin* treeSplitsPtr = trees.GetRepackedBins().data();
         const i32* treeStepNodes = reinterpret_cast<const i32*>(trees.GetNonSymmetricStepNodes().data());
         const ui32* __restrict nonSymmetricNodeIdToLeafIdPtr = trees.GetNonSymmetricNodeIdToLeafId().data();
-        const double* __restrict leafValuesPtr = trees.GetLeafValues().data();
+        const auto* __restrict leafValuesPtr = GetLeafValuesPtr<UseFloatLeaves>(trees);
         for (size_t treeId = treeStart; treeId < treeEnd; ++treeId) {
             const ui32 treeStartIndex = trees.GetTreeStartOffsets()[treeId];
             __m128i* indexesVec = reinterpret_cast<__m128i*>(indexes);
@@ -650,7 +667,7 @@ namespace NCB::NModelEvaluation {
     }
 
 #else
-    template <bool IsSingleClassModel, bool NeedXorMask, bool CalcLeafIndexesOnly = false>
+    template <bool IsSingleClassModel, bool NeedXorMask, bool CalcLeafIndexesOnly = false, bool UseFloatLeaves = false>
     inline void CalcNonSymmetricTrees(
         const TModelTrees& trees,
         const TCPUEvaluatorQuantizedData* quantizedData,
@@ -661,6 +678,7 @@ namespace NCB::NModelEvaluation {
         double* __restrict resultsPtr
     ) {
         const ui8* __restrict binFeatures = quantizedData->QuantizedData.data();
+        const auto* leafValuesPtr = GetLeafValuesPtr<UseFloatLeaves>(trees);
         for (size_t treeId = treeStart; treeId < treeEnd; ++treeId) {
             CalcIndexesNonSymmetric<NeedXorMask>(trees, binFeatures, 0, docCountInBlock, treeId, indexesVec);
             for (size_t docId = 0; docId < docCountInBlock; ++docId) {
@@ -677,7 +695,7 @@ namespace NCB::NModelEvaluation {
             } else {
                 if constexpr (IsSingleClassModel) {
                     for (size_t docId = 0; docId < docCountInBlock; ++docId) {
-                        resultsPtr[docId] += trees.GetLeafValues()[indexesVec[docId]];
+                        resultsPtr[docId] += leafValuesPtr[indexesVec[docId]];
                     }
                 } else {
                     auto resultWritePtr = resultsPtr;
@@ -685,7 +703,7 @@ namespace NCB::NModelEvaluation {
                         const ui32 firstValueIdx = indexesVec[docId];
                         for (int classId = 0;
                              classId < (int)trees.GetDimensionsCount(); ++classId, ++resultWritePtr) {
-                            *resultWritePtr += trees.GetLeafValues()[firstValueIdx + classId];
+                            *resultWritePtr += leafValuesPtr[firstValueIdx + classId];
                         }
                     }
                 }
@@ -695,7 +713,7 @@ namespace NCB::NModelEvaluation {
 #endif
 
 
-    template <bool IsSingleClassModel, bool NeedXorMask, bool CalcIndexesOnly>
+    template <bool IsSingleClassModel, bool NeedXorMask, bool CalcIndexesOnly, bool UseFloatLeaves>
     inline void CalcNonSymmetricTreesSingle(
         const TModelTrees& trees,
         const TCPUEvaluatorQuantizedData* quantizedData,
@@ -710,6 +728,7 @@ namespace NCB::NModelEvaluation {
         const TRepackedBin* treeSplitsPtr = trees.GetRepackedBins().data();
         const TNonSymmetricTreeStepNode* treeStepNodes = trees.GetNonSymmetricStepNodes().data();
         const auto firstLeafOffsets = trees.GetFirstLeafOffsets();
+        const auto* leafValuesPtr = GetLeafValuesPtr<UseFloatLeaves>(trees);
         for (size_t treeId = treeStart; treeId < treeEnd; ++treeId) {
             index = trees.GetTreeStartOffsets()[treeId];
             while (true) {
@@ -732,10 +751,10 @@ namespace NCB::NModelEvaluation {
                 *indexesVec++ = ((firstValueIdx - firstLeafOffsets[treeId]) / trees.GetDimensionsCount());
             } else {
                 if constexpr (IsSingleClassModel) {
-                    *resultsPtr += trees.GetLeafValues()[firstValueIdx];
+                    *resultsPtr += leafValuesPtr[firstValueIdx];
                 } else {
                     for (int classId = 0; classId < (int)trees.GetDimensionsCount(); ++classId) {
-                        resultsPtr[classId] += trees.GetLeafValues()[firstValueIdx + classId];
+                        resultsPtr[classId] += leafValuesPtr[firstValueIdx + classId];
                     }
                 }
             }
@@ -744,20 +763,20 @@ namespace NCB::NModelEvaluation {
 
 
     template <bool AreTreesOblivious, bool IsSingleDoc, bool IsSingleClassModel, bool NeedXorMask,
-        bool CalcLeafIndexesOnly>
+        bool CalcLeafIndexesOnly, bool UseFloatLeaves>
     struct CalcTreeFunctionInstantiationGetter {
         TTreeCalcFunction operator()() const {
             if constexpr (AreTreesOblivious) {
                 if constexpr (IsSingleDoc) {
-                    return CalcTreesSingleDocImpl<IsSingleClassModel, NeedXorMask, CalcLeafIndexesOnly>;
+                    return CalcTreesSingleDocImpl<IsSingleClassModel, NeedXorMask, CalcLeafIndexesOnly, UseFloatLeaves>;
                 } else {
-                    return CalcTreesBlocked<IsSingleClassModel, NeedXorMask, CalcLeafIndexesOnly>;
+                    return CalcTreesBlocked<IsSingleClassModel, NeedXorMask, CalcLeafIndexesOnly, UseFloatLeaves>;
                 }
             } else {
                 if constexpr (IsSingleDoc) {
-                    return CalcNonSymmetricTreesSingle<IsSingleClassModel, NeedXorMask, CalcLeafIndexesOnly>;
+                    return CalcNonSymmetricTreesSingle<IsSingleClassModel, NeedXorMask, CalcLeafIndexesOnly, UseFloatLeaves>;
                 } else {
-                    return CalcNonSymmetricTrees<IsSingleClassModel, NeedXorMask, CalcLeafIndexesOnly>;
+                    return CalcNonSymmetricTrees<IsSingleClassModel, NeedXorMask, CalcLeafIndexesOnly, UseFloatLeaves>;
                 }
             }
         }
@@ -779,6 +798,42 @@ namespace NCB::NModelEvaluation {
         }
     };
 
+    struct TSummationOrderIndexes {
+        TVector<TCalcerIndexType> Indexes;
+    };
+
+    // leaf indexes of all trees in [treeStart, treeEnd) are calculated in the tree order first,
+    // then leaf values are added in trees.GetTreeSummationOrder()
+    template <typename TLeafType>
+    void CalcTreesInSummationOrder(
+        const TTreeCalcFunction& calcIndexes,
+        const TModelTrees& trees,
+        const TCPUEvaluatorQuantizedData* quantizedData,
+        size_t docCountInBlock,
+        size_t treeStart,
+        size_t treeEnd,
+        double* __restrict results
+    ) {
+        auto& indexes = FastTlsSingleton<TSummationOrderIndexes>()->Indexes;
+        indexes.assign(docCountInBlock * (treeEnd - treeStart), 0);
+        calcIndexes(trees, quantizedData, docCountInBlock, indexes.data(), treeStart, treeEnd, nullptr);
+        const TLeafType* leafValuesPtr = GetLeafValuesPtr<std::is_same_v<TLeafType, float>>(trees);
+        const auto& firstLeafOffsets = trees.GetFirstLeafOffsets();
+        const int approxDimension = trees.GetDimensionsCount();
+        for (ui32 treeId : trees.GetTreeSummationOrder()) {
+            if (treeId < treeStart || treeId >= treeEnd) {
+                continue;
+            }
+            const TLeafType* treeLeafPtr = leafValuesPtr + firstLeafOffsets[treeId];
+            const TCalcerIndexType* treeIndexes = indexes.data() + (treeId - treeStart) * docCountInBlock;
+            if (approxDimension == 1) {
+                CalculateLeafValues(docCountInBlock, treeLeafPtr, treeIndexes, results);
+            } else {
+                CalculateLeafValuesMulti(docCountInBlock, treeLeafPtr, treeIndexes, approxDimension, results);
+            }
+        }
+    }
+
     TTreeCalcFunction GetCalcTreesFunction(
         const TModelTrees& trees,
         size_t docCountInBlock,
@@ -788,7 +843,26 @@ namespace NCB::NModelEvaluation {
         const bool isSingleDoc = (docCountInBlock == 1);
         const bool isSingleClassModel = (trees.GetDimensionsCount() == 1);
         const bool needXorMask = !trees.GetOneHotFeatures().empty();
-        return FunctorTemplateParamsSubstitutor<CalcTreeFunctionInstantiationGetter>::Call(
-            areTreesOblivious, isSingleDoc, isSingleClassModel, needXorMask, calcIndexesOnly);
+        const bool useFloatLeaves = !calcIndexesOnly
+            && trees.GetLeafValuesPrecision() != ELeafValuesPrecision::Double;
+        if (calcIndexesOnly || trees.GetTreeSummationOrder().empty()) {
+            return FunctorTemplateParamsSubstitutor<CalcTreeFunctionInstantiationGetter>::Call(
+                areTreesOblivious, isSingleDoc, isSingleClassModel, needXorMask, calcIndexesOnly, useFloatLeaves);
+        }
+        CB_ENSURE_INTERNAL(areTreesOblivious, "Tree summation order is supported only for symmetric trees");
+        auto calcIndexes = FunctorTemplateParamsSubstitutor<CalcTreeFunctionInstantiationGetter>::Call(
+            areTreesOblivious, isSingleDoc, isSingleClassModel, needXorMask, /*calcIndexesOnly*/ true, false);
+        if (useFloatLeaves) {
+            return [calcIndexes] (const TModelTrees& trees, const TCPUEvaluatorQuantizedData* quantizedData,
+                size_t docCountInBlock, TCalcerIndexType*, size_t treeStart, size_t treeEnd, double* results) {
+                CalcTreesInSummationOrder<float>(
+                    calcIndexes, trees, quantizedData, docCountInBlock, treeStart, treeEnd, results);
+            };
+        }
+        return [calcIndexes] (const TModelTrees& trees, const TCPUEvaluatorQuantizedData* quantizedData,
+            size_t docCountInBlock, TCalcerIndexType*, size_t treeStart, size_t treeEnd, double* results) {
+            CalcTreesInSummationOrder<double>(
+                calcIndexes, trees, quantizedData, docCountInBlock, treeStart, treeEnd, results);
+        };
     }
 }
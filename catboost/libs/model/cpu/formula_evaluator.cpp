@@ -1,8 +1,15 @@
+#include <catboost/libs/cat_feature/cat_feature.h>
+#include <catboost/libs/model/cached_ctr_provider.h>
 #include <catboost/libs/model/eval_processing.h>
 #include <catboost/libs/model/model.h>
 
 #include "evaluator.h"
 
+#include <util/generic/algorithm.h>
+#include <util/stream/labeled.h>
+#include <util/string/cast.h>
+#include <util/thread/singleton.h>
+
 namespace NCB::NModelEvaluation {
     namespace NDetail {
         template <typename TFloatFeatureAccessor, typename TCatFeatureAccessor, typename TTextFeatureAccessor>
@@ -18,21 +25,31 @@ namespace NCB::NModelEvaluation {
             size_t treeEnd,
             EPredictionType predictionType,
             TArrayRef<double> results,
-            const NCB::NModelEvaluation::TFeatureLayout* featureInfo = nullptr
+            const NCB::NModelEvaluation::TFeatureLayout* featureInfo = nullptr,
+            TCPUEvaluatorBuffers* buffers = nullptr,
+            const TTreeCalcFunction* precomputedCalcTrees = nullptr
         ) {
             const size_t blockSize = Min(FORMULA_EVALUATION_BLOCK_SIZE, docCount);
-            auto calcTrees = GetCalcTreesFunction(trees, blockSize);
+            TTreeCalcFunction localCalcTrees;
+            if (!precomputedCalcTrees) {
+                localCalcTrees = GetCalcTreesFunction(trees, blockSize);
+            }
+            const TTreeCalcFunction& calcTrees = precomputedCalcTrees ? *precomputedCalcTrees : localCalcTrees;
             std::fill(results.begin(), results.end(), 0.0);
             if (trees.GetTreeCount() == 0) {
                 return;
             }
-            TVector<TCalcerIndexType> indexesVec(blockSize);
+            TVector<TCalcerIndexType> localIndexesVec;
+            auto& indexesVec = buffers ? buffers->Indexes : localIndexesVec;
+            indexesVec.yresize(blockSize);
             TEvalResultProcessor resultProcessor(
                 docCount,
                 results,
                 predictionType,
                 trees.GetDimensionsCount(),
-                blockSize
+                blockSize,
+                Nothing(),
+                buffers ? &buffers->IntermediateBlockResults : nullptr
             );
             ui32 blockId = 0;
             ProcessDocsInBlocks(
@@ -58,16 +75,162 @@ namespace NCB::NModelEvaluation {
                     resultProcessor.PostprocessBlock(blockId);
                     ++blockId;
                 },
-                featureInfo
+                featureInfo,
+                buffers
             );
         }
 
+        // input indexes of used categorical features and their slots in TBatchedCatFeatureHashes
+        struct TUsedCatFeatureSlots {
+            TUsedCatFeatureSlots(const TModelTrees& trees, const TFeatureLayout* featureInfo) {
+                for (const auto& catFeature : trees.GetCatFeatures()) {
+                    if (!catFeature.UsedInModel()) {
+                        continue;
+                    }
+                    const TFeaturePosition position
+                        = featureInfo ? featureInfo->GetRemappedPosition(catFeature) : catFeature.Position;
+                    if ((size_t)position.Index >= IndexToSlot.size()) {
+                        IndexToSlot.resize(position.Index + 1, 0);
+                    }
+                    IndexToSlot[position.Index] = UsedIndexes.size();
+                    UsedIndexes.push_back(position.Index);
+                }
+            }
+
+            TVector<int> UsedIndexes;
+            TVector<ui32> IndexToSlot;
+        };
+
+        /* Hashes of used categorical features for a chunk of documents, computed with CalcCatFeatureHashes
+         * instead of calling CalcCatFeatureHash from the feature accessor for each value.
+         */
+        class TBatchedCatFeatureHashes {
+        public:
+            // documents are hashed in chunks to bound memory for big inputs
+            static constexpr size_t ChunkSize = 8 * FORMULA_EVALUATION_BLOCK_SIZE;
+
+        public:
+            // values and hashes are kept in buffers if they are provided
+            TBatchedCatFeatureHashes(const TUsedCatFeatureSlots& slots, TCPUEvaluatorBuffers* buffers)
+                : Slots(slots)
+                , Values(buffers ? buffers->CatFeatureValues : LocalValues)
+                , Hashes(buffers ? buffers->CatFeatureHashes : LocalHashes)
+            {}
+
+            bool Empty() const {
+                return Slots.UsedIndexes.empty();
+            }
+
+            void Calc(TConstArrayRef<TConstArrayRef<TStringBuf>> catFeatures, size_t docStart, size_t docEnd) {
+                Values.yresize((docEnd - docStart) * Slots.UsedIndexes.size());
+                auto valuePtr = Values.begin();
+                for (size_t docIdx = docStart; docIdx < docEnd; ++docIdx) {
+                    for (int index : Slots.UsedIndexes) {
+                        *valuePtr++ = catFeatures[docIdx][index];
+                    }
+                }
+                Hashes.yresize(Values.size());
+                CalcCatFeatureHashes(Values, Hashes);
+            }
+
+            // docIdx is relative to docStart of the last Calc call
+            int operator()(TFeaturePosition position, size_t docIdx) const {
+                return Hashes[docIdx * Slots.UsedIndexes.size() + Slots.IndexToSlot[position.Index]];
+            }
+
+        private:
+            const TUsedCatFeatureSlots& Slots;
+            TVector<TStringBuf> LocalValues;
+            TVector<ui32> LocalHashes;
+            TVector<TStringBuf>& Values;
+            TVector<ui32>& Hashes;
+        };
+
+        // calls calcChunk(chunkStart, chunkEnd, catFeatureHashes) for consecutive document chunks
+        template <class TCalcChunk>
+        inline void CalcWithBatchedCatFeatureHashes(
+            const TUsedCatFeatureSlots& slots,
+            TCPUEvaluatorBuffers* buffers,
+            TConstArrayRef<TConstArrayRef<TStringBuf>> catFeatures,
+            size_t docCount,
+            TCalcChunk&& calcChunk
+        ) {
+            TBatchedCatFeatureHashes catFeatureHashes(slots, buffers);
+            const size_t chunkSize = catFeatureHashes.Empty()
+                ? Max<size_t>(docCount, 1)
+                : TBatchedCatFeatureHashes::ChunkSize;
+            for (size_t chunkStart = 0; chunkStart < docCount; chunkStart += chunkSize) {
+                const size_t chunkEnd = Min(docCount, chunkStart + chunkSize);
+                if (!catFeatureHashes.Empty()) {
+                    catFeatureHashes.Calc(catFeatures, chunkStart, chunkEnd);
+                }
+                calcChunk(chunkStart, chunkEnd, catFeatureHashes);
+            }
+        }
+
+        static TIntrusivePtr<ICtrProvider> GetEvaluationCtrProvider(const TFullModel& fullModel) {
+            if (!fullModel.CtrProvider || !fullModel.GetCtrValueCache()) {
+                return fullModel.CtrProvider;
+            }
+            return MakeIntrusive<TCachedCtrProvider>(
+                fullModel.CtrProvider,
+                *fullModel.ModelTrees,
+                fullModel.GetCtrValueCache());
+        }
+
+        /* Sums of minimal and maximal leaf values of trees [treeIdx, treeCount), used to stop evaluation
+         * once the remaining trees can't move a raw value across the decision threshold.
+         * Only single dimension models are supported, for others the sums are empty.
+         */
+        struct TLeafValuesSuffixBounds {
+            explicit TLeafValuesSuffixBounds(const TModelTrees& trees) {
+                if (trees.GetDimensionsCount() != 1) {
+                    return;
+                }
+                const size_t treeCount = trees.GetTreeCount();
+                const auto& leafValues = trees.GetLeafValues();
+                const auto& firstLeafOffsets = trees.GetFirstLeafOffsets();
+                MinSums.assign(treeCount + 1, 0.0);
+                MaxSums.assign(treeCount + 1, 0.0);
+                for (size_t treeIdx = treeCount; treeIdx > 0; --treeIdx) {
+                    const size_t leafStart = firstLeafOffsets[treeIdx - 1];
+                    const size_t leafEnd = treeIdx < treeCount ? firstLeafOffsets[treeIdx] : leafValues.size();
+                    const auto minMax = std::minmax_element(leafValues.begin() + leafStart, leafValues.begin() + leafEnd);
+                    MinSums[treeIdx - 1] = MinSums[treeIdx] + *minMax.first;
+                    MaxSums[treeIdx - 1] = MaxSums[treeIdx] + *minMax.second;
+                }
+            }
+
+            TVector<double> MinSums;
+            TVector<double> MaxSums;
+        };
+
+        // copies columns of kept documents of [bucket][doc] quantized block, dst may be equal to src
+        inline void CompactQuantizedColumns(
+            const ui8* src,
+            size_t docCount,
+            TConstArrayRef<ui32> keptDocs,
+            size_t bucketCount,
+            ui8* dst
+        ) {
+            for (size_t bucket = 0; bucket < bucketCount; ++bucket) {
+                const ui8* srcColumn = src + bucket * docCount;
+                ui8* dstColumn = dst + bucket * keptDocs.size();
+                for (size_t i = 0; i < keptDocs.size(); ++i) {
+                    dstColumn[i] = srcColumn[keptDocs[i]];
+                }
+            }
+        }
+
         class TCpuEvaluator final : public IModelEvaluator {
         public:
             explicit TCpuEvaluator(const TFullModel& fullModel)
                 : ModelTrees(fullModel.ModelTrees)
-                , CtrProvider(fullModel.CtrProvider)
+                , CtrProvider(GetEvaluationCtrProvider(fullModel))
                 , TextProcessingCollection(fullModel.TextProcessingCollection)
+                , CatFeatureSlots(*ModelTrees, nullptr)
+                , SingleDocCalcTrees(GetCalcTreesFunction(*ModelTrees, 1))
+                , LeafValuesSuffixBounds(*ModelTrees)
             {}
 
             void SetPredictionType(EPredictionType type) override {
@@ -80,6 +243,7 @@ namespace NCB::NModelEvaluation {
 
             void SetFeatureLayout(const TFeatureLayout& featureLayout) override {
                 ExtFeatureLayout = featureLayout;
+                CatFeatureSlots = TUsedCatFeatureSlots(*ModelTrees, ExtFeatureLayout.Get());
             }
 
             size_t GetTreeCount() const {
@@ -95,8 +259,15 @@ namespace NCB::NModelEvaluation {
             }
 
             void SetProperty(const TStringBuf propName, const TStringBuf propValue) override {
-                CB_ENSURE(false, "CPU evaluator don't have any properties. Got: " << propName);
-                Y_UNUSED(propValue);
+                if (propName == ReuseBuffersPropertyName) {
+                    if (FromString<bool>(propValue)) {
+                        ScratchBuffers.ConstructInPlace();
+                    } else {
+                        ScratchBuffers.Clear();
+                    }
+                    return;
+                }
+                CB_ENSURE(false, "Unknown CPU evaluator property: " << propName);
             }
 
             void CalcFlatTransposed(
@@ -157,7 +328,9 @@ namespace NCB::NModelEvaluation {
                     treeEnd,
                     PredictionType,
                     results,
-                    featureInfo
+                    featureInfo,
+                    GetBuffers(*docCount),
+                    GetCalcTrees(*docCount)
                 );
             }
 
@@ -171,20 +344,7 @@ namespace NCB::NModelEvaluation {
                 if (!featureInfo) {
                     featureInfo = ExtFeatureLayout.Get();
                 }
-                auto expectedFlatVecSize = ModelTrees->GetFlatFeatureVectorExpectedSize();
-                if (featureInfo && featureInfo->FlatIndexes) {
-                    CB_ENSURE(
-                        featureInfo->FlatIndexes->size() >= expectedFlatVecSize,
-                        "Feature layout FlatIndexes expected to be at least " << expectedFlatVecSize << " long"
-                    );
-                    expectedFlatVecSize = *MaxElement(featureInfo->FlatIndexes->begin(), featureInfo->FlatIndexes->end());
-                }
-                for (const auto& flatFeaturesVec : features) {
-                    CB_ENSURE(
-                        flatFeaturesVec.size() >= expectedFlatVecSize,
-                        "insufficient flat features vector size: " << flatFeaturesVec.size() << " expected: " << expectedFlatVecSize
-                    );
-                }
+                CheckFlatFeatureVectorSizes(features, featureInfo);
                 CalcGeneric(
                     *ModelTrees,
                     CtrProvider,
@@ -201,7 +361,124 @@ namespace NCB::NModelEvaluation {
                     treeEnd,
                     PredictionType,
                     results,
-                    featureInfo
+                    featureInfo,
+                    GetBuffers(features.size()),
+                    GetCalcTrees(features.size())
+                );
+            }
+
+            void CalcFlatWithEarlyExit(
+                TConstArrayRef<TConstArrayRef<float>> features,
+                double rawThreshold,
+                size_t treeChunkSize,
+                TArrayRef<double> results,
+                TArrayRef<ui32> evaluatedTreeCounts,
+                const TFeatureLayout* featureInfo
+            ) const override {
+                CB_ENSURE(
+                    ModelTrees->GetDimensionsCount() == 1,
+                    "Early exit evaluation is supported only for single dimension models"
+                );
+                CB_ENSURE(results.size() == features.size(), "Results size should be equal to documents count");
+                CB_ENSURE(
+                    evaluatedTreeCounts.empty() || evaluatedTreeCounts.size() == features.size(),
+                    "Evaluated tree counts size should be equal to documents count"
+                );
+                if (!featureInfo) {
+                    featureInfo = ExtFeatureLayout.Get();
+                }
+                CheckFlatFeatureVectorSizes(features, featureInfo);
+                const size_t docCount = features.size();
+                const size_t treeCount = ModelTrees->GetTreeCount();
+                if (docCount == 0) {
+                    return;
+                }
+                if (treeCount == 0) {
+                    Fill(results.begin(), results.end(), 0.0);
+                    Fill(evaluatedTreeCounts.begin(), evaluatedTreeCounts.end(), 0);
+                    return;
+                }
+                treeChunkSize = Max<size_t>(treeChunkSize, 1);
+                const auto& minSums = LeafValuesSuffixBounds.MinSums;
+                const auto& maxSums = LeafValuesSuffixBounds.MaxSums;
+                const size_t blockSize = Min(FORMULA_EVALUATION_BLOCK_SIZE, docCount);
+                const size_t bucketCount = ModelTrees->GetEffectiveBinaryFeaturesBucketsCount();
+                // single document calcer expects zero results, blocked one accumulates for any document count
+                const auto calcTrees = GetCalcTreesFunction(*ModelTrees, FORMULA_EVALUATION_BLOCK_SIZE);
+                TVector<TCalcerIndexType> indexes;
+                indexes.yresize(blockSize);
+                TVector<double> activeResults;
+                TVector<ui32> activeDocs;
+                TVector<ui32> keptPositions;
+                TVector<ui8> compactedData;
+                compactedData.yresize(bucketCount * blockSize);
+                size_t blockStart = 0;
+                ProcessDocsInBlocks(
+                    *ModelTrees,
+                    CtrProvider,
+                    TextProcessingCollection,
+                    [&features](TFeaturePosition position, size_t index) -> float {
+                        return features[index][position.FlatIndex];
+                    },
+                    [&features](TFeaturePosition position, size_t index) -> int {
+                        return ConvertFloatCatFeatureToIntHash(features[index][position.FlatIndex]);
+                    },
+                    TCpuEvaluator::TextFeatureAccessorStub,
+                    docCount,
+                    blockSize,
+                    [&] (size_t docCountInBlock, const TCPUEvaluatorQuantizedData* quantizedData) {
+                        activeDocs.yresize(docCountInBlock);
+                        Iota(activeDocs.begin(), activeDocs.end(), 0);
+                        activeResults.assign(docCountInBlock, 0.0);
+                        TCPUEvaluatorQuantizedData compactedQuantizedData;
+                        const TCPUEvaluatorQuantizedData* activeQuantizedData = quantizedData;
+                        for (size_t treeStart = 0; !activeDocs.empty(); treeStart += treeChunkSize) {
+                            const size_t treeEnd = Min(treeStart + treeChunkSize, treeCount);
+                            calcTrees(
+                                *ModelTrees,
+                                activeQuantizedData,
+                                activeDocs.size(),
+                                indexes.data(),
+                                treeStart,
+                                treeEnd,
+                                activeResults.data()
+                            );
+                            keptPositions.clear();
+                            for (size_t i = 0; i < activeDocs.size(); ++i) {
+                                const double minFinal = activeResults[i] + minSums[treeEnd];
+                                const double maxFinal = activeResults[i] + maxSums[treeEnd];
+                                if (treeEnd < treeCount && minFinal < rawThreshold && maxFinal >= rawThreshold) {
+                                    activeDocs[keptPositions.size()] = activeDocs[i];
+                                    activeResults[keptPositions.size()] = activeResults[i];
+                                    keptPositions.push_back(i);
+                                    continue;
+                                }
+                                const size_t docIdx = blockStart + activeDocs[i];
+                                results[docIdx] = minFinal >= rawThreshold ? minFinal : maxFinal;
+                                if (!evaluatedTreeCounts.empty()) {
+                                    evaluatedTreeCounts[docIdx] = treeEnd;
+                                }
+                            }
+                            if (!keptPositions.empty() && keptPositions.size() < activeDocs.size()) {
+                                CompactQuantizedColumns(
+                                    activeQuantizedData->QuantizedData.data(),
+                                    activeDocs.size(),
+                                    keptPositions,
+                                    bucketCount,
+                                    compactedData.data()
+                                );
+                                compactedQuantizedData.QuantizedData = TMaybeOwningArrayHolder<ui8>::CreateNonOwning(
+                                    MakeArrayRef(compactedData.data(), bucketCount * keptPositions.size())
+                                );
+                                activeQuantizedData = &compactedQuantizedData;
+                            }
+                            activeDocs.resize(keptPositions.size());
+                            activeResults.resize(keptPositions.size());
+                        }
+                        blockStart += docCountInBlock;
+                    },
+                    featureInfo,
+                    GetBuffers(docCount)
                 );
             }
 
@@ -235,7 +512,9 @@ namespace NCB::NModelEvaluation {
                     treeEnd,
                     PredictionType,
                     results,
-                    featureInfo
+                    featureInfo,
+                    GetBuffers(1),
+                    &SingleDocCalcTrees
                 );
             }
 
@@ -294,7 +573,9 @@ namespace NCB::NModelEvaluation {
                     treeEnd,
                     PredictionType,
                     results,
-                    featureInfo
+                    featureInfo,
+                    GetBuffers(docCount),
+                    GetCalcTrees(docCount)
                 );
             }
 
@@ -335,25 +616,46 @@ namespace NCB::NModelEvaluation {
                 }
                 ValidateInputFeatures(floatFeatures, catFeatures, textFeatures, featureInfo);
                 const size_t docCount = Max(catFeatures.size(), floatFeatures.size(), textFeatures.size());
-                CalcGeneric(
-                    *ModelTrees,
-                    CtrProvider,
-                    TextProcessingCollection,
-                    [&floatFeatures](TFeaturePosition position, size_t index) -> float {
-                        return floatFeatures[index][position.Index];
-                    },
-                    [&catFeatures](TFeaturePosition position, size_t index) -> int {
-                        return CalcCatFeatureHash(catFeatures[index][position.Index]);
-                    },
-                    [&textFeatures](TFeaturePosition position, size_t index) -> TStringBuf {
-                        return textFeatures[index][position.Index];
-                    },
+                if (docCount == 0) {
+                    return;
+                }
+                const size_t resultsPerDoc
+                    = PredictionType == EPredictionType::Class ? 1 : ModelTrees->GetDimensionsCount();
+                CB_ENSURE(
+                    results.size() == docCount * resultsPerDoc,
+                    "`results` size is insufficient: "
+                        << LabeledOutput(results.size(), resultsPerDoc, docCount * resultsPerDoc)
+                );
+                TMaybe<TUsedCatFeatureSlots> slotsHolder;
+                CalcWithBatchedCatFeatureHashes(
+                    GetCatFeatureSlots(featureInfo, &slotsHolder),
+                    GetBuffers(docCount),
+                    catFeatures,
                     docCount,
-                    treeStart,
-                    treeEnd,
-                    PredictionType,
-                    results,
-                    featureInfo
+                    [&] (size_t chunkStart, size_t chunkEnd, const TBatchedCatFeatureHashes& catFeatureHashes) {
+                        CalcGeneric(
+                            *ModelTrees,
+                            CtrProvider,
+                            TextProcessingCollection,
+                            [&floatFeatures, chunkStart](TFeaturePosition position, size_t index) -> float {
+                                return floatFeatures[chunkStart + index][position.Index];
+                            },
+                            [&catFeatureHashes](TFeaturePosition position, size_t index) -> int {
+                                return catFeatureHashes(position, index);
+                            },
+                            [&textFeatures, chunkStart](TFeaturePosition position, size_t index) -> TStringBuf {
+                                return textFeatures[chunkStart + index][position.Index];
+                            },
+                            chunkEnd - chunkStart,
+                            treeStart,
+                            treeEnd,
+                            PredictionType,
+                            results.Slice(chunkStart * resultsPerDoc, (chunkEnd - chunkStart) * resultsPerDoc),
+                            featureInfo,
+                            GetBuffers(docCount),
+                            GetCalcTrees(chunkEnd - chunkStart)
+                        );
+                    }
                 );
             }
 
@@ -369,14 +671,19 @@ namespace NCB::NModelEvaluation {
                     featureInfo = ExtFeatureLayout.Get();
                 }
                 ValidateInputFeatures<TConstArrayRef<TStringBuf>>({floatFeatures}, {catFeatures}, {}, featureInfo);
+                TMaybe<TUsedCatFeatureSlots> slotsHolder;
+                TBatchedCatFeatureHashes catFeatureHashes(GetCatFeatureSlots(featureInfo, &slotsHolder), GetBuffers(1));
+                if (!catFeatureHashes.Empty()) {
+                    catFeatureHashes.Calc(MakeArrayRef(&catFeatures, 1), 0, 1);
+                }
                 CalcLeafIndexesGeneric(
                     *ModelTrees,
                     CtrProvider,
                     [&floatFeatures](TFeaturePosition position, size_t) -> float {
                         return floatFeatures[position.Index];
                     },
-                    [&catFeatures](TFeaturePosition position, size_t) -> int {
-                        return CalcCatFeatureHash(catFeatures[position.Index]);
+                    [&catFeatureHashes](TFeaturePosition position, size_t index) -> int {
+                        return catFeatureHashes(position, index);
                     },
                     1,
                     treeStart,
@@ -399,21 +706,31 @@ namespace NCB::NModelEvaluation {
                 }
                 ValidateInputFeatures(floatFeatures, catFeatures, {}, featureInfo);
                 const size_t docCount = Max(catFeatures.size(), floatFeatures.size());
-                CB_ENSURE(docCount * (treeEnd - treeStart) == indexes.size(), LabeledOutput(docCount * (treeEnd - treeStart), indexes.size()));
-                CalcLeafIndexesGeneric(
-                    *ModelTrees,
-                    CtrProvider,
-                    [&floatFeatures](TFeaturePosition position, size_t index) -> float {
-                        return floatFeatures[index][position.Index];
-                    },
-                    [&catFeatures](TFeaturePosition position, size_t index) -> int {
-                        return CalcCatFeatureHash(catFeatures[index][position.Index]);
-                    },
+                const size_t treeCount = treeEnd - treeStart;
+                CB_ENSURE(docCount * treeCount == indexes.size(), LabeledOutput(docCount * treeCount, indexes.size()));
+                TMaybe<TUsedCatFeatureSlots> slotsHolder;
+                CalcWithBatchedCatFeatureHashes(
+                    GetCatFeatureSlots(featureInfo, &slotsHolder),
+                    GetBuffers(docCount),
+                    catFeatures,
                     docCount,
-                    treeStart,
-                    treeEnd,
-                    indexes,
-                    featureInfo
+                    [&] (size_t chunkStart, size_t chunkEnd, const TBatchedCatFeatureHashes& catFeatureHashes) {
+                        CalcLeafIndexesGeneric(
+                            *ModelTrees,
+                            CtrProvider,
+                            [&floatFeatures, chunkStart](TFeaturePosition position, size_t index) -> float {
+                                return floatFeatures[chunkStart + index][position.Index];
+                            },
+                            [&catFeatureHashes](TFeaturePosition position, size_t index) -> int {
+                                return catFeatureHashes(position, index);
+                            },
+                            chunkEnd - chunkStart,
+                            treeStart,
+                            treeEnd,
+                            indexes.Slice(chunkStart * treeCount, (chunkEnd - chunkStart) * treeCount),
+                            featureInfo
+                        );
+                    }
                 );
             }
             void Calc(
@@ -506,6 +823,26 @@ namespace NCB::NModelEvaluation {
             }
 
         private:
+            void CheckFlatFeatureVectorSizes(
+                TConstArrayRef<TConstArrayRef<float>> features,
+                const TFeatureLayout* featureInfo
+            ) const {
+                auto expectedFlatVecSize = ModelTrees->GetFlatFeatureVectorExpectedSize();
+                if (featureInfo && featureInfo->FlatIndexes) {
+                    CB_ENSURE(
+                        featureInfo->FlatIndexes->size() >= expectedFlatVecSize,
+                        "Feature layout FlatIndexes expected to be at least " << expectedFlatVecSize << " long"
+                    );
+                    expectedFlatVecSize = *MaxElement(featureInfo->FlatIndexes->begin(), featureInfo->FlatIndexes->end());
+                }
+                for (const auto& flatFeaturesVec : features) {
+                    CB_ENSURE(
+                        flatFeaturesVec.size() >= expectedFlatVecSize,
+                        "insufficient flat features vector size: " << flatFeaturesVec.size() << " expected: " << expectedFlatVecSize
+                    );
+                }
+            }
+
             template <typename TCatFeatureContainer = TConstArrayRef<int>>
             void ValidateInputFeatures(
                 TConstArrayRef<TConstArrayRef<float>> floatFeatures,
@@ -575,6 +912,32 @@ namespace NCB::NModelEvaluation {
                 }
             }
 
+            /* Single document calls are the latency critical ones, they take scratch buffers from thread local
+             * storage, so they don't allocate once the buffers have grown to the model size. CTR providers and
+             * multiclass results use these buffers too. Models with text features and CTR value cache misses
+             * still allocate.
+             */
+            TCPUEvaluatorBuffers* GetBuffers(size_t docCount) const {
+                if (ScratchBuffers) {
+                    return ScratchBuffers.Get();
+                }
+                return docCount == 1 ? FastTlsSingleton<TCPUEvaluatorBuffers>() : nullptr;
+            }
+
+            const TTreeCalcFunction* GetCalcTrees(size_t docCount) const {
+                return docCount == 1 ? &SingleDocCalcTrees : nullptr;
+            }
+
+            const TUsedCatFeatureSlots& GetCatFeatureSlots(
+                const TFeatureLayout* featureInfo,
+                TMaybe<TUsedCatFeatureSlots>* slotsHolder
+            ) const {
+                if (featureInfo == ExtFeatureLayout.Get()) {
+                    return CatFeatureSlots;
+                }
+                return slotsHolder->ConstructInPlace(*ModelTrees, featureInfo);
+            }
+
             static TStringBuf TextFeatureAccessorStub(TFeaturePosition position, size_t index) {
                 Y_UNUSED(position, index);
                 CB_ENSURE(false, "This type of apply interface is not implemented with text features yet");
@@ -585,6 +948,12 @@ namespace NCB::NModelEvaluation {
             const TIntrusivePtr<TTextProcessingCollection> TextProcessingCollection;
             EPredictionType PredictionType = EPredictionType::RawFormulaVal;
             TMaybe<TFeatureLayout> ExtFeatureLayout;
+            // set by ReuseBuffersPropertyName property, evaluator with buffers is not thread-safe
+            mutable TMaybe<TCPUEvaluatorBuffers> ScratchBuffers;
+            // precomputed for ExtFeatureLayout
+            TUsedCatFeatureSlots CatFeatureSlots;
+            TTreeCalcFunction SingleDocCalcTrees;
+            TLeafValuesSuffixBounds LeafValuesSuffixBounds;
         };
     }
 
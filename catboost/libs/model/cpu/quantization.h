@@ -51,15 +51,31 @@ namespace NCB::NModelEvaluation {
         }
     };
 
+    // index of the categorical feature among used ones, used features are packed in transposedHash in this order
+    inline size_t GetUsedCatFeaturePackedIndex(TConstArrayRef<TCatFeature> catFeatures, int catFeatureIndex) {
+        size_t packedIdx = 0;
+        for (const auto& catFeature : catFeatures) {
+            if (!catFeature.UsedInModel()) {
+                continue;
+            }
+            if (catFeature.Position.Index == catFeatureIndex) {
+                return packedIdx;
+            }
+            ++packedIdx;
+        }
+        CB_ENSURE_INTERNAL(false, "One hot feature uses unknown categorical feature " << catFeatureIndex);
+        Y_UNREACHABLE();
+    }
+
     inline void OneHotBinsFromTransposedCatFeatures(
         const TConstArrayRef<TOneHotFeature> OneHotFeatures,
-        const THashMap<int, int> catFeaturePackedIndex,
+        const TConstArrayRef<TCatFeature> catFeatures,
         const size_t docCount,
         TArrayRef<ui32> transposedHash,
         ui8*& result
     ) {
         for (const auto& oheFeature : OneHotFeatures) {
-            const auto catIdx = catFeaturePackedIndex.at(oheFeature.CatFeatureIndex);
+            const auto catIdx = GetUsedCatFeaturePackedIndex(catFeatures, oheFeature.CatFeatureIndex);
             for (size_t docId = 0; docId < docCount; ++docId) {
                 static_assert(sizeof(int) >= sizeof(i32));
                 const int val = *reinterpret_cast<i32*>(&(transposedHash[catIdx * docCount + docId]));
@@ -275,7 +291,9 @@ namespace NCB::NModelEvaluation {
         TArrayRef<ui32> transposedHash,
         TArrayRef<float> ctrs,
         TArrayRef<float> estimatedFeatures,
-        const TFeatureLayout* featureInfo = nullptr
+        const TFeatureLayout* featureInfo = nullptr,
+        NCB::TTextProcessingBuffers* textProcessingBuffers = nullptr,
+        TCtrProviderBuffers* ctrProviderBuffers = nullptr
     ) {
         const auto fullDocCount = end - start;
         auto result = *(cpuEvaluatorQuantizedData->QuantizedData);
@@ -343,13 +361,10 @@ namespace NCB::NModelEvaluation {
                     "Fail to apply with text features: TextProcessingCollection must present in FullModel"
                 );
 
-                TVector<TStringBuf> texts;
-                texts.yresize(docCount);
-
                 {
                     TVector<ui32> textFeatureIds;
-                    THashMap<ui32, ui32> textFeatureIdToFlatIndex;
-                    // TODO(d-kruchinin) Check out how index recalculation affects the speed
+                    // text feature index -> flat index, looked up for each document so not a hash map
+                    TVector<int> textFeatureFlatIndices;
                     for (const auto& textFeature : trees.GetTextFeatures()) {
                         if (!textFeature.UsedInModel()) {
                             continue;
@@ -359,22 +374,26 @@ namespace NCB::NModelEvaluation {
                             position = featureInfo->GetRemappedPosition(textFeature);
                         }
                         textFeatureIds.push_back(position.Index);
-                        textFeatureIdToFlatIndex[position.Index] = position.FlatIndex;
+                        if (textFeatureFlatIndices.size() <= size_t(position.Index)) {
+                            textFeatureFlatIndices.resize(position.Index + 1, -1);
+                        }
+                        textFeatureFlatIndices[position.Index] = position.FlatIndex;
                     }
 
                     textProcessingCollection->CalcFeatures(
-                        [start, &textFeatureAccessor, &textFeatureIdToFlatIndex](ui32 textFeatureId, ui32 docId) {
+                        [start, &textFeatureAccessor, &textFeatureFlatIndices](ui32 textFeatureId, ui32 docId) {
                             return textFeatureAccessor(
                                 TFeaturePosition{
                                     SafeIntegerCast<int>(textFeatureId),
-                                    SafeIntegerCast<int>(textFeatureIdToFlatIndex[textFeatureId])
+                                    textFeatureFlatIndices[textFeatureId]
                                 },
                                 start + docId
                             );
                         },
                         MakeConstArrayRef(textFeatureIds),
                         docCount,
-                        estimatedFeatures
+                        estimatedFeatures,
+                        textProcessingBuffers
                     );
                 }
 
@@ -398,13 +417,11 @@ namespace NCB::NModelEvaluation {
                 }
             }
             if (trees.GetUsedCatFeaturesCount() != 0) {
-                THashMap<int, int> catFeaturePackedIndexes;
                 int usedFeatureIdx = 0;
                 for (const auto& catFeature : trees.GetCatFeatures()) {
                     if (!catFeature.UsedInModel()) {
                         continue;
                     }
-                    catFeaturePackedIndexes[catFeature.Position.Index] = usedFeatureIdx;
                     TFeaturePosition position = catFeature.Position;
                     if (featureInfo) {
                         position = featureInfo->GetRemappedPosition(catFeature);
@@ -419,7 +436,7 @@ namespace NCB::NModelEvaluation {
                 Y_ASSERT(trees.GetUsedCatFeaturesCount() == (size_t)usedFeatureIdx);
                 OneHotBinsFromTransposedCatFeatures(
                     trees.GetOneHotFeatures(),
-                    catFeaturePackedIndexes,
+                    trees.GetCatFeatures(),
                     docCount,
                     transposedHash,
                     resultPtr
@@ -430,7 +447,8 @@ namespace NCB::NModelEvaluation {
                         TConstArrayRef<ui8>(resultPtrForBlockStart, docCount * trees.GetEffectiveBinaryFeaturesBucketsCount()),
                         transposedHash,
                         docCount,
-                        ctrs
+                        ctrs,
+                        ctrProviderBuffers
                     );
                 }
                 size_t ctrFloatsPosition = 0;
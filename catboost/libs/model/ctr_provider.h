@@ -17,6 +17,8 @@
 #include <algorithm>
 
 
+struct TCtrProviderBuffers;
+
 class ICtrProvider : public TThrRefBase {
 public:
     virtual ~ICtrProvider() {
@@ -29,7 +31,8 @@ public:
         const TConstArrayRef<ui8>& binarizedFeatures, // vector of binarized float & one hot features
         const TConstArrayRef<ui32>& hashedCatFeatures,
         size_t docCount,
-        TArrayRef<float> result) = 0;
+        TArrayRef<float> result,
+        TCtrProviderBuffers* buffers = nullptr) = 0;
 
     virtual void SetupBinFeatureIndexes(
         const TConstArrayRef<TFloatFeature> floatFeatures,
@@ -89,6 +92,22 @@ public:
     {}
 };
 
+/* Scratch buffers of ICtrProvider::CalcCtrs, they keep their capacity between calls
+ */
+struct TCtrProviderBuffers {
+    TVector<ui64> CtrHashes;
+    TVector<ui64> Buckets;
+    TVector<int> TransposedCatFeatureIndexes;
+    TVector<TBinFeatureIndexValue> BinarizedIndexes;
+
+    // used by TCachedCtrProvider
+    TVector<float> OtherCtrValues;
+    TVector<float> CachedCtrValues;
+    TVector<size_t> MissedDocs;
+    TVector<ui32> MissedHashes;
+    TVector<float> MissedValues;
+};
+
 inline void CalcHashes(
     const TConstArrayRef<ui8>& binarizedFeatures,
     const TConstArrayRef<ui32>& hashedCatFeatures,
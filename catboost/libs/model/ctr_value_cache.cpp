@@ -0,0 +1,53 @@
+#include "ctr_value_cache.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/utility.h>
+
+
+TCtrValueCache::TCtrValueCache(size_t maxEntryCount)
+    : MaxEntryCount(maxEntryCount)
+    , MaxShardEntryCount(Max<size_t>(1, maxEntryCount / ShardCount))
+{
+    CB_ENSURE(maxEntryCount > 0, "CTR value cache size should be positive");
+}
+
+bool TCtrValueCache::Find(ui32 catFeatureIdx, ui32 hash, TArrayRef<float> values) {
+    const ui64 key = GetKey(catFeatureIdx, hash);
+    auto& shard = GetShard(key);
+    with_lock(shard.Lock) {
+        const auto it = shard.Values.find(key);
+        if (it != shard.Values.end()) {
+            Y_ASSERT(it->second.size() == values.size());
+            Copy(it->second.begin(), it->second.end(), values.begin());
+            Hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    Misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void TCtrValueCache::Insert(ui32 catFeatureIdx, ui32 hash, TConstArrayRef<float> values) {
+    const ui64 key = GetKey(catFeatureIdx, hash);
+    auto& shard = GetShard(key);
+    with_lock(shard.Lock) {
+        if (shard.Values.size() >= MaxShardEntryCount) {
+            shard.Values.clear();
+        }
+        shard.Values[key].assign(values.begin(), values.end());
+    }
+}
+
+TCtrValueCacheStats TCtrValueCache::GetStats() const {
+    TCtrValueCacheStats stats;
+    stats.Hits = Hits.load(std::memory_order_relaxed);
+    stats.Misses = Misses.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void TCtrValueCache::ResetStats() {
+    Hits = 0;
+    Misses = 0;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <util/generic/array_ref.h>
+#include <util/generic/hash.h>
+#include <util/generic/ptr.h>
+#include <util/generic/vector.h>
+#include <util/system/spinlock.h>
+#include <util/system/types.h>
+
+#include <atomic>
+
+
+struct TCtrValueCacheStats {
+    ui64 Hits = 0;
+    ui64 Misses = 0;
+
+public:
+    double GetHitRate() const {
+        const ui64 total = Hits + Misses;
+        return total ? double(Hits) / total : 0.0;
+    }
+};
+
+/**
+ * Bounded thread-safe cache of CTR values for categorical feature values seen in previous requests.
+ * Key is (used categorical feature index, categorical value hash), value is a vector of all model CTRs that
+ *  depend only on this feature, so repeated values skip CTR hash calculation and CTR table lookups.
+ * The cache is split into shards with separate locks, a shard is cleared when it becomes full.
+ */
+class TCtrValueCache : public TThrRefBase {
+public:
+    explicit TCtrValueCache(size_t maxEntryCount);
+
+    size_t GetMaxEntryCount() const {
+        return MaxEntryCount;
+    }
+
+    // copies cached values to values and returns true if the key is found
+    bool Find(ui32 catFeatureIdx, ui32 hash, TArrayRef<float> values);
+    void Insert(ui32 catFeatureIdx, ui32 hash, TConstArrayRef<float> values);
+
+    TCtrValueCacheStats GetStats() const;
+    void ResetStats();
+
+private:
+    struct TShard {
+        TAdaptiveLock Lock;
+        THashMap<ui64, TVector<float>> Values;
+    };
+
+    static constexpr size_t ShardCount = 16;
+
+private:
+    static ui64 GetKey(ui32 catFeatureIdx, ui32 hash) {
+        return (ui64(catFeatureIdx) << 32) | hash;
+    }
+
+    TShard& GetShard(ui64 key) {
+        return Shards[IntHash(key) % ShardCount];
+    }
+
+private:
+    size_t MaxEntryCount;
+    size_t MaxShardEntryCount;
+    TShard Shards[ShardCount];
+    std::atomic<ui64> Hits = 0;
+    std::atomic<ui64> Misses = 0;
+};
@@ -88,6 +88,15 @@ public:
         }
     }
 
+    size_t GetDataSize() const {
+        return Visit(
+            [] (const auto& table) {
+                return table.IndexBuckets.size() * sizeof(NCatboost::TBucket) + table.CTRBlob.size();
+            },
+            Impl
+        );
+    }
+
     NCatboost::TDenseIndexHashBuilder GetIndexHashBuilder(size_t uniqueValuesCount) {
         auto& solid = Get<TSolidTable>(Impl);
         auto bucketCount = NCatboost::TDenseIndexHashBuilder::GetProperBucketsCount(uniqueValuesCount);
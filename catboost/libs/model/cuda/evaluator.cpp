@@ -193,6 +193,17 @@ namespace NCB::NModelEvaluation {
                 Ctx.EvalData(dataInput, treeStart, treeEnd, results, PredictionType);
             }
 
+            void CalcFlatWithEarlyExit(
+                TConstArrayRef<TConstArrayRef<float>>,
+                double,
+                size_t,
+                TArrayRef<double>,
+                TArrayRef<ui32>,
+                const TFeatureLayout*
+            ) const override {
+                CB_ENSURE(false, "Early exit evaluation is not supported on GPU");
+            }
+
             void CalcFlatSingle(
                 TConstArrayRef<float> features,
                 size_t treeStart,
@@ -0,0 +1,210 @@
+#include "ensemble_evaluator.h"
+
+#include "cpu/evaluator.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/hash.h>
+#include <util/generic/map.h>
+#include <util/generic/xrange.h>
+
+namespace NCB::NModelEvaluation {
+
+    static bool UsesOnlyFloatFeatures(const TModelTrees& trees) {
+        return AllOf(
+            trees.GetBinFeatures(),
+            [] (const TModelSplit& split) { return split.Type == ESplitType::FloatFeature; }
+        );
+    }
+
+    static TVector<TFloatFeature> GetUnionFloatFeatures(TConstArrayRef<const TModelTrees*> modelTrees) {
+        TMap<int, TFloatFeature> flatIndexToFeature;
+        for (const auto* trees : modelTrees) {
+            for (const auto& feature : trees->GetFloatFeatures()) {
+                auto [it, inserted] = flatIndexToFeature.emplace(feature.Position.FlatIndex, feature);
+                if (inserted) {
+                    continue;
+                }
+                auto& unionFeature = it->second;
+                CB_ENSURE(
+                    unionFeature.Position.Index == feature.Position.Index,
+                    "Internal feature index mismatch: " << unionFeature.Position.Index << " != "
+                    << feature.Position.Index << " flat feature index: " << feature.Position.FlatIndex
+                );
+                CB_ENSURE(
+                    unionFeature.NanValueTreatment == feature.NanValueTreatment,
+                    "Nan value treatment differs for flat feature index: " << feature.Position.FlatIndex
+                );
+                unionFeature.HasNans |= feature.HasNans;
+                unionFeature.Borders.insert(unionFeature.Borders.end(), feature.Borders.begin(), feature.Borders.end());
+            }
+        }
+        TVector<TFloatFeature> result;
+        result.reserve(flatIndexToFeature.size());
+        for (auto& [flatIndex, feature] : flatIndexToFeature) {
+            SortUnique(feature.Borders);
+            result.push_back(std::move(feature));
+        }
+        return result;
+    }
+
+    static TModelTrees RebaseOnFloatFeatures(
+        const TModelTrees& trees,
+        const TVector<TFloatFeature>& floatFeatures,
+        double leafMultiplier
+    ) {
+        // union bin features go in the same order as in TModelTrees::UpdateRuntimeData
+        THashMap<int, std::pair<const TFloatFeature*, size_t>> featureIndexToBinFeaturesStart;
+        size_t binFeatureCount = 0;
+        for (const auto& feature : floatFeatures) {
+            featureIndexToBinFeaturesStart[feature.Position.Index] = {&feature, binFeatureCount};
+            binFeatureCount += feature.Borders.size();
+        }
+        const auto& binFeatures = trees.GetBinFeatures();
+        TVector<int> binFeatureRemap(binFeatures.size());
+        for (auto binFeatureIdx : xrange(binFeatures.size())) {
+            const auto& split = binFeatures[binFeatureIdx].FloatFeature;
+            const auto [feature, featureStart] = featureIndexToBinFeaturesStart.at(split.FloatFeature);
+            const auto& borders = feature->Borders;
+            binFeatureRemap[binFeatureIdx] = featureStart
+                + (LowerBound(borders.begin(), borders.end(), split.Split) - borders.begin());
+        }
+
+        TModelTrees result;
+        result.SetApproxDimension(trees.GetDimensionsCount());
+        result.SetFloatFeatures(floatFeatures);
+        const auto treeSplits = trees.GetTreeSplits();
+        for (auto treeIdx : xrange(trees.GetTreeCount())) {
+            const auto treeStart = trees.GetTreeStartOffsets()[treeIdx];
+            TVector<int> remappedSplits;
+            remappedSplits.reserve(trees.GetTreeSizes()[treeIdx]);
+            for (auto splitIdx : xrange(treeStart, treeStart + trees.GetTreeSizes()[treeIdx])) {
+                remappedSplits.push_back(binFeatureRemap[treeSplits[splitIdx]]);
+            }
+            result.AddBinTree(remappedSplits);
+        }
+        if (!trees.IsOblivious()) {
+            result.SetNonSymmetricStepNodes(TVector<TNonSymmetricTreeStepNode>(
+                trees.GetNonSymmetricStepNodes().begin(),
+                trees.GetNonSymmetricStepNodes().end()));
+            result.SetNonSymmetricNodeIdToLeafId(TVector<ui32>(
+                trees.GetNonSymmetricNodeIdToLeafId().begin(),
+                trees.GetNonSymmetricNodeIdToLeafId().end()));
+        }
+        TVector<double> leafValues(trees.GetLeafValues().begin(), trees.GetLeafValues().end());
+        for (auto& value : leafValues) {
+            value *= leafMultiplier;
+        }
+        result.SetLeafValues(leafValues);
+        result.UpdateRuntimeData();
+        return result;
+    }
+
+    TEnsembleEvaluator::TEnsembleEvaluator(TConstArrayRef<const TFullModel*> models, TConstArrayRef<double> weights) {
+        CB_ENSURE(!models.empty(), "empty model vector unexpected");
+        CB_ENSURE(models.size() == weights.size(), "Models and weights count should be equal");
+        ApproxDimension = models[0]->GetDimensionsCount();
+
+        TVector<const TModelTrees*> sharedModelTrees;
+        TVector<double> sharedModelWeights;
+        for (auto modelIdx : xrange(models.size())) {
+            const auto* model = models[modelIdx];
+            CB_ENSURE(
+                model->GetDimensionsCount() == ApproxDimension,
+                "Approx dimensions don't match: " << model->GetDimensionsCount() << " != " << ApproxDimension
+            );
+            FlatFeatureVectorExpectedSize = Max(
+                FlatFeatureVectorExpectedSize,
+                model->ModelTrees->GetFlatFeatureVectorExpectedSize()
+            );
+            if (UsesOnlyFloatFeatures(*model->ModelTrees)) {
+                sharedModelTrees.push_back(model->ModelTrees.Get());
+                sharedModelWeights.push_back(weights[modelIdx]);
+            } else {
+                SeparatelyEvaluatedModels.emplace_back(model, weights[modelIdx]);
+            }
+        }
+        if (sharedModelTrees.empty()) {
+            return;
+        }
+        const auto unionFloatFeatures = GetUnionFloatFeatures(sharedModelTrees);
+        SharedBinarizationTrees.reserve(sharedModelTrees.size());
+        for (auto i : xrange(sharedModelTrees.size())) {
+            SharedBinarizationTrees.push_back(
+                RebaseOnFloatFeatures(*sharedModelTrees[i], unionFloatFeatures, sharedModelWeights[i]));
+        }
+    }
+
+    void TEnsembleEvaluator::CalcFlat(
+        TConstArrayRef<TConstArrayRef<float>> features,
+        TArrayRef<double> results
+    ) const {
+        const size_t docCount = features.size();
+        CB_ENSURE(
+            results.size() == docCount * ApproxDimension,
+            "Results size should be " << docCount * ApproxDimension << ", got " << results.size()
+        );
+        for (const auto& flatFeaturesVec : features) {
+            CB_ENSURE(
+                flatFeaturesVec.size() >= FlatFeatureVectorExpectedSize,
+                "insufficient flat features vector size: " << flatFeaturesVec.size()
+                << " expected: " << FlatFeatureVectorExpectedSize
+            );
+        }
+        Fill(results.begin(), results.end(), 0.0);
+        if (docCount == 0) {
+            return;
+        }
+
+        if (!SharedBinarizationTrees.empty()) {
+            const size_t blockSize = Min(FORMULA_EVALUATION_BLOCK_SIZE, docCount);
+            TVector<TTreeCalcFunction> calcTreesFunctions;
+            for (const auto& trees : SharedBinarizationTrees) {
+                calcTreesFunctions.push_back(GetCalcTreesFunction(trees, blockSize));
+            }
+            TVector<TCalcerIndexType> indexesVec(blockSize);
+            size_t blockStart = 0;
+            ProcessDocsInBlocks(
+                SharedBinarizationTrees[0],
+                TIntrusivePtr<ICtrProvider>(),
+                [&features](TFeaturePosition position, size_t index) -> float {
+                    return features[index][position.FlatIndex];
+                },
+                [](TFeaturePosition, size_t) -> int {
+                    CB_ENSURE_INTERNAL(false, "Shared binarization is used only for models without categorical features");
+                    return 0;
+                },
+                docCount,
+                blockSize,
+                [&] (size_t docCountInBlock, const TCPUEvaluatorQuantizedData* quantizedData) {
+                    double* blockResults = results.data() + blockStart * ApproxDimension;
+                    for (auto modelIdx : xrange(SharedBinarizationTrees.size())) {
+                        const auto& trees = SharedBinarizationTrees[modelIdx];
+                        calcTreesFunctions[modelIdx](
+                            trees,
+                            quantizedData,
+                            docCountInBlock,
+                            docCount == 1 ? nullptr : indexesVec.data(),
+                            0,
+                            trees.GetTreeCount(),
+                            blockResults
+                        );
+                    }
+                    blockStart += docCountInBlock;
+                },
+                nullptr
+            );
+        }
+
+        if (!SeparatelyEvaluatedModels.empty()) {
+            TVector<double> modelResults(results.size());
+            for (const auto& [model, weight] : SeparatelyEvaluatedModels) {
+                model->CalcFlat(features, modelResults);
+                for (auto i : xrange(results.size())) {
+                    results[i] += weight * modelResults[i];
+                }
+            }
+        }
+    }
+}
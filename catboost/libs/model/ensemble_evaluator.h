@@ -0,0 +1,54 @@
+#pragma once
+
+#include "model.h"
+
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+
+#include <utility>
+
+namespace NCB::NModelEvaluation {
+
+    /**
+     * Evaluates a weighted sum of models without building a summed model.
+     * Models that use only float features are rebased on the union of their borders, so documents are
+     * binarized once for all of them and every model's trees are applied to the same quantized block.
+     * Models with categorical or text features are evaluated separately by their own evaluators.
+     * Results are raw formula values.
+     */
+    class TEnsembleEvaluator {
+    public:
+        TEnsembleEvaluator(TConstArrayRef<const TFullModel*> models, TConstArrayRef<double> weights);
+
+        size_t GetApproxDimension() const {
+            return ApproxDimension;
+        }
+
+        size_t GetFlatFeatureVectorExpectedSize() const {
+            return FlatFeatureVectorExpectedSize;
+        }
+
+        // models evaluated with the shared binarization pass
+        size_t GetSharedBinarizationModelCount() const {
+            return SharedBinarizationTrees.size();
+        }
+
+        /**
+         * @param[in] features flat features array reference. First dimension is object index, second dimension is
+         *  feature index.
+         * @param[out] results raw formula values, docCount * approxDimension
+         */
+        void CalcFlat(TConstArrayRef<TConstArrayRef<float>> features, TArrayRef<double> results) const;
+
+        void CalcFlat(TConstArrayRef<TVector<float>> features, TArrayRef<double> results) const {
+            TVector<TConstArrayRef<float>> featureRefs{features.begin(), features.end()};
+            CalcFlat(featureRefs, results);
+        }
+
+    private:
+        size_t ApproxDimension = 0;
+        size_t FlatFeatureVectorExpectedSize = 0;
+        TVector<TModelTrees> SharedBinarizationTrees; // trees with union borders and leaf values scaled by weight
+        TVector<std::pair<const TFullModel*, double>> SeparatelyEvaluatedModels;
+    };
+}
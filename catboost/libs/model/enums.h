@@ -26,3 +26,13 @@ enum class EModelType {
     Pmml           /* "PMML", "pmml" */,
     CPUSnapshot    /* "CpuSnapshot" */
 };
+
+/**
+ * Precision of leaf values stored in the model file and used by the CPU evaluator.
+ * Predictions are always accumulated in double.
+ */
+enum class ELeafValuesPrecision {
+    Double  /* "Double", "double" */,
+    Float32 /* "Float32", "float32", "Float" */,
+    Float16 /* "Float16", "float16", "Half" */
+};
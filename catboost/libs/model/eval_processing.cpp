@@ -7,7 +7,8 @@ NCB::NModelEvaluation::TEvalResultProcessor::TEvalResultProcessor(
     TArrayRef<double> results,
     NCB::NModelEvaluation::EPredictionType predictionType,
     ui32 approxDimension, ui32 blockSize,
-    TMaybe<double> binclassProbabilityBorder
+    TMaybe<double> binclassProbabilityBorder,
+    TVector<double>* intermediateBlockResultsBuffer
 )
     : Results(results)
     , PredictionType(predictionType)
@@ -20,7 +21,11 @@ NCB::NModelEvaluation::TEvalResultProcessor::TEvalResultProcessor(
         "`results` size is insufficient: " << LabeledOutput(Results.size(), resultApproxDimension, docCount * resultApproxDimension)
     );
     if (approxDimension > 1 && predictionType == EPredictionType::Class) {
-        IntermediateBlockResults.resize(blockSize * approxDimension);
+        if (!intermediateBlockResultsBuffer) {
+            intermediateBlockResultsBuffer = &LocalIntermediateBlockResults;
+        }
+        intermediateBlockResultsBuffer->yresize(blockSize * approxDimension);
+        IntermediateBlockResults = *intermediateBlockResultsBuffer;
     }
     if (binclassProbabilityBorder.Defined() && predictionType == EPredictionType::Class &&
         approxDimension == 1) {
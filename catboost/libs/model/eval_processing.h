@@ -63,7 +63,8 @@ namespace NCB::NModelEvaluation {
             EPredictionType predictionType,
             ui32 approxDimension,
             ui32 blockSize,
-            TMaybe<double> binclassProbabilityBorder = Nothing());
+            TMaybe<double> binclassProbabilityBorder = Nothing(),
+            TVector<double>* intermediateBlockResultsBuffer = nullptr);
 
         inline TArrayRef<double> GetResultBlockView(ui32 blockId, ui32 dimension) {
             return Results.Slice(
@@ -77,6 +78,8 @@ namespace NCB::NModelEvaluation {
 
         inline TArrayRef<double> GetViewForRawEvaluation(ui32 blockId) {
             if (!IntermediateBlockResults.empty()) {
+                // raw values are accumulated, so the buffer is cleared for each block
+                Fill(IntermediateBlockResults.begin(), IntermediateBlockResults.end(), 0.0);
                 return IntermediateBlockResults;
             }
             return GetResultBlockView(blockId, ApproxDimension);
@@ -120,7 +123,8 @@ namespace NCB::NModelEvaluation {
         ui32 ApproxDimension;
         ui32 BlockSize;
 
-        TVector<double> IntermediateBlockResults;
+        TVector<double> LocalIntermediateBlockResults;
+        TArrayRef<double> IntermediateBlockResults;
 
         double BinclassRawValueBorder = 0.0;
     };
@@ -53,6 +53,11 @@ namespace NCB {  // split due to CUDA-compiler inability to parse nested namespa
             }
         };
 
+        /* CPU evaluator property: "true" makes the evaluator keep block scratch buffers between calls.
+         * Such evaluator can't be used from several threads at once, use a clone per thread.
+         */
+        constexpr TStringBuf ReuseBuffersPropertyName = AsStringBuf("ReuseBuffers");
+
         class IModelEvaluator {
         public:
             virtual ~IModelEvaluator() = default;
@@ -133,6 +138,24 @@ namespace NCB {  // split due to CUDA-compiler inability to parse nested namespa
                 CalcFlat(featureRefs, 0, GetTreeCount(), results, featureInfo);
             }
 
+            /* Staged evaluation for threshold decisions of single dimension models. Trees are evaluated in
+             * chunks of treeChunkSize trees, an object is not evaluated further once the minimal and maximal
+             * possible sums of leaf values of the remaining trees can't move its raw formula value across
+             * rawThreshold.
+             * results: exact raw formula value for objects evaluated on all trees, otherwise the bound of the
+             *  final raw value nearest to rawThreshold, it is on the same side of rawThreshold as the final
+             *  value (up to floating point rounding of the sums).
+             * evaluatedTreeCounts: optional, count of trees evaluated for each object.
+             */
+            virtual void CalcFlatWithEarlyExit(
+                TConstArrayRef<TConstArrayRef<float>> features,
+                double rawThreshold,
+                size_t treeChunkSize,
+                TArrayRef<double> results,
+                TArrayRef<ui32> evaluatedTreeCounts,
+                const TFeatureLayout* featureInfo = nullptr
+            ) const = 0;
+
             virtual void CalcFlatSingle(
                 TConstArrayRef<float> features,
                 size_t treeStart,
@@ -5,6 +5,7 @@
 #include "model_build_helper.h"
 #include "static_ctr_provider.h"
 
+#include <catboost/libs/model/flatbuffers/ctr_data.fbs.h>
 #include <catboost/libs/model/flatbuffers/model.fbs.h>
 
 #include <catboost/libs/cat_feature/cat_feature.h>
@@ -18,15 +19,23 @@
 #include <library/json/json_reader.h>
 #include <library/dbg_output/dump.h>
 #include <library/dbg_output/auto.h>
+#include <library/float16/float16.h>
 
 #include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
 #include <util/generic/fwd.h>
 #include <util/generic/guid.h>
+#include <util/generic/maybe.h>
 #include <util/generic/variant.h>
 #include <util/generic/xrange.h>
 #include <util/generic/ylimits.h>
 #include <util/string/builder.h>
+#include <util/stream/file.h>
+#include <util/stream/length.h>
 #include <util/stream/str.h>
+#include <util/system/file.h>
+
+#include <cmath>
 
 
 static const char MODEL_FILE_DESCRIPTOR_CHARS[4] = {'C', 'B', 'M', '1'};
@@ -173,6 +182,135 @@ void TModelTrees::TruncateTrees(size_t begin, size_t end) {
     builder.Build(this);
 }
 
+void TModelTrees::ReorderTrees(TConstArrayRef<ui32> treeOrder, bool keepSummationOrder) {
+    CB_ENSURE(IsOblivious(), "Reordering supports only symmetric trees");
+    CB_ENSURE(treeOrder.size() == TreeSizes.size(), "Tree order size should be equal to tree count");
+    const auto& leafOffsets = GetFirstLeafOffsets();
+    TVector<bool> isPlaced(TreeSizes.size(), false);
+    TVector<int> treeSplits;
+    TVector<int> treeSizes;
+    TVector<int> treeStartOffsets;
+    TVector<double> leafValues;
+    TVector<double> leafWeights;
+    treeSplits.reserve(TreeSplits.size());
+    leafValues.reserve(LeafValues.size());
+    leafWeights.reserve(LeafWeights.size());
+    for (ui32 treeIdx : treeOrder) {
+        CB_ENSURE(treeIdx < TreeSizes.size() && !isPlaced[treeIdx], "Tree order should be a permutation");
+        isPlaced[treeIdx] = true;
+        const auto splitsBegin = TreeSplits.begin() + TreeStartOffsets[treeIdx];
+        treeStartOffsets.push_back(treeSplits.size());
+        treeSizes.push_back(TreeSizes[treeIdx]);
+        treeSplits.insert(treeSplits.end(), splitsBegin, splitsBegin + TreeSizes[treeIdx]);
+        const size_t leafCount = 1u << TreeSizes[treeIdx];
+        const auto leafValuesBegin = LeafValues.begin() + leafOffsets[treeIdx];
+        leafValues.insert(leafValues.end(), leafValuesBegin, leafValuesBegin + leafCount * ApproxDimension);
+        if (!LeafWeights.empty()) {
+            const auto leafWeightsBegin = LeafWeights.begin() + leafOffsets[treeIdx] / ApproxDimension;
+            leafWeights.insert(leafWeights.end(), leafWeightsBegin, leafWeightsBegin + leafCount);
+        }
+    }
+    if (keepSummationOrder) {
+        TVector<ui32> newTreeIndexes(treeOrder.size());
+        for (auto newTreeIdx : xrange<ui32>(treeOrder.size())) {
+            newTreeIndexes[treeOrder[newTreeIdx]] = newTreeIdx;
+        }
+        if (TreeSummationOrder.empty()) {
+            TreeSummationOrder = std::move(newTreeIndexes);
+        } else {
+            for (auto& treeIdx : TreeSummationOrder) {
+                treeIdx = newTreeIndexes[treeIdx];
+            }
+        }
+        if (IsSorted(TreeSummationOrder.begin(), TreeSummationOrder.end())) {
+            TreeSummationOrder.clear();
+        }
+    } else {
+        TreeSummationOrder.clear();
+    }
+    TreeSplits = std::move(treeSplits);
+    TreeSizes = std::move(treeSizes);
+    TreeStartOffsets = std::move(treeStartOffsets);
+    LeafValues = std::move(leafValues);
+    LeafWeights = std::move(leafWeights);
+    UpdateRuntimeData();
+}
+
+// the blocked evaluator gathers leafs of 4 consecutive trees at once
+static constexpr size_t FeatureLocalityTreeWindow = 4;
+
+TVector<ui32> TModelTrees::CalcFeatureLocalityTreeOrder(size_t lookahead) const {
+    CB_ENSURE(IsOblivious(), "Reordering supports only symmetric trees");
+    const auto& repackedBins = GetRepackedBins();
+    const size_t treeCount = TreeSizes.size();
+    TVector<TVector<ui32>> treeBuckets(treeCount);
+    for (size_t treeIdx = 0; treeIdx < treeCount; ++treeIdx) {
+        for (int splitIdx = TreeStartOffsets[treeIdx]; splitIdx < TreeStartOffsets[treeIdx] + TreeSizes[treeIdx]; ++splitIdx) {
+            treeBuckets[treeIdx].push_back(repackedBins[splitIdx].FeatureIndex);
+        }
+        SortUnique(treeBuckets[treeIdx]);
+    }
+
+    // position in the new order of the last tree that reads the bucket
+    TVector<size_t> bucketLastUse(GetEffectiveBinaryFeaturesBucketsCount(), Max<size_t>());
+    auto calcSharedBuckets = [&] (ui32 treeIdx, size_t position) {
+        size_t sharedCount = 0;
+        for (ui32 bucket : treeBuckets[treeIdx]) {
+            sharedCount += bucketLastUse[bucket] != Max<size_t>()
+                && position - bucketLastUse[bucket] <= FeatureLocalityTreeWindow;
+        }
+        return sharedCount;
+    };
+
+    TVector<ui32> pendingTrees = xrange<ui32>(treeCount);
+    TVector<ui32> treeOrder;
+    treeOrder.reserve(treeCount);
+    for (size_t position = 0; position < treeCount; ++position) {
+        size_t bestIdx = 0;
+        size_t bestSharedCount = calcSharedBuckets(pendingTrees[0], position);
+        const size_t candidateCount = Min(Max<size_t>(lookahead, 1), pendingTrees.size());
+        for (size_t candidateIdx = 1; candidateIdx < candidateCount; ++candidateIdx) {
+            const size_t sharedCount = calcSharedBuckets(pendingTrees[candidateIdx], position);
+            if (sharedCount > bestSharedCount) {
+                bestIdx = candidateIdx;
+                bestSharedCount = sharedCount;
+            }
+        }
+        const ui32 treeIdx = pendingTrees[bestIdx];
+        pendingTrees.erase(pendingTrees.begin() + bestIdx);
+        treeOrder.push_back(treeIdx);
+        for (ui32 bucket : treeBuckets[treeIdx]) {
+            bucketLastUse[bucket] = position;
+        }
+    }
+    return treeOrder;
+}
+
+static constexpr int HalfLeafValuesMaxExponent = 15;
+
+// power of 2 such that max absolute leaf value divided by it is in [2^14, 2^15)
+static double CalcLeafValuesHalfScale(TConstArrayRef<double> leafValues) {
+    double maxAbsValue = 0.0;
+    for (double value : leafValues) {
+        maxAbsValue = Max(maxAbsValue, Abs(value));
+    }
+    CB_ENSURE(std::isfinite(maxAbsValue), "Leaf values should be finite to be stored with half precision");
+    if (maxAbsValue == 0.0) {
+        return 1.0;
+    }
+    int exponent = 0;
+    std::frexp(maxAbsValue, &exponent);
+    return std::ldexp(1.0, exponent - HalfLeafValuesMaxExponent);
+}
+
+static TFloat16 PackHalfLeafValue(double value, double scale) {
+    return TFloat16(static_cast<float>(value / scale));
+}
+
+static double UnpackHalfLeafValue(TFloat16 value, double scale) {
+    return static_cast<double>(value.AsFloat()) * scale;
+}
+
 flatbuffers::Offset<NCatBoostFbs::TModelTrees>
 TModelTrees::FBSerialize(TModelPartsCachingSerializer& serializer) const {
     std::vector<flatbuffers::Offset<NCatBoostFbs::TCatFeature>> catFeaturesOffsets;
@@ -207,6 +345,21 @@ TModelTrees::FBSerialize(TModelPartsCachingSerializer& serializer) const {
             nonSymmetricStep.RightSubtreeDiff
         });
     }
+    TVector<float> leafValuesFloat;
+    TVector<ui16> leafValuesHalf;
+    if (LeafValuesPrecision == ELeafValuesPrecision::Float32) {
+        leafValuesFloat.assign(LeafValues.begin(), LeafValues.end());
+    } else if (LeafValuesPrecision == ELeafValuesPrecision::Float16) {
+        leafValuesHalf.reserve(LeafValues.size());
+        for (double value : LeafValues) {
+            CB_ENSURE(
+                Abs(value) < std::ldexp(LeafValuesHalfScale, HalfLeafValuesMaxExponent + 1),
+                "Leaf values were changed after SetLeafValuesPrecision and don't fit half precision"
+            );
+            leafValuesHalf.push_back(PackHalfLeafValue(value, LeafValuesHalfScale).Save());
+        }
+    }
+    const bool isDoublePrecision = LeafValuesPrecision == ELeafValuesPrecision::Double;
     return NCatBoostFbs::CreateTModelTreesDirect(
         serializer.FlatbufBuilder,
         ApproxDimension,
@@ -217,15 +370,40 @@ TModelTrees::FBSerialize(TModelPartsCachingSerializer& serializer) const {
         &floatFeaturesOffsets,
         &oneHotFeaturesOffsets,
         &ctrFeaturesOffsets,
-        &LeafValues,
+        isDoublePrecision ? &LeafValues : nullptr,
         &LeafWeights,
         &fbsNonSymmetricTreeStepNode,
         &NonSymmetricNodeIdToLeafId,
         &textFeaturesOffsets,
-        &estimatedFeaturesOffsets
+        &estimatedFeaturesOffsets,
+        LeafValuesPrecision == ELeafValuesPrecision::Float32 ? &leafValuesFloat : nullptr,
+        LeafValuesPrecision == ELeafValuesPrecision::Float16 ? &leafValuesHalf : nullptr,
+        LeafValuesHalfScale,
+        TreeSummationOrder.empty() ? nullptr : &TreeSummationOrder
     );
 }
 
+void TModelTrees::SetLeafValuesPrecision(ELeafValuesPrecision precision) {
+    LeafValuesPrecision = precision;
+    LeafValuesHalfScale = 1.0;
+    switch (precision) {
+        case ELeafValuesPrecision::Double:
+            break;
+        case ELeafValuesPrecision::Float32:
+            for (auto& value : LeafValues) {
+                value = static_cast<float>(value);
+            }
+            break;
+        case ELeafValuesPrecision::Float16:
+            LeafValuesHalfScale = CalcLeafValuesHalfScale(LeafValues);
+            for (auto& value : LeafValues) {
+                value = UnpackHalfLeafValue(PackHalfLeafValue(value, LeafValuesHalfScale), LeafValuesHalfScale);
+            }
+            break;
+    }
+    UpdateRuntimeData();
+}
+
 void TModelTrees::UpdateRuntimeData() const {
     struct TFeatureSplitId {
         ui32 FeatureIdx = 0;
@@ -372,6 +550,9 @@ void TModelTrees::UpdateRuntimeData() const {
         }
         ref.RepackedBins.push_back(rb);
     }
+    if (LeafValuesPrecision != ELeafValuesPrecision::Double) {
+        ref.FloatLeafValues.assign(LeafValues.begin(), LeafValues.end());
+    }
 }
 
 void TModelTrees::DropUnusedFeatures() {
@@ -416,6 +597,7 @@ void TModelTrees::ConvertObliviousToAsymmetric() {
     TreeSplits = std::move(treeSplits);
     TreeSizes = std::move(treeSizes);
     TreeStartOffsets = std::move(treeStartOffsets);
+    TreeSummationOrder.clear();
     NonSymmetricStepNodes = std::move(nonSymmetricStepNodes);
     NonSymmetricNodeIdToLeafId = std::move(nonSymmetricNodeIdToLeafId);
     UpdateRuntimeData();
@@ -449,6 +631,11 @@ void TModelTrees::AddNumberToAllTreeLeafValues(ui32 treeId, double numberToAdd)
     for (ui32 i = begin; i < end; ++i) {
         LeafValues[i] += numberToAdd;
     }
+    if (LeafValuesPrecision != ELeafValuesPrecision::Double) {
+        for (ui32 i = begin; i < end; ++i) {
+            RuntimeData->FloatLeafValues[i] = LeafValues[i];
+        }
+    }
 }
 
 void TModelTrees::FBDeserialize(const NCatBoostFbs::TModelTrees* fbObj) {
@@ -466,6 +653,26 @@ void TModelTrees::FBDeserialize(const NCatBoostFbs::TModelTrees* fbObj) {
     if (fbObj->LeafValues()) {
         LeafValues.assign(fbObj->LeafValues()->begin(), fbObj->LeafValues()->end());
     }
+    if (fbObj->LeafValuesFloat()) {
+        LeafValuesPrecision = ELeafValuesPrecision::Float32;
+        LeafValues.assign(fbObj->LeafValuesFloat()->begin(), fbObj->LeafValuesFloat()->end());
+    } else if (fbObj->LeafValuesHalf()) {
+        LeafValuesPrecision = ELeafValuesPrecision::Float16;
+        LeafValuesHalfScale = fbObj->LeafValuesHalfScale();
+        LeafValues.clear();
+        LeafValues.reserve(fbObj->LeafValuesHalf()->size());
+        for (ui16 value : *fbObj->LeafValuesHalf()) {
+            LeafValues.push_back(UnpackHalfLeafValue(TFloat16::Load(value), LeafValuesHalfScale));
+        }
+    }
+    if (fbObj->TreeSummationOrder()) {
+        TreeSummationOrder.assign(fbObj->TreeSummationOrder()->begin(), fbObj->TreeSummationOrder()->end());
+        CB_ENSURE(
+            TreeSummationOrder.size() == TreeSizes.size()
+                && AllOf(TreeSummationOrder, [&] (ui32 treeIdx) { return treeIdx < TreeSizes.size(); }),
+            "Tree summation order should be a permutation of trees"
+        );
+    }
     if (fbObj->NonSymmetricStepNodes()) {
         NonSymmetricStepNodes.resize(fbObj->NonSymmetricStepNodes()->size());
         std::copy(
@@ -508,6 +715,22 @@ void TFullModel::CalcFlat(
     GetCurrentEvaluator()->CalcFlat(features, treeStart, treeEnd, results, featureInfo);
 }
 
+void TFullModel::CalcFlatWithEarlyExit(
+    TConstArrayRef<TConstArrayRef<float>> features,
+    double rawThreshold,
+    size_t treeChunkSize,
+    TArrayRef<double> results,
+    TArrayRef<ui32> evaluatedTreeCounts,
+    const TFeatureLayout* featureInfo) const {
+    GetCurrentEvaluator()->CalcFlatWithEarlyExit(
+        features,
+        rawThreshold,
+        treeChunkSize,
+        results,
+        evaluatedTreeCounts,
+        featureInfo);
+}
+
 void TFullModel::CalcFlatSingle(
     TConstArrayRef<float> features,
     size_t treeStart,
@@ -632,7 +855,8 @@ void TFullModel::Save(IOutputStream* s) const {
     }
 }
 
-void TFullModel::Load(IInputStream* s) {
+// loads everything except model parts, returns ids of the parts that follow the core in the stream
+static TVector<TString> LoadModelCore(IInputStream* s, TFullModel* model) {
     using namespace flatbuffers;
     using namespace NCatBoostFbs;
     ui32 fileDescriptor;
@@ -652,12 +876,12 @@ void TFullModel::Load(IInputStream* s) {
         "Unsupported model format: " << fbModelCore->FormatVersion()->str()
     );
     if (fbModelCore->ModelTrees()) {
-        ModelTrees.GetMutable()->FBDeserialize(fbModelCore->ModelTrees());
+        model->ModelTrees.GetMutable()->FBDeserialize(fbModelCore->ModelTrees());
     }
-    ModelInfo.clear();
+    model->ModelInfo.clear();
     if (fbModelCore->InfoMap()) {
         for (auto keyVal : *fbModelCore->InfoMap()) {
-            ModelInfo[keyVal->Key()->str()] = keyVal->Value()->str();
+            model->ModelInfo[keyVal->Key()->str()] = keyVal->Value()->str();
         }
     }
     TVector<TString> modelParts;
@@ -666,6 +890,11 @@ void TFullModel::Load(IInputStream* s) {
             modelParts.emplace_back(part->str());
         }
     }
+    return modelParts;
+}
+
+void TFullModel::Load(IInputStream* s) {
+    const TVector<TString> modelParts = LoadModelCore(s, this);
     if (!modelParts.empty()) {
         for (const auto& modelPartId : modelParts) {
             if (modelPartId == TStaticCtrProvider::ModelPartId()) {
@@ -696,6 +925,10 @@ void TFullModel::UpdateDynamicData() {
     }
     with_lock(CurrentEvaluatorLock) {
         Evaluator.Reset();
+        // cached values depend on model CTRs, and copies of the model share the cache object
+        if (CtrValueCache) {
+            CtrValueCache = MakeIntrusive<TCtrValueCache>(CtrValueCache->GetMaxEntryCount());
+        }
     }
 }
 
@@ -1057,6 +1290,143 @@ TFullModel SumModels(
     return result;
 }
 
+namespace {
+    struct TCtrTableLocation {
+        i64 Offset = 0;
+        ui32 Size = 0;
+    };
+}
+
+/* Loads the model without ctr tables, for every static ctr table only its ctr base
+ * and position in the file are read.
+ */
+static TFullModel LoadModelWithoutCtrTables(
+    const TString& modelPath,
+    THashMap<TModelCtrBase, TCtrTableLocation>* ctrTableLocations)
+{
+    TIFStream fileInput(modelPath);
+    TCountingInput input(&fileInput);
+    TFullModel model;
+    const TVector<TString> modelParts = LoadModelCore(&input, &model);
+    for (const auto& modelPartId : modelParts) {
+        if (modelPartId == TStaticCtrProvider::ModelPartId()) {
+            const size_t ctrTableCount = ::LoadSize(&input);
+            TVector<ui8> ctrTableData;
+            for (auto i : xrange(ctrTableCount)) {
+                Y_UNUSED(i);
+                TCtrTableLocation location;
+                location.Size = ::LoadSize(&input);
+                location.Offset = SafeIntegerCast<i64>(input.Counter());
+                ctrTableData.yresize(location.Size);
+                input.LoadOrFail(ctrTableData.data(), location.Size);
+                TModelCtrBase ctrBase;
+                ctrBase.FBDeserialize(
+                    flatbuffers::GetRoot<NCatBoostFbs::TCtrValueTable>(ctrTableData.data())->ModelCtrBase()
+                );
+                ctrTableLocations->emplace(ctrBase, location);
+            }
+        } else if (modelPartId == NCB::TTextProcessingCollection::GetStringIdentifier()) {
+            model.TextProcessingCollection = new NCB::TTextProcessingCollection();
+            model.TextProcessingCollection->Load(&input);
+        } else {
+            CB_ENSURE(false, "Got unknown partId = " << modelPartId << " via deserialization");
+        }
+    }
+    model.UpdateDynamicData();
+    return model;
+}
+
+TFullModel SumModelsFromFiles(
+    const TVector<TString>& modelPaths,
+    const TVector<double>& weights,
+    ECtrTableMergePolicy ctrMergePolicy,
+    ui64 ctrTablesBatchMemoryLimit)
+{
+    CB_ENSURE(!modelPaths.empty(), "empty model vector unexpected");
+    CB_ENSURE(modelPaths.size() == weights.size());
+
+    // models are parsed once without ctr tables, only positions of the tables in files are kept
+    TVector<TFullModel> models(modelPaths.size());
+    TVector<THashMap<TModelCtrBase, TCtrTableLocation>> ctrTableLocations(modelPaths.size());
+    TVector<TModelCtrBase> ctrBases;
+    THashMap<TModelCtrBase, ui64> ctrTablesDataSize;
+    for (auto modelIdx : xrange(modelPaths.size())) {
+        models[modelIdx] = LoadModelWithoutCtrTables(modelPaths[modelIdx], &ctrTableLocations[modelIdx]);
+        for (const auto& [ctrBase, location] : ctrTableLocations[modelIdx]) {
+            auto [it, inserted] = ctrTablesDataSize.emplace(ctrBase, 0);
+            if (inserted) {
+                ctrBases.push_back(ctrBase);
+            }
+            it->second += location.Size;
+        }
+    }
+    // batches do not depend on the hash map iteration order
+    Sort(ctrBases);
+    TVector<const TFullModel*> modelPtrs;
+    for (const auto& model : models) {
+        modelPtrs.push_back(&model);
+    }
+    TFullModel result = SumModels(modelPtrs, weights, ctrMergePolicy);
+    if (ctrBases.empty()) {
+        return result;
+    }
+
+    /* Ctr tables are merged in batches of ctr bases: only tables of the current batch are read from
+     * the files, so at most ctrTablesBatchMemoryLimit bytes of source tables (or tables of a single
+     * ctr base if they are larger) are held in memory at once.
+     */
+    TIntrusivePtr<TStaticCtrProvider> resultCtrProvider = new TStaticCtrProvider();
+    TVector<ui8> ctrTableData;
+    for (size_t batchBegin = 0; batchBegin < ctrBases.size();) {
+        size_t batchEnd = batchBegin + 1;
+        ui64 batchDataSize = ctrTablesDataSize.at(ctrBases[batchBegin]);
+        while (batchEnd < ctrBases.size()
+            && batchDataSize + ctrTablesDataSize.at(ctrBases[batchEnd]) <= ctrTablesBatchMemoryLimit)
+        {
+            batchDataSize += ctrTablesDataSize.at(ctrBases[batchEnd]);
+            ++batchEnd;
+        }
+
+        TVector<TIntrusivePtr<TStaticCtrProvider>> batchProviders;
+        for (auto modelIdx : xrange(modelPaths.size())) {
+            TMaybe<TFile> modelFile;
+            TIntrusivePtr<TStaticCtrProvider> batchProvider;
+            for (auto ctrBaseIdx : xrange(batchBegin, batchEnd)) {
+                const auto& ctrBase = ctrBases[ctrBaseIdx];
+                const auto locationIt = ctrTableLocations[modelIdx].find(ctrBase);
+                if (locationIt == ctrTableLocations[modelIdx].end()) {
+                    continue;
+                }
+                if (!modelFile) {
+                    modelFile.ConstructInPlace(modelPaths[modelIdx], OpenExisting | RdOnly);
+                    batchProvider = new TStaticCtrProvider();
+                }
+                const auto& location = locationIt->second;
+                ctrTableData.yresize(location.Size);
+                modelFile->Pload(ctrTableData.data(), location.Size, location.Offset);
+                TCtrValueTable ctrValueTable;
+                ctrValueTable.LoadSolid(ctrTableData.data(), location.Size);
+                batchProvider->CtrData.LearnCtrs[ctrBase] = std::move(ctrValueTable);
+            }
+            if (batchProvider) {
+                batchProviders.push_back(std::move(batchProvider));
+            }
+        }
+        TVector<const TStaticCtrProvider*> batchProviderPtrs;
+        for (const auto& provider : batchProviders) {
+            batchProviderPtrs.push_back(provider.Get());
+        }
+        auto mergedBatch = MergeStaticCtrProvidersData(batchProviderPtrs, ctrMergePolicy);
+        for (auto& [ctrBase, ctrValueTable] : mergedBatch->CtrData.LearnCtrs) {
+            resultCtrProvider->CtrData.LearnCtrs[ctrBase] = std::move(ctrValueTable);
+        }
+        batchBegin = batchEnd;
+    }
+    result.CtrProvider = resultCtrProvider;
+    result.UpdateDynamicData();
+    return result;
+}
+
 void SaveModelBorders(
     const TString& file,
     const TFullModel& model) {
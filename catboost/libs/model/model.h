@@ -2,6 +2,7 @@
 
 #include "fwd.h"
 #include "ctr_provider.h"
+#include "ctr_value_cache.h"
 #include "evaluation_interface.h"
 #include "features.h"
 #include "online_ctr.h"
@@ -122,6 +123,9 @@ public:
 
         //! Offset of first tree leaf in flat tree leafs array
         TVector<size_t> TreeFirstLeafOffsets;
+
+        //! Leaf values gathered by the evaluator if LeafValuesPrecision is not Double, same layout as LeafValues
+        TVector<float> FloatLeafValues;
     };
 
 public:
@@ -134,6 +138,9 @@ public:
             NonSymmetricStepNodes,
             NonSymmetricNodeIdToLeafId,
             LeafValues,
+            LeafValuesPrecision,
+            LeafValuesHalfScale,
+            TreeSummationOrder,
             CatFeatures,
             FloatFeatures,
             TextFeatures,
@@ -148,6 +155,9 @@ public:
             other.NonSymmetricStepNodes,
             other.NonSymmetricNodeIdToLeafId,
             other.LeafValues,
+            other.LeafValuesPrecision,
+            other.LeafValuesHalfScale,
+            other.TreeSummationOrder,
             other.CatFeatures,
             other.FloatFeatures,
             other.TextFeatures,
@@ -272,6 +282,25 @@ public:
         LeafWeights.clear();
     }
 
+    ELeafValuesPrecision GetLeafValuesPrecision() const {
+        return LeafValuesPrecision;
+    }
+
+    /**
+     * Store leaf values in the model file with reduced precision and use float32 leaf values in the CPU
+     *  evaluator. Leaf values are rounded right away, so the model predicts the same before and after
+     *  save/load. Call it after all modifications of leaf values.
+     *
+     * Rounding error of a single leaf value v:
+     *   Float32: |v| * 2^-24
+     *   Float16: max(|v|, 2^-14 * scale) * 2^-10, where scale is a power of 2 chosen so that the maximal
+     *            absolute leaf value divided by scale lies in [2^14, 2^15)
+     * Prediction error is bounded by the sum over trees of the maximal rounding error of the tree leafs,
+     *  predictions are accumulated in double.
+     * Models saved with reduced precision can't be loaded by catboost versions that don't support it.
+     */
+    void SetLeafValuesPrecision(ELeafValuesPrecision precision);
+
     void SetNonSymmetricStepNodes(const TVector<TNonSymmetricTreeStepNode>& nonSymmetricStepNodes) {
         NonSymmetricStepNodes = nonSymmetricStepNodes;
     }
@@ -368,6 +397,38 @@ public:
      */
     void TruncateTrees(size_t begin, size_t end);
 
+    /**
+     * Reorder oblivious trees, treeOrder[i] is the current index of the tree that becomes i-th.
+     * If keepSummationOrder is set, the CPU evaluator still adds leaf values in the tree order before the
+     *  call, so predictions on the whole tree range are bit-identical to the model before reordering.
+     *  Otherwise leaf values are added in the new tree order.
+     */
+    void ReorderTrees(TConstArrayRef<ui32> treeOrder, bool keepSummationOrder = false);
+
+    /**
+     * Greedy tree order in which each tree shares as many quantized feature buckets as possible with
+     *  the trees evaluated right before it, so that the evaluator reads the same quantized columns
+     *  while they are still in cache. Next tree is chosen among the first lookahead not yet placed trees
+     *  in the current order, ties keep the current order.
+     */
+    TVector<ui32> CalcFeatureLocalityTreeOrder(size_t lookahead = 256) const;
+
+    /**
+     * Reorder trees by CalcFeatureLocalityTreeOrder. Unless keepSummationOrder is set, leaf values are summed
+     *  in the new tree order, so predictions may differ from the original model in the last bits.
+     */
+    void ReorderTreesByFeatureLocality(size_t lookahead = 256, bool keepSummationOrder = false) {
+        ReorderTrees(CalcFeatureLocalityTreeOrder(lookahead), keepSummationOrder);
+    }
+
+    /**
+     * Indexes of trees in the order the CPU evaluator adds their leaf values, empty if leaf values are added
+     *  in the tree order. Other appliers and exported models sum in the tree order.
+     */
+    const TVector<ui32>& GetTreeSummationOrder() const {
+        return TreeSummationOrder;
+    }
+
     /**
      * Drop unused float and categorical features from model
      */
@@ -410,6 +471,12 @@ public:
         CB_ENSURE(RuntimeData.Defined(), "runtime data should be initialized");
         return &LeafValues[RuntimeData->TreeFirstLeafOffsets[treeIdx]];
     }
+
+    //! Leaf values used by the evaluator if LeafValuesPrecision is not Double
+    const TVector<float>& GetFloatLeafValues() const {
+        CB_ENSURE(RuntimeData.Defined(), "runtime data should be initialized");
+        return RuntimeData->FloatLeafValues;
+    }
     /**
      * List all unique CTR bases (feature combination + ctr type) in model
      * @return
@@ -520,6 +587,14 @@ private:
     //! Leaf values layout: [treeIndex][leafId * ApproxDimension + dimension]
     TVector<double> LeafValues;
 
+    //! Precision of leaf values in the model file and in the CPU evaluator
+    ELeafValuesPrecision LeafValuesPrecision = ELeafValuesPrecision::Double;
+    //! Float16 leaf values are stored divided by this power of 2
+    double LeafValuesHalfScale = 1.0;
+
+    //! Tree indexes in the order of leaf values summation, empty for the tree order
+    TVector<ui32> TreeSummationOrder;
+
     /**
      * Leaf Weights are sums of weights or group weights of samples from the learn dataset that go to that leaf.
      * This information can be absent (this vector will be empty) in some models:
@@ -596,6 +671,7 @@ private:
     EFormulaEvaluatorType FormulaEvaluatorType = EFormulaEvaluatorType::CPU;
     TAdaptiveLock CurrentEvaluatorLock;
     mutable NCB::NModelEvaluation::TModelEvaluatorPtr Evaluator;
+    TIntrusivePtr<TCtrValueCache> CtrValueCache;
 public:
     void SetEvaluatorType(EFormulaEvaluatorType evaluatorType) {
         with_lock(CurrentEvaluatorLock) {
@@ -606,6 +682,12 @@ public:
         }
     }
 
+    EFormulaEvaluatorType GetEvaluatorType() const {
+        with_lock(CurrentEvaluatorLock) {
+            return FormulaEvaluatorType;
+        }
+    }
+
     NCB::NModelEvaluation::TConstModelEvaluatorPtr GetCurrentEvaluator() const {
         with_lock(CurrentEvaluatorLock) {
             if (!Evaluator) {
@@ -615,6 +697,40 @@ public:
         }
     }
 
+    /**
+     * Enable memoization of CTR values that depend on a single categorical feature for online serving,
+     *  where the same categorical values recur in every request. The cache is bounded by maxEntryCount
+     *  (categorical feature, value) pairs, is shared by all evaluations of this model and is reset when the model
+     *  is modified.
+     * @param maxEntryCount 0 disables the cache
+     */
+    void SetCtrValueCache(size_t maxEntryCount) {
+        with_lock(CurrentEvaluatorLock) {
+            CtrValueCache = maxEntryCount ? MakeIntrusive<TCtrValueCache>(maxEntryCount) : nullptr;
+            Evaluator.Reset();
+        }
+    }
+
+    /**
+     * @return CTR value cache hit and miss counters, Nothing() if the cache is disabled
+     */
+    TMaybe<TCtrValueCacheStats> GetCtrValueCacheStats() const {
+        with_lock(CurrentEvaluatorLock) {
+            if (!CtrValueCache) {
+                return Nothing();
+            }
+            return CtrValueCache->GetStats();
+        }
+    }
+
+    /**
+     * Internal usage only.
+     * Used by evaluators on creation, called under evaluator lock.
+     */
+    const TIntrusivePtr<TCtrValueCache>& GetCtrValueCache() const {
+        return CtrValueCache;
+    }
+
     bool operator==(const TFullModel& other) const {
         return *ModelTrees == *other.ModelTrees;
     }
@@ -632,6 +748,7 @@ public:
                 DoSwap(CtrProvider, other.CtrProvider);
                 DoSwap(FormulaEvaluatorType, other.FormulaEvaluatorType);
                 DoSwap(Evaluator, other.Evaluator);
+                DoSwap(CtrValueCache, other.CtrValueCache);
             }
         }
         DoSwap(TextProcessingCollection, other.TextProcessingCollection);
@@ -678,6 +795,27 @@ public:
         UpdateDynamicData();
     }
 
+    /**
+     * Reorder trees so that consecutive trees share quantized features, see
+     *  TModelTrees::CalcFeatureLocalityTreeOrder. Predictions may differ in the last bits because of
+     *  the changed summation order unless keepSummationOrder is set.
+     * @param lookahead
+     * @param keepSummationOrder
+     */
+    void ReorderTreesByFeatureLocality(size_t lookahead = 256, bool keepSummationOrder = false) {
+        ModelTrees.GetMutable()->ReorderTreesByFeatureLocality(lookahead, keepSummationOrder);
+        UpdateDynamicData();
+    }
+
+    /**
+     * Store leaf values with reduced precision, see TModelTrees::SetLeafValuesPrecision for error bounds.
+     * @param precision
+     */
+    void SetLeafValuesPrecision(ELeafValuesPrecision precision) {
+        ModelTrees.GetMutable()->SetLeafValuesPrecision(precision);
+        UpdateDynamicData();
+    }
+
     /**
      * @return Minimal float features vector length sufficient for this model
      */
@@ -824,6 +962,25 @@ public:
         CalcFlat(featureRefs, results, featureInfo);
     }
 
+    /**
+     * Staged evaluation for threshold decisions of single dimension models: evaluation of an object stops
+     *  once the remaining trees can't move its raw formula value across rawThreshold.
+     * See IModelEvaluator::CalcFlatWithEarlyExit for the meaning of results.
+     * @param[in] features same as in CalcFlat
+     * @param[in] rawThreshold
+     * @param[in] treeChunkSize count of trees evaluated between decision checks
+     * @param[out] results
+     * @param[out] evaluatedTreeCounts optional, count of trees evaluated for each object
+     */
+    void CalcFlatWithEarlyExit(
+        TConstArrayRef<TConstArrayRef<float>> features,
+        double rawThreshold,
+        size_t treeChunkSize,
+        TArrayRef<double> results,
+        TArrayRef<ui32> evaluatedTreeCounts = {},
+        const TFeatureLayout* featureInfo = nullptr
+    ) const;
+
     /**
      * Same as CalcFlat method but for one object
      * @param[in] features flat features array reference. First dimension is object index, second dimension is
@@ -1121,6 +1278,16 @@ TFullModel SumModels(
     const TVector<double>& weights,
     ECtrTableMergePolicy ctrMergePolicy = ECtrTableMergePolicy::IntersectingCountersAverage);
 
+/**
+ * Same as SumModels for models stored in files, but ctr tables are not loaded all at once:
+ * they are merged in batches limited by ctrTablesBatchMemoryLimit bytes of source tables.
+ */
+TFullModel SumModelsFromFiles(
+    const TVector<TString>& modelPaths,
+    const TVector<double>& weights,
+    ECtrTableMergePolicy ctrMergePolicy = ECtrTableMergePolicy::IntersectingCountersAverage,
+    ui64 ctrTablesBatchMemoryLimit = 1ull << 30);
+
 void SaveModelBorders(
     const TString& file,
     const TFullModel& model);
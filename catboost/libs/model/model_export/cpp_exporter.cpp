@@ -91,6 +91,86 @@ namespace NCB {
         Out << '\n';
     }
 
+    /*
+     * Batch applicator for models without cat features, supports multiclass
+     */
+
+    static void WriteConstexprArray(
+        IOutputStream& out,
+        const TIndent& indent,
+        TStringBuf type,
+        TStringBuf name,
+        const TString& initializer,
+        size_t size
+    ) {
+        // zero-size arrays are ill-formed, empty tables get a dummy element
+        out << indent << "constexpr " << type << " " << name << "[" << Max<size_t>(size, 1) << "] = {"
+            << (size ? initializer : TString("0")) << "};" << '\n';
+    }
+
+    void TCatboostModelToCppConverter::WriteBatchModel(const TFullModel& model) {
+        CB_ENSURE(
+            model.ModelTrees->GetUsedTextFeaturesCount() == 0,
+            "Export of model with text features to cpp is not supported."
+        );
+        const auto& trees = *model.ModelTrees;
+
+        // the same bins as TModelTrees repacked bins use: up to MAX_VALUES_PER_BIN borders of one feature
+        TVector<ui32> binFloatFeatureIndex;
+        TVector<ui32> binNanValue;
+        TVector<ui32> binBorderOffsets = {0};
+        for (const auto& floatFeature : trees.GetFloatFeatures()) {
+            if (!floatFeature.UsedInModel()) {
+                continue;
+            }
+            const bool nanAsTrue = floatFeature.HasNans
+                && floatFeature.NanValueTreatment == TFloatFeature::ENanValueTreatment::AsTrue;
+            for (size_t binStart = 0; binStart < floatFeature.Borders.size(); binStart += MAX_VALUES_PER_BIN) {
+                const size_t binEnd = Min<size_t>(binStart + MAX_VALUES_PER_BIN, floatFeature.Borders.size());
+                binFloatFeatureIndex.push_back(floatFeature.Position.Index);
+                binNanValue.push_back(nanAsTrue ? binEnd - binStart : 0);
+                binBorderOffsets.push_back(binBorderOffsets.back() + binEnd - binStart);
+            }
+        }
+        Y_ASSERT(binFloatFeatureIndex.size() == trees.GetEffectiveBinaryFeaturesBucketsCount());
+        const auto& bins = trees.GetRepackedBins();
+
+        TIndent indent(0);
+        Out << "/* Model data for the batch applicator */" << '\n';
+        Out << indent++ << "namespace CatboostModelBatchData {" << '\n';
+        Out << indent << "constexpr unsigned int FloatFeatureCount = " << model.GetNumFloatFeatures() << ";" << '\n';
+        Out << indent << "constexpr unsigned int DimensionsCount = " << trees.GetDimensionsCount() << ";" << '\n';
+        Out << indent << "constexpr unsigned int TreeCount = " << trees.GetTreeCount() << ";" << '\n';
+        Out << '\n';
+        Out << indent << "/* Each bin holds up to " << MAX_VALUES_PER_BIN << " borders of one float feature */" << '\n';
+        Out << indent << "constexpr unsigned int BinCount = " << binFloatFeatureIndex.size() << ";" << '\n';
+        WriteConstexprArray(Out, indent, "unsigned int", "BinFloatFeatureIndex", OutputArrayInitializer(binFloatFeatureIndex), binFloatFeatureIndex.size());
+        WriteConstexprArray(Out, indent, "unsigned char", "BinNanValue", OutputArrayInitializer(binNanValue), binNanValue.size());
+        WriteConstexprArray(Out, indent, "unsigned int", "BinBorderOffsets", OutputArrayInitializer(binBorderOffsets), binBorderOffsets.size());
+        WriteConstexprArray(Out, indent, "float", "Borders", OutputBorders(model, true), binBorderOffsets.back());
+        Out << '\n';
+        WriteConstexprArray(Out, indent, "unsigned int", "TreeDepth", OutputArrayInitializer(trees.GetTreeSizes()), trees.GetTreeSizes().size());
+        WriteConstexprArray(
+            Out, indent, "unsigned short", "TreeSplitBin",
+            OutputArrayInitializer([&bins](size_t i) { return bins[i].FeatureIndex; }, bins.size()),
+            bins.size());
+        WriteConstexprArray(
+            Out, indent, "unsigned char", "TreeSplitBorder",
+            OutputArrayInitializer([&bins](size_t i) { return (int)bins[i].SplitIdx; }, bins.size()),
+            bins.size());
+        Out << '\n';
+        Out << indent << "/* Aggregated array of leaf values for trees. Each tree is represented by a separate line: */" << '\n';
+        Out << indent << "constexpr double LeafValues[" << Max<size_t>(trees.GetLeafValues().size(), 1) << "] = {"
+            << (trees.GetLeafValues().empty() ? TString("0") : OutputLeafValues(model, indent));
+        Out << indent << "};" << '\n';
+        Out << --indent << "}" << '\n';
+        Out << '\n';
+    }
+
+    void TCatboostModelToCppConverter::WriteBatchApplicator() {
+        Out << NResource::Find("catboost_model_export_cpp_batch_model_applicator");
+    }
+
     void TCatboostModelToCppConverter::WriteHeader(bool forCatFeatures) {
         if (forCatFeatures) {
            Out << "#include <cassert>" << '\n';
@@ -26,14 +26,21 @@ namespace NCB {
                 WriteApplicatorCatFeatures();
             } else {
                 WriteHeader(/*forCatFeatures*/false);
-                WriteModel(model);
-                WriteApplicator();
+                if (model.ModelTrees->GetDimensionsCount() == 1) {
+                    WriteModel(model);
+                    WriteApplicator();
+                    Out << '\n';
+                }
+                WriteBatchModel(model);
+                WriteBatchApplicator();
             }
         }
 
     private:
         void WriteApplicator();
         void WriteModel(const TFullModel& model);
+        void WriteBatchApplicator();
+        void WriteBatchModel(const TFullModel& model);
         void WriteHeader(bool forCatFeatures);
         void WriteCTRStructs();
         void WriteModelCatFeatures(const TFullModel& model, const THashMap<ui32, TString>* catFeaturesHashToString);
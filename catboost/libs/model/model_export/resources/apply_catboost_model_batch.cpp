@@ -0,0 +1,80 @@
+/* Batch model applicator
+ *
+ * features: docCount rows of CatboostModelBatchData::FloatFeatureCount float features
+ * result: docCount rows of CatboostModelBatchData::DimensionsCount raw formula values
+ *
+ * Documents are evaluated in blocks with all buffers on the stack, so there are no heap allocations.
+ * Binarized features of a block take at most 16 KB of stack (BinCount bytes if there are more bins).
+ * Inner loops run over the documents of a block and are easy for the compiler to vectorize.
+ */
+void ApplyCatboostModelBatch(
+    const float* features,
+    unsigned int docCount,
+    double* result
+) {
+    using namespace CatboostModelBatchData;
+    /* Binarized block takes BinCount * BlockSize bytes of stack, so blocks are shortened for models with many bins */
+    constexpr unsigned int MaxBlockSize = 64;
+    constexpr unsigned int MaxBinsSize = 16384;
+    constexpr unsigned int BlockSize = (BinCount * MaxBlockSize <= MaxBinsSize)
+        ? MaxBlockSize
+        : (MaxBinsSize / BinCount > 0 ? MaxBinsSize / BinCount : 1);
+
+    for (unsigned int i = 0; i < docCount * DimensionsCount; ++i) {
+        result[i] = 0.0;
+    }
+    for (unsigned int blockStart = 0; blockStart < docCount; blockStart += BlockSize) {
+        const unsigned int blockDocCount = (docCount - blockStart < BlockSize) ? (docCount - blockStart) : BlockSize;
+        const float* blockFeatures = features + blockStart * FloatFeatureCount;
+        double* blockResult = result + blockStart * DimensionsCount;
+
+        /* Binarize features, bin value is the number of bin borders below the feature value */
+        unsigned char bins[BinCount > 0 ? BinCount : 1][BlockSize];
+        for (unsigned int binIdx = 0; binIdx < BinCount; ++binIdx) {
+            unsigned char* binValues = bins[binIdx];
+            const unsigned int featureIdx = BinFloatFeatureIndex[binIdx];
+            const unsigned char nanBinValue = BinNanValue[binIdx];
+            float values[BlockSize];
+            for (unsigned int docIdx = 0; docIdx < blockDocCount; ++docIdx) {
+                values[docIdx] = blockFeatures[docIdx * FloatFeatureCount + featureIdx];
+                binValues[docIdx] = (values[docIdx] != values[docIdx]) ? nanBinValue : 0;
+            }
+            for (unsigned int borderIdx = BinBorderOffsets[binIdx]; borderIdx < BinBorderOffsets[binIdx + 1]; ++borderIdx) {
+                const float border = Borders[borderIdx];
+                for (unsigned int docIdx = 0; docIdx < blockDocCount; ++docIdx) {
+                    binValues[docIdx] += (unsigned char)(values[docIdx] > border);
+                }
+            }
+        }
+
+        /* Calculate leaf indexes and gather leaf values tree by tree */
+        unsigned int leafIndexes[BlockSize];
+        const double* treeLeafValues = LeafValues;
+        unsigned int splitIdx = 0;
+        for (unsigned int treeIdx = 0; treeIdx < TreeCount; ++treeIdx) {
+            for (unsigned int docIdx = 0; docIdx < blockDocCount; ++docIdx) {
+                leafIndexes[docIdx] = 0;
+            }
+            for (unsigned int depth = 0; depth < TreeDepth[treeIdx]; ++depth, ++splitIdx) {
+                const unsigned char* binValues = bins[TreeSplitBin[splitIdx]];
+                const unsigned char splitBorder = TreeSplitBorder[splitIdx];
+                for (unsigned int docIdx = 0; docIdx < blockDocCount; ++docIdx) {
+                    leafIndexes[docIdx] |= (unsigned int)(binValues[docIdx] >= splitBorder) << depth;
+                }
+            }
+            if (DimensionsCount == 1) {
+                for (unsigned int docIdx = 0; docIdx < blockDocCount; ++docIdx) {
+                    blockResult[docIdx] += treeLeafValues[leafIndexes[docIdx]];
+                }
+            } else {
+                for (unsigned int docIdx = 0; docIdx < blockDocCount; ++docIdx) {
+                    const double* leafValues = treeLeafValues + leafIndexes[docIdx] * DimensionsCount;
+                    for (unsigned int dim = 0; dim < DimensionsCount; ++dim) {
+                        blockResult[docIdx * DimensionsCount + dim] += leafValues[dim];
+                    }
+                }
+            }
+            treeLeafValues += (1u << TreeDepth[treeIdx]) * DimensionsCount;
+        }
+    }
+}
@@ -90,6 +90,52 @@ static void ParseFeatures(
 
 extern double ApplyCatboostModel(const vector<float>& floatFeatures, const vector<string>& catFeatures);
 
+#ifdef APPLY_CATBOOST_MODEL_BATCH
+
+extern void ApplyCatboostModelBatch(const float* features, unsigned int docCount, double* result);
+
+// evaluates all documents with one call, writes raw formula values of each document on a separate line
+int main(int argc, char *argv[]) {
+    assert(argc == 5);  // main.exe test.tsv cd.tsv predictions.txt dimensionsCount
+
+    vector<size_t> floatColumns, catColumns;
+    set<size_t> otherColumns;
+    ReadColumnDescription(argv[2], &floatColumns, &catColumns, &otherColumns);
+    sort(floatColumns.begin(), floatColumns.end());
+    assert(catColumns.empty());
+    const size_t dimensionsCount = stoul(argv[4]);
+
+    ifstream test(argv[1]);
+    string line;
+    vector<float> features;
+    size_t docCount = 0;
+    for (; getline(test, line); ++docCount) {
+        if (docCount == 0) {
+            size_t columnCount = 1 + count(line.begin(), line.end(), DELIMITER);
+            AdjustFloatColumns(columnCount, catColumns, otherColumns, &floatColumns);
+        }
+        vector<float> floatFeatures;
+        vector<string> catFeatures;
+        ParseFeatures(line, floatColumns, catColumns, &floatFeatures, &catFeatures);
+        features.insert(features.end(), floatFeatures.begin(), floatFeatures.end());
+    }
+
+    vector<double> results(docCount * dimensionsCount);
+    ApplyCatboostModelBatch(features.data(), docCount, results.data());
+
+    ofstream predictions(argv[3]);
+    predictions.precision(17);
+    for (size_t docId = 0; docId < docCount; ++docId) {
+        for (size_t dim = 0; dim < dimensionsCount; ++dim) {
+            predictions << (dim ? "\t" : "") << results[docId * dimensionsCount + dim];
+        }
+        predictions << endl;
+    }
+    return 0;
+}
+
+#else
+
 int main(int argc, char *argv[]) {
     assert(argc == 4);  // main.exe test.tsv cd.tsv predictions.txt
 
@@ -123,3 +169,5 @@ int main(int argc, char *argv[]) {
 
     return 0;
 }
+
+#endif
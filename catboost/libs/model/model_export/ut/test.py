@@ -92,6 +92,52 @@ def test_cpp_export(dataset, parameters):
             raise
 
 
+@pytest.mark.parametrize('dataset,cd_file,parameters', [
+    ('higgs', 'train.cd', []),
+    ('cloudness_small', 'train_float.cd', ['--loss-function', 'MultiClass']),
+])
+def test_cpp_export_batch(dataset, cd_file, parameters):
+    train_path = data_file(dataset, 'train_small')
+    test_path = data_file(dataset, 'test_small')
+    cd_path = data_file(dataset, cd_file)
+    basename = yatest.common.test_output_path('model')
+    yatest.common.execute([
+        CATBOOST_APP_PATH, 'fit',
+        '-f', train_path,
+        '--cd', cd_path,
+        '-i', '100',
+        '-r', '1234',
+        '-m', basename,
+        '--model-format', 'CPP',
+        '--model-format', 'CatboostBinary',
+    ] + parameters)
+
+    model = CatBoost()
+    model.load_model(basename + '.bin')
+    pred_model = model.predict(Pool(test_path, column_description=cd_path), prediction_type='RawFormulaVal')
+    dimensions_count = 1 if pred_model.ndim == 1 else pred_model.shape[1]
+
+    applicator_cpp = yatest.common.source_path('catboost/libs/model/model_export/ut/applicator.cpp')
+    applicator_exe = yatest.common.test_output_path('batch_applicator.exe')
+    predictions_path = yatest.common.test_output_path('predictions.txt')
+    if os.name == 'posix':
+        compile_cmd = ['g++', '-std=c++14', '-O2', '-DAPPLY_CATBOOST_MODEL_BATCH', '-o', applicator_exe]
+    else:
+        compile_cmd = ['cl.exe', '-DAPPLY_CATBOOST_MODEL_BATCH', '-Fe' + applicator_exe]
+    compile_cmd += [applicator_cpp, basename + '.cpp']
+    try:
+        yatest.common.execute(compile_cmd)
+    except OSError as e:
+        if re.search(r"No such file or directory.*'{}'".format(re.escape(compile_cmd[0])), str(e)):
+            pytest.xfail(reason='We ignore `compiler not found` error: {}\n'.format(str(e)))
+        else:
+            raise
+    yatest.common.execute([applicator_exe, test_path, cd_path, predictions_path, str(dimensions_count)])
+
+    pred_cpp = np.loadtxt(predictions_path, ndmin=2)
+    assert _check_data(pred_model.reshape(pred_cpp.shape), pred_cpp, rtol=1e-6)
+
+
 def test_read_model_after_train():
     train_path, test_path, cd_path = _get_train_test_cd_path('adult')
     eval_file = yatest.common.test_output_path('eval-file')
@@ -10,20 +10,30 @@ void TStaticCtrProvider::CalcCtrs(const TVector<TModelCtr>& neededCtrs,
                                   const TConstArrayRef<ui8>& binarizedFeatures,
                                   const TConstArrayRef<ui32>& hashedCatFeatures,
                                   size_t docCount,
-                                  TArrayRef<float> result) {
+                                  TArrayRef<float> result,
+                                  TCtrProviderBuffers* buffers) {
     if (neededCtrs.empty()) {
         return;
     }
-    auto compressedModelCtrs = NCB::CompressModelCtrs(neededCtrs);
+    TCtrProviderBuffers localBuffers;
+    if (!buffers) {
+        buffers = &localBuffers;
+    }
     size_t samplesCount = docCount;
-    TVector<ui64> ctrHashes(samplesCount);
-    TVector<ui64> buckets(samplesCount);
+    auto& ctrHashes = buffers->CtrHashes;
+    auto& buckets = buffers->Buckets;
+    buckets.yresize(samplesCount);
     size_t resultIdx = 0;
     float* resultPtr = result.data();
-    TVector<int> transposedCatFeatureIndexes;
-    TVector<TBinFeatureIndexValue> binarizedIndexes;
-    for (size_t idx = 0; idx < compressedModelCtrs.size(); ++idx) {
-        auto& proj = *compressedModelCtrs[idx].Projection;
+    auto& transposedCatFeatureIndexes = buffers->TransposedCatFeatureIndexes;
+    auto& binarizedIndexes = buffers->BinarizedIndexes;
+    // needed ctrs are sorted, so ctrs with the same projection are adjacent, as in NCB::CompressModelCtrs
+    for (size_t projectionStart = 0, projectionEnd = 0; projectionStart < neededCtrs.size(); projectionStart = projectionEnd) {
+        const auto& proj = neededCtrs[projectionStart].Base.Projection;
+        projectionEnd = projectionStart + 1;
+        while (projectionEnd < neededCtrs.size() && neededCtrs[projectionEnd].Base.Projection == proj) {
+            ++projectionEnd;
+        }
         binarizedIndexes.clear();
         transposedCatFeatureIndexes.clear();
         for (const auto feature : proj.CatFeatures) {
@@ -36,7 +46,8 @@ void TStaticCtrProvider::CalcCtrs(const TVector<TModelCtr>& neededCtrs,
             binarizedIndexes.push_back(OneHotFeatureIndexes.at(feature));
         }
         CalcHashes(binarizedFeatures, hashedCatFeatures, transposedCatFeatureIndexes, binarizedIndexes, docCount, &ctrHashes);
-        for (const auto& ctr: compressedModelCtrs[idx].ModelCtrs) {
+        for (size_t ctrIdx = projectionStart; ctrIdx < projectionEnd; ++ctrIdx) {
+            const auto* ctr = &neededCtrs[ctrIdx];
             auto& learnCtr = CtrData.LearnCtrs.at(ctr->Base);
             auto hashIndexResolver = learnCtr.GetIndexHashViewer();
             const ECtrType ctrType = ctr->Base.CtrType;
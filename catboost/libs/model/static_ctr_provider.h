@@ -26,7 +26,8 @@ public:
         const TConstArrayRef<ui8>& binarizedFeatures, // vector of binarized float & one hot features
         const TConstArrayRef<ui32>& hashedCatFeatures,
         size_t docCount,
-        TArrayRef<float> result) override;
+        TArrayRef<float> result,
+        TCtrProviderBuffers* buffers = nullptr) override;
 
     void SetupBinFeatureIndexes(
         const TConstArrayRef<TFloatFeature> floatFeatures,
@@ -107,7 +108,8 @@ public:
         const TConstArrayRef<ui8>& ,
         const TConstArrayRef<ui32>& ,
         size_t,
-        TArrayRef<float>) override {
+        TArrayRef<float>,
+        TCtrProviderBuffers*) override {
 
         ythrow TCatBoostException()
             << "TStaticCtrOnFlightSerializationProvider is for streamed serialization only";
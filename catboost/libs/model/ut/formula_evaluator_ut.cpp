@@ -8,9 +8,54 @@
 
 #include <library/unittest/registar.h>
 
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
 using namespace NCB;
 using namespace NCB::NModelEvaluation;
 
+// counts allocations to check that single document evaluation doesn't allocate, needs ALLOCATOR(SYSTEM)
+static std::atomic<size_t> AllocationCount{0};
+
+void* operator new(size_t size) {
+    AllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+template <class TCalc>
+static size_t CountSteadyStateAllocations(TCalc&& calc) {
+    calc(); // thread local buffers grow to the model size
+    const size_t allocationCount = AllocationCount.load();
+    for (size_t i = 0; i < 10; ++i) {
+        calc();
+    }
+    return AllocationCount.load() - allocationCount;
+}
+
 const TVector<TVector<float>> DATA = {
     {0.f, 0.f, 0.f},
     {3.f, 0.f, 0.f},
@@ -145,6 +190,137 @@ Y_UNIT_TEST_SUITE(TObliviousTreeModel) {
             model.Calc({}, f, results);
         };
         UNIT_ASSERT_NO_EXCEPTION(applyBatch());
+
+        const auto applyBatchShortResults = [&] {
+            const TVector<TStringBuf> f[] = {{"a", "b", "c"}, {"d", "e", "f"}, {"g", "h", "k"}};
+            double results[2];
+            model.Calc({}, f, results);
+        };
+        UNIT_ASSERT_EXCEPTION(applyBatchShortResults(), TCatBoostException);
+    }
+
+    Y_UNIT_TEST(TestReuseBuffers) {
+        auto model = SimpleFloatModel(2);
+        TVector<double> expected(FLOAT_FEATURES.size());
+        model.CalcFlat(FLOAT_FEATURES, expected);
+
+        auto evaluator = model.GetCurrentEvaluator()->Clone();
+        evaluator->SetProperty(ReuseBuffersPropertyName, "true");
+        for (size_t docCount : {FLOAT_FEATURES.size(), size_t(1), FLOAT_FEATURES.size()}) {
+            TVector<double> results(docCount);
+            evaluator->CalcFlat(MakeArrayRef(FLOAT_FEATURES).Slice(0, docCount), results);
+            UNIT_ASSERT_VALUES_EQUAL(results, TVector<double>(expected.begin(), expected.begin() + docCount));
+        }
+    }
+
+    Y_UNIT_TEST(TestSingleDocMatchesBatch) {
+        // single document calls of different models share thread local buffers
+        auto catModel = TrainCatOnlyModel();
+        auto floatModel = SimpleFloatModel(2);
+        const TVector<TStringBuf> f[] = {{"a", "b", "c"}, {"d", "e", "f"}, {"g", "h", "k"}};
+        TVector<double> catExpected(3);
+        catModel.Calc({}, f, catExpected);
+        TVector<double> floatExpected(FLOAT_FEATURES.size());
+        floatModel.CalcFlat(FLOAT_FEATURES, floatExpected);
+
+        for (auto docIdx : xrange(3)) {
+            TVector<double> result(1);
+            catModel.Calc({}, TConstArrayRef<TVector<TStringBuf>>(f + docIdx, 1), result);
+            UNIT_ASSERT_VALUES_EQUAL(result[0], catExpected[docIdx]);
+            floatModel.CalcFlatSingle(FLOAT_FEATURES[docIdx], result);
+            UNIT_ASSERT_VALUES_EQUAL(result[0], floatExpected[docIdx]);
+        }
+    }
+
+    Y_UNIT_TEST(TestSingleDocDoesNotAllocate) {
+        auto catModel = TrainCatOnlyModel();
+        UNIT_ASSERT(!catModel.ModelTrees->GetUsedModelCtrs().empty());
+        const TVector<TStringBuf> catFeatures = {"a", "b", "c"};
+        const TConstArrayRef<TStringBuf> catFeaturesRef = catFeatures;
+        double result = 0.0;
+        for (size_t ctrValueCacheSize : {0, 100}) {
+            catModel.SetCtrValueCache(ctrValueCacheSize);
+            const auto evaluator = catModel.GetCurrentEvaluator();
+            const size_t allocationCount = CountSteadyStateAllocations([&] {
+                evaluator->Calc({}, MakeArrayRef(&catFeaturesRef, 1), 0, catModel.GetTreeCount(), MakeArrayRef(&result, 1));
+            });
+            UNIT_ASSERT_VALUES_EQUAL(allocationCount, 0);
+        }
+
+        const auto multiClassModel = MultiValueFloatModel();
+        auto classEvaluator = multiClassModel.GetCurrentEvaluator()->Clone();
+        classEvaluator->SetPredictionType(NCB::NModelEvaluation::EPredictionType::Class);
+        const float floatFeatures[] = {0.f, 1.f};
+        const size_t allocationCount = CountSteadyStateAllocations([&] {
+            classEvaluator->CalcFlatSingle(floatFeatures, MakeArrayRef(&result, 1));
+        });
+        UNIT_ASSERT_VALUES_EQUAL(allocationCount, 0);
+    }
+
+    Y_UNIT_TEST(TestCtrValueCache) {
+        auto model = TrainCatOnlyModel();
+        const TVector<TStringBuf> f[] = {{"a", "b", "c"}, {"d", "e", "f"}, {"a", "b", "c"}, {"g", "h", "k"}};
+        TVector<double> expected(4);
+        model.Calc({}, f, expected);
+        UNIT_ASSERT(!model.GetCtrValueCacheStats());
+
+        model.SetCtrValueCache(100);
+        for (auto i : xrange(2)) {
+            Y_UNUSED(i);
+            TVector<double> results(4);
+            model.Calc({}, f, results);
+            UNIT_ASSERT_VALUES_EQUAL(results, expected);
+        }
+        const bool hasSingleFeatureCtrs = AnyOf(
+            model.ModelTrees->GetUsedModelCtrs(),
+            [] (const TModelCtr& ctr) { return ctr.Base.Projection.IsSingleCatFeature(); });
+        const auto stats = model.GetCtrValueCacheStats();
+        UNIT_ASSERT(stats);
+        UNIT_ASSERT_VALUES_EQUAL(stats->Hits > 0, hasSingleFeatureCtrs);
+
+        model.SetCtrValueCache(0);
+        UNIT_ASSERT(!model.GetCtrValueCacheStats());
+    }
+
+    Y_UNIT_TEST(TestEarlyExit) {
+        const auto model = TrainFloatCatboostModel(/*iterations*/ 40);
+        const size_t treeCount = model.GetTreeCount();
+        const size_t docCount = 1000;
+        TFastRng64 rng(0);
+        TVector<TVector<float>> features(docCount, TVector<float>(3));
+        for (auto& doc : features) {
+            for (auto& value : doc) {
+                value = rng.GenRandReal1();
+            }
+        }
+        const auto featureRefs = GetFeatureRef(features);
+        TVector<double> expected(docCount);
+        model.CalcFlat(featureRefs, expected);
+        double leafValuesAbsSum = 0.0;
+        for (double value : model.ModelTrees->GetLeafValues()) {
+            leafValuesAbsSum += Abs(value);
+        }
+
+        const size_t treeChunkSize = 4;
+        for (double threshold : {Accumulate(expected, 0.0) / docCount, leafValuesAbsSum + 1}) {
+            TVector<double> results(docCount);
+            TVector<ui32> evaluatedTreeCounts(docCount);
+            model.CalcFlatWithEarlyExit(featureRefs, threshold, treeChunkSize, results, evaluatedTreeCounts);
+            for (auto docIdx : xrange(docCount)) {
+                UNIT_ASSERT_VALUES_EQUAL(results[docIdx] >= threshold, expected[docIdx] >= threshold);
+                if (evaluatedTreeCounts[docIdx] == treeCount) {
+                    UNIT_ASSERT_DOUBLES_EQUAL(results[docIdx], expected[docIdx], 1e-9);
+                } else if (results[docIdx] >= threshold) {
+                    UNIT_ASSERT(results[docIdx] <= expected[docIdx] + 1e-9);
+                } else {
+                    UNIT_ASSERT(results[docIdx] >= expected[docIdx] - 1e-9);
+                }
+            }
+            if (threshold > leafValuesAbsSum) {
+                // no sum of leaf values reaches the threshold, so only the first chunk is evaluated
+                UNIT_ASSERT(AllOf(evaluatedTreeCounts, [=] (ui32 count) { return count == treeChunkSize; }));
+            }
+        }
     }
 
     static void CheckCalcTextResult(
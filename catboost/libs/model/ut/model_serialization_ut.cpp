@@ -4,6 +4,11 @@
 
 #include <library/unittest/registar.h>
 
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+#include <cmath>
+
 using namespace std;
 using namespace NCB;
 
@@ -23,6 +28,69 @@ Y_UNIT_TEST_SUITE(TModelSerialization) {
         DoSerializeDeserialize(trainedModel);
     }
 
+    Y_UNIT_TEST(TestSerializeDeserializeLeafValuesPrecision) {
+        const TFullModel trainedModel = TrainFloatCatboostModel(20);
+        TFastRng64 rng(42);
+        TVector<TVector<float>> features(100, TVector<float>(3));
+        for (auto& doc : features) {
+            for (auto& value : doc) {
+                value = rng.GenRandReal1();
+            }
+        }
+        const TVector<TConstArrayRef<float>> featureRefs(features.begin(), features.end());
+        TVector<double> expected(features.size());
+        trainedModel.CalcFlat(featureRefs, expected);
+
+        for (auto precision : {ELeafValuesPrecision::Float32, ELeafValuesPrecision::Float16}) {
+            TFullModel model = trainedModel;
+            model.SetLeafValuesPrecision(precision);
+            DoSerializeDeserialize(model);
+
+            const auto& trees = *model.ModelTrees;
+            const auto originalLeafValues = trainedModel.ModelTrees->GetLeafValues();
+            const auto leafValues = trees.GetLeafValues();
+            const auto& firstLeafOffsets = trees.GetFirstLeafOffsets();
+            double maxAbsLeafValue = 0.0;
+            for (double value : originalLeafValues) {
+                maxAbsLeafValue = Max(maxAbsLeafValue, Abs(value));
+            }
+            int exponent = 0;
+            std::frexp(maxAbsLeafValue, &exponent);
+            const double minHalfNormal = std::ldexp(1.0, exponent - 15 - 14);
+            double errorBound = 0.0;
+            for (auto treeIdx : xrange(trees.GetTreeCount())) {
+                const size_t end = treeIdx + 1 < trees.GetTreeCount() ? firstLeafOffsets[treeIdx + 1] : leafValues.size();
+                double treeMaxError = 0.0;
+                for (auto leafIdx : xrange(firstLeafOffsets[treeIdx], end)) {
+                    const double error = Abs(leafValues[leafIdx] - originalLeafValues[leafIdx]);
+                    const double leafBound = precision == ELeafValuesPrecision::Float32
+                        ? Abs(originalLeafValues[leafIdx]) * std::ldexp(1.0, -24)
+                        : Max(Abs(originalLeafValues[leafIdx]), minHalfNormal) * std::ldexp(1.0, -10);
+                    UNIT_ASSERT_C(error <= leafBound, precision << " leaf " << leafIdx);
+                    treeMaxError = Max(treeMaxError, error);
+                }
+                errorBound += treeMaxError;
+            }
+
+            TVector<double> predictions(features.size());
+            model.CalcFlat(featureRefs, predictions);
+            for (auto docIdx : xrange(features.size())) {
+                UNIT_ASSERT_DOUBLES_EQUAL(predictions[docIdx], expected[docIdx], errorBound + 1e-12);
+            }
+
+            TStringStream strStream;
+            model.Save(&strStream);
+            TFullModel loadedModel;
+            loadedModel.Load(&strStream);
+            UNIT_ASSERT_EQUAL(loadedModel.ModelTrees->GetLeafValuesPrecision(), precision);
+            UNIT_ASSERT_EQUAL(loadedModel, model);
+            UNIT_ASSERT_UNEQUAL(loadedModel, trainedModel);
+            TVector<double> loadedPredictions(features.size());
+            loadedModel.CalcFlat(featureRefs, loadedPredictions);
+            UNIT_ASSERT_EQUAL(predictions, loadedPredictions);
+        }
+    }
+
     Y_UNIT_TEST(TestSerializeDeserializeCoreML) {
         TFullModel trainedModel = TrainFloatCatboostModel();
         TStringStream strStream;
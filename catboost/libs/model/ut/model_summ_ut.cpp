@@ -1,3 +1,5 @@
+#include <catboost/libs/model/ensemble_evaluator.h>
+#include <catboost/libs/model/static_ctr_provider.h>
 #include <catboost/libs/model/ut/lib/model_test_helpers.h>
 
 #include <catboost/private/libs/algo/apply.h>
@@ -5,6 +7,8 @@
 
 #include <library/unittest/registar.h>
 
+#include <util/folder/tempdir.h>
+
 using namespace std;
 using namespace NCB;
 
@@ -57,6 +61,34 @@ static void AssertModelSumEqualSliced(TDataProviderPtr dataProvider) {
     }
 }
 
+static TFullModel TrainModelWithCtrs(TDataProviderPtr dataProvider, int seed) {
+    NJson::TJsonValue params;
+    params.InsertValue("iterations", 10);
+    params.InsertValue("random_seed", seed);
+    params.InsertValue("max_ctr_complexity", 2);
+    TFullModel model;
+    TEvalResult evalResult;
+
+    TDataProviders dataProviders;
+    dataProviders.Learn = dataProvider;
+    dataProviders.Test.push_back(dataProvider);
+
+    THolder<TLearnProgress> learnProgress;
+
+    TrainModel(
+        params,
+        nullptr,
+        Nothing(),
+        Nothing(),
+        dataProviders,
+        Nothing(),
+        &learnProgress,
+        "",
+        &model,
+        {&evalResult});
+    return model;
+}
+
 Y_UNIT_TEST_SUITE(TModelSummTests) {
     Y_UNIT_TEST(SimpleModelMerge) {
         const auto model1 = SimpleFloatModel();
@@ -82,6 +114,84 @@ Y_UNIT_TEST_SUITE(TModelSummTests) {
         UNIT_ASSERT_EQUAL(*mergedModel.ModelTrees, *bigModel.ModelTrees);
     }
 
+    Y_UNIT_TEST(EnsembleEvaluatorEqualsSum) {
+        const auto model1 = TrainFloatCatboostModel(10, 1);
+        const auto model2 = TrainFloatCatboostModel(10, 2);
+        const auto model3 = SimpleAsymmetricModel();
+        const TVector<const TFullModel*> modelPtrs = {&model1, &model2};
+        const TVector<double> modelWeights = {0.5, 2.0};
+        const auto mergedModel = SumModels(modelPtrs, modelWeights);
+        const NModelEvaluation::TEnsembleEvaluator ensembleEvaluator(modelPtrs, modelWeights);
+        UNIT_ASSERT_VALUES_EQUAL(ensembleEvaluator.GetSharedBinarizationModelCount(), 2);
+
+        TVector<TVector<float>> features(300, TVector<float>(mergedModel.ModelTrees->GetFlatFeatureVectorExpectedSize()));
+        for (auto docIdx : xrange(features.size())) {
+            for (auto featureIdx : xrange(features[docIdx].size())) {
+                features[docIdx][featureIdx] = ((docIdx * 7 + featureIdx * 13) % 23) / 23.0f;
+            }
+        }
+        TVector<double> expected(features.size());
+        mergedModel.CalcFlat(features, expected);
+        TVector<double> ensembleResult(features.size());
+        ensembleEvaluator.CalcFlat(features, ensembleResult);
+        for (auto idx : xrange(expected.size())) {
+            UNIT_ASSERT_DOUBLES_EQUAL(expected[idx], ensembleResult[idx], 1e-9);
+        }
+
+        const NModelEvaluation::TEnsembleEvaluator singleModelEvaluator({&model3}, {3.0});
+        TVector<TVector<float>> asymmetricModelFeatures(
+            10,
+            TVector<float>(model3.ModelTrees->GetFlatFeatureVectorExpectedSize(), 0.5f));
+        TVector<double> asymmetricExpected(asymmetricModelFeatures.size());
+        model3.CalcFlat(asymmetricModelFeatures, asymmetricExpected);
+        TVector<double> asymmetricResult(asymmetricModelFeatures.size());
+        singleModelEvaluator.CalcFlat(asymmetricModelFeatures, asymmetricResult);
+        for (auto idx : xrange(asymmetricExpected.size())) {
+            UNIT_ASSERT_DOUBLES_EQUAL(3.0 * asymmetricExpected[idx], asymmetricResult[idx], 1e-9);
+        }
+    }
+
+    Y_UNIT_TEST(SumFromFilesEqualsSum) {
+        const auto dataProvider = GetAdultPool();
+        const TVector<TFullModel> models = {
+            TrainModelWithCtrs(dataProvider, 1),
+            TrainModelWithCtrs(dataProvider, 2),
+            TrainModelWithCtrs(dataProvider, 3)
+        };
+        const TVector<double> modelWeights = {0.5, 1.0, 2.0};
+
+        TTempDir tempDir;
+        TVector<TString> modelPaths;
+        TVector<const TFullModel*> modelPtrs;
+        for (auto modelIdx : xrange(models.size())) {
+            UNIT_ASSERT(models[modelIdx].HasCategoricalFeatures());
+            modelPaths.push_back(tempDir.Name() + "/model" + ToString(modelIdx) + ".cbm");
+            OutputModel(models[modelIdx], modelPaths.back());
+            modelPtrs.push_back(&models[modelIdx]);
+        }
+
+        for (auto ctrMergePolicy : {ECtrTableMergePolicy::IntersectingCountersAverage, ECtrTableMergePolicy::LeaveMostDiversifiedTable}) {
+            const auto expectedModel = SumModels(modelPtrs, modelWeights, ctrMergePolicy);
+            const auto expectedResult = ApplyModelMulti(expectedModel, *dataProvider->ObjectsData);
+            const auto* expectedCtrProvider = dynamic_cast<const TStaticCtrProvider*>(expectedModel.CtrProvider.Get());
+            UNIT_ASSERT(expectedCtrProvider);
+            // a single ctr base per batch and all the tables at once
+            for (ui64 ctrTablesBatchMemoryLimit : {ui64(1), Max<ui64>()}) {
+                const auto mergedModel = SumModelsFromFiles(modelPaths, modelWeights, ctrMergePolicy, ctrTablesBatchMemoryLimit);
+                UNIT_ASSERT_EQUAL(*mergedModel.ModelTrees, *expectedModel.ModelTrees);
+                const auto* ctrProvider = dynamic_cast<const TStaticCtrProvider*>(mergedModel.CtrProvider.Get());
+                UNIT_ASSERT(ctrProvider);
+                UNIT_ASSERT_EQUAL(ctrProvider->CtrData, expectedCtrProvider->CtrData);
+
+                const auto mergedResult = ApplyModelMulti(mergedModel, *dataProvider->ObjectsData);
+                UNIT_ASSERT_VALUES_EQUAL(expectedResult.ysize(), mergedResult.ysize());
+                for (int idx = 0; idx < expectedResult.ysize(); ++idx) {
+                    UNIT_ASSERT_VALUES_EQUAL(expectedResult[idx], mergedResult[idx]);
+                }
+            }
+        }
+    }
+
     Y_UNIT_TEST(SumEqualSliced) {
         AssertModelSumEqualSliced(GetAdultPool());
         AssertModelSumEqualSliced(GetMultiClassPool());
@@ -5,6 +5,10 @@
 
 #include <library/unittest/registar.h>
 
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
 using namespace std;
 using namespace NCB;
 
@@ -52,4 +56,84 @@ Y_UNIT_TEST_SUITE(TShrinkModel) {
         }
         model.Truncate(1, 3);
     }
+
+    Y_UNIT_TEST(TestReorderTrees) {
+        TFullModel model = TrainFloatCatboostModel(30);
+        const TFullModel originalModel = model;
+        TFastRng64 rng(42);
+        TVector<TVector<float>> features(100, TVector<float>(3));
+        for (auto& doc : features) {
+            for (auto& value : doc) {
+                value = rng.GenRandReal1();
+            }
+        }
+        const TVector<TConstArrayRef<float>> featureRefs(features.begin(), features.end());
+        TVector<double> expected(features.size());
+        originalModel.CalcFlat(featureRefs, expected);
+
+        const auto treeOrder = model.ModelTrees->CalcFeatureLocalityTreeOrder();
+        TVector<ui32> sortedOrder = treeOrder;
+        Sort(sortedOrder);
+        UNIT_ASSERT_EQUAL(sortedOrder, TVector<ui32>(xrange<ui32>(model.GetTreeCount())));
+
+        model.ReorderTreesByFeatureLocality();
+        TVector<double> result(features.size());
+        model.CalcFlat(featureRefs, result);
+        for (auto idx : xrange(result.size())) {
+            UNIT_ASSERT_DOUBLES_EQUAL(result[idx], expected[idx], 1e-9);
+        }
+
+        TVector<ui32> inverseOrder(treeOrder.size());
+        for (auto idx : xrange(treeOrder.size())) {
+            inverseOrder[treeOrder[idx]] = idx;
+        }
+        model.ModelTrees.GetMutable()->ReorderTrees(inverseOrder);
+        UNIT_ASSERT_EQUAL(*model.ModelTrees, *originalModel.ModelTrees);
+    }
+
+    Y_UNIT_TEST(TestReorderTreesKeepSummationOrder) {
+        TFullModel model = TrainFloatCatboostModel(30);
+        const TFullModel originalModel = model;
+        TFastRng64 rng(42);
+        TVector<TVector<float>> features(300, TVector<float>(3));
+        for (auto& doc : features) {
+            for (auto& value : doc) {
+                value = rng.GenRandReal1();
+            }
+        }
+        const TVector<TConstArrayRef<float>> featureRefs(features.begin(), features.end());
+        TVector<double> expected(features.size());
+        originalModel.CalcFlat(featureRefs, expected);
+
+        const auto checkPredictions = [&] (const TFullModel& reorderedModel) {
+            TVector<double> result(features.size());
+            reorderedModel.CalcFlat(featureRefs, result);
+            UNIT_ASSERT_VALUES_EQUAL(result, expected);
+            for (auto docIdx : xrange<size_t>(0, features.size(), 37)) {
+                double singleResult = 0.0;
+                reorderedModel.CalcFlatSingle(featureRefs[docIdx], MakeArrayRef(&singleResult, 1));
+                UNIT_ASSERT_VALUES_EQUAL(singleResult, expected[docIdx]);
+            }
+        };
+
+        TVector<ui32> reversedOrder = xrange<ui32>(model.GetTreeCount());
+        Reverse(reversedOrder.begin(), reversedOrder.end());
+        model.ModelTrees.GetMutable()->ReorderTrees(reversedOrder, /*keepSummationOrder*/ true);
+        model.UpdateDynamicData();
+        UNIT_ASSERT_VALUES_EQUAL(model.ModelTrees->GetTreeSummationOrder(), reversedOrder);
+        checkPredictions(model);
+
+        model.ReorderTreesByFeatureLocality(/*lookahead*/ 256, /*keepSummationOrder*/ true);
+        checkPredictions(model);
+
+        TStringStream modelStream;
+        model.Save(&modelStream);
+        TFullModel loadedModel;
+        loadedModel.Load(&modelStream);
+        UNIT_ASSERT_EQUAL(*loadedModel.ModelTrees, *model.ModelTrees);
+        checkPredictions(loadedModel);
+
+        model.ReorderTreesByFeatureLocality();
+        UNIT_ASSERT(model.ModelTrees->GetTreeSummationOrder().empty());
+    }
 }
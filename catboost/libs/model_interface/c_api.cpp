@@ -1,23 +1,192 @@
 #include "c_api.h"
 
 #include <catboost/libs/cat_feature/cat_feature.h>
+#include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/model/model.h>
 
+#include <library/containers/stack_vector/stack_vec.h>
+#include <library/threading/local_executor/local_executor.h>
+
 #include <util/generic/singleton.h>
+#include <util/generic/utility.h>
+#include <util/generic/xrange.h>
 #include <util/stream/file.h>
 #include <util/string/builder.h>
 
-#define FULL_MODEL_PTR(x) ((TFullModel*)(x))
+#define MODEL_CALCER_PTR(x) ((TModelCalcer*)(x))
+#define FULL_MODEL_PTR(x) (&MODEL_CALCER_PTR(x)->Model)
+#define THREAD_POOL_PTR(x) ((NPar::TLocalExecutor*)(x))
+#define CONTEXT_PTR(x) ((TModelCalcerContext*)(x))
 
 
 struct TErrorMessageHolder {
     TString Message;
 };
 
+struct TModelCalcer {
+    TFullModel Model;
+    NPar::TLocalExecutor* ThreadPool = nullptr;
+};
+
+struct TModelCalcerContext {
+    const TModelCalcer* Calcer = nullptr;
+    NCB::NModelEvaluation::TConstModelEvaluatorPtr SourceEvaluator;
+    // per thread pool job, keep scratch buffers between calls
+    TVector<NCB::NModelEvaluation::TModelEvaluatorPtr> Evaluators;
+    TVector<TConstArrayRef<float>> TransposedFeatures;
+    TVector<TStringBuf> CatFeatureValues;
+    TVector<ui32> CatFeatureHashes;
+    TVector<float> CatFeatureFloatHashes;
+    TVector<TVector<TConstArrayRef<float>>> JobTransposedFeatures;
+};
+
+// smaller batches are not split between thread pool threads
+static constexpr size_t COLUMNAR_PREDICTION_MIN_JOB_SIZE = 1024;
+
+static void PrepareContextEvaluators(const TFullModel& model, size_t evaluatorCount, TModelCalcerContext* context) {
+    auto currentEvaluator = model.GetCurrentEvaluator();
+    if (context->SourceEvaluator != currentEvaluator) {
+        // model was reloaded or its evaluator type was changed
+        context->Evaluators.clear();
+        context->SourceEvaluator = currentEvaluator;
+    }
+    while (context->Evaluators.size() < evaluatorCount) {
+        auto evaluator = currentEvaluator->Clone();
+        if (model.GetEvaluatorType() == EFormulaEvaluatorType::CPU) {
+            evaluator->SetProperty(NCB::NModelEvaluation::ReuseBuffersPropertyName, "true");
+        }
+        context->Evaluators.push_back(std::move(evaluator));
+    }
+}
+
+static void PrepareTransposedFeatures(
+    const TFullModel& model,
+    NPar::TLocalExecutor* threadPool,
+    size_t docCount,
+    const float* floatFeatures, size_t floatFeaturesSize,
+    const char** catFeatures, size_t catFeaturesSize,
+    TModelCalcerContext* context
+) {
+    const auto& trees = *model.ModelTrees;
+    auto& transposedFeatures = context->TransposedFeatures;
+    transposedFeatures.assign(trees.GetFlatFeatureVectorExpectedSize(), TConstArrayRef<float>());
+    for (const auto& floatFeature : trees.GetFloatFeatures()) {
+        if (!floatFeature.UsedInModel()) {
+            continue;
+        }
+        const auto& position = floatFeature.Position;
+        CB_ENSURE(
+            (size_t)position.Index < floatFeaturesSize,
+            "Insufficient float features count: " << floatFeaturesSize << ", model uses feature " << position.Index);
+        transposedFeatures[position.FlatIndex] = MakeArrayRef(floatFeatures + position.Index * docCount, docCount);
+    }
+
+    TVector<TFeaturePosition> usedCatFeatures;
+    for (const auto& catFeature : trees.GetCatFeatures()) {
+        if (catFeature.UsedInModel()) {
+            CB_ENSURE(
+                (size_t)catFeature.Position.Index < catFeaturesSize,
+                "Insufficient categorical features count: " << catFeaturesSize
+                << ", model uses feature " << catFeature.Position.Index);
+            usedCatFeatures.push_back(catFeature.Position);
+        }
+    }
+    const size_t catValueCount = usedCatFeatures.size() * docCount;
+    context->CatFeatureValues.yresize(catValueCount);
+    context->CatFeatureHashes.yresize(catValueCount);
+    context->CatFeatureFloatHashes.yresize(catValueCount);
+    const auto hashCatFeature = [&] (int usedCatFeatureIdx) {
+        const size_t offset = usedCatFeatureIdx * docCount;
+        const char** column = catFeatures + usedCatFeatures[usedCatFeatureIdx].Index * docCount;
+        auto values = MakeArrayRef(context->CatFeatureValues).Slice(offset, docCount);
+        for (auto docIdx : xrange(docCount)) {
+            values[docIdx] = column[docIdx];
+        }
+        auto hashes = MakeArrayRef(context->CatFeatureHashes).Slice(offset, docCount);
+        CalcCatFeatureHashes(values, hashes);
+        auto floatHashes = MakeArrayRef(context->CatFeatureFloatHashes).Slice(offset, docCount);
+        for (auto docIdx : xrange(docCount)) {
+            floatHashes[docIdx] = ConvertCatFeatureHashToFloat(hashes[docIdx]);
+        }
+        transposedFeatures[usedCatFeatures[usedCatFeatureIdx].FlatIndex] = floatHashes;
+    };
+    if (threadPool) {
+        threadPool->ExecRangeWithThrow(
+            hashCatFeature,
+            0,
+            SafeIntegerCast<int>(usedCatFeatures.size()),
+            NPar::TLocalExecutor::WAIT_COMPLETE);
+    } else {
+        for (auto usedCatFeatureIdx : xrange(usedCatFeatures.size())) {
+            hashCatFeature(usedCatFeatureIdx);
+        }
+    }
+}
+
+static void CalcColumnarPrediction(
+    const TModelCalcer& calcer,
+    size_t docCount,
+    const float* floatFeatures, size_t floatFeaturesSize,
+    const char** catFeatures, size_t catFeaturesSize,
+    TArrayRef<double> result,
+    TModelCalcerContext* context
+) {
+    const TFullModel& model = calcer.Model;
+    CB_ENSURE(
+        result.size() == docCount * model.GetDimensionsCount(),
+        "Result size should be " << docCount * model.GetDimensionsCount() << ", got " << result.size());
+    CB_ENSURE(!model.HasTextFeatures(), "Columnar prediction is not supported for models with text features");
+    if (docCount == 0) {
+        return;
+    }
+    NPar::TLocalExecutor* threadPool = calcer.ThreadPool;
+    PrepareTransposedFeatures(
+        model,
+        threadPool,
+        docCount,
+        floatFeatures, floatFeaturesSize,
+        catFeatures, catFeaturesSize,
+        context);
+
+    const size_t resultsPerDoc = result.size() / docCount;
+    const size_t jobCount = threadPool
+        ? Min<size_t>(threadPool->GetThreadCount() + 1, CeilDiv(docCount, COLUMNAR_PREDICTION_MIN_JOB_SIZE))
+        : 1;
+    PrepareContextEvaluators(model, jobCount, context);
+    if (jobCount == 1) {
+        context->Evaluators[0]->CalcFlatTransposed(context->TransposedFeatures, result);
+        return;
+    }
+
+    // each job owns an evaluator and a features view, so their buffers are never shared between threads
+    const size_t jobDocCount = CeilDiv(docCount, jobCount);
+    context->JobTransposedFeatures.resize(jobCount);
+    threadPool->ExecRangeWithThrow(
+        [&] (int jobIdx) {
+            const size_t jobStart = Min(jobIdx * jobDocCount, docCount);
+            const size_t jobSize = Min(jobDocCount, docCount - jobStart);
+            if (jobSize == 0) {
+                return;
+            }
+            auto& jobTransposedFeatures = context->JobTransposedFeatures[jobIdx];
+            jobTransposedFeatures.resize(context->TransposedFeatures.size());
+            for (auto flatFeatureIdx : xrange(context->TransposedFeatures.size())) {
+                const auto column = context->TransposedFeatures[flatFeatureIdx];
+                jobTransposedFeatures[flatFeatureIdx] = column.empty() ? column : column.Slice(jobStart, jobSize);
+            }
+            context->Evaluators[jobIdx]->CalcFlatTransposed(
+                jobTransposedFeatures,
+                result.Slice(jobStart * resultsPerDoc, jobSize * resultsPerDoc));
+        },
+        0,
+        SafeIntegerCast<int>(jobCount),
+        NPar::TLocalExecutor::WAIT_COMPLETE);
+}
+
 extern "C" {
 EXPORT ModelCalcerHandle* ModelCalcerCreate() {
     try {
-        return new TFullModel;
+        return new TModelCalcer;
     } catch (...) {
         Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
     }
@@ -31,7 +200,7 @@ EXPORT const char* GetErrorString() {
 
 EXPORT void ModelCalcerDelete(ModelCalcerHandle* modelHandle) {
     if (modelHandle != nullptr) {
-        delete FULL_MODEL_PTR(modelHandle);
+        delete MODEL_CALCER_PTR(modelHandle);
     }
 }
 
@@ -69,6 +238,55 @@ EXPORT bool EnableGPUEvaluation(ModelCalcerHandle* modelHandle, int deviceId) {
     return true;
 }
 
+EXPORT ModelCalcerThreadPoolHandle* ModelCalcerThreadPoolCreate(size_t threadCount) {
+    try {
+        CB_ENSURE(threadCount > 0, "Thread count should be positive");
+        auto threadPool = MakeHolder<NPar::TLocalExecutor>();
+        threadPool->RunAdditionalThreads(SafeIntegerCast<int>(threadCount - 1));
+        return threadPool.Release();
+    } catch (...) {
+        Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
+    }
+
+    return nullptr;
+}
+
+EXPORT void ModelCalcerThreadPoolDelete(ModelCalcerThreadPoolHandle* threadPoolHandle) {
+    if (threadPoolHandle != nullptr) {
+        delete THREAD_POOL_PTR(threadPoolHandle);
+    }
+}
+
+EXPORT bool SetModelCalcerThreadPool(ModelCalcerHandle* modelHandle, ModelCalcerThreadPoolHandle* threadPoolHandle) {
+    try {
+        CB_ENSURE(modelHandle != nullptr, "Model handle is null");
+        MODEL_CALCER_PTR(modelHandle)->ThreadPool = THREAD_POOL_PTR(threadPoolHandle);
+    } catch (...) {
+        Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
+        return false;
+    }
+    return true;
+}
+
+EXPORT ModelCalcerContextHandle* ModelCalcerContextCreate(ModelCalcerHandle* modelHandle) {
+    try {
+        CB_ENSURE(modelHandle != nullptr, "Model handle is null");
+        auto context = MakeHolder<TModelCalcerContext>();
+        context->Calcer = MODEL_CALCER_PTR(modelHandle);
+        return context.Release();
+    } catch (...) {
+        Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
+    }
+
+    return nullptr;
+}
+
+EXPORT void ModelCalcerContextDelete(ModelCalcerContextHandle* contextHandle) {
+    if (contextHandle != nullptr) {
+        delete CONTEXT_PTR(contextHandle);
+    }
+}
+
 EXPORT bool CalcModelPredictionFlat(ModelCalcerHandle* modelHandle, size_t docCount, const float** floatFeatures, size_t floatFeaturesSize, double* result, size_t resultSize) {
     try {
         if (docCount == 1) {
@@ -116,13 +334,17 @@ EXPORT bool CalcModelPredictionSingle(
         const char** catFeatures, size_t catFeaturesSize,
         double* result, size_t resultSize) {
     try {
-        TVector<TConstArrayRef<float>> floatFeaturesVec(1);
-        TVector<TVector<TStringBuf>> catFeaturesVec(1, TVector<TStringBuf>(catFeaturesSize));
-        floatFeaturesVec[0] = TConstArrayRef<float>(floatFeatures, floatFeaturesSize);
+        // stack storage only, the evaluator itself doesn't allocate for single documents
+        TStackVec<TStringBuf, 64> catFeaturesBuf(catFeaturesSize);
         for (size_t catFeatureIdx = 0; catFeatureIdx < catFeaturesSize; ++catFeatureIdx) {
-            catFeaturesVec[0][catFeatureIdx] = catFeatures[catFeatureIdx];
+            catFeaturesBuf[catFeatureIdx] = catFeatures[catFeatureIdx];
         }
-        FULL_MODEL_PTR(modelHandle)->Calc(floatFeaturesVec, catFeaturesVec, TArrayRef<double>(result, resultSize));
+        const TConstArrayRef<float> floatFeaturesArray[] = {TConstArrayRef<float>(floatFeatures, floatFeaturesSize)};
+        const TConstArrayRef<TStringBuf> catFeaturesArray[] = {MakeConstArrayRef(catFeaturesBuf)};
+        FULL_MODEL_PTR(modelHandle)->GetCurrentEvaluator()->Calc<TStringBuf>(
+            floatFeaturesArray,
+            catFeaturesArray,
+            TArrayRef<double>(result, resultSize));
     } catch (...) {
         Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
         return false;
@@ -149,6 +371,33 @@ EXPORT bool CalcModelPredictionWithHashedCatFeatures(ModelCalcerHandle* modelHan
     return true;
 }
 
+EXPORT bool CalcModelPredictionColumnar(
+        ModelCalcerHandle* modelHandle,
+        ModelCalcerContextHandle* contextHandle,
+        size_t docCount,
+        const float* floatFeatures, size_t floatFeaturesSize,
+        const char** catFeatures, size_t catFeaturesSize,
+        double* result, size_t resultSize) {
+    try {
+        TModelCalcerContext localContext;
+        TModelCalcerContext* context = contextHandle ? CONTEXT_PTR(contextHandle) : &localContext;
+        CB_ENSURE(
+            !contextHandle || context->Calcer == MODEL_CALCER_PTR(modelHandle),
+            "Prediction context was created for another model handle");
+        CalcColumnarPrediction(
+            *MODEL_CALCER_PTR(modelHandle),
+            docCount,
+            floatFeatures, floatFeaturesSize,
+            catFeatures, catFeaturesSize,
+            TArrayRef<double>(result, resultSize),
+            context);
+    } catch (...) {
+        Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
+        return false;
+    }
+    return true;
+}
+
 EXPORT int GetStringCatFeatureHash(const char* data, size_t size) {
     return CalcCatFeatureHash(TStringBuf(data, size));
 }
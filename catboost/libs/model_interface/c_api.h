@@ -18,6 +18,8 @@ extern "C" {
 #endif
 
 typedef void ModelCalcerHandle;
+typedef void ModelCalcerThreadPoolHandle;
+typedef void ModelCalcerContextHandle;
 
 /**
  * Create empty model handle
@@ -65,6 +67,43 @@ EXPORT bool LoadFullModelFromBuffer(
 */
 EXPORT bool EnableGPUEvaluation(ModelCalcerHandle* modelHandle, int deviceId);
 
+/**
+ * Create thread pool for model evaluation. One pool can be shared by several model handles.
+ * @param threadCount total number of threads used for evaluation, including the calling thread
+ * @return nullptr if error occured
+ */
+EXPORT ModelCalcerThreadPoolHandle* ModelCalcerThreadPoolCreate(size_t threadCount);
+
+/**
+ * Delete thread pool. Model handles that use it should be detached or deleted before.
+ * @param threadPoolHandle
+ */
+EXPORT void ModelCalcerThreadPoolDelete(ModelCalcerThreadPoolHandle* threadPoolHandle);
+
+/**
+ * Use thread pool for columnar predictions of the model, batches are split between pool threads.
+ * @param calcer model handle
+ * @param threadPoolHandle thread pool handle, nullptr to evaluate in the calling thread
+ * @return false if error occured
+ */
+EXPORT bool SetModelCalcerThreadPool(
+    ModelCalcerHandle* modelHandle,
+    ModelCalcerThreadPoolHandle* threadPoolHandle);
+
+/**
+ * Create prediction context that keeps evaluation buffers between calls, so repeated predictions don't allocate
+ * memory when batch sizes don't grow. Context should be used by one thread at a time.
+ * @param calcer model handle
+ * @return nullptr if error occured
+ */
+EXPORT ModelCalcerContextHandle* ModelCalcerContextCreate(ModelCalcerHandle* modelHandle);
+
+/**
+ * Delete prediction context
+ * @param contextHandle
+ */
+EXPORT void ModelCalcerContextDelete(ModelCalcerContextHandle* contextHandle);
+
 /**
  * **Use this method only if you really understand what you want.**
  * Calculate raw model predictions on flat feature vectors
@@ -145,6 +184,29 @@ EXPORT bool CalcModelPredictionWithHashedCatFeatures(
     const int** catFeatures, size_t catFeaturesSize,
     double* result, size_t resultSize);
 
+/**
+ * Calculate raw model predictions on features stored by columns
+ * @param calcer model handle
+ * @param contextHandle prediction context created for this model handle, can be nullptr
+ * @param docCount object count
+ * @param floatFeatures contiguous float feature values, value of feature i for object j is floatFeatures[i * docCount + j]
+ * @param floatFeaturesSize float feature count
+ * @param catFeatures contiguous categorical value pointers, value of feature i for object j is
+ * catFeatures[i * docCount + j]. String pointer should point to zero terminated string.
+ * @param catFeaturesSize categorical feature count
+ * @param result pointer to user allocated results vector
+ * @param resultSize result size should be equal to modelApproxDimension * docCount
+ * (e.g. for non multiclass models should be equal to docCount)
+ * @return false if error occured
+ */
+EXPORT bool CalcModelPredictionColumnar(
+    ModelCalcerHandle* modelHandle,
+    ModelCalcerContextHandle* contextHandle,
+    size_t docCount,
+    const float* floatFeatures, size_t floatFeaturesSize,
+    const char** catFeatures, size_t catFeaturesSize,
+    double* result, size_t resultSize);
+
 /**
  * Get hash for given string value
  * @param data we don't expect data to be zero terminated, so pass correct size
@@ -0,0 +1,188 @@
+#include <catboost/libs/model_interface/c_api.h>
+
+#include <catboost/libs/model/ut/lib/model_test_helpers.h>
+
+#include <library/unittest/registar.h>
+
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+
+struct TTestFeatures {
+    size_t DocCount = 0;
+    size_t FloatFeatureCount = 0;
+    size_t CatFeatureCount = 0;
+    // feature-major, as expected by CalcModelPredictionColumnar
+    TVector<float> FloatColumns;
+    TVector<TString> CatValues;
+    TVector<const char*> CatColumns;
+
+public:
+    TTestFeatures(ModelCalcerHandle* modelHandle, size_t docCount)
+        : DocCount(docCount)
+        , FloatFeatureCount(GetFloatFeaturesCount(modelHandle))
+        , CatFeatureCount(GetCatFeaturesCount(modelHandle))
+    {
+        TFastRng64 rng(0);
+        FloatColumns.resize(FloatFeatureCount * DocCount);
+        for (auto& value : FloatColumns) {
+            value = rng.GenRandReal1();
+        }
+        const TVector<TString> catFeatureValues = {"a", "b", "c", "d", "e", "f", "g", "h", "k", "unknown"};
+        for (auto i : xrange(CatFeatureCount * DocCount)) {
+            Y_UNUSED(i);
+            CatValues.push_back(catFeatureValues[rng.Uniform(catFeatureValues.size())]);
+        }
+        for (const auto& value : CatValues) {
+            CatColumns.push_back(value.c_str());
+        }
+    }
+
+    TVector<double> CalcRowwise(ModelCalcerHandle* modelHandle) const {
+        TVector<TVector<float>> floatRows(DocCount, TVector<float>(FloatFeatureCount));
+        TVector<TVector<const char*>> catRows(DocCount, TVector<const char*>(CatFeatureCount));
+        TVector<const float*> floatRowPtrs;
+        TVector<const char**> catRowPtrs;
+        for (auto docIdx : xrange(DocCount)) {
+            for (auto featureIdx : xrange(FloatFeatureCount)) {
+                floatRows[docIdx][featureIdx] = FloatColumns[featureIdx * DocCount + docIdx];
+            }
+            for (auto featureIdx : xrange(CatFeatureCount)) {
+                catRows[docIdx][featureIdx] = CatColumns[featureIdx * DocCount + docIdx];
+            }
+            floatRowPtrs.push_back(floatRows[docIdx].data());
+            catRowPtrs.push_back(catRows[docIdx].data());
+        }
+        TVector<double> result(DocCount * GetDimensionsCount(modelHandle));
+        UNIT_ASSERT_C(
+            CalcModelPrediction(
+                modelHandle,
+                DocCount,
+                floatRowPtrs.data(), FloatFeatureCount,
+                catRowPtrs.data(), CatFeatureCount,
+                result.data(), result.size()),
+            GetErrorString());
+        return result;
+    }
+
+    TVector<double> CalcColumnar(ModelCalcerHandle* modelHandle, ModelCalcerContextHandle* contextHandle) const {
+        TVector<double> result(DocCount * GetDimensionsCount(modelHandle));
+        UNIT_ASSERT_C(
+            CalcModelPredictionColumnar(
+                modelHandle,
+                contextHandle,
+                DocCount,
+                FloatColumns.data(), FloatFeatureCount,
+                const_cast<const char**>(CatColumns.data()), CatFeatureCount,
+                result.data(), result.size()),
+            GetErrorString());
+        return result;
+    }
+};
+
+static void AssertPredictionsEqual(const TVector<double>& expected, const TVector<double>& result) {
+    UNIT_ASSERT_VALUES_EQUAL(expected.size(), result.size());
+    for (auto idx : xrange(expected.size())) {
+        UNIT_ASSERT_DOUBLES_EQUAL(expected[idx], result[idx], 1e-9);
+    }
+}
+
+static ModelCalcerHandle* CreateModelCalcer(const TFullModel& model) {
+    ModelCalcerHandle* modelHandle = ModelCalcerCreate();
+    UNIT_ASSERT(modelHandle);
+    const TString serializedModel = SerializeModel(model);
+    UNIT_ASSERT_C(
+        LoadFullModelFromBuffer(modelHandle, serializedModel.data(), serializedModel.size()),
+        GetErrorString());
+    return modelHandle;
+}
+
+
+Y_UNIT_TEST_SUITE(CApiTests) {
+    Y_UNIT_TEST(ColumnarPredictionEqualsRowwise) {
+        for (const auto& model : {TrainFloatCatboostModel(10), TrainCatOnlyModel()}) {
+            ModelCalcerHandle* modelHandle = CreateModelCalcer(model);
+            // a single small batch, and a batch split between thread pool jobs
+            for (size_t docCount : {1, 100, 5000}) {
+                const TTestFeatures features(modelHandle, docCount);
+                const auto expected = features.CalcRowwise(modelHandle);
+                AssertPredictionsEqual(expected, features.CalcColumnar(modelHandle, /*contextHandle*/ nullptr));
+
+                ModelCalcerThreadPoolHandle* threadPoolHandle = ModelCalcerThreadPoolCreate(4);
+                UNIT_ASSERT_C(threadPoolHandle, GetErrorString());
+                UNIT_ASSERT_C(SetModelCalcerThreadPool(modelHandle, threadPoolHandle), GetErrorString());
+                AssertPredictionsEqual(expected, features.CalcColumnar(modelHandle, /*contextHandle*/ nullptr));
+                UNIT_ASSERT(SetModelCalcerThreadPool(modelHandle, nullptr));
+                ModelCalcerThreadPoolDelete(threadPoolHandle);
+            }
+            ModelCalcerDelete(modelHandle);
+        }
+    }
+
+    Y_UNIT_TEST(ThreadPoolAndContextLifecycle) {
+        const auto model = TrainCatOnlyModel();
+        ModelCalcerHandle* modelHandle = CreateModelCalcer(model);
+        ModelCalcerHandle* otherModelHandle = CreateModelCalcer(model);
+
+        ModelCalcerThreadPoolHandle* threadPoolHandle = ModelCalcerThreadPoolCreate(3);
+        UNIT_ASSERT_C(threadPoolHandle, GetErrorString());
+        // one pool is shared by several model handles
+        UNIT_ASSERT(SetModelCalcerThreadPool(modelHandle, threadPoolHandle));
+        UNIT_ASSERT(SetModelCalcerThreadPool(otherModelHandle, threadPoolHandle));
+
+        ModelCalcerContextHandle* contextHandle = ModelCalcerContextCreate(modelHandle);
+        UNIT_ASSERT_C(contextHandle, GetErrorString());
+
+        // context buffers are reused for batches of the same, smaller and bigger sizes
+        for (size_t docCount : {3000, 3000, 10, 6000}) {
+            const TTestFeatures features(modelHandle, docCount);
+            const auto expected = features.CalcRowwise(modelHandle);
+            AssertPredictionsEqual(expected, features.CalcColumnar(modelHandle, contextHandle));
+        }
+
+        // the context is bound to its model handle
+        {
+            const TTestFeatures features(otherModelHandle, 10);
+            TVector<double> result(features.DocCount);
+            UNIT_ASSERT(!CalcModelPredictionColumnar(
+                otherModelHandle,
+                contextHandle,
+                features.DocCount,
+                features.FloatColumns.data(), features.FloatFeatureCount,
+                const_cast<const char**>(features.CatColumns.data()), features.CatFeatureCount,
+                result.data(), result.size()));
+            UNIT_ASSERT(TStringBuf(GetErrorString()).Contains("another model handle"));
+        }
+
+        // context stays valid after the pool is detached
+        UNIT_ASSERT(SetModelCalcerThreadPool(modelHandle, nullptr));
+        UNIT_ASSERT(SetModelCalcerThreadPool(otherModelHandle, nullptr));
+        ModelCalcerThreadPoolDelete(threadPoolHandle);
+        {
+            const TTestFeatures features(modelHandle, 2000);
+            AssertPredictionsEqual(features.CalcRowwise(modelHandle), features.CalcColumnar(modelHandle, contextHandle));
+        }
+
+        ModelCalcerContextDelete(contextHandle);
+        ModelCalcerDelete(otherModelHandle);
+        ModelCalcerDelete(modelHandle);
+
+        // deleting null handles is a no-op
+        ModelCalcerContextDelete(nullptr);
+        ModelCalcerThreadPoolDelete(nullptr);
+    }
+
+    Y_UNIT_TEST(InvalidHandles) {
+        UNIT_ASSERT(!ModelCalcerThreadPoolCreate(0));
+        UNIT_ASSERT(TStringBuf(GetErrorString()).Contains("Thread count"));
+
+        ModelCalcerThreadPoolHandle* threadPoolHandle = ModelCalcerThreadPoolCreate(2);
+        UNIT_ASSERT_C(threadPoolHandle, GetErrorString());
+        UNIT_ASSERT(!SetModelCalcerThreadPool(nullptr, threadPoolHandle));
+        UNIT_ASSERT(TStringBuf(GetErrorString()).Contains("Model handle is null"));
+        ModelCalcerThreadPoolDelete(threadPoolHandle);
+
+        UNIT_ASSERT(!ModelCalcerContextCreate(nullptr));
+        UNIT_ASSERT(TStringBuf(GetErrorString()).Contains("Model handle is null"));
+    }
+}
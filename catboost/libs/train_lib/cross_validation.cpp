@@ -23,6 +23,7 @@
 #include <catboost/private/libs/options/plain_options_helper.h>
 
 #include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
 #include <util/generic/mapfindptr.h>
 #include <util/generic/scope.h>
 #include <util/generic/ymath.h>
@@ -184,7 +185,7 @@ TFoldContext::TFoldContext(
 class TCrossValidationCallbacks : public ITrainingCallbacks {
 public:
     TCrossValidationCallbacks(
-        ELoggingLevel loggingLevel,
+        TMaybe<ELoggingLevel> loggingLevel,
         double maxTimeSpentOnFixedCostRatio,
         ui32 maxIterationsBatchSize,
         size_t globalMaxIteration,
@@ -218,7 +219,11 @@ public:
         }
 
         if (!*UpToIteration) {
-            TSetLogging inThisScope(LoggingLevel);
+            // logging settings are global, so they are left untouched for folds trained concurrently
+            TMaybe<TSetLogging> inThisScope;
+            if (LoggingLevel) {
+                inThisScope.ConstructInPlace(*LoggingLevel);
+            }
 
             BatchIterationsTime += metricsAndTimeHistory.TimeHistory.back().IterationTime;
 
@@ -261,7 +266,7 @@ public:
 
 private:
     size_t BatchStartIteration;
-    ELoggingLevel LoggingLevel;
+    TMaybe<ELoggingLevel> LoggingLevel;
     double MaxTimeSpentOnFixedCostRatio;
     ui32 MaxIterationsBatchSize;
     size_t GlobalMaxIteration;
@@ -285,15 +290,12 @@ void TrainBatch(
     ui32 maxIterationsBatchSize,
     size_t globalMaxIteration,
     bool isErrorTrackerActive,
-    ELoggingLevel loggingLevel,
+    TMaybe<ELoggingLevel> loggingLevel, // if not defined logging settings are not changed
     TFoldContext* foldContext,
     IModelTrainer* modelTrainer,
     NPar::TLocalExecutor* localExecutor,
     TMaybe<ui32>* upToIteration) { // exclusive bound, if not inited - init from profile data
 
-    // don't output data from folds training
-    TSetLoggingSilent silentMode;
-
     const size_t batchStartIteration = foldContext->MetricValuesOnTest.size();
     Y_ASSERT(
         !batchStartIteration ||
@@ -688,6 +690,30 @@ void CrossValidate(
 
     TProfileInfo profile(globalMaxIteration);
 
+    /* Folds share quantized features data (and borders via QuantizedFeaturesInfo) by reference,
+     * so concurrent training only requires splitting threads between folds.
+     * Each worker gets its own executor with an equal share of threads and trains every
+     * parallelFoldCount-th fold.
+     */
+    const ui32 parallelFoldCount = Min(cvParams.ParallelFoldCount, cvParams.FoldCount);
+    CB_ENSURE(
+        (parallelFoldCount == 1) || (taskType == ETaskType::CPU),
+        "Parallel folds training in Cross-validation is supported only on CPU"
+    );
+    TVector<THolder<NPar::TLocalExecutor>> foldsExecutors;
+    if (parallelFoldCount > 1) {
+        const int threadsPerFold = Max(1, (localExecutor->GetThreadCount() + 1) / (int)parallelFoldCount);
+        CATBOOST_INFO_LOG << "CrossValidation: train " << parallelFoldCount << " folds concurrently with "
+            << threadsPerFold << " threads each" << Endl;
+        for (auto workerIdx : xrange(parallelFoldCount)) {
+            Y_UNUSED(workerIdx);
+            foldsExecutors.push_back(MakeHolder<NPar::TLocalExecutor>());
+            foldsExecutors.back()->RunAdditionalThreads(threadsPerFold - 1);
+        }
+    }
+
+    TVector<double> foldsTrainTime(foldContexts.size(), 0.0); // [foldIdx], in sec
+
     ui32 iteration = 0;
     ui32 batchStartIteration = 0;
 
@@ -702,7 +728,12 @@ void CrossValidate(
          */
         TMaybe<ui32> batchEndIteration;
 
-        for (auto foldIdx : xrange(foldContexts.size())) {
+        const auto trainFoldBatch = [&] (
+            ui32 foldIdx,
+            TMaybe<ELoggingLevel> foldLoggingLevel,
+            NPar::TLocalExecutor* foldExecutor,
+            TMaybe<ui32>* foldBatchEndIteration) {
+
             THPTimer timer;
 
             TrainBatch(
@@ -716,16 +747,65 @@ void CrossValidate(
                 cvParams.DevMaxIterationsBatchSize,
                 globalMaxIteration,
                 errorTracker.IsActive(),
-                loggingLevel,
+                foldLoggingLevel,
                 &foldContexts[foldIdx],
                 modelTrainerHolder.Get(),
-                localExecutor,
-                &batchEndIteration);
-
-            Y_ASSERT(batchEndIteration); // should be inited right after the first iteration of the first fold
-            CATBOOST_INFO_LOG << "CrossValidation: Processed batch of iterations [" << batchStartIteration
-                << ',' << *batchEndIteration << ") for fold " << foldIdx << '/' << cvParams.FoldCount
-                << " in " << FloatToString(timer.Passed(), PREC_NDIGITS, 2) << " sec" << Endl;
+                foldExecutor,
+                foldBatchEndIteration);
+
+            Y_ASSERT(*foldBatchEndIteration); // should be inited right after the first iteration of the fold
+            const double batchTime = timer.Passed();
+            foldsTrainTime[foldIdx] += batchTime;
+            return batchTime;
+        };
+
+        if (parallelFoldCount > 1) {
+            // batch size is always 1 on CPU, so every fold comes to the same batch end independently
+            TVector<TMaybe<ui32>> foldsBatchEndIteration(foldContexts.size());
+            TVector<double> foldsBatchTime(foldContexts.size(), 0.0);
+            {
+                /* logging settings are global, so folds are silenced once here
+                 * and folds' threads don't switch them concurrently
+                 */
+                TSetLoggingSilent silentMode;
+
+                localExecutor->ExecRangeWithThrow(
+                    [&] (int workerIdx) {
+                        for (ui32 foldIdx = workerIdx; foldIdx < foldContexts.size(); foldIdx += parallelFoldCount) {
+                            foldsBatchTime[foldIdx] = trainFoldBatch(
+                                foldIdx,
+                                /*foldLoggingLevel*/ Nothing(),
+                                foldsExecutors[workerIdx].Get(),
+                                &foldsBatchEndIteration[foldIdx]);
+                        }
+                    },
+                    0,
+                    SafeIntegerCast<int>(parallelFoldCount),
+                    NPar::TLocalExecutor::WAIT_COMPLETE
+                );
+            }
+            batchEndIteration = foldsBatchEndIteration[0];
+            for (auto foldIdx : xrange(foldContexts.size())) {
+                CB_ENSURE_INTERNAL(
+                    foldsBatchEndIteration[foldIdx] == batchEndIteration,
+                    "Folds trained concurrently have different batch end iterations"
+                );
+                CATBOOST_INFO_LOG << "CrossValidation: Processed batch of iterations [" << batchStartIteration
+                    << ',' << *batchEndIteration << ") for fold " << foldIdx << '/' << cvParams.FoldCount
+                    << " in " << FloatToString(foldsBatchTime[foldIdx], PREC_NDIGITS, 2) << " sec" << Endl;
+            }
+        } else {
+            for (auto foldIdx : xrange(foldContexts.size())) {
+                double batchTime;
+                {
+                    // don't output data from folds training
+                    TSetLoggingSilent silentMode;
+                    batchTime = trainFoldBatch(foldIdx, loggingLevel, localExecutor, &batchEndIteration);
+                }
+                CATBOOST_INFO_LOG << "CrossValidation: Processed batch of iterations [" << batchStartIteration
+                    << ',' << *batchEndIteration << ") for fold " << foldIdx << '/' << cvParams.FoldCount
+                    << " in " << FloatToString(batchTime, PREC_NDIGITS, 2) << " sec" << Endl;
+            }
         }
 
         while (true) {
@@ -812,6 +892,17 @@ void CrossValidate(
         }
     }
 
+    for (auto foldIdx : xrange(foldContexts.size())) {
+        const double foldTrainTime = foldsTrainTime[foldIdx];
+        CATBOOST_INFO_LOG << "CrossValidation: fold " << foldIdx << '/' << cvParams.FoldCount
+            << ": " << iteration << " iterations in " << FloatToString(foldTrainTime, PREC_NDIGITS, 2) << " sec";
+        if (foldTrainTime > 0.0) {
+            CATBOOST_INFO_LOG << " (" << FloatToString(iteration / foldTrainTime, PREC_NDIGITS, 3)
+                << " iterations/sec)";
+        }
+        CATBOOST_INFO_LOG << Endl;
+    }
+
     if (cvParams.IsCalledFromSearchHyperparameters) {
         const int lastIteration = iteration - 1;
         for (int metricIdx = 0; metricIdx < metrics.ysize(); ++metricIdx) {
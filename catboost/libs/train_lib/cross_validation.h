@@ -208,7 +208,7 @@ void TrainBatch(
     ui32 maxIterationsBatchSize,
     size_t globalMaxIteration,
     bool isErrorTrackerActive,
-    ELoggingLevel loggingLevel,
+    TMaybe<ELoggingLevel> loggingLevel, // if not defined logging settings are not changed
     TFoldContext* foldContext,
     IModelTrainer* modelTrainer,
     NPar::TLocalExecutor* localExecutor,
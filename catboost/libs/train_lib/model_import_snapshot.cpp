@@ -17,7 +17,7 @@ namespace NCB{
             CB_ENSURE(NFs::Exists(snapshotPath), "Model file doesn't exist: " << snapshotPath);
             TLearnProgress learnProgress;
             TProfileInfoData profileRestored;
-            TProgressHelper(ToString(ETaskType::CPU)).CheckedLoad(snapshotPath, [&](TIFStream* in) {
+            TProgressHelper(ToString(ETaskType::CPU)).CheckedLoad(snapshotPath, [&](IInputStream* in) {
                 learnProgress.Load(in);
                 ::Load(in, profileRestored);
             });
@@ -0,0 +1,222 @@
+#include "quantized_pool_cache.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/logging/logging.h>
+#include <catboost/private/libs/quantized_pool/serialization.h>
+
+#include <library/digest/md5/md5.h>
+
+#include <util/folder/path.h>
+#include <util/generic/guid.h>
+#include <util/generic/vector.h>
+#include <util/stream/file.h>
+#include <util/string/builder.h>
+#include <util/string/cast.h>
+#include <util/string/escape.h>
+#include <util/string/join.h>
+#include <util/system/fs.h>
+#include <util/system/fstat.h>
+
+
+namespace NCB {
+
+    // change when the cached pool contents or the key composition change
+    static constexpr ui32 QuantizedPoolCacheFormatVersion = 2;
+
+    static const TString QuantizedPoolCacheKeyFileName = "key";
+    static const TString QuantizedPoolCacheDataFileName = "pool.qbin";
+
+
+    template <class T>
+    static void AddToKey(TStringBuf name, const T& value, TStringBuilder* key) {
+        *key << name << '\t' << EscapeC(ToString(value)) << '\n';
+    }
+
+    template <class T>
+    static void AddToKey(TStringBuf name, const TVector<T>& values, TStringBuilder* key) {
+        AddToKey(name, JoinSeq(",", values), key);
+    }
+
+    static void AddFileToKey(TStringBuf name, const TPathWithScheme& path, TStringBuilder* key) {
+        if (!path.Inited()) {
+            AddToKey(name, TStringBuf("none"), key);
+            return;
+        }
+        AddToKey(name, path.Scheme + ":" + ToString(GetFileLength(path.Path)) + ":" + MD5::File(path.Path), key);
+    }
+
+    static void AddBinarizationOptionsToKey(
+        TStringBuf name,
+        const NCatboostOptions::TBinarizationOptions& binarizationOptions,
+        TStringBuilder* key
+    ) {
+        AddToKey(
+            name,
+            TStringBuilder() << binarizationOptions.BorderSelectionType.Get()
+                << ',' << binarizationOptions.BorderCount.Get()
+                << ',' << binarizationOptions.NanMode.Get(),
+            key);
+    }
+
+    TString CalcQuantizedLearnPoolCacheKey(
+        const NCatboostOptions::TPoolLoadParams& loadOptions,
+        const NCatboostOptions::TCatBoostOptions& catBoostOptions,
+        EObjectsOrder objectsOrder,
+        TConstArrayRef<TString> classNames
+    ) {
+        TStringBuilder key;
+        AddToKey("version", QuantizedPoolCacheFormatVersion, &key);
+
+        // data: group weights and baseline are stored in the cached pool, pairs are not
+        AddFileToKey("learn", loadOptions.LearnSetPath, &key);
+        AddFileToKey("cd", loadOptions.ColumnarPoolFormatParams.CdFilePath, &key);
+        AddFileToKey("group_weights", loadOptions.GroupWeightsFilePath, &key);
+        AddFileToKey("baseline", loadOptions.BaselineFilePath, &key);
+
+        const auto& dsvFormat = loadOptions.ColumnarPoolFormatParams.DsvFormat;
+        AddToKey("has_header", dsvFormat.HasHeader, &key);
+        AddToKey("delimiter", dsvFormat.Delimiter, &key);
+        AddToKey("load_ignored_features", loadOptions.IgnoredFeatures, &key);
+        AddToKey("objects_order", objectsOrder, &key);
+        AddToKey("class_names_count", classNames.size(), &key);
+        for (const auto& className : classNames) {
+            AddToKey("class_name", className, &key);
+        }
+
+        // quantization
+        const auto& dataProcessingOptions = catBoostOptions.DataProcessingOptions.Get();
+        AddToKey("ignored_features", dataProcessingOptions.IgnoredFeatures.Get(), &key);
+        AddBinarizationOptionsToKey("float_features_binarization", dataProcessingOptions.FloatFeaturesBinarization.Get(), &key);
+        for (const auto& [flatFeatureIdx, binarizationOptions] : dataProcessingOptions.PerFloatFeatureQuantization.Get()) {
+            AddBinarizationOptionsToKey("per_float_feature_quantization:" + ToString(flatFeatureIdx), binarizationOptions, &key);
+        }
+        AddToKey("border_sketch_rank_error", dataProcessingOptions.DevBorderSketchRankError.Get(), &key);
+        // borders for big pools are built on a random subsample
+        AddToKey("random_seed", catBoostOptions.RandomSeed.Get(), &key);
+
+        return key;
+    }
+
+    TString TQuantizedLearnPoolCacheEntry::GetPoolPath() const {
+        return JoinFsPaths(Dir, QuantizedPoolCacheDataFileName);
+    }
+
+    TString TQuantizedLearnPoolCacheEntry::GetKeyPath() const {
+        return JoinFsPaths(Dir, QuantizedPoolCacheKeyFileName);
+    }
+
+    TMaybe<TQuantizedLearnPoolCacheEntry> GetQuantizedLearnPoolCacheEntry(
+        const NCatboostOptions::TPoolLoadParams& loadOptions,
+        const NCatboostOptions::TCatBoostOptions& catBoostOptions,
+        EObjectsOrder objectsOrder,
+        TConstArrayRef<TString> classNames
+    ) {
+        if (loadOptions.QuantizedPoolCacheDir.empty()) {
+            return Nothing();
+        }
+        const auto skipCache = [] (TStringBuf reason) {
+            CATBOOST_WARNING_LOG << "Quantized pool cache is not used: " << reason << Endl;
+            return Nothing();
+        };
+        if (loadOptions.LearnSetPath.Scheme != "dsv") {
+            return skipCache("learn data is not in dsv format");
+        }
+        if (loadOptions.CvParams.FoldCount != 0) {
+            return skipCache("cross-validation mode");
+        }
+        if (!loadOptions.BordersFile.empty()) {
+            return skipCache("borders are loaded from file");
+        }
+        if (catBoostOptions.GetTaskType() != ETaskType::CPU) {
+            return skipCache("supported only for CPU");
+        }
+        if (!catBoostOptions.SystemOptions->IsSingleHost()) {
+            return skipCache("distributed training");
+        }
+
+        TQuantizedLearnPoolCacheEntry entry;
+        entry.Key = CalcQuantizedLearnPoolCacheKey(loadOptions, catBoostOptions, objectsOrder, classNames);
+        entry.Dir = JoinFsPaths(loadOptions.QuantizedPoolCacheDir, "learn_" + MD5::Calc(entry.Key));
+        return entry;
+    }
+
+    bool IsQuantizedLearnPoolCached(const TQuantizedLearnPoolCacheEntry& entry) {
+        if (!NFs::Exists(entry.GetKeyPath()) || !NFs::Exists(entry.GetPoolPath())) {
+            return false;
+        }
+        TString storedKey;
+        try {
+            storedKey = TIFStream(entry.GetKeyPath()).ReadAll();
+        } catch (...) {
+            CATBOOST_WARNING_LOG << "Failed to read quantized pool cache key: " << CurrentExceptionMessage() << Endl;
+            return false;
+        }
+        if (storedKey != entry.Key) {
+            CATBOOST_WARNING_LOG << "Quantized pool cache entry " << entry.Dir
+                << " was saved for different data or options, it is not used" << Endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool CanCacheQuantizedLearnPool(const TDataProvider& learnData) {
+        const auto& featuresLayout = *learnData.MetaInfo.FeaturesLayout;
+        if (featuresLayout.GetCatFeatureCount() || featuresLayout.GetTextFeatureCount()) {
+            CATBOOST_WARNING_LOG << "Quantized pool cache supports only numerical features, learn pool is not cached" << Endl;
+            return false;
+        }
+        if (learnData.ObjectsData->GetTimestamp()) {
+            CATBOOST_WARNING_LOG << "Quantized pool cache does not support timestamps, learn pool is not cached" << Endl;
+            return false;
+        }
+        // labels are stored as floats in the quantized pool format
+        const auto target = learnData.RawTargetData.GetTarget();
+        if (target) {
+            CB_ENSURE(
+                target->size() == 1,
+                "Quantized pool cache supports only a single label column, disable the cache for this pool");
+            float value;
+            for (const auto& label : (*target)[0]) {
+                CB_ENSURE(
+                    TryFromString<float>(label, value),
+                    "Quantized pool cache supports only numeric labels, got '" << label
+                        << "', disable the cache for this pool");
+            }
+        }
+        return true;
+    }
+
+    bool SaveQuantizedLearnPoolToCache(
+        const TDataProviderPtr& learnData,
+        const TQuantizedLearnPoolCacheEntry& entry
+    ) {
+        CB_ENSURE_INTERNAL(CanCacheQuantizedLearnPool(*learnData), "Learn pool can't be cached");
+
+        const TFsPath entryDir(entry.Dir);
+        const TFsPath tempDir = entryDir.Parent() / (CreateGuidAsString() + ".tmp");
+        try {
+            tempDir.MkDirs();
+            TSaveQuantizedPoolParameters saveParams;
+            saveParams.ChunkCodec = EQuantizedPoolChunkCodec::Lz4;
+            saveParams.PackBits = true;
+            SaveQuantizedPool(learnData, tempDir / QuantizedPoolCacheDataFileName, saveParams);
+            {
+                TOFStream keyOutput(tempDir / QuantizedPoolCacheKeyFileName);
+                keyOutput.Write(entry.Key);
+                keyOutput.Finish();
+            }
+            // an entry with the same digest but a different key is replaced
+            if (entryDir.Exists()) {
+                entryDir.ForceDelete();
+            }
+            // rename is atomic, so concurrent runs never see a partially written entry
+            NFs::Rename(tempDir, entryDir);
+        } catch (...) {
+            CATBOOST_WARNING_LOG << "Failed to save quantized learn pool to cache: " << CurrentExceptionMessage() << Endl;
+            tempDir.ForceDelete();
+            return false;
+        }
+        CATBOOST_INFO_LOG << "Quantized learn pool saved to cache: " << entry.Dir << Endl;
+        return true;
+    }
+}
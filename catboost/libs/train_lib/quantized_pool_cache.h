@@ -0,0 +1,61 @@
+#pragma once
+
+#include <catboost/libs/data/data_provider.h>
+#include <catboost/libs/data/objects.h>
+#include <catboost/private/libs/options/catboost_options.h>
+#include <catboost/private/libs/options/load_options.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/maybe.h>
+#include <util/generic/string.h>
+#include <util/system/types.h>
+
+
+namespace NCB {
+
+    /* Content-addressed cache of quantized learn pools shared between training runs.
+     *
+     * The key describes the learn file contents (by size and MD5), the column description, dsv format and
+     * all options that affect quantization results, so any change in data or parameters produces
+     * a different cache entry. An entry is a directory named by the digest of the key, it contains
+     * the key itself, compared with the expected one before reuse, and the pool in the quantized pool
+     * format ('quantized' scheme), so only pools with numerical features and labels can be cached.
+     */
+
+    TString CalcQuantizedLearnPoolCacheKey(
+        const NCatboostOptions::TPoolLoadParams& loadOptions,
+        const NCatboostOptions::TCatBoostOptions& catBoostOptions,
+        EObjectsOrder objectsOrder,
+        TConstArrayRef<TString> classNames);
+
+    struct TQuantizedLearnPoolCacheEntry {
+        TString Dir;
+        TString Key;
+
+    public:
+        TString GetPoolPath() const;
+        TString GetKeyPath() const;
+    };
+
+    // returns Nothing() if caching is disabled or unsupported for these options
+    TMaybe<TQuantizedLearnPoolCacheEntry> GetQuantizedLearnPoolCacheEntry(
+        const NCatboostOptions::TPoolLoadParams& loadOptions,
+        const NCatboostOptions::TCatBoostOptions& catBoostOptions,
+        EObjectsOrder objectsOrder,
+        TConstArrayRef<TString> classNames);
+
+    // entry exists and was saved with the same key
+    bool IsQuantizedLearnPoolCached(const TQuantizedLearnPoolCacheEntry& entry);
+
+    /* checks features and columns supported by the quantized pool format, logs the reason if unsupported,
+     * labels that are not numbers are an error because class names can't be restored from the cache
+     */
+    bool CanCacheQuantizedLearnPool(const TDataProvider& learnData);
+
+    /* Learn data must be already quantized.
+     * The cache is best effort: errors are logged and false is returned.
+     */
+    bool SaveQuantizedLearnPoolToCache(
+        const TDataProviderPtr& learnData,
+        const TQuantizedLearnPoolCacheEntry& entry);
+}
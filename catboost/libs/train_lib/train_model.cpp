@@ -1,6 +1,7 @@
 #include "train_model.h"
 #include "options_helper.h"
 #include "cross_validation.h"
+#include "quantized_pool_cache.h"
 
 #include <catboost/private/libs/algo/approx_dimension.h>
 #include <catboost/private/libs/algo/data.h>
@@ -13,6 +14,7 @@
 #include <catboost/libs/data/feature_names_converter.h>
 #include <catboost/libs/data/borders_io.h>
 #include <catboost/libs/data/load_data.h>
+#include <catboost/libs/data/quantization.h>
 #include <catboost/private/libs/data_util/exists_checker.h>
 #include <catboost/private/libs/distributed/master.h>
 #include <catboost/private/libs/distributed/worker.h>
@@ -38,6 +40,7 @@
 #include <catboost/private/libs/pairs/util.h>
 #include <catboost/private/libs/target/classification_target_helper.h>
 
+#include <library/chromium_trace/global.h>
 #include <library/grid_creator/binarization.h>
 #include <library/json/json_prettifier.h>
 
@@ -128,6 +131,35 @@ static TDataProviders LoadPools(
     }
 }
 
+static TDataProviders LoadPoolsWithCachedLearn(
+    const NCatboostOptions::TPoolLoadParams& loadOptions,
+    const TString& cachedLearnPath,
+    EObjectsOrder objectsOrder,
+    TVector<TString>* classNames,
+    NPar::TLocalExecutor* const executor,
+    TProfileInfo* profile
+) {
+    loadOptions.Validate();
+
+    CATBOOST_INFO_LOG << "Loading quantized learn pool from cache: " << cachedLearnPath << Endl;
+    TDataProviders pools;
+    pools.Learn = ReadDataset(
+        TPathWithScheme(cachedLearnPath, "quantized"),
+        loadOptions.PairsFilePath,
+        /*groupWeightsFilePath*/ TPathWithScheme(), // stored in cached pool
+        /*baselineFilePath*/ TPathWithScheme(), // stored in cached pool
+        NCatboostOptions::TColumnarPoolFormatParams(),
+        loadOptions.IgnoredFeatures,
+        objectsOrder,
+        TDatasetSubset::MakeColumns(),
+        classNames,
+        executor);
+    profile->AddOperation("Build learn pool");
+
+    pools.Test = ReadTestDatasets(loadOptions, objectsOrder, classNames, executor, profile);
+    return pools;
+}
+
 static bool HasInvalidValues(const TVector<TVector<double>>& treeLeafValues) {
     for (const auto& leafValuesDimension : treeLeafValues) {
         for (double leafValueCoord : leafValuesDimension) {
@@ -385,7 +417,6 @@ static void Train(
         profile.StartNextIteration();
 
         if (timer.Passed() > ctx->OutputOptions.GetSnapshotSaveInterval()) {
-            profile.AddOperation("Save snapshot");
             ctx->SaveProgress(onSnapshotSavedCallback);
             timer.Reset();
         }
@@ -449,6 +480,8 @@ static void Train(
     }
 
     ctx->SaveProgress(onSnapshotSavedCallback);
+    // the context destructor only logs snapshot saving errors
+    ctx->WaitForSnapshotSaving();
 
     if (hasTest) {
         (*testMultiApprox) = ctx->LearnProgress->TestApprox;
@@ -582,7 +615,9 @@ static void SaveModel(
             if (addResultModelToInitModel) {
                 TVector<const TFullModel*> models = {*initModel, modelPtr};
                 TVector<double> weights = {1.0, 1.0};
-                (dstModel ? *dstModel : *modelPtr) = SumModels(models, weights);
+                TFullModel& resultModel = dstModel ? *dstModel : *modelPtr;
+                resultModel = SumModels(models, weights);
+                resultModel.SetLeafValuesPrecision(ctx.OutputOptions.GetModelLeafValuesPrecision());
 
                 if (!dstModel) {
                     const bool allLearnObjectsDataIsAvailable
@@ -926,6 +961,13 @@ static void TrainModel(
             *trainingData.Learn->ObjectsData->GetQuantizedFeaturesInfo());
     }
 
+    // global tracer is a no-op unless the sink is set
+    THolder<NChromiumTrace::TGlobalJsonFileSink> chromiumTraceSink;
+    if (outputOptions.NeedChromiumTrace()) {
+        chromiumTraceSink = MakeHolder<NChromiumTrace::TGlobalJsonFileSink>(
+            outputOptions.CreateChromiumTraceFullPath());
+    }
+
     modelTrainerHolder->TrainModel(
         TTrainModelInternalOptions(),
         catBoostOptions,
@@ -1001,14 +1043,28 @@ void TrainModel(
     const auto objectsOrder = catBoostOptions.DataProcessingOptions->HasTimeFlag.Get() ?
         EObjectsOrder::Ordered : EObjectsOrder::Undefined;
     const bool hasFeatures = !IsDistributedShared(&loadOptions, catBoostOptions);
-    TDataProviders pools = LoadPools(
+    const auto learnPoolCacheEntry = GetQuantizedLearnPoolCacheEntry(
         loadOptions,
-        ParseMemorySizeDescription(catBoostOptions.SystemOptions->CpuUsedRamLimit.Get()),
+        catBoostOptions,
         objectsOrder,
-        TDatasetSubset::MakeColumns(hasFeatures),
-        &classNames,
-        &executor,
-        &profile);
+        classNames);
+    const bool isLearnPoolCached = learnPoolCacheEntry && IsQuantizedLearnPoolCached(*learnPoolCacheEntry);
+    TDataProviders pools = isLearnPoolCached ?
+        LoadPoolsWithCachedLearn(
+            loadOptions,
+            learnPoolCacheEntry->GetPoolPath(),
+            objectsOrder,
+            &classNames,
+            &executor,
+            &profile) :
+        LoadPools(
+            loadOptions,
+            ParseMemorySizeDescription(catBoostOptions.SystemOptions->CpuUsedRamLimit.Get()),
+            objectsOrder,
+            TDatasetSubset::MakeColumns(hasFeatures),
+            &classNames,
+            &executor,
+            &profile);
 
     TVector<TString> outputColumns;
     if (!evalOutputFileName.empty() && !pools.Test.empty()) {
@@ -1049,6 +1105,21 @@ void TrainModel(
             quantizedFeaturesInfo.Get());
     }
 
+    if (learnPoolCacheEntry && !isLearnPoolCached && CanCacheQuantizedLearnPool(*pools.Learn)) {
+        CATBOOST_INFO_LOG << "Quantized learn pool is not found in cache, quantizing" << Endl;
+        TRestorableFastRng64 rand(catBoostOptions.RandomSeed.Get());
+        pools.Learn->ObjectsData = GetQuantizedObjectsData(
+            &catBoostOptions,
+            pools.Learn,
+            /*bordersFile*/ Nothing(),
+            quantizedFeaturesInfo,
+            outputOptions.AllowWriteFiles(),
+            &executor,
+            &rand);
+        SaveQuantizedLearnPoolToCache(pools.Learn, *learnPoolCacheEntry);
+        profile.AddOperation("Quantize and cache learn pool");
+    }
+
     bool needPoolAfterTrain = !evalOutputFileName.empty() || (needFstr && outputOptions.GetFstrType() == EFstrType::LossFunctionChange);
     if (needFstr && outputOptions.GetFstrType() == EFstrType::FeatureImportance && updatedTrainJson.Has("loss_function")) {
         NCatboostOptions::TLossDescription modelLossDescription;
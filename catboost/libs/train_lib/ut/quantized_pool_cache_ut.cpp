@@ -0,0 +1,199 @@
+#include <catboost/libs/train_lib/quantized_pool_cache.h>
+
+#include <catboost/libs/data/load_data.h>
+#include <catboost/libs/data/quantization.h>
+
+#include <library/threading/local_executor/local_executor.h>
+#include <library/unittest/registar.h>
+
+#include <util/folder/path.h>
+#include <util/folder/tempdir.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/stream/file.h>
+#include <util/string/builder.h>
+#include <util/string/cast.h>
+
+
+using namespace NCB;
+
+
+static NCatboostOptions::TPoolLoadParams MakeLoadParams(const TTempDir& dir, TStringBuf learnData) {
+    const auto learnPath = JoinFsPaths(dir.Name(), "learn.tsv");
+    const auto cdPath = JoinFsPaths(dir.Name(), "pool.cd");
+    TOFStream(learnPath).Write(learnData);
+    TOFStream(cdPath).Write("0\tLabel\n");
+
+    NCatboostOptions::TPoolLoadParams loadParams;
+    loadParams.LearnSetPath = TPathWithScheme(learnPath, "dsv");
+    loadParams.ColumnarPoolFormatParams.CdFilePath = TPathWithScheme(cdPath, "file");
+    loadParams.QuantizedPoolCacheDir = JoinFsPaths(dir.Name(), "cache");
+    return loadParams;
+}
+
+static NCatboostOptions::TCatBoostOptions MakeOptions(ui32 borderCount) {
+    NCatboostOptions::TCatBoostOptions options(ETaskType::CPU);
+    options.DataProcessingOptions->FloatFeaturesBinarization->BorderCount.Set(borderCount);
+    return options;
+}
+
+
+Y_UNIT_TEST_SUITE(QuantizedPoolCache) {
+    Y_UNIT_TEST(KeyDependsOnDataAndQuantizationOptions) {
+        TTempDir dir;
+        const auto options = MakeOptions(32);
+
+        auto loadParams = MakeLoadParams(dir, "0\t0.1\t0.2\n1\t0.3\t0.4\n");
+        const TString key = CalcQuantizedLearnPoolCacheKey(loadParams, options, EObjectsOrder::Undefined, {});
+        UNIT_ASSERT_VALUES_EQUAL(
+            key,
+            CalcQuantizedLearnPoolCacheKey(loadParams, options, EObjectsOrder::Undefined, {}));
+
+        UNIT_ASSERT_VALUES_UNEQUAL(
+            key,
+            CalcQuantizedLearnPoolCacheKey(loadParams, MakeOptions(64), EObjectsOrder::Undefined, {}));
+        UNIT_ASSERT_VALUES_UNEQUAL(
+            key,
+            CalcQuantizedLearnPoolCacheKey(loadParams, options, EObjectsOrder::Ordered, {}));
+
+        loadParams.IgnoredFeatures = {1};
+        UNIT_ASSERT_VALUES_UNEQUAL(
+            key,
+            CalcQuantizedLearnPoolCacheKey(loadParams, options, EObjectsOrder::Undefined, {}));
+
+        loadParams = MakeLoadParams(dir, "0\t0.1\t0.2\n1\t0.3\t0.5\n");
+        UNIT_ASSERT_VALUES_UNEQUAL(
+            key,
+            CalcQuantizedLearnPoolCacheKey(loadParams, options, EObjectsOrder::Undefined, {}));
+    }
+
+    Y_UNIT_TEST(CacheEntry) {
+        TTempDir dir;
+        const auto options = MakeOptions(32);
+        auto loadParams = MakeLoadParams(dir, "0\t0.1\n");
+
+        const auto entry = GetQuantizedLearnPoolCacheEntry(loadParams, options, EObjectsOrder::Undefined, {});
+        UNIT_ASSERT(entry);
+        UNIT_ASSERT_VALUES_EQUAL(TFsPath(entry->Dir).Parent().GetPath(), loadParams.QuantizedPoolCacheDir);
+        UNIT_ASSERT_VALUES_EQUAL(
+            entry->Key,
+            CalcQuantizedLearnPoolCacheKey(loadParams, options, EObjectsOrder::Undefined, {}));
+        UNIT_ASSERT(!IsQuantizedLearnPoolCached(*entry));
+
+        loadParams.CvParams.FoldCount = 2;
+        UNIT_ASSERT(!GetQuantizedLearnPoolCacheEntry(loadParams, options, EObjectsOrder::Undefined, {}));
+
+        loadParams.CvParams.FoldCount = 0;
+        loadParams.QuantizedPoolCacheDir.clear();
+        UNIT_ASSERT(!GetQuantizedLearnPoolCacheEntry(loadParams, options, EObjectsOrder::Undefined, {}));
+    }
+
+    Y_UNIT_TEST(SaveAndReload) {
+        TTempDir dir;
+        auto options = MakeOptions(16);
+
+        TFastRng64 dataRand(0);
+        TStringBuilder learnData;
+        for (auto i : xrange(200)) {
+            Y_UNUSED(i);
+            learnData << dataRand.GenRandReal1() << '\t' << dataRand.GenRandReal1() << '\t'
+                << dataRand.Uniform(5) << '\n';
+        }
+        const auto loadParams = MakeLoadParams(dir, learnData);
+
+        NPar::TLocalExecutor executor;
+        executor.RunAdditionalThreads(1);
+        auto learnPool = ReadDataset(
+            loadParams.LearnSetPath,
+            TPathWithScheme(),
+            TPathWithScheme(),
+            TPathWithScheme(),
+            loadParams.ColumnarPoolFormatParams,
+            /*ignoredFeatures*/ {},
+            EObjectsOrder::Undefined,
+            TDatasetSubset::MakeColumns(),
+            /*classNames*/ Nothing(),
+            &executor);
+        UNIT_ASSERT(CanCacheQuantizedLearnPool(*learnPool));
+
+        auto quantizedFeaturesInfo = MakeIntrusive<TQuantizedFeaturesInfo>(
+            *learnPool->MetaInfo.FeaturesLayout,
+            TConstArrayRef<ui32>(),
+            options.DataProcessingOptions->FloatFeaturesBinarization.Get());
+        TRestorableFastRng64 rand(options.RandomSeed.Get());
+        learnPool->ObjectsData = GetQuantizedObjectsData(
+            &options,
+            learnPool,
+            /*bordersFile*/ Nothing(),
+            quantizedFeaturesInfo,
+            /*allowWriteFiles*/ false,
+            &executor,
+            &rand);
+
+        const auto entry = GetQuantizedLearnPoolCacheEntry(loadParams, options, EObjectsOrder::Undefined, {});
+        UNIT_ASSERT(entry);
+        UNIT_ASSERT(!IsQuantizedLearnPoolCached(*entry));
+        UNIT_ASSERT(SaveQuantizedLearnPoolToCache(learnPool, *entry));
+        UNIT_ASSERT(IsQuantizedLearnPoolCached(*entry));
+
+        const auto cachedPool = ReadDataset(
+            TPathWithScheme(entry->GetPoolPath(), "quantized"),
+            TPathWithScheme(),
+            TPathWithScheme(),
+            TPathWithScheme(),
+            NCatboostOptions::TColumnarPoolFormatParams(),
+            /*ignoredFeatures*/ {},
+            EObjectsOrder::Undefined,
+            TDatasetSubset::MakeColumns(),
+            /*classNames*/ Nothing(),
+            &executor);
+
+        const auto& srcObjects = dynamic_cast<const TQuantizedObjectsDataProvider&>(*learnPool->ObjectsData);
+        const auto& cachedObjects = dynamic_cast<const TQuantizedObjectsDataProvider&>(*cachedPool->ObjectsData);
+        UNIT_ASSERT_VALUES_EQUAL(cachedObjects.GetObjectCount(), srcObjects.GetObjectCount());
+        const ui32 floatFeatureCount = learnPool->MetaInfo.FeaturesLayout->GetFloatFeatureCount();
+        UNIT_ASSERT_VALUES_EQUAL(cachedPool->MetaInfo.FeaturesLayout->GetFloatFeatureCount(), floatFeatureCount);
+        for (auto floatFeatureIdx : xrange(floatFeatureCount)) {
+            const auto srcBins = (*srcObjects.GetFloatFeature(floatFeatureIdx))->ExtractValues(&executor);
+            const auto cachedBins = (*cachedObjects.GetFloatFeature(floatFeatureIdx))->ExtractValues(&executor);
+            UNIT_ASSERT_EQUAL(*srcBins, *cachedBins);
+        }
+
+        const auto srcTarget = *learnPool->RawTargetData.GetOneDimensionalTarget();
+        const auto cachedTarget = *cachedPool->RawTargetData.GetOneDimensionalTarget();
+        UNIT_ASSERT_VALUES_EQUAL(srcTarget.size(), cachedTarget.size());
+        for (auto objectIdx : xrange(srcTarget.size())) {
+            UNIT_ASSERT_VALUES_EQUAL(FromString<float>(srcTarget[objectIdx]), FromString<float>(cachedTarget[objectIdx]));
+        }
+
+        // any change of quantization params misses the cache
+        const auto otherEntry = GetQuantizedLearnPoolCacheEntry(loadParams, MakeOptions(32), EObjectsOrder::Undefined, {});
+        UNIT_ASSERT(otherEntry);
+        UNIT_ASSERT_VALUES_UNEQUAL(otherEntry->Dir, entry->Dir);
+        UNIT_ASSERT(!IsQuantizedLearnPoolCached(*otherEntry));
+
+        // an entry saved with a different key is not reused even if the digest matches
+        auto collidingEntry = *entry;
+        collidingEntry.Key = otherEntry->Key;
+        UNIT_ASSERT(!IsQuantizedLearnPoolCached(collidingEntry));
+    }
+
+    Y_UNIT_TEST(NonNumericLabelsAreRejected) {
+        TTempDir dir;
+        const auto loadParams = MakeLoadParams(dir, "a\t0.1\nb\t0.2\n");
+
+        NPar::TLocalExecutor executor;
+        auto learnPool = ReadDataset(
+            loadParams.LearnSetPath,
+            TPathWithScheme(),
+            TPathWithScheme(),
+            TPathWithScheme(),
+            loadParams.ColumnarPoolFormatParams,
+            /*ignoredFeatures*/ {},
+            EObjectsOrder::Undefined,
+            TDatasetSubset::MakeColumns(),
+            /*classNames*/ Nothing(),
+            &executor);
+        UNIT_ASSERT_EXCEPTION(CanCacheQuantizedLearnPool(*learnPool), TCatBoostException);
+    }
+}
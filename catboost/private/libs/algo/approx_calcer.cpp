@@ -25,6 +25,7 @@
 #include <catboost/private/libs/options/enum_helpers.h>
 #include <catboost/private/libs/functools/forward_as_const.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/algorithm.h>
@@ -943,6 +944,7 @@ void CalcLeafValues(
     TLearnContext* ctx,
     TVector<TVector<double>>* leafDeltas,
     TVector<TIndexType>* indices) {
+    CHROMIUM_TRACE_FUNCTION();
     *indices = BuildIndices(fold, tree, data.Learn, data.Test, ctx->LocalExecutor);
     const int approxDimension = ctx->LearnProgress->AveragingFold.GetApproxDimension();
     Y_VERIFY(fold.GetLearnSampleCount() == data.Learn->GetObjectCount());
@@ -0,0 +1,95 @@
+#include <catboost/libs/data/data_provider_builders.h>
+#include <catboost/libs/train_lib/train_model.h>
+
+#include <library/json/json_value.h>
+#include <library/testing/benchmark/bench.h>
+
+#include <util/generic/singleton.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/system/info.h>
+
+using namespace NCB;
+
+const ui32 ObjectCount = 200000;
+const ui32 FeaturesCount = 50;
+
+namespace {
+    struct TPool {
+        TDataProviderPtr Data;
+
+        TPool() {
+            TReallyFastRng32 rng(0);
+            TVector<TVector<float>> features(FeaturesCount, TVector<float>(ObjectCount));
+            TVector<float> target(ObjectCount, 0.0f);
+            for (auto featureIdx : xrange(FeaturesCount)) {
+                for (auto objectIdx : xrange(ObjectCount)) {
+                    features[featureIdx][objectIdx] = rng.GenRandReal2();
+                    target[objectIdx] += (featureIdx % 5) * features[featureIdx][objectIdx];
+                }
+            }
+
+            Data = CreateDataProvider(
+                [&] (IRawFeaturesOrderDataVisitor* visitor) {
+                    TDataMetaInfo metaInfo;
+                    metaInfo.TargetCount = 1;
+                    metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                        FeaturesCount,
+                        TVector<ui32>{},
+                        TVector<ui32>{},
+                        TVector<TString>{});
+
+                    visitor->Start(metaInfo, ObjectCount, EObjectsOrder::Undefined, {});
+                    for (auto featureIdx : xrange(FeaturesCount)) {
+                        visitor->AddFloatFeature(
+                            featureIdx,
+                            MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(features[featureIdx]))
+                        );
+                    }
+                    visitor->AddTarget(target);
+                    visitor->Finish();
+                }
+            );
+        }
+    };
+}
+
+// border_count = 15 makes all features fit into 4 bits
+static void Train(bool nibblePack, size_t iterationCount) {
+    TDataProviders dataProviders;
+    dataProviders.Learn = Singleton<TPool>()->Data;
+
+    NJson::TJsonValue plainFitParams;
+    plainFitParams.InsertValue("iterations", 50);
+    plainFitParams.InsertValue("depth", 6);
+    plainFitParams.InsertValue("border_count", 15);
+    plainFitParams.InsertValue("thread_count", (int)NSystemInfo::CachedNumberOfCpus());
+    plainFitParams.InsertValue("allow_writing_files", false);
+    plainFitParams.InsertValue("dev_nibble_pack_features", nibblePack);
+
+    for (auto i : xrange(iterationCount)) {
+        Y_UNUSED(i);
+        TFullModel model;
+        TrainModel(
+            plainFitParams,
+            nullptr,
+            Nothing(),
+            Nothing(),
+            dataProviders,
+            /*initModel*/ Nothing(),
+            /*initLearnProgress*/ nullptr,
+            "",
+            &model,
+            {}
+        );
+        Y_DO_NOT_OPTIMIZE_AWAY(model);
+    }
+}
+
+Y_CPU_BENCHMARK(TrainBorderCount15, iface) {
+    Train(/*nibblePack*/ false, iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(TrainBorderCount15NibblePacked, iface) {
+    Train(/*nibblePack*/ true, iface.Iterations());
+}
@@ -250,6 +250,7 @@ void TCalcScoreFold::Create(
     int defaultCalcStatsObjBlockSize,
     float sampleRate
 ) {
+    ResetSparseScoringData();
     BernoulliSampleRate = sampleRate;
     Y_ASSERT(BernoulliSampleRate > 0.0f && BernoulliSampleRate <= 1.0f);
     DocCount = folds[0].GetLearnSampleCount();
@@ -424,6 +425,7 @@ void TCalcScoreFold::SelectSmallestSplitSide(
     const TCalcScoreFold& fold,
     NPar::TLocalExecutor* localExecutor
 ) {
+    ResetSparseScoringData();
     SetSmallestSideControl(curDepth, fold.DocCount, fold.Indices, localExecutor);
 
     TVectorSlicing srcBlocks;
@@ -612,6 +614,7 @@ void TCalcScoreFold::Sample(
     bool shouldSortByLeaf,
     ui32 leavesCount
 ) {
+    ResetSparseScoringData();
     if (performRandomChoice) {
         SetSampledControl(indices.ysize(), samplingUnit, fold.LearnQueriesInfo, rand);
     } else {
@@ -676,6 +679,7 @@ void TCalcScoreFold::Sample(
 }
 
 void TCalcScoreFold::UpdateIndices(const TVector<TIndexType>& indices, NPar::TLocalExecutor* localExecutor) {
+    ResetSparseScoringData();
     NPar::TLocalExecutor::TExecRangeParams blockParams(0, indices.ysize());
     blockParams.SetBlockSize(2000);
     const int blockCount = blockParams.GetBlockCount();
@@ -712,6 +716,7 @@ void TCalcScoreFold::UpdateIndices(const TVector<TIndexType>& indices, NPar::TLo
 
 // only for sampling per tree
 void TCalcScoreFold::UpdateIndicesInLeafwiseSortedFold(const TVector<TIndexType>& indices, NPar::TLocalExecutor* localExecutor) {
+    ResetSparseScoringData();
     Y_ASSERT(GetBodyTailCount() == 1);
     Y_UNUSED(localExecutor);
 
@@ -868,6 +873,19 @@ const NCB::IIndexRangesGenerator<int>& TCalcScoreFold::GetCalcStatsIndexRanges()
     return *CalcStatsIndexRanges;
 }
 
+const TCalcScoreFold::TSparseScoringData& TCalcScoreFold::GetSparseScoringData(
+    int depth,
+    const std::function<void(TSparseScoringData*)>& calcFunc
+) const {
+    with_lock(SparseScoringDataLock) {
+        if (SparseScoringData.Depth != depth) {
+            calcFunc(&SparseScoringData);
+            SparseScoringData.Depth = depth;
+        }
+    }
+    return SparseScoringData;
+}
+
 void TCalcScoreFold::SetSmallestSideControl(
     int curDepth,
     int docCount,
@@ -16,6 +16,8 @@
 #include <util/system/info.h>
 #include <util/system/spinlock.h>
 
+#include <functional>
+
 
 struct TRestorableFastRng64;
 
@@ -262,10 +264,29 @@ public:
     // for data with queries - query indices, object indices otherwise
     const NCB::IIndexRangesGenerator<int>& GetCalcStatsIndexRanges() const;
 
+    // data shared by statistics calculations for all sparse features, depends only on the fold state
+    struct TSparseScoringData {
+        int Depth = -1;
+        TVector<TBucketStats> LeafStats; // [bodyTail & approxDim][leaf]
+        TVector<ui32> DocInFold; // [objectIdx in features data], Max<ui32>() if object is not in fold
+    };
+
+    /* calcFunc is called only for the first request after the fold update, so the data is calculated
+     * once for all sparse feature candidates. Thread-safe.
+     */
+    const TSparseScoringData& GetSparseScoringData(
+        int depth,
+        const std::function<void(TSparseScoringData*)>& calcFunc
+    ) const;
+
 private:
     using TSlice = TVectorSlicing::TSlice;
 
 private:
+    inline void ResetSparseScoringData() {
+        SparseScoringData.Depth = -1;
+    }
+
     inline void ClearBodyTail() {
         for (auto& bodyTail : BodyTailArr) {
             bodyTail.BodyFinish = bodyTail.TailFinish = 0;
@@ -342,6 +363,9 @@ private:
     int DefaultCalcStatsObjBlockSize;
 
     THolder<NCB::IIndexRangesGenerator<int>> CalcStatsIndexRanges;
+
+    mutable TAdaptiveLock SparseScoringDataLock;
+    mutable TSparseScoringData SparseScoringData;
 };
 
 
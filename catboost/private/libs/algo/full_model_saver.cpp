@@ -467,6 +467,7 @@ namespace NCB {
         dstModel->ModelInfo["model_guid"] = CreateGuidAsString();
         dstModel->ModelInfo["train_finish_time"] = TInstant::Now().ToStringUpToSeconds();
         dstModel->ModelInfo["catboost_version_info"] = GetProgramSvnVersion();
+        dstModel->SetLeafValuesPrecision(outputOptions.GetModelLeafValuesPrecision());
 
         {
             NJson::TJsonValue jsonOptions(NJson::EJsonValueType::JSON_MAP);
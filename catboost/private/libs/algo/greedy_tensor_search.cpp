@@ -19,6 +19,7 @@
 #include <catboost/libs/helpers/parallel_tasks.h>
 #include <catboost/libs/logging/profile_info.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/fast_log/fast_log.h>
 
 #include <util/generic/cast.h>
@@ -613,6 +614,7 @@ static void CalcBestScore(
             TVector<TVector<double>> allScores(candidate.Candidates.size());
             ctx->LocalExecutor->ExecRange(
                 [&](int oneCandidate) {
+                    CHROMIUM_TRACE_SCOPE("Score candidate");
                     THolder<IScoreCalcer> scoreCalcer;
                     if (IsPairwiseScoring(ctx->Params.LossFunctionDescription->GetLossFunction())) {
                         scoreCalcer.Reset(new TPairwiseScoreCalcer);
@@ -696,6 +698,7 @@ static void CalcBestScoreForOneCandidate(
     TFold* fold,
     TLearnContext* ctx
 ) {
+    CHROMIUM_TRACE_SCOPE("Score candidate");
     auto candidateScores = CalcScoresForOneCandidate(
         *data.Learn->ObjectsData,
         *candidate,
@@ -842,6 +845,7 @@ void GreedyTensorSearch(
     TLearnContext* ctx,
     TSplitTree* resSplitTree) {
 
+    CHROMIUM_TRACE_FUNCTION();
     TSplitTree currentSplitTree;
     TrimOnlineCTRcache({fold});
 
@@ -906,7 +910,10 @@ void GreedyTensorSearch(
         }
         profile.AddOperation(TStringBuilder() << "Bootstrap, depth " << curDepth);
 
-        CalcScores(data, currentSplitTree, modelLength, &candidatesContext, fold, ctx);
+        {
+            CHROMIUM_TRACE_SCOPE("Calc scores");
+            CalcScores(data, currentSplitTree, modelLength, &candidatesContext, fold, ctx);
+        }
 
         size_t maxFeatureValueCount = 1;
         for (const auto& candidate : candidatesContext.CandidateList) {
@@ -6,6 +6,7 @@
 #include <catboost/private/libs/distributed/master.h>
 #include <catboost/libs/logging/logging.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/malloc/api/malloc.h>
 
 #include <functional>
@@ -173,6 +174,7 @@ void CalcErrors(
     bool calcErrorTrackerMetric,
     TLearnContext* ctx
 ) {
+    CHROMIUM_TRACE_FUNCTION();
     if (trainingDataProviders.Learn->GetObjectCount() > 0) {
         ctx->LearnProgress->MetricsAndTimeHistory.LearnMetricsHistory.emplace_back();
         if (calcAllMetrics) {
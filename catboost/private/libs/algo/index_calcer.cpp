@@ -28,10 +28,11 @@ static inline ui16 GetFeatureSplitIdx(const TSplit& split) {
 }
 
 
-template <typename TCount, typename TCmpOp, int VectorWidth>
+// histogram is a pointer to bucket values or TConstNibbleArrayPtr
+template <typename THistogram, typename TCmpOp, int VectorWidth>
 inline void UpdateIndicesKernel(
     const ui32* permutation,
-    const TCount* histogram,
+    THistogram histogram,
     TCmpOp cmpOp,
     int level,
     TIndexType* indices) {
@@ -41,10 +42,10 @@ inline void UpdateIndicesKernel(
     const ui32 perm1 = permutation[1];
     const ui32 perm2 = permutation[2];
     const ui32 perm3 = permutation[3];
-    const TCount hist0 = histogram[perm0];
-    const TCount hist1 = histogram[perm1];
-    const TCount hist2 = histogram[perm2];
-    const TCount hist3 = histogram[perm3];
+    const auto hist0 = histogram[perm0];
+    const auto hist1 = histogram[perm1];
+    const auto hist2 = histogram[perm2];
+    const auto hist3 = histogram[perm3];
     const TIndexType idx0 = indices[0];
     const TIndexType idx1 = indices[1];
     const TIndexType idx2 = indices[2];
@@ -56,10 +57,10 @@ inline void UpdateIndicesKernel(
 }
 
 
-template <typename TCount, typename TCmpOp>
+template <typename THistogram, typename TCmpOp>
 inline void UpdateIndicesForSplit(
     const ui32* permutation,
-    const TCount* histogram,
+    THistogram histogram,
     TIndexRange<ui32> indexRange,
     TCmpOp cmpOp,
     int level,
@@ -69,7 +70,7 @@ inline void UpdateIndicesForSplit(
 
     ui32 doc;
     for (doc = indexRange.Begin; doc + vectorWidth <= indexRange.End; doc += vectorWidth) {
-        UpdateIndicesKernel<TCount, TCmpOp, vectorWidth>(
+        UpdateIndicesKernel<THistogram, TCmpOp, vectorWidth>(
             permutation + doc,
             histogram,
             cmpOp,
@@ -85,10 +86,12 @@ inline void UpdateIndicesForSplit(
 template <typename T, EFeatureValuesType FeatureValuesType, class TCmpOp>
 inline void ScheduleUpdateIndicesForSplit(
     const TIndexedSubset<ui32>& columnsIndexing,
+    const std::function<TConstArrayRef<ui32>()>& getObjectToDocIndexing,
     const TTypedFeatureValuesHolder<T, FeatureValuesType>& column,
     TCmpOp cmpOp,
     int level,
     TIndexType* indices,
+    TIndexType* defaultIndexValue,
     TVector<std::function<void(TIndexRange<ui32>)>>* updateBlockCallbacks) {
 
     if (const auto* columnData
@@ -105,10 +108,10 @@ inline void ScheduleUpdateIndicesForSplit(
              compressedArray]
                 (TIndexRange<ui32> indexRange) {
 
-                NCB::DispatchBitsPerKeyToDataType(
+                NCB::DispatchBitsPerKeyToDataTypeOrNibbles(
                     *compressedArray,
                     "UpdateIndicesForSplit",
-                    [=] (const auto* histogram) {
+                    [=] (auto histogram) {
                         UpdateIndicesForSplit(
                             columnsIndexingPtr->data(),
                             histogram,
@@ -118,6 +121,44 @@ inline void ScheduleUpdateIndicesForSplit(
                             indices);
                     });
             });
+    } else if (const auto* sparseColumnData
+                   = dynamic_cast<const TSparseCompressedValuesHolderImpl<T, FeatureValuesType>*>(&column))
+    {
+        // split value for the default bucket is applied to all docs by defaultIndexValue,
+        // so only docs with non-default values and a different split value have to be updated
+        const auto& sparseArray = sparseColumnData->GetData();
+        const bool defaultSplitValue = cmpOp(sparseArray.GetDefaultValue());
+        if (defaultSplitValue) {
+            *defaultIndexValue += level;
+        }
+
+        const TConstArrayRef<ui32> objectToDocIndexing = getObjectToDocIndexing();
+        TVector<ui32> docsToUpdate;
+        sparseArray.ForEachNonDefault(
+            [&] (ui32 objectIdx, T value) {
+                const ui32 doc = objectToDocIndexing[objectIdx];
+                if ((doc != Max<ui32>()) && (cmpOp(value) != defaultSplitValue)) {
+                    docsToUpdate.push_back(doc);
+                }
+            });
+        Sort(docsToUpdate);
+
+        updateBlockCallbacks->push_back(
+            [docsToUpdate = std::move(docsToUpdate),
+             defaultSplitValue,
+             level,
+             indices]
+                (TIndexRange<ui32> indexRange) {
+
+                auto docIt = LowerBound(docsToUpdate.begin(), docsToUpdate.end(), indexRange.Begin);
+                for (; (docIt != docsToUpdate.end()) && (*docIt < indexRange.End); ++docIt) {
+                    if (defaultSplitValue) {
+                        indices[*docIt] -= level;
+                    } else {
+                        indices[*docIt] += level;
+                    }
+                }
+            });
     } else {
         CB_ENSURE_INTERNAL(false, "UpdateIndicesForSplit: unsupported column type");
     }
@@ -131,6 +172,7 @@ void ScheduleUpdateIndicesForSplit(
     TMaybe<TFeaturesGroupIndex> maybeFeaturesGroupIndex,
     TConstArrayRef<TExclusiveFeaturesBundle> exclusiveFeaturesBundlesMetaData,
     const TIndexedSubset<ui32>& columnsIndexing,
+    const std::function<TConstArrayRef<ui32>()>& getObjectToDocIndexing,
     const TTypedFeatureValuesHolder<T, FeatureValuesType>& column,
     std::function<const TExclusiveFeatureBundleHolder*(ui32)>&& getExclusiveFeaturesBundle,
     std::function<const TBinaryPacksHolder*(ui32)>&& getBinaryFeaturesPack,
@@ -138,15 +180,18 @@ void ScheduleUpdateIndicesForSplit(
     TCmpOp cmpOp,
     int level,
     TIndexType* indices,
+    TIndexType* defaultIndexValue,
     TVector<std::function<void(TIndexRange<ui32>)>>* updateBlockCallbacks) {
 
     auto scheduleUpdateIndicesForSplit = [&] (const auto& column, auto&& cmpOp) {
         ScheduleUpdateIndicesForSplit(
             columnsIndexing,
+            getObjectToDocIndexing,
             column,
             std::move(cmpOp),
             level,
             indices,
+            defaultIndexValue,
             updateBlockCallbacks);
     };
 
@@ -207,6 +252,17 @@ static void UpdateIndices(
 
     TIndexType* indicesData = indices.data();
 
+    // needed only for sparse columns, calculated once for all splits
+    TMaybe<TVector<ui32>> objectToDocIndexing;
+    auto getObjectToDocIndexing = [&] () -> TConstArrayRef<ui32> {
+        if (!objectToDocIndexing) {
+            objectToDocIndexing = GetObjectToColumnsIndexingPosition(
+                columnsIndexing,
+                objectsDataProvider.GetFeaturesArraySubsetIndexing());
+        }
+        return *objectToDocIndexing;
+    };
+
     for (const auto& splitParams : params) {
         const ui32 splitWeight = 1 << splitParams.Depth;
         const auto& split = splitParams.Split;
@@ -237,6 +293,7 @@ static void UpdateIndices(
                     maybeFeaturesGroupIndex,
                     objectsDataProvider.GetExclusiveFeatureBundlesMetaData(),
                     columnsIndexing,
+                    getObjectToDocIndexing,
                     column,
                     [&] (ui32 bundleIdx) {
                         return &objectsDataProvider.GetExclusiveFeaturesBundle(bundleIdx);
@@ -248,6 +305,7 @@ static void UpdateIndices(
                     std::move(cmpOp),
                     splitWeight,
                     indicesData,
+                    &defaultIndexValue,
                     &updateBlockCallbacks);
             };
 
@@ -336,6 +394,34 @@ void SetPermutedIndices(
         *indices);
 }
 
+TVector<ui32> GetObjectToColumnsIndexingPosition(
+    TConstArrayRef<ui32> columnsIndexing,
+    const NCB::TFeaturesArraySubsetIndexing& objectsFeaturesArraySubsetIndexing) {
+
+    TVector<ui32> result(objectsFeaturesArraySubsetIndexing.Size(), Max<ui32>());
+
+    if (const auto consecutiveSubsetBegin = objectsFeaturesArraySubsetIndexing.GetConsecutiveSubsetBegin()) {
+        for (auto position : xrange(columnsIndexing.size())) {
+            result[columnsIndexing[position] - *consecutiveSubsetBegin] = position;
+        }
+    } else {
+        const ui32 featuresArraySize = columnsIndexing.empty() ?
+            0
+            : (*MaxElement(columnsIndexing.begin(), columnsIndexing.end()) + 1);
+        TVector<ui32> positionInFeaturesArray(featuresArraySize, Max<ui32>());
+        for (auto position : xrange(columnsIndexing.size())) {
+            positionInFeaturesArray[columnsIndexing[position]] = position;
+        }
+        objectsFeaturesArraySubsetIndexing.ForEach(
+            [&] (ui32 objectIdx, ui32 srcIdx) {
+                if (srcIdx < featuresArraySize) {
+                    result[objectIdx] = positionInFeaturesArray[srcIdx];
+                }
+            });
+    }
+    return result;
+}
+
 TVector<bool> GetIsLeafEmpty(int curDepth, const TVector<TIndexType>& indices) {
     TVector<bool> isLeafEmpty(1 << curDepth, true);
     size_t populatedLeafCount = 0;
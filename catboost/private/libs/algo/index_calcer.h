@@ -5,6 +5,7 @@
 #include <catboost/libs/data/data_provider.h>
 #include <catboost/private/libs/options/restrictions.h>
 
+#include <util/generic/array_ref.h>
 #include <util/generic/vector.h>
 
 
@@ -30,6 +31,13 @@ void SetPermutedIndices(
     TVector<TIndexType>* indices,
     NPar::TLocalExecutor* localExecutor);
 
+/* Sparse columns store values in objects order, not in features arrays order,
+ * returns [objectIdx] -> position in columnsIndexing, Max<ui32>() if the object is not there
+ */
+TVector<ui32> GetObjectToColumnsIndexingPosition(
+    TConstArrayRef<ui32> columnsIndexing, // indices in features arrays
+    const NCB::TFeaturesArraySubsetIndexing& objectsFeaturesArraySubsetIndexing);
+
 TVector<bool> GetIsLeafEmpty(int curDepth, const TVector<TIndexType>& indices);
 
 int GetRedundantSplitIdx(const TVector<bool>& isLeafEmpty);
@@ -40,10 +40,10 @@ inline void ProcessColumnForCalcHashes(
     if (const auto* denseColumnData = dynamic_cast<const TDenseHolder*>(&column)) {
         const TCompressedArray& compressedArray = *denseColumnData->GetCompressedData().GetSrc();
 
-        NCB::DispatchBitsPerKeyToDataType(
+        NCB::DispatchBitsPerKeyToDataTypeOrNibbles(
             compressedArray,
             "ProcessColumnForCalcHashes",
-            [&] (const auto* histogram) {
+            [&] (auto histogram) {
                 featuresSubsetIndexing.ParallelForEach(
                     [histogram, f] (ui32 i, ui32 srcIdx) {
                         f(i, histogram[srcIdx]);
@@ -238,7 +238,12 @@ struct TCalcHashParams {
     ui32 BitsPerKey;
 
     void GatherValues(ui32 srcIdx, ui32 unrollCount, TArrayRef<ui64> values) const {
-        if (BitsPerKey == 8) {
+        if (BitsPerKey == 4) {
+            const TConstNibbleArrayPtr nibbles((const ui8*)RawColumnPtr);
+            for (ui32 unrollIdx : xrange(unrollCount)) {
+                values[unrollIdx] = nibbles[srcIdx + unrollIdx];
+            }
+        } else if (BitsPerKey == 8) {
             for (ui32 unrollIdx : xrange(unrollCount)) {
                 values[unrollIdx] = ((const ui8*)RawColumnPtr)[srcIdx + unrollIdx];
             }
@@ -268,7 +273,12 @@ struct TCalcHashParams {
     }
 
     void GatherValues(ui32 srcIdx, ui32 unrollCount, const ui32* srcIndices, TArrayRef<ui64> values) const {
-        if (BitsPerKey == 8) {
+        if (BitsPerKey == 4) {
+            const TConstNibbleArrayPtr nibbles((const ui8*)RawColumnPtr);
+            for (ui32 unrollIdx : xrange(unrollCount)) {
+                values[unrollIdx] = nibbles[srcIndices[srcIdx + unrollIdx]];
+            }
+        } else if (BitsPerKey == 8) {
             for (ui32 unrollIdx : xrange(unrollCount)) {
                 values[unrollIdx] = ((const ui8*)RawColumnPtr)[srcIndices[srcIdx + unrollIdx]];
             }
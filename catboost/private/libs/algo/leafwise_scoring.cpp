@@ -21,9 +21,10 @@ bool IsLeafwiseScoringApplicable(const NCatboostOptions::TCatBoostOptions& param
 
 // Helper function for calculating index of leaf for each document given a new split.
 // Calculates indices when a permutation is given.
-template <typename TColumnType, typename TBucketIndexType>
+// column is a pointer to bucket values or TConstNibbleArrayPtr
+template <typename TColumn, typename TBucketIndexType>
 inline static void SetBucketIndex(
-    const TColumnType* column,
+    TColumn column,
     const ui32* bucketIndexing, // can be nullptr for simple case, use bucketBeginOffset instead then
     const int bucketBeginOffset,
     TIndexRange<ui32> docIndexRange,
@@ -88,10 +89,10 @@ inline static void ExtractBucketIndex(
 
         const TCompressedArray& compressedArray = *denseColumnData->GetCompressedData().GetSrc();
 
-        DispatchBitsPerKeyToDataType(
+        DispatchBitsPerKeyToDataTypeOrNibbles(
             compressedArray,
             "ExtractBucketIndex",
-            [&] (const auto* columnData) {
+            [&] (auto columnData) {
                 SetBucketIndex(
                     columnData,
                     docInDataProviderIndexing,
@@ -18,23 +18,33 @@
 #include <catboost/private/libs/index_range/index_range.h>
 #include <catboost/private/libs/options/defaults_helper.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/digest/crc32c/crc32c.h>
 #include <library/digest/md5/md5.h>
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/digest/multi.h>
 #include <util/generic/algorithm.h>
+#include <util/generic/buffer.h>
 #include <util/generic/cast.h>
 #include <util/generic/guid.h>
 #include <util/generic/xrange.h>
 #include <util/folder/path.h>
+#include <util/stream/buffer.h>
 #include <util/stream/file.h>
 #include <util/system/fs.h>
+#include <util/system/hp_timer.h>
+
+#include <utility>
 
 
 using namespace NCB;
 
 
+// fast codec, snapshot is compressed in the snapshot saving thread
+static const TStringBuf SnapshotCodecName = "lz4";
+
+
 static bool IsPermutationNeeded(bool hasTime, bool hasCtrs, bool isOrderedBoosting, bool isAveragingFold) {
     if (hasTime) {
         return false;
@@ -369,6 +379,11 @@ TLearnContext::TLearnContext(
 
 
 TLearnContext::~TLearnContext() {
+    try {
+        WaitForSnapshotSaving();
+    } catch (...) {
+        CATBOOST_WARNING_LOG << "Can't save snapshot: " << CurrentExceptionMessage() << Endl;
+    }
     if (Params.SystemOptions->IsMaster()) {
         FinalizeMaster(this);
     }
@@ -378,15 +393,49 @@ void TLearnContext::SaveProgress(std::function<void(IOutputStream*)> onSnapshotS
     if (!OutputOptions.SaveSnapshot()) {
         return;
     }
-    TProgressHelper(ToString(ETaskType::CPU)).Write(
-        Files.SnapshotFile,
-        [&](IOutputStream* out) {
-            ::SaveMany(out, *LearnProgress, Profile.DumpProfileInfo());
-            onSnapshotSaved(out);
+    CHROMIUM_TRACE_FUNCTION();
+    WaitForSnapshotSaving();
+    Profile.AddOperation("Wait for snapshot saving");
+    auto snapshot = MakeAtomicShared<TBuffer>();
+    {
+        TBufferOutput out(*snapshot);
+        ::SaveMany(&out, *LearnProgress, Profile.DumpProfileInfo());
+        onSnapshotSaved(&out);
+    }
+    Profile.AddOperation("Capture snapshot");
+    SnapshotSavingThread = SystemThreadFactory()->Run(
+        [this, snapshot, snapshotFile = Files.SnapshotFile] () {
+            try {
+                THPTimer writeTimer;
+                TBuffer compressedSnapshot;
+                TProgressHelper::Compress(
+                    SnapshotCodecName,
+                    &compressedSnapshot,
+                    [&](IOutputStream* out) {
+                        out->Write(snapshot->Data(), snapshot->Size());
+                    }
+                );
+                TProgressHelper(ToString(ETaskType::CPU)).WriteCompressed(snapshotFile, compressedSnapshot);
+                CATBOOST_DEBUG_LOG << "Snapshot of " << snapshot->Size() << " bytes compressed to "
+                    << compressedSnapshot.Size() << " bytes and written in background in "
+                    << writeTimer.Passed() << " sec" << Endl;
+            } catch (...) {
+                SnapshotSavingException = std::current_exception();
+            }
         }
     );
 }
 
+void TLearnContext::WaitForSnapshotSaving() {
+    if (SnapshotSavingThread) {
+        SnapshotSavingThread->Join();
+        SnapshotSavingThread.Destroy();
+    }
+    if (SnapshotSavingException) {
+        std::rethrow_exception(std::exchange(SnapshotSavingException, nullptr));
+    }
+}
+
 bool TLearnContext::TryLoadProgress(std::function<void(IInputStream*)> onSnapshotLoaded) {
     if (!OutputOptions.SaveSnapshot() || !NFs::Exists(Files.SnapshotFile)) {
         return false;
@@ -394,7 +443,7 @@ bool TLearnContext::TryLoadProgress(std::function<void(IInputStream*)> onSnapsho
     try {
         TProgressHelper(ToString(ETaskType::CPU)).CheckedLoad(
             Files.SnapshotFile,
-            [&](TIFStream* in) {
+            [&](IInputStream* in) {
                 // use progress copy to avoid partial deserialization of corrupted progress file
                 THolder<TLearnProgress> learnProgressRestored = MakeHolder<TLearnProgress>(*LearnProgress);
                 TProfileInfoData ProfileRestored;
@@ -24,6 +24,9 @@
 #include <util/generic/noncopyable.h>
 #include <util/generic/hash_set.h>
 #include <util/generic/ptr.h>
+#include <util/thread/factory.h>
+
+#include <exception>
 
 
 namespace NPar {
@@ -193,7 +196,13 @@ public:
 
     ~TLearnContext();
 
+    /* Progress is serialized to memory synchronously, compression and writing to the snapshot file
+     * are done in a background thread, previous snapshot writing is waited for before that.
+     * Waiting and capture times are added to Profile operations.
+     */
     void SaveProgress(std::function<void(IOutputStream*)> onSnapshotSaved = [] (IOutputStream* /*snapshot*/) {});
+    // rethrows an exception of the background snapshot saving
+    void WaitForSnapshotSaving();
     bool TryLoadProgress(std::function<void(IInputStream*)> onSnapshotLoaded = [] (IInputStream* /*snapshot*/) {});
     bool UseTreeLevelCaching() const;
     bool GetHasWeights() const;
@@ -213,6 +222,8 @@ public:
 private:
     bool UseTreeLevelCachingFlag;
     bool HasWeights;
+    THolder<IThreadFactory::IThread> SnapshotSavingThread;
+    std::exception_ptr SnapshotSavingException;
 };
 
 bool NeedToUseTreeLevelCaching(
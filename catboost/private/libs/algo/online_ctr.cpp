@@ -13,6 +13,7 @@
 #include <catboost/libs/model/ctr_value_table.h>
 #include <catboost/libs/model/model.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/bitops.h>
@@ -554,6 +555,7 @@ void ComputeOnlineCTRs(
     const TLearnContext* ctx,
     TOnlineCTR* dst) {
 
+    CHROMIUM_TRACE_FUNCTION();
     const TCtrHelper& ctrHelper = ctx->CtrsHelper;
     const auto& ctrInfo = ctrHelper.GetCtrInfo(proj);
     dst->Feature.resize(ctrInfo.size());
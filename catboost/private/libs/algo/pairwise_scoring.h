@@ -377,11 +377,11 @@ inline void ComputePairwiseStats(
 
         const TCompressedArray& compressedArray = *denseColumnData->GetCompressedData().GetSrc();
 
-        NCB::DispatchBitsPerKeyToDataType(
+        NCB::DispatchBitsPerKeyToDataTypeOrNibbles(
             compressedArray,
             "ComputePairwiseStats",
-            [&] (const auto* bucketSrcData) {
-                ComputePairwiseStats<decltype(*bucketSrcData)>(
+            [&] (auto bucketSrcData) {
+                ComputePairwiseStats<decltype(bucketSrcData[0])>(
                     splitEnsembleType,
                     weightedDerivatives,
                     pairs,
@@ -52,7 +52,7 @@ void UpdateUndefinedRandomSeed(
     ETaskType taskType,
     const NCatboostOptions::TOutputFilesOptions& outputOptions,
     NJson::TJsonValue* updatedJsonParams,
-    std::function<void(TIFStream*, TString&)> paramsLoader) {
+    std::function<void(IInputStream*, TString&)> paramsLoader) {
 
     const TString snapshotFilename = TOutputFiles::AlignFilePath(
         outputOptions.GetTrainDir(),
@@ -65,7 +65,7 @@ void UpdateUndefinedRandomSeed(
         try {
             TProgressHelper(ToString(taskType)).CheckedLoad(
                 snapshotFilename,
-                [&](TIFStream* inputStream) {
+                [&](IInputStream* inputStream) {
                     paramsLoader(inputStream, serializedTrainParams);
                 }
             );
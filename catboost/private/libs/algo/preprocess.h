@@ -5,7 +5,7 @@
 
 #include <util/generic/string.h>
 #include <util/generic/vector.h>
-#include <util/stream/file.h>
+#include <util/stream/input.h>
 
 #include <functional>
 
@@ -32,7 +32,7 @@ void UpdateUndefinedRandomSeed(
     ETaskType taskType,
     const NCatboostOptions::TOutputFilesOptions& outputOptions,
     NJson::TJsonValue* updatedJsonParams,
-    std::function<void(TIFStream*, TString&)> paramsLoader
+    std::function<void(IInputStream*, TString&)> paramsLoader
 );
 
 void UpdateUndefinedClassNames(
@@ -52,13 +52,45 @@ namespace {
 }
 
 
+// Sets index for docs in [docBegin, docEnd) which buckets are consecutive in bucketIndex
+// starting from position bucketOffset + docBegin.
+template <typename TBucketIndex, typename TFullIndexType>
+inline static void SetSingleIndexForConsecutiveBuckets(
+    const TStatsIndexer& indexer,
+    const TIndexType* indices,
+    TBucketIndex bucketIndex,
+    int bucketOffset,
+    int docBegin,
+    int docEnd,
+    TArrayRef<TFullIndexType> singleIdxRef
+) {
+    int doc = docBegin;
+    if constexpr (std::is_same_v<TBucketIndex, TConstNibbleArrayPtr>) {
+        // decode buckets of two docs from one byte
+        if ((doc < docEnd) && ((bucketOffset + doc) & 1)) {
+            singleIdxRef[doc] = indexer.GetIndex(indices[doc], bucketIndex[bucketOffset + doc]);
+            ++doc;
+        }
+        for (; doc + 2 <= docEnd; doc += 2) {
+            const ui8 packedBuckets = bucketIndex.GetByte((bucketOffset + doc) >> 1);
+            singleIdxRef[doc] = indexer.GetIndex(indices[doc], packedBuckets & 0xF);
+            singleIdxRef[doc + 1] = indexer.GetIndex(indices[doc + 1], packedBuckets >> 4);
+        }
+    }
+    for (; doc < docEnd; ++doc) {
+        singleIdxRef[doc] = indexer.GetIndex(indices[doc], bucketIndex[bucketOffset + doc]);
+    }
+}
+
+
 // Helper function for calculating index of leaf for each document given a new split.
 // Calculates indices when a permutation is given.
-template <typename TBucketIndexType, typename TFullIndexType>
+// bucketIndex is a pointer to bucket values or TConstNibbleArrayPtr.
+template <typename TBucketIndex, typename TFullIndexType>
 inline static void SetSingleIndex(
     const TCalcScoreFold& fold,
     const TStatsIndexer& indexer,
-    TBucketIndexType* bucketIndex,
+    TBucketIndex bucketIndex,
     const ui32* bucketIndexing, // can be nullptr for simple case, use bucketBeginOffset instead then
     const int bucketBeginOffset,
     const int permBlockSize,
@@ -70,9 +102,15 @@ inline static void SetSingleIndex(
     const TArrayRef<TFullIndexType> singleIdxRef(*singleIdx);
 
     if (bucketIndexing == nullptr) {
-        for (int doc : docIndexRange.Iter()) {
-            singleIdxRef[doc] = indexer.GetIndex(indices[doc], bucketIndex[bucketBeginOffset + doc]);
-        }
+        SetSingleIndexForConsecutiveBuckets(
+            indexer,
+            indices,
+            bucketIndex,
+            bucketBeginOffset,
+            docIndexRange.Begin,
+            docIndexRange.End,
+            singleIdxRef
+        );
     } else if (permBlockSize > 1) {
         const int blockCount = (docCount + permBlockSize - 1) / permBlockSize;
         Y_ASSERT(
@@ -88,10 +126,15 @@ inline static void SetSingleIndex(
                 docIndexRange.End
             );
             const int originalBlockIdx = static_cast<int>(bucketIndexing[blockStart]);
-            for (int doc = blockStart; doc < nextBlockStart; ++doc) {
-                const int originalDocIdx = originalBlockIdx + doc - blockStart;
-                singleIdxRef[doc] = indexer.GetIndex(indices[doc], bucketIndex[originalDocIdx]);
-            }
+            SetSingleIndexForConsecutiveBuckets(
+                indexer,
+                indices,
+                bucketIndex,
+                originalBlockIdx - blockStart,
+                blockStart,
+                nextBlockStart,
+                singleIdxRef
+            );
             blockStart = nextBlockStart;
         }
     } else {
@@ -123,10 +166,10 @@ inline static void BuildSingleIndex(
 
         const TCompressedArray& compressedArray = *denseColumnData->GetCompressedData().GetSrc();
 
-        DispatchBitsPerKeyToDataType(
+        DispatchBitsPerKeyToDataTypeOrNibbles(
             compressedArray,
             "BuildSingleIndex",
-            [&] (const auto* histogram) {
+            [&] (auto histogram) {
                 SetSingleIndex(
                     fold,
                     indexer,
@@ -494,6 +537,193 @@ static void CalcStatsImpl(
 }
 
 
+// Leaf totals (over all buckets) and mapping of objects to fold docs, shared by all sparse features
+static void CalcSparseScoringData(
+    const TCalcScoreFold& fold,
+    const TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
+    bool isPlainMode,
+    int depth,
+    TCalcScoreFold::TSparseScoringData* data
+) {
+    data->DocInFold = GetObjectToColumnsIndexingPosition(
+        fold.LearnPermutationFeaturesSubset.Get<TIndexedSubset<ui32>>(),
+        objectsDataProvider.GetFeaturesArraySubsetIndexing()
+    );
+
+    // leaf totals are stats for a feature with a single bucket
+    const TStatsIndexer leafIndexer(/*bucketCount*/ 1);
+    const int leafCount = 1 << depth;
+    const int approxDimension = fold.GetApproxDimension();
+    data->LeafStats.yresize(fold.GetBodyTailCount() * approxDimension * leafCount);
+    for (int bodyTailIdx : xrange(fold.GetBodyTailCount())) {
+        for (int dim : xrange(approxDimension)) {
+            CalcStatsKernel<TIndexType>(
+                /*isCaching*/ false,
+                fold.Indices,
+                fold,
+                isPlainMode,
+                leafIndexer,
+                depth,
+                fold.BodyTailArr[bodyTailIdx],
+                dim,
+                NCB::TIndexRange<int>(fold.GetDocCount()),
+                data->LeafStats.data() + (bodyTailIdx * approxDimension + dim) * leafCount
+            );
+        }
+    }
+}
+
+
+/* Stats for sparse features are accumulated only for docs with non-default values,
+ * stats for the default bucket are derived by subtraction from leaf totals.
+ * The result is the same as for CalcStatsKernel + FixUpStats inputs.
+ */
+template <class T, EFeatureValuesType FeatureValuesType>
+static void CalcSparseStats(
+    const TCalcScoreFold& fold,
+    const TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
+    const TSparseCompressedValuesHolderImpl<T, FeatureValuesType>& column,
+    const TStatsIndexer& indexer,
+    bool isCaching,
+    bool isPlainMode,
+    int depth,
+    int splitStatsCount,
+    TBucketStatsRefOptionalHolder* stats
+) {
+    const auto& sparseScoringData = fold.GetSparseScoringData(
+        depth,
+        [&] (TCalcScoreFold::TSparseScoringData* data) {
+            CalcSparseScoringData(fold, objectsDataProvider, isPlainMode, depth, data);
+        }
+    );
+
+    const TSparseCompressedArray<T, ui32>& sparseArray = column.GetData();
+    const int defaultBucket = (int)sparseArray.GetDefaultValue();
+
+    TVector<std::pair<ui32, int>> docsWithStatsIdx; // (doc, stats idx), common for all bodyTails and dims
+    docsWithStatsIdx.reserve(sparseArray.GetNonDefaultSize());
+    sparseArray.ForEachNonDefault(
+        [&] (ui32 objectIdx, T bucket) {
+            const ui32 doc = sparseScoringData.DocInFold[objectIdx];
+            if (doc != Max<ui32>()) {
+                docsWithStatsIdx.emplace_back(doc, indexer.GetIndex(fold.Indices[doc], (int)bucket));
+            }
+        }
+    );
+
+    const int approxDimension = fold.GetApproxDimension();
+    if (stats->NonInited()) {
+        (*stats) = TBucketStatsRefOptionalHolder(fold.GetBodyTailCount() * approxDimension * splitStatsCount);
+    }
+
+    // with caching fold contains only docs from the upper half of leaves
+    const int leafCount = 1 << depth;
+    const int leafBegin = isCaching ? leafCount / 2 : 0;
+
+    for (int bodyTailIdx : xrange(fold.GetBodyTailCount())) {
+        const auto& bt = fold.BodyTailArr[bodyTailIdx];
+        const bool hasPairwiseWeights = !bt.PairwiseWeights.empty();
+        const float* weightsData = hasPairwiseWeights ?
+            GetDataPtr(bt.PairwiseWeights) : GetDataPtr(fold.LearnWeights);
+        const float* sampleWeightsData = hasPairwiseWeights ?
+            GetDataPtr(bt.SamplePairwiseWeights) : GetDataPtr(fold.SampleWeights);
+        const int bodyFinish = isPlainMode ? 0 : bt.BodyFinish;
+
+        for (int dim : xrange(approxDimension)) {
+            const int bodyTailDimIdx = bodyTailIdx * approxDimension + dim;
+            TBucketStats* statsSubset = stats->GetData().data() + bodyTailDimIdx * splitStatsCount;
+            Fill(
+                statsSubset + indexer.GetIndex(leafBegin, 0),
+                statsSubset + indexer.CalcSize(depth),
+                TBucketStats{0, 0, 0, 0}
+            );
+
+            const double* weightedDerivativesData = GetDataPtr(bt.WeightedDerivatives[dim]);
+            const double* sampleWeightedDerivativesData = GetDataPtr(bt.SampleWeightedDerivatives[dim]);
+            for (const auto& docWithStatsIdx : docsWithStatsIdx) {
+                const int doc = (int)docWithStatsIdx.first;
+                if (doc >= bt.TailFinish) {
+                    continue;
+                }
+                TBucketStats& bucketStats = statsSubset[docWithStatsIdx.second];
+                if (doc < bodyFinish) {
+                    bucketStats.SumDelta += weightedDerivativesData[doc];
+                    bucketStats.Count += weightsData ? weightsData[doc] : 1;
+                } else {
+                    bucketStats.SumWeightedDelta += sampleWeightedDerivativesData[doc];
+                    bucketStats.SumWeight += sampleWeightsData[doc];
+                }
+            }
+
+            const TBucketStats* leafStats = sparseScoringData.LeafStats.data() + bodyTailDimIdx * leafCount;
+            for (int leaf : xrange(leafBegin, leafCount)) {
+                TBucketStats defaultBucketStats = leafStats[leaf];
+                for (int bucket : xrange(indexer.BucketCount)) {
+                    if (bucket != defaultBucket) {
+                        defaultBucketStats.Remove(statsSubset[indexer.GetIndex(leaf, bucket)]);
+                    }
+                }
+                statsSubset[indexer.GetIndex(leaf, defaultBucket)] = defaultBucketStats;
+            }
+        }
+    }
+}
+
+
+// returns false if the split candidate is not a sparse feature
+static bool TryCalcSparseStats(
+    const TCalcScoreFold& fold,
+    const TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
+    const TSplitEnsemble& splitEnsemble,
+    const TStatsIndexer& indexer,
+    bool isCaching,
+    bool isPlainMode,
+    int depth,
+    int splitStatsCount,
+    TBucketStatsRefOptionalHolder* stats
+) {
+    if (splitEnsemble.Type != ESplitEnsembleType::OneFeature) {
+        return false;
+    }
+
+    auto tryCalcSparseStats = [&] (const auto* sparseColumn) {
+        if (sparseColumn) {
+            CalcSparseStats(
+                fold,
+                objectsDataProvider,
+                *sparseColumn,
+                indexer,
+                isCaching,
+                isPlainMode,
+                depth,
+                splitStatsCount,
+                stats
+            );
+            return true;
+        }
+        return false;
+    };
+
+    const auto& splitCandidate = splitEnsemble.SplitCandidate;
+    switch (splitCandidate.Type) {
+        case ESplitType::FloatFeature:
+            return tryCalcSparseStats(
+                dynamic_cast<const TQuantizedFloatSparseValuesHolder*>(
+                    *objectsDataProvider.GetNonPackedFloatFeature((ui32)splitCandidate.FeatureIdx)
+                )
+            );
+        case ESplitType::OneHotFeature:
+            return tryCalcSparseStats(
+                dynamic_cast<const TQuantizedCatSparseValuesHolder*>(
+                    *objectsDataProvider.GetNonPackedCatFeature((ui32)splitCandidate.FeatureIdx)
+                )
+            );
+        default:
+            return false;
+    }
+}
+
+
 template <typename TFullIndexType, typename TIsCaching>
 static void CalcStatsImpl(
     const TCalcScoreFold& fold,
@@ -514,9 +744,6 @@ static void CalcStatsImpl(
 
     const int docCount = fold.GetDocCount();
 
-    TVector<TFullIndexType> singleIdx;
-    singleIdx.yresize(docCount);
-
     const int statsCount = fold.GetBodyTailCount() * fold.GetApproxDimension() * splitStatsCount;
     const int filledSplitStatsCount = indexer.CalcSize(depth);
 
@@ -530,72 +757,89 @@ static void CalcStatsImpl(
         }
     };
 
-    NCB::MapMerge(
-        localExecutor,
-        fold.GetCalcStatsIndexRanges(),
-        /*mapFunc*/[&](NCB::TIndexRange<int> indexRange, TBucketStatsRefOptionalHolder* output) {
-            NCB::TIndexRange<int> docIndexRange = fold.HasQueryInfo() ?
-                NCB::TIndexRange<int>(
-                    fold.LearnQueriesInfo[indexRange.Begin].Begin,
-                    (indexRange.End == 0) ? 0 : fold.LearnQueriesInfo[indexRange.End - 1].End
-                )
-                : indexRange;
+    const bool isSparse = TryCalcSparseStats(
+        fold,
+        objectsDataProvider,
+        splitEnsemble,
+        indexer,
+        isCaching,
+        isPlainMode,
+        depth,
+        splitStatsCount,
+        stats
+    );
 
-            BuildSingleIndex(
-                fold,
-                objectsDataProvider,
-                allCtrs,
-                splitEnsemble,
-                indexer,
-                docIndexRange,
-                &singleIdx
-            );
+    if (!isSparse) {
+        TVector<TFullIndexType> singleIdx;
+        singleIdx.yresize(docCount);
+
+        NCB::MapMerge(
+            localExecutor,
+            fold.GetCalcStatsIndexRanges(),
+            /*mapFunc*/[&](NCB::TIndexRange<int> indexRange, TBucketStatsRefOptionalHolder* output) {
+                NCB::TIndexRange<int> docIndexRange = fold.HasQueryInfo() ?
+                    NCB::TIndexRange<int>(
+                        fold.LearnQueriesInfo[indexRange.Begin].Begin,
+                        (indexRange.End == 0) ? 0 : fold.LearnQueriesInfo[indexRange.End - 1].End
+                    )
+                    : indexRange;
 
-            if (output->NonInited()) {
-                (*output) = TBucketStatsRefOptionalHolder(statsCount);
-            } else {
-                Y_ASSERT(docIndexRange.Begin == 0);
-            }
+                BuildSingleIndex(
+                    fold,
+                    objectsDataProvider,
+                    allCtrs,
+                    splitEnsemble,
+                    indexer,
+                    docIndexRange,
+                    &singleIdx
+                );
 
-            forEachBodyTailAndApproxDimension(
-                [&](int bodyTailIdx, int dim, int bucketStatsArrayBegin) {
-                    TBucketStats* statsSubset = output->GetData().data() + bucketStatsArrayBegin;
-                    CalcStatsKernel(
-                        isCaching && (indexRange.Begin == 0),
-                        singleIdx,
-                        fold,
-                        isPlainMode,
-                        indexer,
-                        depth,
-                        fold.BodyTailArr[bodyTailIdx],
-                        dim,
-                        docIndexRange,
-                        statsSubset
-                    );
+                if (output->NonInited()) {
+                    (*output) = TBucketStatsRefOptionalHolder(statsCount);
+                } else {
+                    Y_ASSERT(docIndexRange.Begin == 0);
                 }
-            );
-        },
-        /*mergeFunc*/[&](
-            TBucketStatsRefOptionalHolder* output,
-            TVector<TBucketStatsRefOptionalHolder>&& addVector
-        ) {
-            forEachBodyTailAndApproxDimension(
-                [&](int /*bodyTailIdx*/, int /*dim*/, int bucketStatsArrayBegin) {
-                    TBucketStats* outputStatsSubset =
-                        output->GetData().data() + bucketStatsArrayBegin;
-
-                    for (const auto& addItem : addVector) {
-                        const TBucketStats* addStatsSubset =
-                            addItem.GetData().data() + bucketStatsArrayBegin;
-                        for (size_t i : xrange(filledSplitStatsCount)) {
-                            (outputStatsSubset + i)->Add(*(addStatsSubset + i));
+
+                forEachBodyTailAndApproxDimension(
+                    [&](int bodyTailIdx, int dim, int bucketStatsArrayBegin) {
+                        TBucketStats* statsSubset = output->GetData().data() + bucketStatsArrayBegin;
+                        CalcStatsKernel(
+                            isCaching && (indexRange.Begin == 0),
+                            singleIdx,
+                            fold,
+                            isPlainMode,
+                            indexer,
+                            depth,
+                            fold.BodyTailArr[bodyTailIdx],
+                            dim,
+                            docIndexRange,
+                            statsSubset
+                        );
+                    }
+                );
+            },
+            /*mergeFunc*/[&](
+                TBucketStatsRefOptionalHolder* output,
+                TVector<TBucketStatsRefOptionalHolder>&& addVector
+            ) {
+                forEachBodyTailAndApproxDimension(
+                    [&](int /*bodyTailIdx*/, int /*dim*/, int bucketStatsArrayBegin) {
+                        TBucketStats* outputStatsSubset =
+                            output->GetData().data() + bucketStatsArrayBegin;
+
+                        for (const auto& addItem : addVector) {
+                            const TBucketStats* addStatsSubset =
+                                addItem.GetData().data() + bucketStatsArrayBegin;
+                            for (size_t i : xrange(filledSplitStatsCount)) {
+                                (outputStatsSubset + i)->Add(*(addStatsSubset + i));
+                            }
                         }
                     }
-                }
-            );
-        },
-        stats
-    );
+                );
+            },
+            stats
+        );
+    }
 
     if (isCaching) {
         forEachBodyTailAndApproxDimension(
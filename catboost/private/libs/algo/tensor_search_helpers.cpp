@@ -7,6 +7,7 @@
 #include <catboost/libs/helpers/restorable_rng.h>
 #include <catboost/private/libs/options/catboost_options.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/maybe.h>
@@ -451,6 +452,7 @@ void CalcWeightedDerivatives(
     TFold* takenFold,
     NPar::TLocalExecutor* localExecutor
 ) {
+    CHROMIUM_TRACE_FUNCTION();
     TFold::TBodyTail& bt = takenFold->BodyTailArr[bodyTailIdx];
     const TVector<TVector<double>>& approx = bt.Approx;
     const TVector<float>& target = takenFold->LearnTarget[0];
@@ -22,6 +22,8 @@
 #include <catboost/private/libs/distributed/master.h>
 #include <catboost/private/libs/distributed/worker.h>
 
+#include <library/chromium_trace/interface.h>
+
 
 TErrorTracker BuildErrorTracker(
     EMetricBestValue bestValueType,
@@ -41,6 +43,7 @@ static void UpdateLearningFold(
     TFold* fold,
     TLearnContext* ctx
 ) {
+    CHROMIUM_TRACE_FUNCTION();
     TVector<TVector<TVector<double>>> approxDelta;
 
     CalcApproxForLeafStruct(
@@ -142,6 +145,7 @@ void CalcApproxesLeafwise(
     TVector<TVector<double>>* treeValues,
     TVector<TIndexType>* indices
 ) {
+    CHROMIUM_TRACE_FUNCTION();
     *indices = BuildIndices(
         ctx->LearnProgress->AveragingFold,
         bestSplitTree,
@@ -185,6 +189,7 @@ void CalcApproxesLeafwise(
 }
 
 void TrainOneIteration(const NCB::TTrainingForCPUDataProviders& data, TLearnContext* ctx) {
+    CHROMIUM_TRACE_FUNCTION();
     const auto error = BuildError(ctx->Params, ctx->ObjectiveDescriptor);
     ctx->LearnProgress->HessianType = error->GetHessianType();
     TProfileInfo& profile = ctx->Profile;
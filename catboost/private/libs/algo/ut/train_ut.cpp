@@ -134,4 +134,206 @@ Y_UNIT_TEST_SUITE(TTrainTest) {
             );
         }
     }
+
+    Y_UNIT_TEST(TestSparseFeaturesTrainIsSameAsDense) {
+        const ui32 docCount = 2000;
+        const ui32 factorCount = 20;
+        const float nonDefaultFraction = 0.05f;
+
+        TReallyFastRng32 rng(17);
+
+        TVector<float> target(docCount, 0.0f);
+        TVector<TVector<ui32>> nonDefaultIndices(factorCount); // [featureIdx]
+        TVector<TVector<float>> nonDefaultValues(factorCount); // [featureIdx]
+        for (auto factorId : xrange(factorCount)) {
+            for (auto docId : xrange(docCount)) {
+                if (rng.GenRandReal2() < nonDefaultFraction) {
+                    const float value = 1.0f + rng.GenRandReal2();
+                    nonDefaultIndices[factorId].push_back(docId);
+                    nonDefaultValues[factorId].push_back(value);
+                    target[docId] += (factorId % 3) * value;
+                }
+            }
+        }
+
+        auto createDataProvider = [&] (bool sparse) {
+            return CreateDataProvider(
+                [&] (IRawFeaturesOrderDataVisitor* visitor) {
+                    TDataMetaInfo metaInfo;
+                    metaInfo.TargetCount = 1;
+                    metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                        factorCount,
+                        TVector<ui32>{},
+                        TVector<ui32>{},
+                        TVector<TString>{});
+
+                    visitor->Start(metaInfo, docCount, EObjectsOrder::Undefined, {});
+
+                    for (auto factorId : xrange(factorCount)) {
+                        if (sparse) {
+                            visitor->AddFloatFeature(
+                                factorId,
+                                MakeConstPolymorphicValuesSparseArrayWithArrayIndex(
+                                    docCount,
+                                    TMaybeOwningConstArrayHolder<ui32>::CreateOwning(
+                                        TVector<ui32>(nonDefaultIndices[factorId])
+                                    ),
+                                    TMaybeOwningConstArrayHolder<float>::CreateOwning(
+                                        TVector<float>(nonDefaultValues[factorId])
+                                    ),
+                                    /*ordered*/ true,
+                                    /*defaultValue*/ 0.0f
+                                )
+                            );
+                        } else {
+                            TVector<float> values(docCount, 0.0f);
+                            for (auto i : xrange(nonDefaultIndices[factorId].size())) {
+                                values[nonDefaultIndices[factorId][i]] = nonDefaultValues[factorId][i];
+                            }
+                            visitor->AddFloatFeature(
+                                factorId,
+                                MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(values))
+                            );
+                        }
+                    }
+                    visitor->AddTarget(target);
+
+                    visitor->Finish();
+                }
+            );
+        };
+
+        // sparse path is used both for scoring and for indices update in learn and test data
+        auto train = [&] (bool sparse, TFullModel* model, TEvalResult* testApprox) {
+            TDataProviders dataProviders;
+            dataProviders.Learn = createDataProvider(sparse);
+            dataProviders.Test.push_back(createDataProvider(sparse));
+
+            NJson::TJsonValue plainFitParams;
+            plainFitParams.InsertValue("random_seed", 5);
+            plainFitParams.InsertValue("iterations", 20);
+            plainFitParams.InsertValue("depth", 4);
+            plainFitParams.InsertValue("train_dir", ".");
+            plainFitParams.InsertValue("thread_count", 2);
+            plainFitParams.InsertValue("dev_efb_max_buckets", 0); // don't bundle sparse features
+            TrainModel(
+                plainFitParams,
+                nullptr,
+                Nothing(),
+                Nothing(),
+                dataProviders,
+                /*initModel*/ Nothing(),
+                /*initLearnProgress*/ nullptr,
+                "",
+                model,
+                {testApprox}
+            );
+        };
+
+        TFullModel denseModel;
+        TEvalResult denseTestApprox;
+        train(/*sparse*/ false, &denseModel, &denseTestApprox);
+
+        TFullModel sparseModel;
+        TEvalResult sparseTestApprox;
+        train(/*sparse*/ true, &sparseModel, &sparseTestApprox);
+
+        const auto denseSplits = denseModel.ModelTrees->GetTreeSplits();
+        const auto sparseSplits = sparseModel.ModelTrees->GetTreeSplits();
+        UNIT_ASSERT(Equal(denseSplits.begin(), denseSplits.end(), sparseSplits.begin(), sparseSplits.end()));
+
+        const auto& denseApprox = denseTestApprox.GetRawValuesConstRef()[0][0];
+        const auto& sparseApprox = sparseTestApprox.GetRawValuesConstRef()[0][0];
+        UNIT_ASSERT_VALUES_EQUAL(denseApprox.size(), sparseApprox.size());
+        for (auto i : xrange(denseApprox.size())) {
+            UNIT_ASSERT_DOUBLES_EQUAL(denseApprox[i], sparseApprox[i], 1e-6);
+        }
+    }
+
+    Y_UNIT_TEST(TestNibblePackedFeaturesTrainIsSameAsUnpacked) {
+        const ui32 docCount = 2001; // odd to check the last half-filled byte
+        const ui32 factorCount = 10;
+
+        TReallyFastRng32 rng(11);
+
+        TVector<TVector<float>> features(factorCount, TVector<float>(docCount)); // [featureIdx][docIdx]
+        TVector<float> target(docCount, 0.0f);
+        for (auto factorId : xrange(factorCount)) {
+            for (auto docId : xrange(docCount)) {
+                const float value = rng.GenRandReal2();
+                features[factorId][docId] = value;
+                target[docId] += (factorId % 4) * value;
+            }
+        }
+
+        auto createDataProvider = [&] () {
+            return CreateDataProvider(
+                [&] (IRawFeaturesOrderDataVisitor* visitor) {
+                    TDataMetaInfo metaInfo;
+                    metaInfo.TargetCount = 1;
+                    metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                        factorCount,
+                        TVector<ui32>{},
+                        TVector<ui32>{},
+                        TVector<TString>{});
+
+                    visitor->Start(metaInfo, docCount, EObjectsOrder::Undefined, {});
+                    for (auto factorId : xrange(factorCount)) {
+                        visitor->AddFloatFeature(
+                            factorId,
+                            MakeIntrusive<TTypeCastArrayHolder<float, float>>(TVector<float>(features[factorId]))
+                        );
+                    }
+                    visitor->AddTarget(target);
+                    visitor->Finish();
+                }
+            );
+        };
+
+        auto train = [&] (bool nibblePack, TFullModel* model, TEvalResult* testApprox) {
+            TDataProviders dataProviders;
+            dataProviders.Learn = createDataProvider();
+            dataProviders.Test.push_back(createDataProvider());
+
+            NJson::TJsonValue plainFitParams;
+            plainFitParams.InsertValue("random_seed", 5);
+            plainFitParams.InsertValue("iterations", 20);
+            plainFitParams.InsertValue("depth", 4);
+            plainFitParams.InsertValue("border_count", 15);
+            plainFitParams.InsertValue("train_dir", ".");
+            plainFitParams.InsertValue("thread_count", 2);
+            plainFitParams.InsertValue("dev_nibble_pack_features", nibblePack);
+            TrainModel(
+                plainFitParams,
+                nullptr,
+                Nothing(),
+                Nothing(),
+                dataProviders,
+                /*initModel*/ Nothing(),
+                /*initLearnProgress*/ nullptr,
+                "",
+                model,
+                {testApprox}
+            );
+        };
+
+        TFullModel unpackedModel;
+        TEvalResult unpackedTestApprox;
+        train(/*nibblePack*/ false, &unpackedModel, &unpackedTestApprox);
+
+        TFullModel packedModel;
+        TEvalResult packedTestApprox;
+        train(/*nibblePack*/ true, &packedModel, &packedTestApprox);
+
+        const auto unpackedSplits = unpackedModel.ModelTrees->GetTreeSplits();
+        const auto packedSplits = packedModel.ModelTrees->GetTreeSplits();
+        UNIT_ASSERT(Equal(unpackedSplits.begin(), unpackedSplits.end(), packedSplits.begin(), packedSplits.end()));
+
+        const auto& unpackedApprox = unpackedTestApprox.GetRawValuesConstRef()[0][0];
+        const auto& packedApprox = packedTestApprox.GetRawValuesConstRef()[0][0];
+        UNIT_ASSERT_VALUES_EQUAL(unpackedApprox.size(), packedApprox.size());
+        for (auto i : xrange(unpackedApprox.size())) {
+            UNIT_ASSERT_DOUBLES_EQUAL(unpackedApprox[i], packedApprox[i], 1e-6);
+        }
+    }
 }
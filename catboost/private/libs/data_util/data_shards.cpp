@@ -0,0 +1,172 @@
+#include "data_shards.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <contrib/libs/zstd/zstd.h>
+
+#include <util/folder/filelist.h>
+#include <util/folder/path.h>
+#include <util/generic/algorithm.h>
+#include <util/stream/file.h>
+#include <util/stream/zlib.h>
+#include <util/system/fs.h>
+
+
+namespace NCB {
+
+    namespace {
+
+        class TZstdDecompress : public IInputStream {
+        public:
+            explicit TZstdDecompress(IInputStream* slave)
+                : Slave(slave)
+                , Stream(ZSTD_createDStream())
+                , InBuffer(ZSTD_DStreamInSize())
+                , Input{InBuffer.data(), 0, 0}
+            {
+                CB_ENSURE(Stream, "Failed to create zstd decompression stream");
+                CheckResult(ZSTD_initDStream(Stream));
+            }
+
+            ~TZstdDecompress() override {
+                ZSTD_freeDStream(Stream);
+            }
+
+        private:
+            size_t DoRead(void* buf, size_t len) override {
+                ZSTD_outBuffer output{buf, len, 0};
+                while (output.pos == 0) {
+                    if (Input.pos == Input.size) {
+                        Input.size = Slave->Read(InBuffer.data(), InBuffer.size());
+                        Input.pos = 0;
+                        if (Input.size == 0) {
+                            CB_ENSURE(FrameFinished, "Unexpected end of zstd compressed data");
+                            return 0;
+                        }
+                    }
+                    FrameFinished = (CheckResult(ZSTD_decompressStream(Stream, &output, &Input)) == 0);
+                }
+                return output.pos;
+            }
+
+            static size_t CheckResult(size_t result) {
+                CB_ENSURE(!ZSTD_isError(result), "zstd decompression error: " << ZSTD_getErrorName(result));
+                return result;
+            }
+
+        private:
+            IInputStream* Slave;
+            ZSTD_DStream* Stream;
+            TVector<char> InBuffer;
+            ZSTD_inBuffer Input;
+            bool FrameFinished = true;
+        };
+
+
+        class TDataShardInput : public IInputStream {
+        public:
+            explicit TDataShardInput(const TString& path)
+                : File(path)
+            {
+                if (TStringBuf(path).EndsWith(".gz")) {
+                    Decompressed = MakeHolder<TZLibDecompress>(&File, ZLib::GZip);
+                } else if (TStringBuf(path).EndsWith(".zst")) {
+                    Decompressed = MakeHolder<TZstdDecompress>(&File);
+                }
+            }
+
+        private:
+            size_t DoRead(void* buf, size_t len) override {
+                return Decompressed ? Decompressed->Read(buf, len) : File.Read(buf, len);
+            }
+
+        private:
+            TIFStream File;
+            THolder<IInputStream> Decompressed;
+        };
+
+
+        bool IsGlobPattern(TStringBuf name) {
+            return name.find_first_of(AsStringBuf("*?")) != TStringBuf::npos;
+        }
+
+        bool MatchGlob(TStringBuf pattern, TStringBuf name) {
+            // '*' matches any (possibly empty) sequence of characters, backtrack to the last '*' on mismatch
+            size_t patternPos = 0;
+            size_t namePos = 0;
+            size_t starPos = TStringBuf::npos;
+            size_t starMatchEnd = 0;
+            while (namePos < name.size()) {
+                if (patternPos < pattern.size() && (pattern[patternPos] == '?' || pattern[patternPos] == name[namePos])) {
+                    ++patternPos;
+                    ++namePos;
+                } else if (patternPos < pattern.size() && pattern[patternPos] == '*') {
+                    starPos = patternPos++;
+                    starMatchEnd = namePos;
+                } else if (starPos != TStringBuf::npos) {
+                    patternPos = starPos + 1;
+                    namePos = ++starMatchEnd;
+                } else {
+                    return false;
+                }
+            }
+            while (patternPos < pattern.size() && pattern[patternPos] == '*') {
+                ++patternPos;
+            }
+            return patternPos == pattern.size();
+        }
+
+        TVector<TString> ListDirFiles(const TString& dir, TStringBuf namePattern) {
+            TFileEntitiesList fileList(TFileEntitiesList::EM_FILES_SLINKS);
+            fileList.Fill(dir, /*prefix*/ TStringBuf(), /*suffix*/ TStringBuf(), /*depth*/ 1);
+
+            TVector<TString> result;
+            while (const char* name = fileList.Next()) {
+                const TStringBuf nameBuf(name);
+                if (nameBuf.StartsWith('.') || !MatchGlob(namePattern, nameBuf)) {
+                    continue;
+                }
+                const TString path = JoinFsPaths(dir, nameBuf);
+                if (TFsPath(path).IsFile()) {
+                    result.push_back(path);
+                }
+            }
+            Sort(result);
+            return result;
+        }
+
+    }
+
+
+    TVector<TString> GetDataShardPaths(const TString& path) {
+        if (NFs::Exists(path) && TFsPath(path).IsDirectory()) {
+            return ListDirFiles(path, AsStringBuf("*"));
+        }
+
+        TStringBuf dir;
+        TStringBuf name;
+        if (!TStringBuf(path).TryRSplit('/', dir, name)) {
+            dir = AsStringBuf(".");
+            name = path;
+        }
+        if (IsGlobPattern(name)) {
+            CB_ENSURE(!IsGlobPattern(dir), "Wildcards are supported only in the file name part of path " << path);
+            const TString dirPath = dir.empty() ? TString("/") : TString(dir);
+            if (!NFs::Exists(dirPath)) {
+                return {};
+            }
+            return ListDirFiles(dirPath, name);
+        }
+        return {path};
+    }
+
+    bool IsShardedDataPath(TStringBuf path) {
+        return IsGlobPattern(path) || (NFs::Exists(TString(path)) && TFsPath(path).IsDirectory());
+    }
+
+    THolder<IInputStream> OpenDataShard(const TString& path) {
+        CB_ENSURE(NFs::Exists(path), "data file '" << path << "' is not found");
+        return MakeHolder<TDataShardInput>(path);
+    }
+
+}
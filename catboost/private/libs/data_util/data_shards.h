@@ -0,0 +1,27 @@
+#pragma once
+
+#include <util/generic/ptr.h>
+#include <util/generic/strbuf.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/stream/input.h>
+
+
+namespace NCB {
+
+    /* Data can be split into several shard files, 'path' can be:
+     *  - a directory: all its files (not starting with '.') are used as shards
+     *  - a glob pattern with '*' and '?' wildcards in the file name part, e.g. 'data/part-*.tsv.gz'
+     *  - a regular file: a single shard
+     * Shards are returned in lexicographical order so the order of objects is deterministic,
+     * the result is empty if nothing matches the pattern
+     */
+    TVector<TString> GetDataShardPaths(const TString& path);
+
+    // true if 'path' is a directory or a glob pattern
+    bool IsShardedDataPath(TStringBuf path);
+
+    // '.gz' and '.zst' files are decompressed transparently
+    THolder<IInputStream> OpenDataShard(const TString& path);
+
+}
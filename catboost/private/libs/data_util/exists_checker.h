@@ -1,5 +1,6 @@
 #pragma once
 
+#include "data_shards.h"
 #include "path_with_scheme.h"
 
 #include <library/object_factory/object_factory.h>
@@ -27,7 +28,9 @@ namespace NCB {
 
     struct TFSExistsChecker : public IExistsChecker {
         bool Exists(const TPathWithScheme& pathWithScheme) const override {
-            return NFs::Exists(pathWithScheme.Path);
+            // glob patterns exist if there's at least one matching file
+            return NFs::Exists(pathWithScheme.Path)
+                || (IsShardedDataPath(pathWithScheme.Path) && !GetDataShardPaths(pathWithScheme.Path).empty());
         }
         bool IsSharedFs() const override {
             return false;
@@ -1,29 +1,405 @@
 #include "line_data_reader.h"
+#include "data_shards.h"
 
+#include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
+#include <util/generic/xrange.h>
 #include <util/system/fs.h>
+#include <util/system/guard.h>
 
 
 namespace NCB {
 
     THolder<ILineDataReader> GetLineDataReader(const TPathWithScheme& pathWithScheme,
-                                               const TDsvFormatOptions& format)
+                                               const TDsvFormatOptions& format,
+                                               int threadCount)
     {
         return GetProcessor<ILineDataReader, TLineDataReaderArgs>(
-            pathWithScheme, TLineDataReaderArgs{pathWithScheme, format}
+            pathWithScheme, TLineDataReaderArgs{pathWithScheme, format, threadCount}
         );
     }
 
     int CountLines(const TString& poolFile) {
         CB_ENSURE(NFs::Exists(TString(poolFile)), "pool file '" << TString(poolFile) << "' is not found");
-        TIFStream reader(poolFile.c_str());
+        THolder<IInputStream> reader = OpenDataShard(poolFile);
         size_t count = 0;
         TString buffer;
-        while (reader.ReadLine(buffer)) {
+        while (reader->ReadLine(buffer)) {
             ++count;
         }
         return count;
     }
 
+
+    TFileLineDataReader::TFileLineDataReader(const TLineDataReaderArgs& args)
+        : Args(args)
+        , HeaderProcessed(!Args.Format.HasHeader)
+    {
+        if (IsShardedDataPath(Args.PathWithScheme.Path)) {
+            TVector<TString> shardPaths = GetDataShardPaths(Args.PathWithScheme.Path);
+            CB_ENSURE(!shardPaths.empty(), "No data files match " << Args.PathWithScheme.Path);
+            const int threadCount = (int)Min<size_t>(shardPaths.size(), Max(Args.ThreadCount, 1));
+            ShardedReader = MakeHolder<TShardedLineDataReader>(std::move(shardPaths), Args.Format, threadCount);
+        } else {
+            Input = OpenDataShard(Args.PathWithScheme.Path);
+        }
+    }
+
+    ui64 TFileLineDataReader::GetDataLineCount() {
+        if (ShardedReader) {
+            return ShardedReader->GetDataLineCount();
+        }
+        ui64 nLines = (ui64)CountLines(Args.PathWithScheme.Path);
+        if (Args.Format.HasHeader) {
+            --nLines;
+        }
+        return nLines;
+    }
+
+    TMaybe<TString> TFileLineDataReader::GetHeader() {
+        if (ShardedReader) {
+            return ShardedReader->GetHeader();
+        }
+        if (Args.Format.HasHeader) {
+            CB_ENSURE(!HeaderProcessed, "TFileLineDataReader: multiple calls to GetHeader");
+            TString header;
+            CB_ENSURE(Input->ReadLine(header), "TFileLineDataReader: no header in file");
+            HeaderProcessed = true;
+            return header;
+        }
+
+        return {};
+    }
+
+    bool TFileLineDataReader::ReadLine(TString* line) {
+        if (ShardedReader) {
+            return ShardedReader->ReadLine(line);
+        }
+        // skip header if it hasn't been read
+        if (!HeaderProcessed) {
+            GetHeader();
+        }
+        return Input->ReadLine(*line) != 0;
+    }
+
+
+    static constexpr size_t ShardBlockLineCount = 1024;
+
+    static size_t GetLineBytes(const TString& line) {
+        return sizeof(TString) + line.size();
+    }
+
+    TShardedLineDataReader::TShardedLineDataReader(
+        TVector<TString> shardPaths,
+        const TDsvFormatOptions& format,
+        int threadCount,
+        size_t maxBufferedBytes
+    )
+        : ShardPaths(std::move(shardPaths))
+        , Format(format)
+        , MaxBufferedBytes(maxBufferedBytes)
+        , Shards(ShardPaths.size())
+        , HeaderProcessed(!Format.HasHeader)
+    {
+        CB_ENSURE(!ShardPaths.empty(), "TShardedLineDataReader: no shards");
+        LocalExecutor.RunAdditionalThreads(Max(threadCount, 1));
+        with_lock(Lock) {
+            ScheduleShardLoading();
+        }
+    }
+
+    TShardedLineDataReader::~TShardedLineDataReader() {
+        with_lock(Lock) {
+            Stopping = true;
+            BufferFreed.BroadCast();
+        }
+        // loading tasks write to Shards
+        for (auto& shard : Shards) {
+            if (shard.LoadFuture.Initialized()) {
+                shard.LoadFuture.Wait();
+            }
+        }
+    }
+
+    ui64 TShardedLineDataReader::GetDataLineCount() {
+        if (!DataLineCount) {
+            // shards that are being loaded are counted separately, their loading can wait for ReadLine calls
+            TVector<std::pair<size_t, bool>> shardsToCount; // (shardIdx, keepLines)
+            with_lock(Lock) {
+                for (auto shardIdx : xrange(Shards.size())) {
+                    TShard& shard = Shards[shardIdx];
+                    if (shard.LineCount) {
+                        continue;
+                    }
+                    const bool keepLines = shard.State == EShardState::NotLoaded;
+                    if (keepLines) {
+                        shard.State = EShardState::Counting;
+                    }
+                    shardsToCount.emplace_back(shardIdx, keepLines);
+                }
+            }
+            LocalExecutor.ExecRangeWithThrow(
+                [&] (int i) {
+                    CountShard(shardsToCount[i].first, shardsToCount[i].second);
+                },
+                0,
+                SafeIntegerCast<int>(shardsToCount.size()),
+                NPar::TLocalExecutor::WAIT_COMPLETE
+            );
+            ui64 dataLineCount = 0;
+            with_lock(Lock) {
+                for (const auto& shard : Shards) {
+                    dataLineCount += *shard.LineCount;
+                }
+            }
+            DataLineCount = dataLineCount;
+        }
+        return *DataLineCount;
+    }
+
+    TMaybe<TString> TShardedLineDataReader::GetHeader() {
+        if (Format.HasHeader) {
+            CB_ENSURE(!HeaderProcessed, "TShardedLineDataReader: multiple calls to GetHeader");
+            HeaderProcessed = true;
+            with_lock(Lock) {
+                TShard& shard = Shards[0];
+                while (!shard.HeaderIsRead && !shard.Error) {
+                    ShardUpdated.WaitI(Lock);
+                }
+                if (shard.Error) {
+                    std::rethrow_exception(shard.Error);
+                }
+                return shard.Header;
+            }
+        }
+
+        return {};
+    }
+
+    bool TShardedLineDataReader::ReadLine(TString* line) {
+        HeaderProcessed = true;
+        while (CurrentLineIdx == CurrentLines.size()) {
+            if (!TakeNextBlock()) {
+                return false;
+            }
+        }
+        *line = std::move(CurrentLines[CurrentLineIdx++]);
+        return true;
+    }
+
+    bool TShardedLineDataReader::TakeNextBlock() {
+        with_lock(Lock) {
+            while (CurrentShardIdx < Shards.size()) {
+                TShard& shard = Shards[CurrentShardIdx];
+                while (shard.Blocks.empty() && shard.State != EShardState::Loaded) {
+                    ShardUpdated.WaitI(Lock);
+                }
+                if (shard.Error) {
+                    std::rethrow_exception(shard.Error);
+                }
+                if (!shard.Blocks.empty()) {
+                    TLineBlock& block = shard.Blocks.front();
+                    CurrentLines = std::move(block.Lines);
+                    CurrentLineIdx = 0;
+                    BufferedBytes -= block.Bytes;
+                    shard.Blocks.pop_front();
+                    BufferFreed.BroadCast();
+                    return true;
+                }
+                CB_ENSURE(
+                    shard.Header == Shards[0].Header,
+                    "TShardedLineDataReader: header in " << ShardPaths[CurrentShardIdx]
+                    << " differs from header in " << ShardPaths[0]
+                );
+                ++CurrentShardIdx;
+                ScheduleShardLoading();
+                // the new current shard loading can continue
+                BufferFreed.BroadCast();
+            }
+        }
+        return false;
+    }
+
+    void TShardedLineDataReader::LoadShard(size_t shardIdx) {
+        try {
+            THolder<IInputStream> input = OpenDataShard(ShardPaths[shardIdx]);
+            TMaybe<TString> header;
+            if (Format.HasHeader) {
+                TString headerLine;
+                CB_ENSURE(input->ReadLine(headerLine), "TShardedLineDataReader: no header in file " << ShardPaths[shardIdx]);
+                header = std::move(headerLine);
+            }
+            with_lock(Lock) {
+                Shards[shardIdx].Header = std::move(header);
+                Shards[shardIdx].HeaderIsRead = true;
+                ShardUpdated.BroadCast();
+            }
+
+            ui64 lineCount = 0;
+            TLineBlock block;
+            for (TString line; input->ReadLine(line);) {
+                ++lineCount;
+                block.Bytes += GetLineBytes(line);
+                block.Lines.push_back(std::move(line));
+                if (block.Lines.size() == ShardBlockLineCount && !PushBlock(shardIdx, &block)) {
+                    return;
+                }
+            }
+            if (!block.Lines.empty() && !PushBlock(shardIdx, &block)) {
+                return;
+            }
+
+            with_lock(Lock) {
+                TShard& shard = Shards[shardIdx];
+                shard.LineCount = lineCount;
+                shard.State = EShardState::Loaded;
+                ShardUpdated.BroadCast();
+            }
+        } catch (...) {
+            with_lock(Lock) {
+                SetShardError(shardIdx, std::current_exception());
+            }
+        }
+    }
+
+    void TShardedLineDataReader::CountShard(size_t shardIdx, bool keepLines) {
+        size_t reservedBytes = 0;
+        try {
+            THolder<IInputStream> input = OpenDataShard(ShardPaths[shardIdx]);
+            TMaybe<TString> header;
+            if (Format.HasHeader) {
+                TString headerLine;
+                CB_ENSURE(input->ReadLine(headerLine), "TShardedLineDataReader: no header in file " << ShardPaths[shardIdx]);
+                header = std::move(headerLine);
+            }
+
+            ui64 lineCount = 0;
+            TDeque<TLineBlock> blocks;
+            TLineBlock block;
+            const auto keepBlock = [&] () {
+                if (TryReserveBytes(block.Bytes)) {
+                    reservedBytes += block.Bytes;
+                    blocks.push_back(std::move(block));
+                } else {
+                    // the shard will be read again by ReadLine
+                    keepLines = false;
+                    ReleaseBytes(reservedBytes);
+                    reservedBytes = 0;
+                    blocks.clear();
+                }
+                block = TLineBlock();
+            };
+            for (TString line; input->ReadLine(line);) {
+                ++lineCount;
+                if (keepLines) {
+                    block.Bytes += GetLineBytes(line);
+                    block.Lines.push_back(std::move(line));
+                    if (block.Lines.size() == ShardBlockLineCount) {
+                        keepBlock();
+                    }
+                }
+            }
+            if (keepLines && !block.Lines.empty()) {
+                keepBlock();
+            }
+
+            with_lock(Lock) {
+                TShard& shard = Shards[shardIdx];
+                if (!shard.LineCount) {
+                    shard.LineCount = lineCount;
+                }
+                if (shard.State == EShardState::Counting) {
+                    if (keepLines) {
+                        shard.Header = std::move(header);
+                        shard.HeaderIsRead = true;
+                        shard.Blocks = std::move(blocks);
+                        shard.State = EShardState::Loaded;
+                    } else {
+                        shard.State = EShardState::NotLoaded;
+                        ScheduleShardLoading();
+                    }
+                    ShardUpdated.BroadCast();
+                }
+            }
+        } catch (...) {
+            ReleaseBytes(reservedBytes);
+            if (keepLines) {
+                with_lock(Lock) {
+                    SetShardError(shardIdx, std::current_exception());
+                }
+            }
+            throw;
+        }
+    }
+
+    bool TShardedLineDataReader::PushBlock(size_t shardIdx, TLineBlock* block) {
+        with_lock(Lock) {
+            TShard& shard = Shards[shardIdx];
+            // the current shard is loaded beyond the limit if ReadLine has nothing to return
+            while (!Stopping
+                && (BufferedBytes + block->Bytes > MaxBufferedBytes)
+                && !(shardIdx == CurrentShardIdx && shard.Blocks.empty()))
+            {
+                BufferFreed.WaitI(Lock);
+            }
+            if (Stopping) {
+                return false;
+            }
+            BufferedBytes += block->Bytes;
+            shard.Blocks.push_back(std::move(*block));
+            ShardUpdated.BroadCast();
+        }
+        *block = TLineBlock();
+        return true;
+    }
+
+    bool TShardedLineDataReader::TryReserveBytes(size_t bytes) {
+        with_lock(Lock) {
+            if (BufferedBytes + bytes > MaxBufferedBytes) {
+                return false;
+            }
+            BufferedBytes += bytes;
+        }
+        return true;
+    }
+
+    void TShardedLineDataReader::ReleaseBytes(size_t bytes) {
+        if (!bytes) {
+            return;
+        }
+        with_lock(Lock) {
+            BufferedBytes -= bytes;
+            BufferFreed.BroadCast();
+        }
+    }
+
+    void TShardedLineDataReader::ScheduleShardLoading() {
+        const size_t loadAheadEnd = Min(CurrentShardIdx + (size_t)LocalExecutor.GetThreadCount(), Shards.size());
+        for (auto shardIdx : xrange(CurrentShardIdx, loadAheadEnd)) {
+            TShard& shard = Shards[shardIdx];
+            if (shard.State != EShardState::NotLoaded) {
+                continue;
+            }
+            shard.State = EShardState::Loading;
+            auto futures = LocalExecutor.ExecRangeWithFutures(
+                [this] (int shardIdx) { LoadShard(shardIdx); },
+                SafeIntegerCast<int>(shardIdx),
+                SafeIntegerCast<int>(shardIdx + 1),
+                NPar::TLocalExecutor::HIGH_PRIORITY
+            );
+            Y_VERIFY(futures.size() == 1);
+            shard.LoadFuture = std::move(futures[0]);
+        }
+    }
+
+    void TShardedLineDataReader::SetShardError(size_t shardIdx, std::exception_ptr error) {
+        TShard& shard = Shards[shardIdx];
+        shard.Error = error;
+        shard.State = EShardState::Loaded;
+        ShardUpdated.BroadCast();
+    }
+
+
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> DefLineDataReaderReg("");
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> FileLineDataReaderReg("file");
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> DsvLineDataReaderReg("dsv");
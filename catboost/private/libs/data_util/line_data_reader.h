@@ -5,11 +5,20 @@
 #include <catboost/libs/helpers/exception.h>
 
 #include <library/object_factory/object_factory.h>
+#include <library/threading/future/future.h>
+#include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/deque.h>
 #include <util/generic/maybe.h>
+#include <util/generic/ptr.h>
 #include <util/generic/string.h>
-
+#include <util/generic/vector.h>
 #include <util/stream/file.h>
+#include <util/stream/input.h>
+#include <util/system/condvar.h>
+#include <util/system/mutex.h>
+
+#include <exception>
 
 
 
@@ -23,6 +32,7 @@ namespace NCB {
     struct TLineDataReaderArgs {
         TPathWithScheme PathWithScheme;
         TDsvFormatOptions Format;
+        int ThreadCount = 1; // used to read data split into several shards
     };
 
 
@@ -49,51 +59,121 @@ namespace NCB {
         NObjectFactory::TParametrizedObjectFactory<ILineDataReader, TString, TLineDataReaderArgs>;
 
     THolder<ILineDataReader> GetLineDataReader(const TPathWithScheme& pathWithScheme,
-                                               const TDsvFormatOptions& format = {});
+                                               const TDsvFormatOptions& format = {},
+                                               int threadCount = 1);
 
 
     int CountLines(const TString& poolFile);
 
+    /* Reads a file (transparently decompressing '.gz' and '.zst' files)
+     * or, if path is a directory or a glob pattern, its shards in order (see GetDataShardPaths)
+     */
     class TFileLineDataReader : public ILineDataReader {
     public:
-        TFileLineDataReader(const TLineDataReaderArgs& args)
-            : Args(args)
-            , IFStream(args.PathWithScheme.Path)
-            , HeaderProcessed(!Args.Format.HasHeader)
-        {}
-
-        ui64 GetDataLineCount() override {
-            ui64 nLines = (ui64)CountLines(Args.PathWithScheme.Path);
-            if (Args.Format.HasHeader) {
-                --nLines;
-            }
-            return nLines;
-        }
-
-        TMaybe<TString> GetHeader() override {
-            if (Args.Format.HasHeader) {
-                CB_ENSURE(!HeaderProcessed, "TFileLineDataReader: multiple calls to GetHeader");
-                TString header;
-                CB_ENSURE(IFStream.ReadLine(header), "TFileLineDataReader: no header in file");
-                HeaderProcessed = true;
-                return header;
-            }
-
-            return {};
-        }
-
-        bool ReadLine(TString* line) override {
-            // skip header if it hasn't been read
-            if (!HeaderProcessed) {
-                GetHeader();
-            }
-            return IFStream.ReadLine(*line) != 0;
-        }
+        TFileLineDataReader(const TLineDataReaderArgs& args);
+
+        ui64 GetDataLineCount() override;
+
+        TMaybe<TString> GetHeader() override;
+
+        bool ReadLine(TString* line) override;
 
     private:
         TLineDataReaderArgs Args;
-        TIFStream IFStream;
+        THolder<ILineDataReader> ShardedReader; // used if data is split into several shards
+        THolder<IInputStream> Input;
         bool HeaderProcessed;
     };
 
+
+    /* Shards are read and decompressed concurrently by threadCount background threads (up to threadCount
+     * shards starting from the current one), lines are returned in the order of shards.
+     * Loaded lines that are not yet returned take at most maxBufferedBytes, loading of further shards waits
+     * for ReadLine calls, only the current shard is loaded beyond this limit if there are no lines of it to return.
+     * Line counts are collected while shards are read, GetDataLineCount reads only shards with unknown counts
+     * and keeps lines of not yet loaded ones for ReadLine if they fit into maxBufferedBytes.
+     * If format.HasHeader each shard must start with the same header.
+     */
+    class TShardedLineDataReader : public ILineDataReader {
+    public:
+        static constexpr size_t DefaultMaxBufferedBytes = 256 << 20;
+
+    public:
+        TShardedLineDataReader(
+            TVector<TString> shardPaths,
+            const TDsvFormatOptions& format,
+            int threadCount,
+            size_t maxBufferedBytes = DefaultMaxBufferedBytes
+        );
+
+        ~TShardedLineDataReader();
+
+        ui64 GetDataLineCount() override;
+
+        TMaybe<TString> GetHeader() override;
+
+        bool ReadLine(TString* line) override;
+
+    private:
+        struct TLineBlock {
+            TVector<TString> Lines;
+            size_t Bytes = 0;
+        };
+
+        enum class EShardState {
+            NotLoaded,
+            Counting, // lines are kept if they fit into the buffer
+            Loading,
+            Loaded
+        };
+
+        struct TShard {
+            EShardState State = EShardState::NotLoaded;
+            bool HeaderIsRead = false;
+            TMaybe<TString> Header;
+            TDeque<TLineBlock> Blocks; // loaded and not yet returned by ReadLine
+            TMaybe<ui64> LineCount;
+            std::exception_ptr Error;
+            NThreading::TFuture<void> LoadFuture;
+        };
+
+    private:
+        void LoadShard(size_t shardIdx);
+        void CountShard(size_t shardIdx, bool keepLines);
+
+        // waits for space in the buffer, returns false if the reader is being destroyed
+        bool PushBlock(size_t shardIdx, TLineBlock* block);
+        bool TryReserveBytes(size_t bytes);
+        void ReleaseBytes(size_t bytes);
+
+        // call under Lock
+        void ScheduleShardLoading();
+        void SetShardError(size_t shardIdx, std::exception_ptr error);
+
+        bool TakeNextBlock();
+
+    private:
+        TVector<TString> ShardPaths;
+        TDsvFormatOptions Format;
+        size_t MaxBufferedBytes;
+
+        // private threads, loading tasks block until the consumer takes loaded lines
+        NPar::TLocalExecutor LocalExecutor;
+
+        TMutex Lock;
+        TCondVar ShardUpdated;
+        TCondVar BufferFreed;
+        size_t BufferedBytes = 0;
+        bool Stopping = false;
+        TVector<TShard> Shards;
+        size_t CurrentShardIdx = 0;
+
+        // accessed only by the consumer
+        TVector<TString> CurrentLines;
+        size_t CurrentLineIdx = 0;
+        bool HeaderProcessed;
+
+        TMaybe<ui64> DataLineCount; // cached
+    };
+
 }
@@ -0,0 +1,147 @@
+#include <library/unittest/registar.h>
+
+#include <catboost/private/libs/data_util/exists_checker.h>
+#include <catboost/private/libs/data_util/line_data_reader.h>
+
+#include <contrib/libs/zstd/zstd.h>
+
+#include <util/folder/path.h>
+#include <util/folder/tempdir.h>
+#include <util/generic/xrange.h>
+#include <util/stream/file.h>
+#include <util/stream/zlib.h>
+
+
+using namespace NCB;
+
+
+static void WriteShard(const TString& path, const TString& data) {
+    TOFStream out(path);
+    if (TStringBuf(path).EndsWith(".gz")) {
+        TZLibCompress compressed(&out, ZLib::GZip);
+        compressed.Write(data);
+        compressed.Finish();
+    } else if (TStringBuf(path).EndsWith(".zst")) {
+        TVector<char> compressed(ZSTD_compressBound(data.size()));
+        const size_t compressedSize = ZSTD_compress(compressed.data(), compressed.size(), data.data(), data.size(), 1);
+        UNIT_ASSERT(!ZSTD_isError(compressedSize));
+        out.Write(compressed.data(), compressedSize);
+    } else {
+        out.Write(data);
+    }
+}
+
+static TVector<TString> ReadAllLines(ILineDataReader* reader) {
+    TVector<TString> lines;
+    TString line;
+    while (reader->ReadLine(&line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+
+Y_UNIT_TEST_SUITE(LineDataReader) {
+    Y_UNIT_TEST(CompressedFile) {
+        TTempDir tempDir;
+        for (TString name : {"data.tsv.gz", "data.tsv.zst"}) {
+            const TString path = JoinFsPaths(tempDir(), name);
+            WriteShard(path, "a\tb\n1\t2\n3\t4\n");
+
+            auto reader = GetLineDataReader(TPathWithScheme(path), TDsvFormatOptions{true, '\t'});
+            UNIT_ASSERT_VALUES_EQUAL(reader->GetDataLineCount(), 2);
+            UNIT_ASSERT_VALUES_EQUAL(*reader->GetHeader(), "a\tb");
+            UNIT_ASSERT_VALUES_EQUAL(ReadAllLines(reader.Get()), (TVector<TString>{"1\t2", "3\t4"}));
+        }
+    }
+
+    Y_UNIT_TEST(Shards) {
+        TTempDir tempDir;
+        // shards are read in the order of their names
+        const TVector<TString> shardNames = {"part-02.tsv.zst", "part-00.tsv", "part-10.tsv.gz", "part-01.tsv.gz"};
+        for (auto shardName : shardNames) {
+            const TString shardIdx = TString(TStringBuf(shardName).SubStr(5, 2));
+            TString data = "h\n";
+            for (auto lineIdx : xrange(3)) {
+                data += shardIdx + "_" + ToString(lineIdx) + "\n";
+            }
+            WriteShard(JoinFsPaths(tempDir(), shardName), data);
+        }
+        WriteShard(JoinFsPaths(tempDir(), ".hidden"), "h\nhidden\n");
+
+        const TVector<TString> expectedLines = {
+            "00_0", "00_1", "00_2", "01_0", "01_1", "01_2", "02_0", "02_1", "02_2", "10_0", "10_1", "10_2"
+        };
+        for (const TString& path : {tempDir(), JoinFsPaths(tempDir(), "part-*.tsv*")}) {
+            UNIT_ASSERT(CheckExists(TPathWithScheme(path)));
+
+            auto reader = GetLineDataReader(TPathWithScheme(path), TDsvFormatOptions{true, '\t'});
+            UNIT_ASSERT_VALUES_EQUAL(reader->GetDataLineCount(), expectedLines.size());
+            UNIT_ASSERT_VALUES_EQUAL(*reader->GetHeader(), "h");
+            UNIT_ASSERT_VALUES_EQUAL(ReadAllLines(reader.Get()), expectedLines);
+        }
+
+        auto reader = GetLineDataReader(TPathWithScheme(JoinFsPaths(tempDir(), "part-0?.tsv.gz")));
+        UNIT_ASSERT_VALUES_EQUAL(ReadAllLines(reader.Get()), (TVector<TString>{"h", "01_0", "01_1", "01_2"}));
+
+        UNIT_ASSERT(!CheckExists(TPathWithScheme(JoinFsPaths(tempDir(), "other-*"))));
+    }
+
+    Y_UNIT_TEST(ShardsWithBoundedBuffer) {
+        TTempDir tempDir;
+        TVector<TString> shardPaths;
+        TVector<TString> expectedLines;
+        // shards span several line blocks
+        for (auto shardIdx : xrange(6)) {
+            TString data = "h\n";
+            for (auto lineIdx : xrange(2500)) {
+                const TString line = ToString(shardIdx) + "_" + ToString(lineIdx);
+                data += line + "\n";
+                expectedLines.push_back(line);
+            }
+            shardPaths.push_back(JoinFsPaths(tempDir(), ToString(shardIdx) + (shardIdx % 2 ? ".tsv.gz" : ".tsv")));
+            WriteShard(shardPaths.back(), data);
+        }
+
+        // a single line block fits, all lines fit
+        for (size_t maxBufferedBytes : {size_t(1), size_t(64) << 10, TShardedLineDataReader::DefaultMaxBufferedBytes}) {
+            for (int threadCount : {1, 3}) {
+                for (size_t countAfterLines : {size_t(0), size_t(100), size_t(4000), expectedLines.size()}) {
+                    TShardedLineDataReader reader(shardPaths, TDsvFormatOptions{true, '\t'}, threadCount, maxBufferedBytes);
+                    UNIT_ASSERT_VALUES_EQUAL(*reader.GetHeader(), "h");
+                    TVector<TString> lines;
+                    TString line;
+                    while (true) {
+                        if (lines.size() == countAfterLines) {
+                            UNIT_ASSERT_VALUES_EQUAL(reader.GetDataLineCount(), expectedLines.size());
+                        }
+                        if (!reader.ReadLine(&line)) {
+                            break;
+                        }
+                        lines.push_back(line);
+                    }
+                    UNIT_ASSERT_VALUES_EQUAL(lines, expectedLines);
+                    UNIT_ASSERT_VALUES_EQUAL(reader.GetDataLineCount(), expectedLines.size());
+                }
+            }
+        }
+
+        // the reader is destroyed while loading tasks wait for buffer space
+        {
+            TShardedLineDataReader reader(shardPaths, TDsvFormatOptions{true, '\t'}, 3, 1);
+            TString line;
+            UNIT_ASSERT_VALUES_EQUAL(*reader.GetHeader(), "h");
+            UNIT_ASSERT(reader.ReadLine(&line));
+            UNIT_ASSERT_VALUES_EQUAL(line, "0_0");
+        }
+    }
+
+    Y_UNIT_TEST(DifferentShardHeaders) {
+        TTempDir tempDir;
+        WriteShard(JoinFsPaths(tempDir(), "0.tsv"), "a\n1\n");
+        WriteShard(JoinFsPaths(tempDir(), "1.tsv"), "b\n2\n");
+
+        auto reader = GetLineDataReader(TPathWithScheme(tempDir()), TDsvFormatOptions{true, '\t'});
+        UNIT_ASSERT_EXCEPTION(ReadAllLines(reader.Get()), TCatBoostException);
+    }
+}
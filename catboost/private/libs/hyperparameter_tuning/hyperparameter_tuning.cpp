@@ -18,7 +18,9 @@
 #include <util/generic/xrange.h>
 #include <util/random/shuffle.h>
 
+#include <cmath>
 #include <numeric>
+#include <tuple>
 
 namespace {
 
@@ -1066,9 +1068,377 @@ namespace {
         }
         return bestParamsSetMetricValue;
     }
+
+    class TIterationsLimitCallbacks : public ITrainingCallbacks {
+    public:
+        TIterationsLimitCallbacks(ui32 startIteration, ui32 iterationsLimit)
+            : StartIteration(startIteration)
+            , IterationsLimit(iterationsLimit)
+        {}
+
+        bool IsContinueTraining(const TMetricsAndTimeLeftHistory& metricsAndTimeHistory) override {
+            return StartIteration + metricsAndTimeHistory.TimeHistory.size() < IterationsLimit;
+        }
+
+    private:
+        ui32 StartIteration;
+        ui32 IterationsLimit;
+    };
+
+    struct THalvingCandidate {
+        TVector<NJson::TJsonValue> ParamsSet; // {border_count, feature_border_type, nan_mode, [others]}
+        TQuantizationParamsInfo QuantizationParamsSet;
+        NJson::TJsonValue ModelParams;
+        ui32 IterationCount = 0;
+
+        THolder<TLearnProgress> LearnProgress; // defined only if training can be continued
+        ui32 TrainedIterations = 0;
+        bool HasMetricValue = false;
+        double MetricValue = 0.0;
+    };
+
+    double TuneHyperparamsTrainTestWithHalving(
+        const TVector<TString>& paramNames,
+        const TMaybe<TCustomObjectiveDescriptor>& objectiveDescriptor,
+        const TMaybe<TCustomMetricDescriptor>& evalMetricDescriptor,
+        const TTrainTestSplitParams& trainTestSplitParams,
+        const TGeneralQuatizationParamsInfo& generalQuantizeParamsInfo,
+        const NCB::THalvingSearchParams& halvingSearchParams,
+        ui64 cpuUsedRamLimit,
+        NCB::TDataProviderPtr data,
+        TProductIteratorBase<TDeque<NJson::TJsonValue>, NJson::TJsonValue>* gridIterator,
+        NJson::TJsonValue* modelParamsToBeTried,
+        TGridParamsInfo* bestGridParams,
+        NPar::TLocalExecutor* localExecutor,
+        int verbose,
+        const THashMap<TString, NCB::TCustomRandomDistributionGenerator>& randDistGenerators = {}) {
+        TRestorableFastRng64 rand(trainTestSplitParams.PartitionRandSeed);
+
+        if (trainTestSplitParams.Shuffle) {
+            auto objectsGroupingSubset = NCB::Shuffle(data->ObjectsGrouping, 1, &rand);
+            data = data->GetSubset(objectsGroupingSubset, cpuUsedRamLimit, localExecutor);
+        }
+
+        // Random values are sampled once per candidate, so survivors keep their parameters between rounds
+        TVector<THalvingCandidate> candidates;
+        while (auto paramsSet = gridIterator->Next()) {
+            THalvingCandidate candidate;
+            candidate.ParamsSet.assign(paramsSet->begin(), paramsSet->end());
+            candidate.QuantizationParamsSet.BinsCount = GetRandomValueIfNeeded((*paramsSet)[0], randDistGenerators).GetInteger();
+            candidate.QuantizationParamsSet.BorderType = FromString<EBorderSelectionType>((*paramsSet)[1].GetString());
+            candidate.QuantizationParamsSet.NanMode = FromString<ENanMode>((*paramsSet)[2].GetString());
+            AssignOptionsToJson(
+                TConstArrayRef<TString>(paramNames),
+                TConstArrayRef<NJson::TJsonValue>(
+                    paramsSet->begin() + IndexOfFirstTrainingParameter,
+                    paramsSet->end()
+                ), // Ignoring quantization params
+                randDistGenerators,
+                modelParamsToBeTried
+            );
+            candidate.ModelParams = *modelParamsToBeTried;
+            candidates.push_back(std::move(candidate));
+        }
+        CB_ENSURE(!candidates.empty(), "Error: no parameter sets to search over");
+
+        const TVector<size_t> roundCandidateCounts = halvingSearchParams.GetRoundCandidateCounts(candidates.size());
+        const ui32 roundCount = roundCandidateCounts.size();
+        const size_t totalRunCount = Accumulate(roundCandidateCounts, size_t(0));
+
+        TSetLogging inThisScope(ELoggingLevel::Verbose);
+        TLogger logger;
+        TString searchToken = "loss";
+        const auto parametersToken = GetParametersToken();
+        AddConsoleLogger(
+            searchToken,
+            {},
+            /*hasTrain=*/true,
+            verbose,
+            totalRunCount,
+            &logger
+        );
+
+        /* Only one quantized and split pool is kept at a time: candidates of a round are trained
+         * grouped by quantization params, so each pool is built at most once per round.
+         * Quantization gets its own random generator with a fixed seed so that the pool
+         * of survivors is the same in all rounds and their training can be continued on it.
+         */
+        using TQuantizationKey = std::tuple<int, EBorderSelectionType, ENanMode>;
+        const auto getQuantizationKey = [&] (size_t candidateIdx) {
+            const TQuantizationParamsInfo& quantizationParamsSet = candidates[candidateIdx].QuantizationParamsSet;
+            return std::make_tuple(
+                quantizationParamsSet.BinsCount,
+                quantizationParamsSet.BorderType,
+                quantizationParamsSet.NanMode);
+        };
+        TMaybe<TQuantizationKey> quantizedDataKey;
+        NCB::TTrainingDataProviders quantizedData;
+        TLabelConverter labelConverter;
+
+        TVector<size_t> survivors(candidates.size());
+        std::iota(survivors.begin(), survivors.end(), 0);
+
+        double bestParamsSetMetricValue = 0.0;
+        bool isBestDefined = false;
+        bool areFilesLoggersInitialized = false;
+        bool allowWriteFiles = false;
+        int runIdx = 0;
+        int bestRunIdx = 0;
+        TProfileInfo profile(totalRunCount);
+        for (ui32 roundIdx : xrange(roundCount)) {
+            Y_ASSERT(survivors.size() == roundCandidateCounts[roundIdx]);
+
+            TVector<size_t> roundTrainOrder = survivors;
+            StableSortBy(roundTrainOrder, getQuantizationKey);
+
+            int metricSign = 1;
+            for (size_t candidateIdx : roundTrainOrder) {
+                auto& candidate = candidates[candidateIdx];
+                profile.StartIterationBlock();
+
+                NJson::TJsonValue jsonParams;
+                NJson::TJsonValue outputJsonParams;
+                NCatboostOptions::PlainJsonToOptions(candidate.ModelParams, &jsonParams, &outputJsonParams);
+                NCatboostOptions::TCatBoostOptions catBoostOptions(NCatboostOptions::LoadOptions(jsonParams));
+                NCatboostOptions::TOutputFilesOptions outputFileOptions;
+                outputFileOptions.Load(outputJsonParams);
+                if (runIdx == 0) {
+                    allowWriteFiles = outputFileOptions.AllowWriteFiles();
+                }
+                InitializeEvalMetricIfNotSet(catBoostOptions.MetricOptions->ObjectiveMetric, &catBoostOptions.MetricOptions->EvalMetric);
+
+                candidate.IterationCount = catBoostOptions.BoostingOptions->IterationCount.Get();
+                const ui32 roundIterations = halvingSearchParams.GetRoundIterationCount(
+                    candidate.IterationCount,
+                    roundIdx,
+                    roundCount);
+
+                const TQuantizationParamsInfo& quantizationParamsSet = candidate.QuantizationParamsSet;
+                const auto quantizationKey = getQuantizationKey(candidateIdx);
+
+                TMetricsAndTimeLeftHistory metricsAndTimeHistory;
+                if (candidate.TrainedIterations < roundIterations) {
+                    TSetLogging inThisScope(catBoostOptions.LoggingLevel);
+                    if (quantizedDataKey != quantizationKey) {
+                        quantizedData = NCB::TTrainingDataProviders(); // free memory before quantization
+                        TRestorableFastRng64 quantizationRand(trainTestSplitParams.PartitionRandSeed);
+                        QuantizeAndSplitDataIfNeeded(
+                            allowWriteFiles,
+                            trainTestSplitParams,
+                            cpuUsedRamLimit,
+                            data->MetaInfo.FeaturesLayout,
+                            /*quantizedFeaturesInfo*/ nullptr,
+                            data,
+                            /*oldQuantizedParamsInfo*/ TQuantizationParamsInfo(),
+                            quantizationParamsSet,
+                            &labelConverter,
+                            localExecutor,
+                            &quantizationRand,
+                            &catBoostOptions,
+                            &quantizedData
+                        );
+                        quantizedDataKey = quantizationKey;
+                    }
+                    const bool canContinueTraining = catBoostOptions.GetTaskType() == ETaskType::CPU;
+                    if (!canContinueTraining) {
+                        candidate.TrainedIterations = 0;
+                    }
+
+                    THolder<IModelTrainer> modelTrainerHolder = TTrainerFactory::Construct(catBoostOptions.GetTaskType());
+
+                    TEvalResult evalRes;
+
+                    TTrainModelInternalOptions internalOptions;
+                    internalOptions.CalcMetricsOnly = true;
+                    internalOptions.ForceCalcEvalMetricOnEveryIteration = false;
+                    internalOptions.OffsetMetricPeriodByInitModelSize = true;
+                    outputFileOptions.SetAllowWriteFiles(false);
+
+                    const THolder<ITrainingCallbacks> callbacks = MakeHolder<TIterationsLimitCallbacks>(
+                        candidate.TrainedIterations,
+                        roundIterations);
+
+                    modelTrainerHolder->TrainModel(
+                        internalOptions,
+                        catBoostOptions,
+                        outputFileOptions,
+                        objectiveDescriptor,
+                        evalMetricDescriptor,
+                        quantizedData,
+                        labelConverter,
+                        callbacks,
+                        /*initModel*/ Nothing(),
+                        std::move(candidate.LearnProgress),
+                        /*initModelApplyCompatiblePools*/ NCB::TDataProviders(),
+                        localExecutor,
+                        &rand,
+                        /*dstModel*/ nullptr,
+                        /*evalResultPtrs*/ {&evalRes},
+                        &metricsAndTimeHistory,
+                        canContinueTraining ? &candidate.LearnProgress : nullptr
+                    );
+                    candidate.TrainedIterations = roundIterations;
+                }
+
+                ui32 approxDimension = NCB::GetApproxDimension(catBoostOptions, labelConverter, data->RawTargetData.GetTargetDimension());
+                const TVector<THolder<IMetric>> metrics = CreateMetrics(
+                    catBoostOptions.MetricOptions,
+                    evalMetricDescriptor,
+                    approxDimension,
+                    data->MetaInfo.HasWeights
+                );
+                metricSign = GetSignForMetricMinimization(metrics[0]);
+                const TString& lossDescription = metrics[0]->GetDescription();
+                if (!metricsAndTimeHistory.TestBestError.empty()) {
+                    // history is reset on training continuation, so keep the best value over all rounds
+                    const double roundMetricValue = metricsAndTimeHistory.TestBestError[0][lossDescription];
+                    if (!candidate.HasMetricValue || (metricSign * roundMetricValue < metricSign * candidate.MetricValue)) {
+                        candidate.MetricValue = roundMetricValue;
+                        candidate.HasMetricValue = true;
+                    }
+                }
+
+                if (allowWriteFiles && !areFilesLoggersInitialized) {
+                    // Initialize Files Loggers
+                    outputFileOptions.SetAllowWriteFiles(allowWriteFiles);
+                    TOutputFiles outputFiles(outputFileOptions, "");
+                    InitializeFilesLoggers(
+                        metrics,
+                        outputFiles,
+                        totalRunCount,
+                        ELaunchMode::Train,
+                        quantizedData.Test.ysize(),
+                        parametersToken,
+                        &logger
+                    );
+                    areFilesLoggersInitialized = true;
+                }
+
+                if (candidate.TrainedIterations == candidate.IterationCount) {
+                    if (!isBestDefined) {
+                        // We guarantee to update the parameters on the first fully trained candidate
+                        bestParamsSetMetricValue = candidate.MetricValue + metricSign;
+                        isBestDefined = true;
+                    }
+                    bool isUpdateBest = SetBestParamsAndUpdateMetricValueIfNeeded(
+                        candidate.MetricValue,
+                        metrics,
+                        quantizationParamsSet,
+                        candidate.ModelParams,
+                        paramNames,
+                        /*quantizedFeaturesInfo*/ nullptr,
+                        bestGridParams,
+                        &bestParamsSetMetricValue);
+                    if (isUpdateBest) {
+                        bestRunIdx = runIdx;
+                    }
+                }
+
+                TOneInterationLogger oneIterLogger(logger);
+                if (isBestDefined) {
+                    oneIterLogger.OutputMetric(
+                        searchToken,
+                        TMetricEvalResult(
+                            lossDescription,
+                            candidate.MetricValue,
+                            bestParamsSetMetricValue,
+                            bestRunIdx,
+                            true
+                        )
+                    );
+                } else {
+                    oneIterLogger.OutputMetric(
+                        searchToken,
+                        TMetricEvalResult(lossDescription, candidate.MetricValue, true)
+                    );
+                }
+                if (allowWriteFiles) {
+                    //log metrics
+                    if (!metricsAndTimeHistory.TestBestError.empty()) {
+                        const auto& skipMetricOnTrain = GetSkipMetricOnTrain(metrics);
+                        auto& learnErrors = metricsAndTimeHistory.LearnBestError;
+                        auto& testErrors = metricsAndTimeHistory.TestBestError[0];
+                        for (auto metricIdx : xrange(metrics.size())) {
+                            const auto& metricDescription = metrics[metricIdx]->GetDescription();
+                            LogTrainTest(
+                                metricDescription,
+                                oneIterLogger,
+                                skipMetricOnTrain[metricIdx] ? Nothing() :
+                                    MakeMaybe<double>(learnErrors.at(metricDescription)),
+                                testErrors.at(metricDescription),
+                                "learn",
+                                "test",
+                                metricIdx == 0
+                            );
+                        }
+                    }
+                    //log parameters
+                    LogParameters(
+                        paramNames,
+                        candidate.ParamsSet,
+                        parametersToken,
+                        generalQuantizeParamsInfo,
+                        oneIterLogger
+                    );
+                }
+                profile.FinishIterationBlock(1);
+                oneIterLogger.OutputProfile(profile.GetProfileResults());
+                runIdx++;
+            }
+
+            if (roundIdx + 1 == roundCount) {
+                break;
+            }
+
+            StableSortBy(
+                survivors,
+                [&] (size_t candidateIdx) { return metricSign * candidates[candidateIdx].MetricValue; }
+            );
+            const size_t survivorCount = roundCandidateCounts[roundIdx + 1];
+            for (auto idx : xrange(survivorCount, survivors.size())) {
+                candidates[survivors[idx]].LearnProgress.Destroy(); // free memory of dropped candidates
+            }
+            survivors.resize(survivorCount);
+            if (verbose) {
+                CATBOOST_NOTICE_LOG << "Successive halving: round " << roundIdx << " done, "
+                    << survivorCount << " candidates are kept" << Endl;
+            }
+        }
+        return bestParamsSetMetricValue;
+    }
 } // anonymous namespace
 
 namespace NCB {
+    void THalvingSearchParams::Check() const {
+        CB_ENSURE(
+            ReductionFactor > 1.0,
+            "Successive halving reduction factor should be greater than 1, got " << ReductionFactor << " instead"
+        );
+    }
+
+    TVector<size_t> THalvingSearchParams::GetRoundCandidateCounts(size_t candidateCount) const {
+        TVector<size_t> roundCandidateCounts = {candidateCount};
+        while (roundCandidateCounts.back() >= ReductionFactor) {
+            roundCandidateCounts.push_back(
+                Max<size_t>(1, static_cast<size_t>(roundCandidateCounts.back() / ReductionFactor))
+            );
+        }
+        return roundCandidateCounts;
+    }
+
+    ui32 THalvingSearchParams::GetRoundIterationCount(ui32 iterationCount, ui32 roundIdx, ui32 roundCount) const {
+        if (roundIdx + 1 == roundCount) {
+            return iterationCount;
+        }
+        double roundIterations;
+        if (MinIterations) {
+            roundIterations = MinIterations * pow(ReductionFactor, roundIdx);
+        } else {
+            roundIterations = iterationCount / pow(ReductionFactor, roundCount - 1 - roundIdx);
+        }
+        return Min(iterationCount, Max<ui32>(1, static_cast<ui32>(ceil(roundIterations))));
+    }
+
     void TBestOptionValuesWithCvResult::SetOptionsFromJson(
         const THashMap<TString, NJson::TJsonValue>& options,
         const TVector<TString>& optionsNames) {
@@ -1119,7 +1489,8 @@ namespace NCB {
         TBestOptionValuesWithCvResult* bestOptionValuesWithCvResult,
         bool isSearchUsingTrainTestSplit,
         bool returnCvStat,
-        int verbose) {
+        int verbose,
+        const TMaybe<THalvingSearchParams>& halvingSearchParams) {
 
         // CatBoost options
         NJson::TJsonValue jsonParams;
@@ -1130,6 +1501,11 @@ namespace NCB {
         outputFileOptions.Load(outputJsonParams);
         CB_ENSURE(!outputJsonParams["save_snapshot"].GetBoolean(), "Snapshots are not yet supported for GridSearchCV");
 
+        if (halvingSearchParams) {
+            CB_ENSURE(isSearchUsingTrainTestSplit, "Successive halving is supported only for search using train-test split");
+            halvingSearchParams->Check();
+        }
+
         InitializeEvalMetricIfNotSet(catBoostOptions.MetricOptions->ObjectiveMetric, &catBoostOptions.MetricOptions->EvalMetric);
 
         NPar::TLocalExecutor localExecutor;
@@ -1174,7 +1550,23 @@ namespace NCB {
                 TSetLogging inThisScope(ELoggingLevel::Verbose);
                 CATBOOST_NOTICE_LOG << "Grid #" << gridEnumerator << Endl;
             }
-            if (isSearchUsingTrainTestSplit) {
+            if (halvingSearchParams) {
+                metricValue = TuneHyperparamsTrainTestWithHalving(
+                    paramNames,
+                    objectiveDescriptor,
+                    evalMetricDescriptor,
+                    trainTestSplitParams,
+                    generalQuantizeParamsInfo,
+                    *halvingSearchParams,
+                    cpuUsedRamLimit,
+                    data,
+                    &gridIterator,
+                    &modelParamsToBeTried,
+                    &gridParams,
+                    &localExecutor,
+                    verbose
+                );
+            } else if (isSearchUsingTrainTestSplit) {
                 metricValue = TuneHyperparamsTrainTest(
                     paramNames,
                     objectiveDescriptor,
@@ -1247,7 +1639,8 @@ namespace NCB {
         TBestOptionValuesWithCvResult* bestOptionValuesWithCvResult,
         bool isSearchUsingTrainTestSplit,
         bool returnCvStat,
-        int verbose) {
+        int verbose,
+        const TMaybe<THalvingSearchParams>& halvingSearchParams) {
 
         // CatBoost options
         NJson::TJsonValue jsonParams;
@@ -1258,6 +1651,11 @@ namespace NCB {
         outputFileOptions.Load(outputJsonParams);
         CB_ENSURE(!outputJsonParams["save_snapshot"].GetBoolean(), "Snapshots are not yet supported for RandomizedSearchCV");
 
+        if (halvingSearchParams) {
+            CB_ENSURE(isSearchUsingTrainTestSplit, "Successive halving is supported only for search using train-test split");
+            halvingSearchParams->Check();
+        }
+
         InitializeEvalMetricIfNotSet(catBoostOptions.MetricOptions->ObjectiveMetric, &catBoostOptions.MetricOptions->EvalMetric);
         NPar::TLocalExecutor localExecutor;
         localExecutor.RunAdditionalThreads(catBoostOptions.SystemOptions->NumThreads.Get() - 1);
@@ -1297,7 +1695,24 @@ namespace NCB {
 
         TGridParamsInfo bestGridParams;
         TVector<TCVResult> cvResult;
-        if (isSearchUsingTrainTestSplit) {
+        if (halvingSearchParams) {
+            TuneHyperparamsTrainTestWithHalving(
+                paramNames,
+                objectiveDescriptor,
+                evalMetricDescriptor,
+                trainTestSplitParams,
+                generalQuantizeParamsInfo,
+                *halvingSearchParams,
+                cpuUsedRamLimit,
+                data,
+                &gridIterator,
+                &modelParamsToBeTried,
+                &bestGridParams,
+                &localExecutor,
+                verbose,
+                randDistGenerators
+            );
+        } else if (isSearchUsingTrainTestSplit) {
             TuneHyperparamsTrainTest(
                 paramNames,
                 objectiveDescriptor,
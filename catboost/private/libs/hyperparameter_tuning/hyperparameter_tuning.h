@@ -29,6 +29,26 @@ namespace NCB {
         TEvalFuncPtr EvalFunc = nullptr;
     };
 
+    // Successive halving: all candidates are trained with a small iterations budget, only the best
+    // 1/ReductionFactor of them survive to the next round where the budget is multiplied by ReductionFactor.
+    // Survivors continue training from already learned trees (on CPU) instead of restarting.
+    struct THalvingSearchParams {
+        double ReductionFactor = 3.0;
+
+        // Iterations budget of the first round,
+        // if 0 - derived from the iteration count so that the last round trains full models
+        ui32 MinIterations = 0;
+
+    public:
+        void Check() const;
+
+        // [roundIdx], the first round trains all candidates
+        TVector<size_t> GetRoundCandidateCounts(size_t candidateCount) const;
+
+        // iterations budget of a candidate with iterationCount iterations in roundIdx-th round
+        ui32 GetRoundIterationCount(ui32 iterationCount, ui32 roundIdx, ui32 roundCount) const;
+    };
+
     struct TBestOptionValuesWithCvResult {
     public:
         TVector<TCVResult> CvResult;
@@ -54,7 +74,8 @@ namespace NCB {
         TBestOptionValuesWithCvResult* bestOptionValuesWithCvResult,
         bool isSearchUsingTrainTestSplit = true,
         bool returnCvStat = true,
-        int verbose = 1);
+        int verbose = 1,
+        const TMaybe<THalvingSearchParams>& halvingSearchParams = Nothing());
 
     void RandomizedSearch(
         ui32 numberOfTries,
@@ -69,5 +90,6 @@ namespace NCB {
         TBestOptionValuesWithCvResult* bestOptionValuesWithCvResult,
         bool isSearchUsingTrainTestSplit = true,
         bool returnCvStat = true,
-        int verbose = 1);
+        int verbose = 1,
+        const TMaybe<THalvingSearchParams>& halvingSearchParams = Nothing());
 }
@@ -0,0 +1,81 @@
+#include <catboost/private/libs/hyperparameter_tuning/hyperparameter_tuning.h>
+#include <catboost/libs/helpers/exception.h>
+
+#include <library/unittest/registar.h>
+
+#include <util/generic/xrange.h>
+
+
+using namespace NCB;
+
+Y_UNIT_TEST_SUITE(THalvingScheduleTest) {
+    TVector<ui32> GetRoundIterationCounts(
+        const THalvingSearchParams& halvingSearchParams,
+        size_t candidateCount,
+        ui32 iterationCount) {
+
+        const ui32 roundCount = halvingSearchParams.GetRoundCandidateCounts(candidateCount).size();
+        TVector<ui32> roundIterationCounts;
+        for (auto roundIdx : xrange(roundCount)) {
+            roundIterationCounts.push_back(
+                halvingSearchParams.GetRoundIterationCount(iterationCount, roundIdx, roundCount)
+            );
+        }
+        return roundIterationCounts;
+    }
+
+    Y_UNIT_TEST(TestDerivedIterations) {
+        THalvingSearchParams halvingSearchParams;
+        halvingSearchParams.ReductionFactor = 3.0;
+
+        UNIT_ASSERT_VALUES_EQUAL(
+            halvingSearchParams.GetRoundCandidateCounts(27),
+            TVector<size_t>({27, 9, 3, 1})
+        );
+        UNIT_ASSERT_VALUES_EQUAL(
+            GetRoundIterationCounts(halvingSearchParams, 27, 27),
+            TVector<ui32>({1, 3, 9, 27})
+        );
+
+        UNIT_ASSERT_VALUES_EQUAL(
+            halvingSearchParams.GetRoundCandidateCounts(10),
+            TVector<size_t>({10, 3, 1})
+        );
+        UNIT_ASSERT_VALUES_EQUAL(
+            GetRoundIterationCounts(halvingSearchParams, 10, 100),
+            TVector<ui32>({12, 34, 100})
+        );
+    }
+
+    Y_UNIT_TEST(TestMinIterations) {
+        THalvingSearchParams halvingSearchParams;
+        halvingSearchParams.ReductionFactor = 2.0;
+        halvingSearchParams.MinIterations = 5;
+
+        UNIT_ASSERT_VALUES_EQUAL(
+            halvingSearchParams.GetRoundCandidateCounts(9),
+            TVector<size_t>({9, 4, 2, 1})
+        );
+        UNIT_ASSERT_VALUES_EQUAL(
+            GetRoundIterationCounts(halvingSearchParams, 9, 100),
+            TVector<ui32>({5, 10, 20, 100})
+        );
+        // budget of intermediate rounds never exceeds the iteration count
+        UNIT_ASSERT_VALUES_EQUAL(
+            GetRoundIterationCounts(halvingSearchParams, 9, 12),
+            TVector<ui32>({5, 10, 12, 12})
+        );
+    }
+
+    Y_UNIT_TEST(TestSingleCandidate) {
+        THalvingSearchParams halvingSearchParams;
+        UNIT_ASSERT_VALUES_EQUAL(halvingSearchParams.GetRoundCandidateCounts(1), TVector<size_t>({1}));
+        UNIT_ASSERT_VALUES_EQUAL(GetRoundIterationCounts(halvingSearchParams, 1, 50), TVector<ui32>({50}));
+    }
+
+    Y_UNIT_TEST(TestCheck) {
+        THalvingSearchParams halvingSearchParams;
+        halvingSearchParams.ReductionFactor = 1.0;
+        UNIT_ASSERT_EXCEPTION(halvingSearchParams.Check(), TCatBoostException);
+    }
+}
@@ -20,6 +20,12 @@ struct TCrossValidationParams : public TSplitParams {
     TMaybe<TVector<TVector<ui32>>> customTestSubsets = Nothing();
     double MaxTimeSpentOnFixedCostRatio = 0.05;
     ui32 DevMaxIterationsBatchSize = 100000; // useful primarily for tests
+
+    /* > 1 - train up to this number of folds concurrently, splitting threads between them.
+     * Supported only on CPU, useful for small and medium datasets where per-iteration threads
+     * synchronization dominates
+     */
+    ui32 ParallelFoldCount = 1;
     ECrossValidation Type = ECrossValidation::Classical;
     bool IsCalledFromSearchHyperparameters = false;
 
@@ -23,12 +23,16 @@ NCatboostOptions::TDataProcessingOptions::TDataProcessingOptions(ETaskType type)
       , ClassNames("class_names", TVector<TString>())
       , DevDefaultValueFractionToEnableSparseStorage("dev_default_value_fraction_for_sparse", 0.83f)
       , DevSparseArrayIndexingType("dev_sparse_array_indexing", NCB::ESparseArrayIndexingType::Indices)
+      , DevBorderSketchRankError("dev_border_sketch_rank_error", 0.0)
       , GpuCatFeaturesStorage("gpu_cat_features_storage", EGpuCatFeaturesStorage::GpuRam, type)
       , DevLeafwiseScoring("dev_leafwise_scoring", false, type)
       , DevGroupFeatures("dev_group_features", false, type)
+      , DevNibblePackFeatures("dev_nibble_pack_features", false, type)
+      , TokenizedTextCacheDir("tokenized_text_cache_dir", "")
 {
     GpuCatFeaturesStorage.ChangeLoadUnimplementedPolicy(ELoadUnimplementedPolicy::SkipWithWarning);
     DevGroupFeatures.ChangeLoadUnimplementedPolicy(ELoadUnimplementedPolicy::SkipWithWarning);
+    DevNibblePackFeatures.ChangeLoadUnimplementedPolicy(ELoadUnimplementedPolicy::SkipWithWarning);
 }
 
 void NCatboostOptions::TDataProcessingOptions::Load(const NJson::TJsonValue& options) {
@@ -38,7 +42,9 @@ void NCatboostOptions::TDataProcessingOptions::Load(const NJson::TJsonValue& opt
         &ClassesCount, &ClassWeights, &ClassNames,
         &DevDefaultValueFractionToEnableSparseStorage,
         &DevSparseArrayIndexingType,
-        &GpuCatFeaturesStorage, &DevLeafwiseScoring, &DevGroupFeatures
+        &DevBorderSketchRankError,
+        &GpuCatFeaturesStorage, &DevLeafwiseScoring, &DevGroupFeatures, &DevNibblePackFeatures,
+        &TokenizedTextCacheDir
     );
     Validate();
     SetPerFeatureMissingSettingToCommonValues();
@@ -51,7 +57,8 @@ void NCatboostOptions::TDataProcessingOptions::Save(NJson::TJsonValue* options)
         ClassesCount, ClassWeights, ClassNames,
         DevDefaultValueFractionToEnableSparseStorage,
         DevSparseArrayIndexingType,
-        GpuCatFeaturesStorage, DevLeafwiseScoring, DevGroupFeatures
+        DevBorderSketchRankError,
+        GpuCatFeaturesStorage, DevLeafwiseScoring, DevGroupFeatures, DevNibblePackFeatures
     );
 }
 
@@ -60,14 +67,16 @@ bool NCatboostOptions::TDataProcessingOptions::operator==(const TDataProcessingO
                     FloatFeaturesBinarization, PerFloatFeatureQuantization, TextProcessingOptions,
                     ClassesCount, ClassWeights, ClassNames,
                     DevDefaultValueFractionToEnableSparseStorage,
-                    DevSparseArrayIndexingType, GpuCatFeaturesStorage, DevLeafwiseScoring,
-                    DevGroupFeatures) ==
+                    DevSparseArrayIndexingType, DevBorderSketchRankError, GpuCatFeaturesStorage,
+                    DevLeafwiseScoring,
+                    DevGroupFeatures, DevNibblePackFeatures) ==
            std::tie(rhs.IgnoredFeatures, rhs.HasTimeFlag, rhs.AllowConstLabel, rhs.TargetBorder,
                     rhs.FloatFeaturesBinarization, rhs.PerFloatFeatureQuantization, rhs.TextProcessingOptions,
                     rhs.ClassesCount, rhs.ClassWeights, rhs.ClassNames,
                     rhs.DevDefaultValueFractionToEnableSparseStorage,
-                    rhs.DevSparseArrayIndexingType, rhs.GpuCatFeaturesStorage, rhs.DevLeafwiseScoring,
-                    rhs.DevGroupFeatures);
+                    rhs.DevSparseArrayIndexingType, rhs.DevBorderSketchRankError, rhs.GpuCatFeaturesStorage,
+                    rhs.DevLeafwiseScoring,
+                    rhs.DevGroupFeatures, rhs.DevNibblePackFeatures);
 }
 
 bool NCatboostOptions::TDataProcessingOptions::operator!=(const TDataProcessingOptions& rhs) const {
@@ -80,6 +89,10 @@ void NCatboostOptions::TDataProcessingOptions::Validate() const {
         (DevDefaultValueFractionToEnableSparseStorage.Get() < 1.f),
         "DevDefaultValueFractionToEnableSparseStorage must be in [0, 1)"
     );
+    CB_ENSURE(
+        (DevBorderSketchRankError.Get() >= 0.0) && (DevBorderSketchRankError.Get() < 1.0),
+        "DevBorderSketchRankError must be in [0, 1)"
+    );
     CB_ENSURE(
         DevGroupFeatures.NotSet() || DevLeafwiseScoring.IsSet(),
         "DevGroupFeatures is supported only with DevLeafwiseScoring"
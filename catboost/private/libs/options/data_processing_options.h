@@ -46,9 +46,18 @@ namespace NCatboostOptions {
         TOption<float> DevDefaultValueFractionToEnableSparseStorage; // 0 means sparse storage is disabled
         TOption<NCB::ESparseArrayIndexingType> DevSparseArrayIndexingType;
 
+        // if > 0 borders are built from quantile sketches with this rank error instead of sorted values
+        TOption<double> DevBorderSketchRankError;
+
         TGpuOnlyOption<EGpuCatFeaturesStorage> GpuCatFeaturesStorage;
         TCpuOnlyOption<bool> DevLeafwiseScoring;
         TCpuOnlyOption<bool> DevGroupFeatures;
+        TCpuOnlyOption<bool> DevNibblePackFeatures; // 4 bits per value for float features with < 16 borders
+
+        /* reuse dictionaries and tokenized text features between runs
+         * local path, it is loaded but not saved, so it doesn't get to model and snapshot params
+         */
+        TOption<TString> TokenizedTextCacheDir;
     private:
         void SetPerFeatureMissingSettingToCommonValues();
     };
@@ -44,6 +44,7 @@ namespace NCatboostOptions {
 
         TVector<ui32> IgnoredFeatures;
         TString BordersFile;
+        TString QuantizedPoolCacheDir; // empty means the cache is disabled
 
         TPoolLoadParams() = default;
 
@@ -55,7 +56,7 @@ namespace NCatboostOptions {
             CvParams, ColumnarPoolFormatParams, LearnSetPath, TestSetPaths,
             PairsFilePath, TestPairsFilePath, GroupWeightsFilePath, TestGroupWeightsFilePath,
             BaselineFilePath, TestBaselineFilePath, ClassNames, IgnoredFeatures,
-            BordersFile
+            BordersFile, QuantizedPoolCacheDir
         );
     };
 
@@ -24,6 +24,8 @@ NCatboostOptions::TObliviousTreeLearnerOptions::TObliviousTreeLearnerOptions(ETa
       , DevScoreCalcObjBlockSize("dev_score_calc_obj_block_size", 5000000, taskType)
       , DevExclusiveFeaturesBundleMaxBuckets("dev_efb_max_buckets", 1 << 10, taskType)
       , SparseFeaturesConflictFraction("sparse_features_conflict_fraction", 0.0f, taskType)
+      , DevExclusiveFeaturesBundleSampleSize("dev_efb_sample_size", 0, taskType)
+      , DevExclusiveFeaturesBundleTimeBudget("dev_efb_time_budget", 0.0, taskType)
       , ObservationsToBootstrap("observations_to_bootstrap", EObservationsToBootstrap::TestOnly, taskType) //it's specific for fold-based scheme, so here and not in bootstrap options
       , FoldSizeLossNormalization("fold_size_loss_normalization", false, taskType)
       , AddRidgeToTargetFunctionFlag("add_ridge_penalty_to_loss_function", false, taskType)
@@ -58,6 +60,8 @@ void NCatboostOptions::TObliviousTreeLearnerOptions::Load(const NJson::TJsonValu
             &DevScoreCalcObjBlockSize,
             &DevExclusiveFeaturesBundleMaxBuckets,
             &SparseFeaturesConflictFraction,
+            &DevExclusiveFeaturesBundleSampleSize,
+            &DevExclusiveFeaturesBundleTimeBudget,
             &GrowPolicy,
             &MaxLeaves,
             &MinDataInLeaf,
@@ -79,6 +83,8 @@ void NCatboostOptions::TObliviousTreeLearnerOptions::Save(NJson::TJsonValue* opt
             DevScoreCalcObjBlockSize,
             DevExclusiveFeaturesBundleMaxBuckets,
             SparseFeaturesConflictFraction,
+            DevExclusiveFeaturesBundleSampleSize,
+            DevExclusiveFeaturesBundleTimeBudget,
             GrowPolicy,
             MaxLeaves,
             MinDataInLeaf,
@@ -93,6 +99,7 @@ bool NCatboostOptions::TObliviousTreeLearnerOptions::operator==(const TOblivious
             AddRidgeToTargetFunctionFlag, ScoreFunction, MaxCtrComplexityForBordersCaching,
             PairwiseNonDiagReg, LeavesEstimationBacktrackingType, DevScoreCalcObjBlockSize,
             DevExclusiveFeaturesBundleMaxBuckets, SparseFeaturesConflictFraction,
+            DevExclusiveFeaturesBundleSampleSize, DevExclusiveFeaturesBundleTimeBudget,
             GrowPolicy, MaxLeaves, MinDataInLeaf, MonotoneConstraints, DevLeafwiseApproxes
             ) ==
         std::tie(rhs.MaxDepth, rhs.LeavesEstimationIterations, rhs.LeavesEstimationMethod, rhs.L2Reg, rhs.ModelSizeReg,
@@ -101,6 +108,7 @@ bool NCatboostOptions::TObliviousTreeLearnerOptions::operator==(const TOblivious
                 rhs.ScoreFunction, rhs.MaxCtrComplexityForBordersCaching, rhs.PairwiseNonDiagReg, rhs.LeavesEstimationBacktrackingType,
                 rhs.DevScoreCalcObjBlockSize,
                 rhs.DevExclusiveFeaturesBundleMaxBuckets, rhs.SparseFeaturesConflictFraction,
+                rhs.DevExclusiveFeaturesBundleSampleSize, rhs.DevExclusiveFeaturesBundleTimeBudget,
                 rhs.GrowPolicy, rhs.MaxLeaves, rhs.MinDataInLeaf, rhs.MonotoneConstraints, rhs.DevLeafwiseApproxes);
 }
 
@@ -126,6 +134,10 @@ void NCatboostOptions::TObliviousTreeLearnerOptions::Validate() const {
         (SparseFeaturesConflictFraction.GetUnchecked() >= 0.f) && (SparseFeaturesConflictFraction.GetUnchecked() < 1.f),
         "SparseFeaturesConflictFraction should be in [0, 1)"
     );
+    CB_ENSURE(
+        DevExclusiveFeaturesBundleTimeBudget.GetUnchecked() >= 0.0,
+        "DevExclusiveFeaturesBundleTimeBudget should be >= 0"
+    );
     CB_ENSURE(LeavesEstimationIterations.Get() > 0, "Leaves estimation iterations should be positive");
     CB_ENSURE(L2Reg.Get() >= 0, "L2LeafRegularizer should be >= 0, current value: " << L2Reg.Get());
     CB_ENSURE(PairwiseNonDiagReg.Get() >= 0, "PairwiseNonDiagReg should be >= 0, current value: " << PairwiseNonDiagReg.Get());
@@ -42,6 +42,11 @@ namespace NCatboostOptions {
         TCpuOnlyOption<ui32> DevExclusiveFeaturesBundleMaxBuckets;
         TCpuOnlyOption<float> SparseFeaturesConflictFraction;
 
+        // 0 means exact bundling, otherwise conflicts are estimated on a sample of this size
+        TCpuOnlyOption<ui32> DevExclusiveFeaturesBundleSampleSize;
+        // in seconds, 0 means unlimited, used only with sampled bundling
+        TCpuOnlyOption<double> DevExclusiveFeaturesBundleTimeBudget;
+
         TGpuOnlyOption<EObservationsToBootstrap> ObservationsToBootstrap;
         TGpuOnlyOption<bool> FoldSizeLossNormalization;
         TGpuOnlyOption<bool> AddRidgeToTargetFunctionFlag;
@@ -74,6 +74,7 @@ NCatboostOptions::TOutputFilesOptions::TOutputFilesOptions()
     , ProfileLogPath("profile_log", "catboost_profile.log")
     , LearnErrorLogPath("learn_error_log", "learn_error.tsv")
     , ModelFormats("model_format", {EModelType::CatboostBinary})
+    , ModelLeafValuesPrecision("model_leaf_values_precision", ELeafValuesPrecision::Double)
     , TestErrorLogPath("test_error_log", "test_error.tsv")
     , TimeLeftLog("time_left_log", "time_left.tsv")
     , SnapshotPath("snapshot_file", "experiment.cbsnapshot")
@@ -92,7 +93,8 @@ NCatboostOptions::TOutputFilesOptions::TOutputFilesOptions()
     , MetricPeriod("metric_period", 1)
     , PredictionTypes("prediction_type", {EPredictionType::RawFormulaVal})
     , OutputColumns("output_columns", {"SampleId", "RawFormulaVal", "Label"})
-    , RocOutputPath("roc_file", "") {
+    , RocOutputPath("roc_file", "")
+    , ChromiumTraceFileName("chromium_trace_file", "") {
 }
 
 const TString& NCatboostOptions::TOutputFilesOptions::GetTrainDir() const {
@@ -131,6 +133,10 @@ const TVector<EModelType>& NCatboostOptions::TOutputFilesOptions::GetModelFormat
     return ModelFormats.Get();
 }
 
+ELeafValuesPrecision NCatboostOptions::TOutputFilesOptions::GetModelLeafValuesPrecision() const {
+    return ModelLeafValuesPrecision.Get();
+}
+
 bool NCatboostOptions::TOutputFilesOptions::ExportRequiresStaticCtrProvider() const {
     return AnyOf(
             GetModelFormats().cbegin(),
@@ -250,13 +256,22 @@ TString NCatboostOptions::TOutputFilesOptions::GetRocOutputPath() const {
     return GetFullPath(RocOutputPath.Get());
 }
 
+bool NCatboostOptions::TOutputFilesOptions::NeedChromiumTrace() const {
+    return AllowWriteFiles() && !ChromiumTraceFileName.Get().empty();
+}
+
+TString NCatboostOptions::TOutputFilesOptions::CreateChromiumTraceFullPath() const {
+    return GetFullPath(ChromiumTraceFileName.Get());
+}
+
 bool NCatboostOptions::TOutputFilesOptions::operator==(const TOutputFilesOptions& rhs) const {
     return std::tie(
             TrainDir, Name, JsonLogPath, ProfileLogPath, LearnErrorLogPath, TestErrorLogPath,
             TimeLeftLog, ResultModelPath, SnapshotPath, ModelFormats, SaveSnapshotFlag,
             AllowWriteFilesFlag, FinalCtrComputationMode, FinalFeatureCalcerComputationMode, UseBestModel, BestModelMinTrees,
             SnapshotSaveIntervalSeconds, EvalFileName, FstrRegularFileName, FstrInternalFileName, FstrType,
-            TrainingOptionsFileName, OutputBordersFileName, RocOutputPath
+            TrainingOptionsFileName, OutputBordersFileName, RocOutputPath, ChromiumTraceFileName,
+            ModelLeafValuesPrecision
             ) == std::tie(
                 rhs.TrainDir, rhs.Name, rhs.JsonLogPath, rhs.ProfileLogPath,
                 rhs.LearnErrorLogPath, rhs.TestErrorLogPath, rhs.TimeLeftLog, rhs.ResultModelPath,
@@ -264,7 +279,7 @@ bool NCatboostOptions::TOutputFilesOptions::operator==(const TOutputFilesOptions
                 rhs.FinalCtrComputationMode, rhs.FinalFeatureCalcerComputationMode, rhs.UseBestModel, rhs.BestModelMinTrees,
                 rhs.SnapshotSaveIntervalSeconds, rhs.EvalFileName, rhs.FstrRegularFileName,
                 rhs.FstrInternalFileName, rhs.FstrType, rhs.TrainingOptionsFileName, rhs.OutputBordersFileName,
-                rhs.RocOutputPath
+                rhs.RocOutputPath, rhs.ChromiumTraceFileName, rhs.ModelLeafValuesPrecision
                 );
 }
 
@@ -280,7 +295,8 @@ void NCatboostOptions::TOutputFilesOptions::Load(const NJson::TJsonValue& option
             &SaveSnapshotFlag, &AllowWriteFilesFlag, &FinalCtrComputationMode, &FinalFeatureCalcerComputationMode,
             &UseBestModel, &BestModelMinTrees, &SnapshotSaveIntervalSeconds, &EvalFileName, &OutputColumns,
             &FstrRegularFileName, &FstrInternalFileName, &FstrType, &TrainingOptionsFileName, &MetricPeriod,
-            &VerbosePeriod, &PredictionTypes, &OutputBordersFileName, &RocOutputPath
+            &VerbosePeriod, &PredictionTypes, &OutputBordersFileName, &RocOutputPath, &ChromiumTraceFileName,
+            &ModelLeafValuesPrecision
             );
     if (!VerbosePeriod.IsSet() || VerbosePeriod.Get() == 1) {
         VerbosePeriod.Set(MetricPeriod.Get());
@@ -296,7 +312,7 @@ void NCatboostOptions::TOutputFilesOptions::Save(NJson::TJsonValue* options) con
             AllowWriteFilesFlag, FinalCtrComputationMode, FinalFeatureCalcerComputationMode, UseBestModel,
             BestModelMinTrees, SnapshotSaveIntervalSeconds, EvalFileName, OutputColumns, FstrRegularFileName,
             FstrInternalFileName, FstrType, TrainingOptionsFileName, MetricPeriod, VerbosePeriod, PredictionTypes,
-            OutputBordersFileName, RocOutputPath
+            OutputBordersFileName, RocOutputPath, ChromiumTraceFileName, ModelLeafValuesPrecision
             );
 }
 
@@ -46,6 +46,8 @@ namespace NCatboostOptions {
 
         const TVector<EModelType>& GetModelFormats() const;
 
+        ELeafValuesPrecision GetModelLeafValuesPrecision() const;
+
         bool ExportRequiresStaticCtrProvider() const;
 
         bool AddFileFormatExtension() const;
@@ -93,6 +95,10 @@ namespace NCatboostOptions {
 
         TString GetRocOutputPath() const;
 
+        bool NeedChromiumTrace() const;
+
+        TString CreateChromiumTraceFullPath() const;
+
         void SetAllowWriteFiles(bool flag) {
             AllowWriteFilesFlag.Set(flag);
         }
@@ -132,6 +138,7 @@ namespace NCatboostOptions {
         TOption<TString> ProfileLogPath;
         TOption<TString> LearnErrorLogPath;
         TOption<TVector<EModelType>> ModelFormats;
+        TOption<ELeafValuesPrecision> ModelLeafValuesPrecision;
         TOption<TString> TestErrorLogPath;
         TOption<TString> TimeLeftLog;
         TOption<TString> SnapshotPath;
@@ -153,5 +160,6 @@ namespace NCatboostOptions {
         TOption<TVector<EPredictionType>> PredictionTypes;
         TOption<TVector<TString>> OutputColumns;
         TOption<TString> RocOutputPath;
+        TOption<TString> ChromiumTraceFileName;
     };
 }
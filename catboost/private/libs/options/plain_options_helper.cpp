@@ -284,6 +284,7 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "meta", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "json_log", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "profile_log", &outputFilesJson, &seenKeys);
+    CopyOption(plainOptions, "chromium_trace_file", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "learn_error_log", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "test_error_log", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "time_left_log", &outputFilesJson, &seenKeys);
@@ -306,6 +307,7 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "fstr_type", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "training_options_file", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "model_format",  &outputFilesJson, &seenKeys);
+    CopyOption(plainOptions, "model_leaf_values_precision", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "output_borders",  &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "roc_file",  &outputFilesJson, &seenKeys);
 
@@ -345,6 +347,8 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "model_size_reg", &treeOptions, &seenKeys);
     CopyOption(plainOptions, "dev_score_calc_obj_block_size", &treeOptions, &seenKeys);
     CopyOption(plainOptions, "dev_efb_max_buckets", &treeOptions, &seenKeys);
+    CopyOption(plainOptions, "dev_efb_sample_size", &treeOptions, &seenKeys);
+    CopyOption(plainOptions, "dev_efb_time_budget", &treeOptions, &seenKeys);
     CopyOption(plainOptions, "sparse_features_conflict_fraction", &treeOptions, &seenKeys);
     CopyOption(plainOptions, "random_strength", &treeOptions, &seenKeys);
     CopyOption(plainOptions, "leaf_estimation_method", &treeOptions, &seenKeys);
@@ -422,9 +426,12 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "class_weights", &dataProcessingOptions, &seenKeys);
     CopyOption(plainOptions, "dev_default_value_fraction_for_sparse", &dataProcessingOptions, &seenKeys);
     CopyOption(plainOptions, "dev_sparse_array_indexing", &dataProcessingOptions, &seenKeys);
+    CopyOption(plainOptions, "dev_border_sketch_rank_error", &dataProcessingOptions, &seenKeys);
     CopyOption(plainOptions, "gpu_cat_features_storage", &dataProcessingOptions, &seenKeys);
     CopyOption(plainOptions, "dev_leafwise_scoring", &dataProcessingOptions, &seenKeys);
     CopyOption(plainOptions, "dev_group_features", &dataProcessingOptions, &seenKeys);
+    CopyOption(plainOptions, "dev_nibble_pack_features", &dataProcessingOptions, &seenKeys);
+    CopyOption(plainOptions, "tokenized_text_cache_dir", &dataProcessingOptions, &seenKeys);
 
     auto& floatFeaturesBinarization = dataProcessingOptions["float_features_binarization"];
     floatFeaturesBinarization.SetType(NJson::JSON_MAP);
@@ -517,6 +524,7 @@ void NCatboostOptions::ConvertOptionsToPlainJson(
     DeleteSeenOption(&outputoptionsCopy, "meta");
     DeleteSeenOption(&outputoptionsCopy, "json_log");
     DeleteSeenOption(&outputoptionsCopy, "profile_log");
+    DeleteSeenOption(&outputoptionsCopy, "chromium_trace_file");
     DeleteSeenOption(&outputoptionsCopy, "learn_error_log");
     DeleteSeenOption(&outputoptionsCopy, "test_error_log");
     DeleteSeenOption(&outputoptionsCopy, "time_left_log");
@@ -544,6 +552,7 @@ void NCatboostOptions::ConvertOptionsToPlainJson(
     DeleteSeenOption(&outputoptionsCopy, "fstr_type");
     DeleteSeenOption(&outputoptionsCopy, "training_options_file");
     DeleteSeenOption(&outputoptionsCopy, "model_format");
+    DeleteSeenOption(&outputoptionsCopy, "model_leaf_values_precision");
     DeleteSeenOption(&outputoptionsCopy, "output_borders");
     DeleteSeenOption(&outputoptionsCopy, "roc_file");
     CB_ENSURE(outputoptionsCopy.GetMapSafe().empty(), "output_options: key " + outputoptionsCopy.GetMapSafe().begin()->first + " wasn't added to plain options.");
@@ -634,6 +643,8 @@ void NCatboostOptions::ConvertOptionsToPlainJson(
         DeleteSeenOption(&optionsCopyTree, "dev_score_calc_obj_block_size");
 
         DeleteSeenOption(&optionsCopyTree, "dev_efb_max_buckets");
+        DeleteSeenOption(&optionsCopyTree, "dev_efb_sample_size");
+        DeleteSeenOption(&optionsCopyTree, "dev_efb_time_budget");
 
         CopyOption(treeOptions, "sparse_features_conflict_fraction", &plainOptionsJson, &seenKeys);
         DeleteSeenOption(&optionsCopyTree, "sparse_features_conflict_fraction");
@@ -801,6 +812,9 @@ void NCatboostOptions::ConvertOptionsToPlainJson(
         CopyOption(dataProcessingOptions, "dev_sparse_array_indexing", &plainOptionsJson, &seenKeys);
         DeleteSeenOption(&optionsCopyDataProcessing, "dev_sparse_array_indexing");
 
+        CopyOption(dataProcessingOptions, "dev_border_sketch_rank_error", &plainOptionsJson, &seenKeys);
+        DeleteSeenOption(&optionsCopyDataProcessing, "dev_border_sketch_rank_error");
+
         CopyOption(dataProcessingOptions, "gpu_cat_features_storage", &plainOptionsJson, &seenKeys);
         DeleteSeenOption(&optionsCopyDataProcessing, "gpu_cat_features_storage");
 
@@ -814,6 +828,9 @@ void NCatboostOptions::ConvertOptionsToPlainJson(
         CopyOption(dataProcessingOptions, "dev_group_features", &plainOptionsJson, &seenKeys);
         DeleteSeenOption(&optionsCopyDataProcessing, "dev_group_features");
 
+        CopyOption(dataProcessingOptions, "dev_nibble_pack_features", &plainOptionsJson, &seenKeys);
+        DeleteSeenOption(&optionsCopyDataProcessing, "dev_nibble_pack_features");
+
         ConcatenatePerFloatFeatureQuantizationOptions(
             dataProcessingOptions,
             "per_float_feature_quantization",
@@ -5,6 +5,7 @@
 #include <catboost/private/libs/options/enums.h>
 #include <catboost/private/libs/options/system_options.h>
 #include <catboost/private/libs/options/catboost_options.h>
+#include <catboost/private/libs/options/data_processing_options.h>
 
 Y_UNIT_TEST_SUITE(TOptionsTest) {
     using namespace NCatboostOptions;
@@ -118,6 +119,17 @@ Y_UNIT_TEST_SUITE(TOptionsTest) {
         }
     }
 
+    Y_UNIT_TEST(TestTokenizedTextCacheDirIsNotSaved) {
+        TDataProcessingOptions options(ETaskType::CPU);
+        options.Load(ReadTJsonValue("{\"tokenized_text_cache_dir\":\"text_cache\"}"));
+        UNIT_ASSERT_VALUES_EQUAL(options.TokenizedTextCacheDir.Get(), "text_cache");
+
+        NJson::TJsonValue tree;
+        options.Save(&tree);
+        UNIT_ASSERT(!tree.Has("tokenized_text_cache_dir"));
+        TestSaveLoad(options, ETaskType::CPU);
+    }
+
     Y_UNIT_TEST(TestCpuOptions) {
         TCatBoostOptions options(ETaskType::CPU);
         options.SetNotSpecifiedOptionsToDefaults();
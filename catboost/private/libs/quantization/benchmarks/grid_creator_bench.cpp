@@ -0,0 +1,70 @@
+#include <catboost/private/libs/quantization/grid_creator.h>
+
+#include <library/testing/benchmark/bench.h>
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/singleton.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/random/normal.h>
+#include <util/system/info.h>
+
+using namespace NCB;
+
+const size_t ValuesCount = 1000000;
+const ui32 BorderCount = 254;
+
+namespace {
+    struct TValues {
+        TVector<float> Values;
+
+        TValues() {
+            TFastRng64 rand(0);
+            Values.reserve(ValuesCount);
+            for (auto i : xrange(ValuesCount)) {
+                Y_UNUSED(i);
+                Values.push_back(NormalDistribution<double>(rand, 0.0, 1.0));
+            }
+        }
+    };
+
+    struct TBenchExecutor : public NPar::TLocalExecutor {
+        TBenchExecutor() {
+            RunAdditionalThreads(NSystemInfo::CachedNumberOfCpus() - 1);
+        }
+    };
+}
+
+static void BuildBorders(IFactory<IGridBuilder>& factory, EBorderSelectionType type, size_t iterationCount) {
+    const auto& values = Singleton<TValues>()->Values;
+    for (auto i : xrange(iterationCount)) {
+        Y_UNUSED(i);
+        auto builder = factory.Create(type);
+        Y_DO_NOT_OPTIMIZE_AWAY(builder->AddFeature(values, BorderCount, ENanMode::Forbidden).Borders());
+    }
+}
+
+Y_CPU_BENCHMARK(ExactGreedyLogSum, iface) {
+    TGridBuilderFactory factory;
+    BuildBorders(factory, EBorderSelectionType::GreedyLogSum, iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(SketchGreedyLogSum, iface) {
+    TSketchGridBuilderFactory factory(0.001);
+    BuildBorders(factory, EBorderSelectionType::GreedyLogSum, iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(ParallelSketchGreedyLogSum, iface) {
+    TSketchGridBuilderFactory factory(0.001, Singleton<TBenchExecutor>());
+    BuildBorders(factory, EBorderSelectionType::GreedyLogSum, iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(ExactMedian, iface) {
+    TGridBuilderFactory factory;
+    BuildBorders(factory, EBorderSelectionType::Median, iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(SketchMedian, iface) {
+    TSketchGridBuilderFactory factory(0.001);
+    BuildBorders(factory, EBorderSelectionType::Median, iface.Iterations());
+}
@@ -1,4 +1,5 @@
 #include "grid_creator.h"
+#include "quantile_sketch.h"
 
 #include <util/generic/vector.h>
 
@@ -40,6 +41,49 @@ namespace NCB {
         private:
             TVector<TVector<float>> Result;
         };
+
+        class TSketchGridBuilder: public IGridBuilder {
+        public:
+            TSketchGridBuilder(EBorderSelectionType type, ui32 sketchSize, NPar::TLocalExecutor* localExecutor)
+                : Type(type)
+                , SketchSize(sketchSize)
+                , LocalExecutor(localExecutor)
+            {
+            }
+
+            IGridBuilder& AddFeature(TConstArrayRef<float> feature,
+                                     ui32 borderCount,
+                                     ENanMode nanMode) override {
+                if (nanMode == ENanMode::Forbidden) {
+                    CB_ENSURE(
+                        AllOf(feature, [] (float value) { return !IsNan(value); }),
+                        "Error: NaN in features, but NaNs are forbidden");
+                }
+                NPar::TLocalExecutor sequentialExecutor;
+                const auto sketch = BuildQuantileSketch(
+                    feature,
+                    SketchSize,
+                    LocalExecutor ? LocalExecutor : &sequentialExecutor);
+                Result.push_back(BuildBordersFromSketch(sketch, borderCount, Type));
+                return *this;
+            }
+
+            const TVector<TVector<float>>& Borders() override {
+                return Result;
+            }
+
+            TVector<float> BuildBorders(TConstArrayRef<float> sortedFeature, ui32 borderCount) const override {
+                TQuantileSketch sketch(SketchSize);
+                sketch.Add(CheckedCopyWithoutNans(sortedFeature, ENanMode::Forbidden));
+                return BuildBordersFromSketch(sketch, borderCount, Type);
+            }
+
+        private:
+            EBorderSelectionType Type;
+            ui32 SketchSize;
+            NPar::TLocalExecutor* LocalExecutor;
+            TVector<TVector<float>> Result;
+        };
     }
 
     TVector<float> CheckedCopyWithoutNans(TConstArrayRef<float> values, ENanMode nanMode) {
@@ -78,6 +122,16 @@ namespace NCB {
         ythrow yexception() << "Invalid grid builder type!";
     }
 
+    TSketchGridBuilderFactory::TSketchGridBuilderFactory(double rankError, NPar::TLocalExecutor* localExecutor)
+        : SketchSize(TQuantileSketch::GetSizeForRankError(rankError))
+        , LocalExecutor(localExecutor)
+    {
+    }
+
+    THolder<IGridBuilder> TSketchGridBuilderFactory::Create(EBorderSelectionType type) {
+        return MakeHolder<TSketchGridBuilder>(type, SketchSize, LocalExecutor);
+    }
+
     TVector<float> TBordersBuilder::operator()(const NCatboostOptions::TBinarizationOptions& description) {
         auto builder = BuilderFactory.Create(description.BorderSelectionType);
         const ui32 borderCount = description.NanMode == ENanMode::Forbidden ? description.BorderCount : description.BorderCount - 1;
@@ -3,6 +3,7 @@
 #include <catboost/private/libs/options/binarization_options.h>
 
 #include <library/grid_creator/binarization.h>
+#include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/algorithm.h>
 #include <util/generic/array_ref.h>
@@ -47,6 +48,20 @@ namespace NCB {
         THolder<IGridBuilder> Create(EBorderSelectionType type) override;
     };
 
+    /* Builds borders from mergeable quantile sketches instead of a sorted copy of the feature,
+     * borders are within rankError (in terms of value ranks) of the exact ones.
+     */
+    class TSketchGridBuilderFactory: public IFactory<IGridBuilder> {
+    public:
+        explicit TSketchGridBuilderFactory(double rankError = 0.001, NPar::TLocalExecutor* localExecutor = nullptr);
+
+        THolder<IGridBuilder> Create(EBorderSelectionType type) override;
+
+    private:
+        ui32 SketchSize;
+        NPar::TLocalExecutor* LocalExecutor;
+    };
+
     class TBordersBuilder {
     public:
         TBordersBuilder(IFactory<IGridBuilder>& builderFactory,
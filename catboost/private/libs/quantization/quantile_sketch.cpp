@@ -0,0 +1,248 @@
+#include "quantile_sketch.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/utility.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+
+#include <cmath>
+
+
+namespace NCB {
+
+    TQuantileSketch::TQuantileSketch(ui32 k, ui64 seed)
+        : K(Max<ui32>(k, 8))
+        , Compactors(1)
+        , Rand(seed)
+    {
+    }
+
+    ui32 TQuantileSketch::GetSizeForRankError(double rankError) {
+        CB_ENSURE(rankError > 0.0 && rankError < 1.0, "Rank error should be in (0, 1), got " << rankError);
+        return static_cast<ui32>(Min(std::ceil(2.0 / rankError), double(Max<ui32>() / 4)));
+    }
+
+    ui32 TQuantileSketch::GetLevelCapacity(ui32 level) const {
+        const ui32 depth = Compactors.size() - 1 - level;
+        return Max<ui32>(2, static_cast<ui32>(std::ceil(K * std::pow(2.0 / 3.0, depth))));
+    }
+
+    void TQuantileSketch::Add(float value) {
+        Y_ASSERT(!IsNan(value));
+        Compactors[0].push_back(value);
+        ++Count;
+        MinValue = Min(MinValue, value);
+        MaxValue = Max(MaxValue, value);
+        if (Compactors[0].size() >= GetLevelCapacity(0)) {
+            CompressIfNeeded();
+        }
+    }
+
+    void TQuantileSketch::Add(TConstArrayRef<float> values) {
+        for (float value : values) {
+            Add(value);
+        }
+    }
+
+    void TQuantileSketch::Add(float value, ui64 count) {
+        Y_ASSERT(!IsNan(value));
+        if (!count) {
+            return;
+        }
+        Count += count;
+        MinValue = Min(MinValue, value);
+        MaxValue = Max(MaxValue, value);
+        // item at level h has weight 2^h, so copies are added as the binary representation of count
+        for (ui32 level = 0; count; ++level, count >>= 1) {
+            if (count & 1) {
+                if (level >= Compactors.size()) {
+                    Compactors.resize(level + 1);
+                }
+                Compactors[level].push_back(value);
+            }
+        }
+        CompressIfNeeded();
+    }
+
+    void TQuantileSketch::Merge(const TQuantileSketch& other) {
+        CB_ENSURE_INTERNAL(K == other.K, "Merged quantile sketches should have the same size");
+        if (other.Compactors.size() > Compactors.size()) {
+            Compactors.resize(other.Compactors.size());
+        }
+        for (auto level : xrange(other.Compactors.size())) {
+            const auto& otherItems = other.Compactors[level];
+            Compactors[level].insert(Compactors[level].end(), otherItems.begin(), otherItems.end());
+        }
+        Count += other.Count;
+        MinValue = Min(MinValue, other.MinValue);
+        MaxValue = Max(MaxValue, other.MaxValue);
+        CompressIfNeeded();
+    }
+
+    size_t TQuantileSketch::GetSize() const {
+        size_t size = 0;
+        for (const auto& items : Compactors) {
+            size += items.size();
+        }
+        return size;
+    }
+
+    void TQuantileSketch::CompressIfNeeded() {
+        // Compactors.size() can grow inside the loop
+        for (ui32 level = 0; level < Compactors.size(); ++level) {
+            if (Compactors[level].size() >= GetLevelCapacity(level)) {
+                Compact(level);
+            }
+        }
+    }
+
+    void TQuantileSketch::Compact(ui32 level) {
+        if (level + 1 == Compactors.size()) {
+            Compactors.emplace_back();
+        }
+        auto& items = Compactors[level];
+        auto& nextLevelItems = Compactors[level + 1];
+
+        Sort(items);
+        const size_t pairedCount = items.size() - items.size() % 2;
+        const size_t offset = Rand.GenRand() & 1;
+        for (size_t i = offset; i < pairedCount; i += 2) {
+            nextLevelItems.push_back(items[i]);
+        }
+        if (pairedCount != items.size()) {
+            items[0] = items.back();
+            items.resize(1);
+        } else {
+            items.clear();
+        }
+    }
+
+    void TQuantileSketch::GetWeightedItems(TVector<float>* values, TVector<ui64>* weights) const {
+        TVector<std::pair<float, ui64>> items;
+        items.reserve(GetSize());
+        for (auto level : xrange(Compactors.size())) {
+            for (float value : Compactors[level]) {
+                items.emplace_back(value, ui64(1) << level);
+            }
+        }
+        Sort(items);
+
+        values->clear();
+        weights->clear();
+        values->reserve(items.size());
+        weights->reserve(items.size());
+        for (const auto& [value, weight] : items) {
+            values->push_back(value);
+            weights->push_back(weight);
+        }
+    }
+
+    double TQuantileSketch::GetRank(float value) const {
+        if (Count == 0) {
+            return 0.0;
+        }
+        ui64 weightBelow = 0;
+        for (auto level : xrange(Compactors.size())) {
+            for (float item : Compactors[level]) {
+                if (item <= value) {
+                    weightBelow += ui64(1) << level;
+                }
+            }
+        }
+        return double(weightBelow) / Count;
+    }
+
+    TVector<float> TQuantileSketch::GetSortedSample(ui32 sampleSize) const {
+        if (Count == 0) {
+            return {};
+        }
+        if (Compactors.size() == 1) {
+            // nothing was compacted yet, the sketch holds all the values
+            TVector<float> sample = Compactors[0];
+            Sort(sample);
+            return sample;
+        }
+        CB_ENSURE_INTERNAL(sampleSize >= 2, "Quantile sketch sample should have at least 2 values");
+
+        TVector<float> values;
+        TVector<ui64> weights;
+        GetWeightedItems(&values, &weights);
+
+        TVector<float> sample;
+        sample.yresize(sampleSize);
+        size_t itemIdx = 0;
+        ui64 cumulativeWeight = weights[0];
+        for (auto i : xrange(sampleSize)) {
+            const double targetRank = (i + 0.5) * Count / sampleSize;
+            while (cumulativeWeight <= targetRank && itemIdx + 1 < values.size()) {
+                ++itemIdx;
+                cumulativeWeight += weights[itemIdx];
+            }
+            sample[i] = values[itemIdx];
+        }
+        sample.front() = MinValue;
+        sample.back() = MaxValue;
+        return sample;
+    }
+
+    TQuantileSketch BuildQuantileSketch(
+        TConstArrayRef<float> values,
+        ui32 k,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        const size_t minBlockSize = 16 * size_t(k);
+        const int blockCount = Max<int>(
+            1,
+            Min<size_t>(localExecutor->GetThreadCount() + 1, values.size() / minBlockSize));
+        const size_t blockSize = CeilDiv(values.size(), size_t(blockCount));
+
+        TVector<TQuantileSketch> blockSketches;
+        blockSketches.reserve(blockCount);
+        for (auto blockIdx : xrange(blockCount)) {
+            blockSketches.emplace_back(k, blockIdx);
+        }
+
+        localExecutor->ExecRangeWithThrow(
+            [&] (int blockIdx) {
+                const size_t blockBegin = Min(blockIdx * blockSize, values.size());
+                const size_t blockEnd = Min(blockBegin + blockSize, values.size());
+                auto& sketch = blockSketches[blockIdx];
+                for (auto i : xrange(blockBegin, blockEnd)) {
+                    if (!IsNan(values[i])) {
+                        sketch.Add(values[i]);
+                    }
+                }
+            },
+            0,
+            blockCount,
+            NPar::TLocalExecutor::WAIT_COMPLETE);
+
+        for (auto blockIdx : xrange(1, blockCount)) {
+            blockSketches[0].Merge(blockSketches[blockIdx]);
+        }
+        return std::move(blockSketches[0]);
+    }
+
+    TVector<float> BuildBordersFromSketch(
+        const TQuantileSketch& sketch,
+        ui32 borderCount,
+        EBorderSelectionType type
+    ) {
+        if (sketch.GetCount() == 0) {
+            return {};
+        }
+        /* Exact binarizers are run on an equi-rank resample of the sketch, so borders differ from the exact
+         * ones by no more than the sketch rank error plus the resample step.
+         */
+        const ui32 sampleSize = 2 * sketch.GetSize();
+        TVector<float> sample = sketch.GetSortedSample(sampleSize);
+
+        const auto binarizer = NSplitSelection::MakeBinarizer(type);
+        auto quantization = binarizer->BestSplit(
+            NSplitSelection::TFeatureValues(std::move(sample), /*valuesSorted*/ true),
+            borderCount);
+        return std::move(quantization.Borders);
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <library/grid_creator/binarization.h>
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+#include <util/random/fast.h>
+#include <util/system/types.h>
+#include <util/ysaveload.h>
+
+#include <limits>
+
+
+namespace NCB {
+
+    /* Mergeable KLL quantile sketch over float values.
+     *
+     * Keeps a hierarchy of compactors, level h holds items of weight 2^h. Memory is O(K log(N / K)),
+     * rank error of any quantile is about 2 / K with high probability.
+     * Sketches built on different blocks, threads or workers can be merged with Merge().
+     * NaNs must be filtered out by the caller.
+     */
+    class TQuantileSketch {
+    public:
+        explicit TQuantileSketch(ui32 k = 2048, ui64 seed = 0);
+
+        static ui32 GetSizeForRankError(double rankError);
+
+        void Add(float value);
+        void Add(TConstArrayRef<float> values);
+
+        // adds count copies of value in O(log(count)) time
+        void Add(float value, ui64 count);
+
+        void Merge(const TQuantileSketch& other);
+
+        ui64 GetCount() const {
+            return Count;
+        }
+
+        float GetMin() const {
+            return MinValue;
+        }
+
+        float GetMax() const {
+            return MaxValue;
+        }
+
+        // number of retained items
+        size_t GetSize() const;
+
+        // estimated fraction of added values that are <= value
+        double GetRank(float value) const;
+
+        // sorted (value, weight) pairs, weights sum up to GetCount()
+        void GetWeightedItems(TVector<float>* values, TVector<ui64>* weights) const;
+
+        /* Equi-rank resample of the sketched distribution: sampleSize sorted values where i-th value
+         * is the estimated quantile of rank (i + 0.5) / sampleSize, exact min and max are always included.
+         */
+        TVector<float> GetSortedSample(ui32 sampleSize) const;
+
+        Y_SAVELOAD_DEFINE(K, Count, MinValue, MaxValue, Compactors);
+
+    private:
+        ui32 GetLevelCapacity(ui32 level) const;
+        void CompressIfNeeded();
+        void Compact(ui32 level);
+
+    private:
+        ui32 K;
+        ui64 Count = 0;
+        float MinValue = std::numeric_limits<float>::max();
+        float MaxValue = std::numeric_limits<float>::lowest();
+        TVector<TVector<float>> Compactors; // compactor level -> items of weight 2^level
+        TFastRng64 Rand;
+    };
+
+    // builds sketches over blocks of values in parallel and merges them, NaNs are skipped
+    TQuantileSketch BuildQuantileSketch(
+        TConstArrayRef<float> values,
+        ui32 k,
+        NPar::TLocalExecutor* localExecutor);
+
+    TVector<float> BuildBordersFromSketch(
+        const TQuantileSketch& sketch,
+        ui32 borderCount,
+        EBorderSelectionType type);
+}
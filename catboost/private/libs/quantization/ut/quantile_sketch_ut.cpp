@@ -0,0 +1,116 @@
+#include <library/unittest/registar.h>
+
+#include <catboost/private/libs/quantization/grid_creator.h>
+#include <catboost/private/libs/quantization/quantile_sketch.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/random/normal.h>
+
+using namespace NCB;
+
+
+static TVector<float> GenerateValues(size_t count, ui64 seed) {
+    TFastRng64 rand(seed);
+    TVector<float> values;
+    values.reserve(count);
+    for (auto i : xrange(count)) {
+        Y_UNUSED(i);
+        values.push_back(NormalDistribution<double>(rand, 0.0, 1.0));
+    }
+    return values;
+}
+
+static double GetExactRank(TConstArrayRef<float> sortedValues, float value) {
+    return double(UpperBound(sortedValues.begin(), sortedValues.end(), value) - sortedValues.begin())
+        / sortedValues.size();
+}
+
+Y_UNIT_TEST_SUITE(TQuantileSketchTests) {
+    Y_UNIT_TEST(TestSmallInputIsExact) {
+        const TVector<float> values = {3.f, 1.f, 2.f, 5.f, 4.f};
+        TQuantileSketch sketch(64);
+        sketch.Add(values);
+
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetCount(), 5);
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetSortedSample(10), TVector<float>({1.f, 2.f, 3.f, 4.f, 5.f}));
+        UNIT_ASSERT_DOUBLES_EQUAL(sketch.GetRank(3.f), 0.6, 1e-9);
+    }
+
+    Y_UNIT_TEST(TestRankError) {
+        const double rankError = 0.01;
+        TVector<float> values = GenerateValues(200000, 0);
+
+        TQuantileSketch sketch(TQuantileSketch::GetSizeForRankError(rankError));
+        sketch.Add(values);
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetCount(), values.size());
+        UNIT_ASSERT(sketch.GetSize() < values.size() / 100);
+
+        Sort(values);
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetMin(), values.front());
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetMax(), values.back());
+        for (size_t i = 0; i < values.size(); i += values.size() / 100) {
+            UNIT_ASSERT_DOUBLES_EQUAL(sketch.GetRank(values[i]), GetExactRank(values, values[i]), rankError);
+        }
+    }
+
+    Y_UNIT_TEST(TestAddWithCount) {
+        const double rankError = 0.01;
+        const ui64 defaultValueCount = 300001;
+        TVector<float> values = GenerateValues(100000, 1);
+
+        TQuantileSketch sketch(TQuantileSketch::GetSizeForRankError(rankError));
+        sketch.Add(values);
+        sketch.Add(0.0f, defaultValueCount);
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetCount(), values.size() + defaultValueCount);
+
+        values.insert(values.end(), defaultValueCount, 0.0f);
+        Sort(values);
+        for (size_t i = 0; i < values.size(); i += values.size() / 100) {
+            UNIT_ASSERT_DOUBLES_EQUAL(sketch.GetRank(values[i]), GetExactRank(values, values[i]), rankError);
+        }
+    }
+
+    Y_UNIT_TEST(TestMergedRankError) {
+        const double rankError = 0.01;
+        const ui32 sketchSize = TQuantileSketch::GetSizeForRankError(rankError);
+        TVector<float> values = GenerateValues(200000, 1);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+        const auto sketch = BuildQuantileSketch(values, sketchSize, &localExecutor);
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetCount(), values.size());
+
+        Sort(values);
+        for (size_t i = 0; i < values.size(); i += values.size() / 100) {
+            UNIT_ASSERT_DOUBLES_EQUAL(sketch.GetRank(values[i]), GetExactRank(values, values[i]), rankError);
+        }
+    }
+
+    Y_UNIT_TEST(TestBordersCloseToExact) {
+        const double rankError = 0.005;
+        const ui32 borderCount = 32;
+        TVector<float> values = GenerateValues(100000, 2);
+
+        for (auto type : {EBorderSelectionType::GreedyLogSum, EBorderSelectionType::Median}) {
+            TGridBuilderFactory exactFactory;
+            auto exactBuilder = exactFactory.Create(type);
+            const auto& exactBorders = exactBuilder->AddFeature(values, borderCount, ENanMode::Forbidden).Borders()[0];
+
+            TSketchGridBuilderFactory sketchFactory(rankError);
+            auto sketchBuilder = sketchFactory.Create(type);
+            const auto& sketchBorders = sketchBuilder->AddFeature(values, borderCount, ENanMode::Forbidden).Borders()[0];
+
+            UNIT_ASSERT_VALUES_EQUAL(sketchBorders.size(), exactBorders.size());
+            TVector<float> sortedValues = values;
+            Sort(sortedValues);
+            for (auto i : xrange(exactBorders.size())) {
+                UNIT_ASSERT_DOUBLES_EQUAL(
+                    GetExactRank(sortedValues, sketchBorders[i]),
+                    GetExactRank(sortedValues, exactBorders[i]),
+                    2 * rankError);
+            }
+        }
+    }
+}
@@ -12,6 +12,9 @@
 
 #include <contrib/libs/flatbuffers/include/flatbuffers/flatbuffers.h>
 
+#include <library/blockcodecs/codecs.h>
+#include <library/threading/local_executor/local_executor.h>
+
 #include <catboost/idl/pool/flat/quantized_chunk_t.fbs.h>
 
 #include <util/digest/numeric.h>
@@ -19,11 +22,13 @@
 #include <util/generic/algorithm.h>
 #include <util/generic/array_ref.h>
 #include <util/generic/array_size.h>
+#include <util/generic/cast.h>
 #include <util/generic/deque.h>
 #include <util/generic/strbuf.h>
 #include <util/generic/string.h>
 #include <util/generic/utility.h>
 #include <util/generic/vector.h>
+#include <util/generic/xrange.h>
 #include <util/memory/blob.h>
 #include <util/stream/file.h>
 #include <util/stream/input.h>
@@ -46,7 +51,8 @@ static const size_t MagicSize = Y_ARRAY_SIZE(Magic);  // yes, with terminating z
 static const char MagicEnd[] = "CatboostQuantizedPoolEnd";
 static const size_t MagicEndSize = Y_ARRAY_SIZE(MagicEnd);  // yes, with terminating zero
 static const ui32 Version = 1;
-static const ui32 VersionHash = IntHash(Version);
+// chunk descriptors have codec and value count, chunks can be compressed or bit-packed
+static const ui32 CompressedChunksVersion = 2;
 
 template <typename T>
 static TDeque<ui32> CollectAndSortKeys(const T& m) {
@@ -106,45 +112,115 @@ namespace {
         ui64 Offset = 0;
         ui32 DocumentOffset = 0;
         ui32 DocumentsInChunkCount = 0;
+        // written only in CompressedChunksVersion
+        ui32 Codec = 0;
+        ui32 ValueCount = 0;
 
         TChunkInfo() = default;
-        TChunkInfo(ui32 size, ui64 offset, ui32 documentOffset, ui32 documentsInChunkCount)
+        TChunkInfo(ui32 size, ui64 offset, ui32 documentOffset, ui32 documentsInChunkCount, ui32 codec, ui32 valueCount)
             : Size(size)
             , Offset(offset)
             , DocumentOffset(documentOffset)
-            , DocumentsInChunkCount(documentsInChunkCount) {
+            , DocumentsInChunkCount(documentsInChunkCount)
+            , Codec(codec)
+            , ValueCount(valueCount) {
         }
     };
 }
 
+static TStringBuf GetChunkCodecName(const ui32 codec) {
+    switch (static_cast<NCB::EQuantizedPoolChunkCodec>(codec)) {
+        case NCB::EQuantizedPoolChunkCodec::Lz4:
+            return AsStringBuf("lz4");
+        case NCB::EQuantizedPoolChunkCodec::Zstd:
+            return AsStringBuf("zstd_3");
+        case NCB::EQuantizedPoolChunkCodec::None:
+            break;
+    }
+    ythrow TCatBoostException() << "unknown quantized pool chunk codec " << codec;
+}
+
+static ui32 GetPackedBitsPerDocument(const ui8 maxValue) {
+    if (maxValue < 2) {
+        return 1;
+    } else if (maxValue < 4) {
+        return 2;
+    } else if (maxValue < 16) {
+        return 4;
+    }
+    return 8;
+}
+
+// values are packed from the lowest bits of each byte
+static TVector<ui8> PackQuants(const TConstArrayRef<ui8> values, const ui32 bitsPerDocument) {
+    const ui32 valuesPerByte = CHAR_BIT / bitsPerDocument;
+    TVector<ui8> packed((values.size() + valuesPerByte - 1) / valuesPerByte, 0);
+    for (size_t i = 0; i < values.size(); ++i) {
+        packed[i / valuesPerByte] |= values[i] << (i % valuesPerByte * bitsPerDocument);
+    }
+    return packed;
+}
+
+static TVector<ui8> UnpackQuants(const TConstArrayRef<ui8> packed, const ui32 bitsPerDocument, const ui32 valueCount) {
+    const ui32 valuesPerByte = CHAR_BIT / bitsPerDocument;
+    CB_ENSURE(packed.size() * valuesPerByte >= valueCount, "Packed quantized pool chunk is too small");
+    const ui8 mask = (1 << bitsPerDocument) - 1;
+    TVector<ui8> values;
+    values.yresize(valueCount);
+    for (size_t i = 0; i < valueCount; ++i) {
+        values[i] = (packed[i / valuesPerByte] >> (i % valuesPerByte * bitsPerDocument)) & mask;
+    }
+    return values;
+}
+
 static void WriteChunk(
     const NCB::TQuantizedPool::TChunkDescription& chunk,
+    const NCB::TSaveQuantizedPoolParameters& params,
     TCountingOutput* const output,
     TDeque<TChunkInfo>* const chunkInfos,
-    flatbuffers::FlatBufferBuilder* const builder) {
+    flatbuffers::FlatBufferBuilder* const builder,
+    TBuffer* const compressedChunk) {
 
     builder->Clear();
 
-    const auto quantsOffset = builder->CreateVector(
-        chunk.Chunk->Quants()->data(),
-        chunk.Chunk->Quants()->size());
+    TConstArrayRef<ui8> quants(chunk.Chunk->Quants()->data(), chunk.Chunk->Quants()->size());
+    auto bitsPerDocument = chunk.Chunk->BitsPerDocument();
+    const ui32 valueCount = quants.size() * CHAR_BIT / Max<ui32>(bitsPerDocument, CHAR_BIT);
+    TVector<ui8> packedQuants;
+    if (params.PackBits && bitsPerDocument == NCB::NIdl::EBitsPerDocumentFeature_BPDF_8 && !quants.empty()) {
+        const ui32 packedBitsPerDocument = GetPackedBitsPerDocument(*MaxElement(quants.begin(), quants.end()));
+        if (packedBitsPerDocument < CHAR_BIT) {
+            packedQuants = PackQuants(quants, packedBitsPerDocument);
+            quants = packedQuants;
+            bitsPerDocument = static_cast<NCB::NIdl::EBitsPerDocumentFeature>(packedBitsPerDocument);
+        }
+    }
+
+    const auto quantsOffset = builder->CreateVector(quants.data(), quants.size());
     NCB::NIdl::TQuantizedFeatureChunkBuilder chunkBuilder(*builder);
-    chunkBuilder.add_BitsPerDocument(chunk.Chunk->BitsPerDocument());
+    chunkBuilder.add_BitsPerDocument(bitsPerDocument);
     chunkBuilder.add_Quants(quantsOffset);
     builder->Finish(chunkBuilder.Finish());
 
+    TConstArrayRef<char> chunkData(reinterpret_cast<const char*>(builder->GetBufferPointer()), builder->GetSize());
+    const auto codec = static_cast<ui32>(params.ChunkCodec);
+    if (params.ChunkCodec != NCB::EQuantizedPoolChunkCodec::None) {
+        NBlockCodecs::Codec(GetChunkCodecName(codec))->Encode(NBlockCodecs::TData(chunkData), *compressedChunk);
+        chunkData = TConstArrayRef<char>(compressedChunk->Data(), compressedChunk->Size());
+    }
+
     AddPadding(16, output);
 
     const auto chunkOffset = output->Counter();
-    output->Write(builder->GetBufferPointer(), builder->GetSize());
+    output->Write(chunkData.data(), chunkData.size());
 
-    chunkInfos->emplace_back(builder->GetSize(), chunkOffset, chunk.DocumentOffset, chunk.DocumentCount);
+    chunkInfos->emplace_back(chunkData.size(), chunkOffset, chunk.DocumentOffset, chunk.DocumentCount, codec, valueCount);
 }
 
-static void WriteHeader(TCountingOutput* const output) {
+static void WriteHeader(const ui32 version, TCountingOutput* const output) {
     output->Write(Magic, MagicSize);
-    WriteLittleEndian(Version, output);
-    WriteLittleEndian(VersionHash, output);
+    WriteLittleEndian(version, output);
+    WriteLittleEndian(IntHash(version), output);
 
     const ui32 metainfoSize = 0;
     WriteLittleEndian(metainfoSize, output);
@@ -229,10 +305,16 @@ static TPoolMetainfo MakePoolMetainfo(
     return metainfo;
 }
 
-static void WriteAsOneFile(const NCB::TQuantizedPool& pool, IOutputStream* slave) {
+static void WriteAsOneFile(
+    const NCB::TQuantizedPool& pool,
+    const NCB::TSaveQuantizedPoolParameters& params,
+    IOutputStream* slave) {
+
     TCountingOutput output(slave);
 
-    WriteHeader(&output);
+    const bool encodeChunks = params.ChunkCodec != NCB::EQuantizedPoolChunkCodec::None || params.PackBits;
+    const ui32 version = encodeChunks ? CompressedChunksVersion : Version;
+    WriteHeader(version, &output);
 
     const auto chunksOffset = output.Counter();
 
@@ -241,11 +323,12 @@ static void WriteAsOneFile(const NCB::TQuantizedPool& pool, IOutputStream* slave
     perFeatureChunkInfos.resize(pool.ColumnIndexToLocalIndex.size());
     {
         flatbuffers::FlatBufferBuilder builder;
+        TBuffer compressedChunk;
         for (const auto trueFeatureIndex : sortedTrueFeatureIndices) {
             const auto localIndex = pool.ColumnIndexToLocalIndex.at(trueFeatureIndex);
             auto* const chunkInfos = &perFeatureChunkInfos[localIndex];
             for (const auto& chunk : pool.Chunks[localIndex]) {
-                WriteChunk(chunk, &output, chunkInfos, &builder);
+                WriteChunk(chunk, params, &output, chunkInfos, &builder, &compressedChunk);
             }
         }
     }
@@ -282,6 +365,10 @@ static void WriteAsOneFile(const NCB::TQuantizedPool& pool, IOutputStream* slave
             WriteLittleEndian(chunkInfo.Offset, &output);
             WriteLittleEndian(chunkInfo.DocumentOffset, &output);
             WriteLittleEndian(chunkInfo.DocumentsInChunkCount, &output);
+            if (version == CompressedChunksVersion) {
+                WriteLittleEndian(chunkInfo.Codec, &output);
+                WriteLittleEndian(chunkInfo.ValueCount, &output);
+            }
         }
     }
 
@@ -292,8 +379,12 @@ static void WriteAsOneFile(const NCB::TQuantizedPool& pool, IOutputStream* slave
     output.Write(MagicEnd, MagicEndSize);
 }
 
-void NCB::SaveQuantizedPool(const TQuantizedPool& pool, IOutputStream* const output) {
-    WriteAsOneFile(pool, output);
+void NCB::SaveQuantizedPool(
+    const TQuantizedPool& pool,
+    IOutputStream* const output,
+    const TSaveQuantizedPoolParameters& params) {
+
+    WriteAsOneFile(pool, params, output);
 }
 
 static void ValidatePoolPart(const TConstArrayRef<char> blob) {
@@ -301,7 +392,8 @@ static void ValidatePoolPart(const TConstArrayRef<char> blob) {
     (void)blob;
 }
 
-static void ReadHeader(TCountingInput* const input) {
+// returns format version
+static ui32 ReadHeader(TCountingInput* const input) {
     char magic[MagicSize];
     const auto magicSize = input->Load(magic, MagicSize);
     CB_ENSURE(MagicSize == magicSize);
@@ -309,11 +401,13 @@ static void ReadHeader(TCountingInput* const input) {
 
     ui32 version;
     ReadLittleEndian(&version, input);
-    CB_ENSURE(Version == version);
+    CB_ENSURE(
+        Version == version || CompressedChunksVersion == version,
+        "Unsupported quantized pool version " << version);
 
     ui32 versionHash;
     ReadLittleEndian(&versionHash, input);
-    CB_ENSURE(VersionHash == versionHash);
+    CB_ENSURE(IntHash(version) == versionHash);
 
     ui32 metainfoSize;
     ReadLittleEndian(&metainfoSize, input);
@@ -322,6 +416,8 @@ static void ReadHeader(TCountingInput* const input) {
 
     const auto metainfoBytesSkipped = input->Skip(metainfoSize);
     CB_ENSURE(metainfoSize == metainfoBytesSkipped);
+
+    return version;
 }
 
 template <typename T>
@@ -465,6 +561,35 @@ static TEpilogOffsets ReadEpilogOffsets(const TConstArrayRef<char> blob) {
     return offsets;
 }
 
+// decompresses chunk and unpacks its quants to 8 bits per document, result is a flatbuffer chunk
+static TVector<ui8> DecodeChunk(const TConstArrayRef<char> chunkBlob, const ui32 codec, const ui32 valueCount) {
+    TBuffer decompressed;
+    TConstArrayRef<char> flatChunk = chunkBlob;
+    if (codec != static_cast<ui32>(NCB::EQuantizedPoolChunkCodec::None)) {
+        NBlockCodecs::Codec(GetChunkCodecName(codec))->Decode(NBlockCodecs::TData(chunkBlob), decompressed);
+        flatChunk = TConstArrayRef<char>(decompressed.Data(), decompressed.Size());
+    }
+    const auto* const chunk = flatbuffers::GetRoot<NCB::NIdl::TQuantizedFeatureChunk>(flatChunk.data());
+    const ui32 bitsPerDocument = chunk->BitsPerDocument();
+    if (bitsPerDocument >= CHAR_BIT) {
+        return TVector<ui8>(flatChunk.begin(), flatChunk.end());
+    }
+    CB_ENSURE(
+        bitsPerDocument == 1 || bitsPerDocument == 2 || bitsPerDocument == 4,
+        "Unexpected bits per document in quantized pool chunk: " << bitsPerDocument);
+    const auto values = UnpackQuants(
+        TConstArrayRef<ui8>(chunk->Quants()->data(), chunk->Quants()->size()),
+        bitsPerDocument,
+        valueCount);
+    flatbuffers::FlatBufferBuilder builder;
+    builder.Finish(
+        NCB::NIdl::CreateTQuantizedFeatureChunk(
+            builder,
+            NCB::NIdl::EBitsPerDocumentFeature_BPDF_8,
+            builder.CreateVector(values.data(), values.size())));
+    return TVector<ui8>(builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize());
+}
+
 namespace {
     class TFileQuantizedPoolLoader : public NCB::IQuantizedPoolLoader {
     public:
@@ -498,10 +623,11 @@ NCB::TQuantizedPool TFileQuantizedPoolLoader::LoadQuantizedPool(NCB::TLoadQuanti
 
     ValidatePoolPart(blob);
 
-    const auto chunksOffsetByReading = [blob] {
+    ui32 version = 0;
+    const auto chunksOffsetByReading = [blob, &version] {
         TMemoryInput slave(blob.data(), blob.size());
         TCountingInput input(&slave);
-        ReadHeader(&input);
+        version = ReadHeader(&input);
         return input.Counter();
     }();
     const auto epilogOffsets = ReadEpilogOffsets(blob);
@@ -529,6 +655,16 @@ NCB::TQuantizedPool TFileQuantizedPoolLoader::LoadQuantizedPool(NCB::TLoadQuanti
     TVector<TVector<NCB::TQuantizedPool::TChunkDescription>> stringColumnChunks;
     THashMap<ui32, EColumn> stringColumnIndexToColumnType;
 
+    struct TChunkToDecode {
+        TConstArrayRef<char> Blob;
+        ui32 Codec = 0;
+        ui32 ValueCount = 0;
+        bool IsStringColumn = false;
+        ui32 ColumnIndex = 0; // in pool.Chunks or stringColumnChunks
+        ui32 ChunkIndex = 0;
+    };
+    TVector<TChunkToDecode> chunksToDecode;
+
     ui32 featureCount;
     ReadLittleEndian(&featureCount, &epilog);
     for (ui32 i = 0; i < featureCount; ++i) {
@@ -567,7 +703,12 @@ NCB::TQuantizedPool TFileQuantizedPoolLoader::LoadQuantizedPool(NCB::TLoadQuanti
         ui64 chunkOffset;
         ui32 docOffset;
         ui32 docsInChunkCount;
-        const size_t featureEpilogBytes = chunkCount * (sizeof(chunkSize) + sizeof(chunkOffset) + sizeof(docOffset) + sizeof(docsInChunkCount));
+        ui32 codec = 0;
+        ui32 valueCount = 0;
+        const bool hasCodecs = version == CompressedChunksVersion;
+        const size_t chunkDescriptorBytes = sizeof(chunkSize) + sizeof(chunkOffset) + sizeof(docOffset) + sizeof(docsInChunkCount)
+            + (hasCodecs ? sizeof(codec) + sizeof(valueCount) : 0);
+        const size_t featureEpilogBytes = chunkCount * chunkDescriptorBytes;
         TVector<ui8> featureEpilog(featureEpilogBytes);
         CB_ENSURE(featureEpilogBytes == epilog.Load(featureEpilog.data(), featureEpilogBytes));
         const auto* featureEpilogPtr = featureEpilog.data();
@@ -582,14 +723,59 @@ NCB::TQuantizedPool TFileQuantizedPoolLoader::LoadQuantizedPool(NCB::TLoadQuanti
 
             ReadLittleEndian(&docsInChunkCount, &featureEpilogPtr);
 
+            if (hasCodecs) {
+                ReadLittleEndian(&codec, &featureEpilogPtr);
+                ReadLittleEndian(&valueCount, &featureEpilogPtr);
+            }
+
             const TConstArrayRef<char> chunkBlob{blob.data() + chunkOffset, chunkSize};
             // TODO(yazevnul): validate flatbuffer, including document count
-            const auto* const chunk = flatbuffers::GetRoot<NCB::NIdl::TQuantizedFeatureChunk>(chunkBlob.data());
+            const auto* chunk = flatbuffers::GetRoot<NCB::NIdl::TQuantizedFeatureChunk>(chunkBlob.data());
+            const bool isEncoded = codec != static_cast<ui32>(NCB::EQuantizedPoolChunkCodec::None)
+                || (hasCodecs && static_cast<ui32>(chunk->BitsPerDocument()) < CHAR_BIT);
+            if (isEncoded) {
+                // pointer is set after decoding
+                chunk = nullptr;
+                chunksToDecode.push_back({
+                    chunkBlob,
+                    codec,
+                    valueCount,
+                    isFakeColumn,
+                    isFakeColumn ? SafeIntegerCast<ui32>(stringColumnChunks.size() - 1) : localFeatureIndex,
+                    SafeIntegerCast<ui32>(chunks.size())});
+            }
 
             chunks.emplace_back(docOffset, docsInChunkCount, chunk);
         }
     }
 
+    if (!chunksToDecode.empty()) {
+        pool.ChunkStorage.resize(chunksToDecode.size());
+        const auto decodeChunk = [&] (int i) {
+            const auto& chunkToDecode = chunksToDecode[i];
+            pool.ChunkStorage[i] = DecodeChunk(chunkToDecode.Blob, chunkToDecode.Codec, chunkToDecode.ValueCount);
+        };
+        if (params.LocalExecutor) {
+            params.LocalExecutor->ExecRangeWithThrow(
+                decodeChunk,
+                0,
+                SafeIntegerCast<int>(chunksToDecode.size()),
+                NPar::TLocalExecutor::WAIT_COMPLETE);
+        } else {
+            for (auto i : xrange(SafeIntegerCast<int>(chunksToDecode.size()))) {
+                decodeChunk(i);
+            }
+        }
+        for (auto i : xrange(chunksToDecode.size())) {
+            const auto& chunkToDecode = chunksToDecode[i];
+            auto& chunks = chunkToDecode.IsStringColumn
+                ? stringColumnChunks[chunkToDecode.ColumnIndex]
+                : pool.Chunks[chunkToDecode.ColumnIndex];
+            chunks[chunkToDecode.ChunkIndex].Chunk
+                = flatbuffers::GetRoot<NCB::NIdl::TQuantizedFeatureChunk>(pool.ChunkStorage[i].data());
+        }
+    }
+
     AddPoolMetainfo(poolMetainfo, &pool);
 
     // `pool.ColumnTypes` expected to have the same size as number of columns in pool,
@@ -827,7 +1013,8 @@ namespace NCB {
 
     void SaveQuantizedPool(
         const TSrcData& srcData,
-        TString fileName
+        TString fileName,
+        const TSaveQuantizedPoolParameters& params
     ) {
         TQuantizedPool pool;
         pool.DocumentCount = srcData.DocumentCount;
@@ -860,7 +1047,7 @@ namespace NCB {
 
 
         TFileOutput output(fileName);
-        SaveQuantizedPool(pool, &output);
+        SaveQuantizedPool(pool, &output, params);
     }
 
 
@@ -1020,7 +1207,11 @@ namespace NCB {
     }
 
 
-    void SaveQuantizedPool(const TDataProviderPtr& dataProvider, TString fileName) {
+    void SaveQuantizedPool(
+        const TDataProviderPtr& dataProvider,
+        TString fileName,
+        const TSaveQuantizedPoolParameters& params
+    ) {
         const auto threadCount = NSystemInfo::CachedNumberOfCpus();
         NPar::TLocalExecutor localExecutor;
         localExecutor.RunAdditionalThreads(threadCount);
@@ -1028,6 +1219,6 @@ namespace NCB {
         TSrcData srcData;
         BuildSrcDataFromDataProvider(dataProvider, &localExecutor, &srcData);
 
-        SaveQuantizedPool(srcData, fileName);
+        SaveQuantizedPool(srcData, fileName, params);
     }
 }
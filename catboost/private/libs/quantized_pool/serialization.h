@@ -61,11 +61,34 @@ namespace NCB {
 }
 
 namespace NCB {
+    // Block codec of quantized pool chunks, values are stored in the file and must not be changed.
+    enum class EQuantizedPoolChunkCodec : ui32 {
+        None = 0,
+        Lz4 = 1,
+        Zstd = 2
+    };
+
+    // Pools saved with compression or bit packing can't be read by older versions.
+    struct TSaveQuantizedPoolParameters {
+        EQuantizedPoolChunkCodec ChunkCodec = EQuantizedPoolChunkCodec::None;
+        // store 8-bit chunks with 1, 2 or 4 bits per document if all chunk values fit
+        bool PackBits = false;
+    };
+
     //only for used C++
-    void SaveQuantizedPool(const TQuantizedPool& pool, IOutputStream* output);
-    void SaveQuantizedPool(const TSrcData& srcData, TString fileName);
+    void SaveQuantizedPool(
+        const TQuantizedPool& pool,
+        IOutputStream* output,
+        const TSaveQuantizedPoolParameters& params = {});
+    void SaveQuantizedPool(
+        const TSrcData& srcData,
+        TString fileName,
+        const TSaveQuantizedPoolParameters& params = {});
     //only for python
-    void SaveQuantizedPool(const TDataProviderPtr& dataProvider, TString fileName);
+    void SaveQuantizedPool(
+        const TDataProviderPtr& dataProvider,
+        TString fileName,
+        const TSaveQuantizedPoolParameters& params = {});
 
     template<class T>
     TSrcColumn<T> GenerateSrcColumn(TConstArrayRef<T> data, EColumn columnType);
@@ -74,6 +97,8 @@ namespace NCB {
         bool LockMemory = true;
         bool Precharge = true;
         TDatasetSubset DatasetSubset;
+        // compressed or bit packed chunks are decoded on it, sequentially if it is not set
+        NPar::TLocalExecutor* LocalExecutor = nullptr;
     };
 
     // Load quantized pool saved by `SaveQuantizedPool` from file.
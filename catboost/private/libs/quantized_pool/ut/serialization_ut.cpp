@@ -2,6 +2,7 @@
 #include "print.h"
 #include "serialization.h"
 
+#include <library/threading/local_executor/local_executor.h>
 #include <library/unittest/registar.h>
 
 #include <contrib/libs/flatbuffers/include/flatbuffers/flatbuffers.h>
@@ -154,6 +155,34 @@ Y_UNIT_TEST_SUITE(SerializationTests) {
         UNIT_ASSERT_VALUES_EQUAL(loadedPoolAsText, poolAsText);
     }
 
+    Y_UNIT_TEST(TestSerializeDeserializeEncodedChunks) {
+        const auto pool = MakeQuantizedPool();
+        const auto path = TFsPath(GetSystemTempDir()) / "quantized_pool.bin";
+        const auto poolAsText = QuantizedPoolToString(pool);
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        for (auto codec : {NCB::EQuantizedPoolChunkCodec::None, NCB::EQuantizedPoolChunkCodec::Lz4, NCB::EQuantizedPoolChunkCodec::Zstd}) {
+            for (bool packBits : {false, true}) {
+                NCB::TSaveQuantizedPoolParameters params;
+                params.ChunkCodec = codec;
+                params.PackBits = packBits;
+                {
+                    TFileOutput output(path.GetPath());
+                    NCB::SaveQuantizedPool(pool, &output, params);
+                }
+
+                const auto loadedPool = NCB::LoadQuantizedPool(NCB::TPathWithScheme(path.GetPath(), "quantized"), {false, false, NCB::TDatasetSubset::MakeColumns()});
+                UNIT_ASSERT_VALUES_EQUAL(QuantizedPoolToString(loadedPool), poolAsText);
+
+                const auto loadedInParallelPool = NCB::LoadQuantizedPool(
+                    NCB::TPathWithScheme(path.GetPath(), "quantized"),
+                    {false, false, NCB::TDatasetSubset::MakeColumns(), &localExecutor});
+                UNIT_ASSERT_VALUES_EQUAL(QuantizedPoolToString(loadedInParallelPool), poolAsText);
+            }
+        }
+    }
+
     Y_UNIT_TEST(TestLoadQuantizationSchema) {
         const auto pool = MakeQuantizedPool();
         const auto path = TFsPath(GetSystemTempDir()) / "quantized_pool.bin";
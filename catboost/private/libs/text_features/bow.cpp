@@ -1,5 +1,8 @@
 #include "bow.h"
 
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+
 namespace NCB {
     TTextFeatureCalcerFactory::TRegistrator<TBagOfWordsCalcer>
         BagOfWordsRegistrator(EFeatureCalcerType::BoW);
@@ -13,6 +16,44 @@ namespace NCB {
         );
     }
 
+    void TBagOfWordsCalcer::Compute(TConstArrayRef<TText> texts, TArrayRef<float> result) const {
+        const ui64 docCount = texts.size();
+        const auto activeFeatures = GetActiveFeatureIndices();
+        Y_ASSERT(result.size() >= activeFeatures.size() * docCount);
+
+        Fill(result.begin(), result.begin() + activeFeatures.size() * docCount, 0.0f);
+        for (ui64 docId : xrange(docCount)) {
+            for (const auto& [token, count] : texts[docId]) {
+                Y_UNUSED(count);
+                const ui32 tokenId = token;
+                if (tokenId >= NumTokens) {
+                    continue;
+                }
+                const ui32 featureIdx = FeatureIdxByToken.empty() ? tokenId : FeatureIdxByToken[tokenId];
+                if (featureIdx != Max<ui32>()) {
+                    result[featureIdx * docCount + docId] = 1.0f;
+                }
+            }
+        }
+    }
+
+    void TBagOfWordsCalcer::TrimFeatures(TConstArrayRef<ui32> featureIndices) {
+        TTextFeatureCalcer::TrimFeatures(featureIndices);
+        BuildFeatureIdxByToken();
+    }
+
+    void TBagOfWordsCalcer::BuildFeatureIdxByToken() {
+        const auto activeFeatures = GetActiveFeatureIndices();
+        if (activeFeatures.size() == NumTokens) {
+            FeatureIdxByToken.clear();
+            return;
+        }
+        FeatureIdxByToken.assign(NumTokens, Max<ui32>());
+        for (ui32 featureIdx : xrange(activeFeatures.size())) {
+            FeatureIdxByToken[activeFeatures[featureIdx]] = featureIdx;
+        }
+    }
+
     TTextFeatureCalcer::TFeatureCalcerFbs TBagOfWordsCalcer::SaveParametersToFB(
         flatbuffers::FlatBufferBuilder& builder) const {
         using namespace NCatBoostFbs;
@@ -24,6 +65,7 @@ namespace NCB {
     void TBagOfWordsCalcer::LoadParametersFromFB(const NCatBoostFbs::TFeatureCalcer* calcer) {
         auto bow = calcer->FeatureCalcerImpl_as_TBoW();
         NumTokens = bow->NumTokens();
+        BuildFeatureIdxByToken();
     }
 
 }
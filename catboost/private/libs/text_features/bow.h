@@ -19,6 +19,10 @@ namespace NCB {
 
         void Compute(const TText& text, TOutputFloatIterator outputFeaturesIterator) const override;
 
+        void Compute(TConstArrayRef<TText> texts, TArrayRef<float> result) const override;
+
+        void TrimFeatures(TConstArrayRef<ui32> featureIndices) override;
+
     protected:
         TTextFeatureCalcer::TFeatureCalcerFbs SaveParametersToFB(flatbuffers::FlatBufferBuilder&) const override;
         void LoadParametersFromFB(const NCatBoostFbs::TFeatureCalcer*) override;
@@ -26,7 +30,11 @@ namespace NCB {
         void SaveLargeParameters(IOutputStream*) const override {}
         void LoadLargeParameters(IInputStream*) override {}
 
+    private:
+        void BuildFeatureIdxByToken();
+
     private:
         ui32 NumTokens;
+        TVector<ui32> FeatureIdxByToken; // empty if features are not trimmed, so feature index is token id
     };
 }
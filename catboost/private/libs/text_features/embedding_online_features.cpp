@@ -4,39 +4,92 @@
 #include <cmath>
 #include <contrib/libs/clapack/clapack.h>
 
-static inline void SolveLinearSystemCholesky(TArrayRef<double> matrix,
-                                             TArrayRef<double> vec) {
+#include <library/dot_product/dot_product.h>
+#include <library/sse/sse.h>
+
+#include <util/generic/ymath.h>
+
+static inline void SolveWithCholeskyFactor(TConstArrayRef<double> factor,
+                                           TArrayRef<double> vec) {
 
     char matrixStorageType[] = {'U', '\0'};
     int systemSize = static_cast<int>(vec.size());
     int numberOfRightHandSides = 1;
 
     int info = 0;
-    dposv_(matrixStorageType, &systemSize, &numberOfRightHandSides, matrix.data(), &systemSize,
-           vec.data(), &systemSize, &info);
+    // the factor is not modified
+    dpotrs_(matrixStorageType, &systemSize, &numberOfRightHandSides, const_cast<double*>(factor.data()), &systemSize,
+            vec.data(), &systemSize, &info);
 
     Y_VERIFY(info >= 0);
 }
 
+// sums[j] += value * embedding[j], products are computed in float precision
+static inline void AddScaledVector(float value, const float* embedding, double* sums, ui32 size) {
+    ui32 j = 0;
+#ifdef ARCADIA_SSE
+    const __m128 scale = _mm_set1_ps(value);
+    for (; j + 4 <= size; j += 4) {
+        const __m128 products = _mm_mul_ps(scale, _mm_loadu_ps(embedding + j));
+        _mm_storeu_pd(sums + j, _mm_add_pd(_mm_loadu_pd(sums + j), _mm_cvtps_pd(products)));
+        _mm_storeu_pd(sums + j + 2, _mm_add_pd(_mm_loadu_pd(sums + j + 2), _mm_cvtps_pd(_mm_movehl_ps(products, products))));
+    }
+#endif
+    for (; j < size; ++j) {
+        sums[j] += value * embedding[j];
+    }
+}
+
+
+void NCB::TEmbeddingOnlineFeatures::Factorize(TConstArrayRef<double> sigma, TSigmaFactor* sigmaFactor) {
+    sigmaFactor->Factor.assign(sigma.begin(), sigma.end());
+
+    char matrixStorageType[] = {'U', '\0'};
+    int systemSize = static_cast<int>(sqrt(sigma.size()));
+    Y_ASSERT(size_t(systemSize) * systemSize == sigma.size());
+
+    int info = 0;
+    dpotrf_(matrixStorageType, &systemSize, sigmaFactor->Factor.data(), &systemSize, &info);
+
+    Y_VERIFY(info >= 0);
+    sigmaFactor->IsPositiveDefinite = (info == 0);
+}
+
+void NCB::TEmbeddingOnlineFeatures::UpdateSigmaFactors(TMaybe<ui32> updatedClassId) {
+    if (ComputeHomoscedasticModel) {
+        Factorize(TotalSigma, &TotalSigmaFactor);
+    }
+    if (ComputeHeteroscedasticModel) {
+        for (ui32 i = 0; i < NumClasses; ++i) {
+            if (!updatedClassId.Defined() || *updatedClassId == i) {
+                Factorize(PerClassSigma[i], &PerClassSigmaFactors[i]);
+            }
+        }
+    }
+}
+
+double NCB::TEmbeddingOnlineFeatures::LogProbNormal(
+    TConstArrayRef<float> x,
+    TConstArrayRef<double> mu,
+    const TSigmaFactor& sigmaFactor) {
 
-inline double LogProbNormal(TConstArrayRef<float> x, TConstArrayRef<double> mu, TConstArrayRef<double> sigma) {
     const ui32 dim = x.size();
 
-    TVector<double> target(x.begin(), x.end());
+    TVector<double> delta(x.begin(), x.end());
     for (ui32 i = 0; i < dim; ++i) {
-        target[i] -= mu[i];
+        delta[i] -= mu[i];
+    }
+    TVector<double> target = delta;
+    // dposv_ leaves the right hand side as is if the matrix is not positive definite
+    if (sigmaFactor.IsPositiveDefinite) {
+        SolveWithCholeskyFactor(sigmaFactor.Factor, target);
     }
-    TVector<double> sigmaCopy(sigma.begin(), sigma.end());
-    SolveLinearSystemCholesky(sigmaCopy, target);
     double logDet = 0;
     for (ui32 i = 0; i < dim; ++i) {
-        logDet += log(sigmaCopy[i * dim + i]);
+        logDet += log(sigmaFactor.Factor[i * dim + i]);
     }
     Y_ASSERT(std::isfinite(logDet));
-    double result = 0;
-    for (ui32 i = 0; i < dim; ++i) {
-        result += (x[i] - mu[i]) * target[i];
-    }
+    double result = DotProduct(delta.data(), target.data(), dim);
     result *= 0.5;
 
     result += 0.5 * log(2 * PI) + logDet;
@@ -56,11 +109,11 @@ void NCB::TEmbeddingOnlineFeatures::Compute(
 
         if (ComputeHomoscedasticModel) {
             classProbsHomoscedastic[i] += classPrior;
-            classProbsHomoscedastic[i] += LogProbNormal(embedding, Means[i], TotalSigma);
+            classProbsHomoscedastic[i] += LogProbNormal(embedding, Means[i], TotalSigmaFactor);
         }
         if (ComputeHeteroscedasticModel) {
             classProbsHeteroscedastic[i] += classPrior;
-            classProbsHeteroscedastic[i] += LogProbNormal(embedding, Means[i], PerClassSigma[i]);
+            classProbsHeteroscedastic[i] += LogProbNormal(embedding, Means[i], PerClassSigmaFactors[i]);
         }
 
         if (ComputeCosDistance) {
@@ -106,9 +159,7 @@ void NCB::TEmbeddingFeaturesVisitor::UpdateEmbedding(
 
         for (ui64 i = 0; i < Dim; ++i) {
             sums[i] += embedding[i];
-            for (ui32 j = 0; j <= i; ++j) {
-                sums2[i * (i + 1) / 2 + j] += embedding[i] * embedding[j];
-            }
+            AddScaledVector(embedding[i], embedding.data(), sums2.data() + i * (i + 1) / 2, i + 1);
         }
     }
 
@@ -157,4 +208,5 @@ void NCB::TEmbeddingFeaturesVisitor::UpdateEmbedding(
         val /= totalWeight;
     }
     embeddingCalcer->TotalWeight = totalWeight;
+    embeddingCalcer->UpdateSigmaFactors(classId);
 }
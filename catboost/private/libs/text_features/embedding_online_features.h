@@ -7,6 +7,7 @@
 #include <util/system/types.h>
 #include <util/generic/vector.h>
 #include <util/generic/array_ref.h>
+#include <util/generic/maybe.h>
 
 namespace NCB {
 
@@ -52,6 +53,8 @@ namespace NCB {
             for (auto& vec : PerClassSigma) {
                 vec.resize(embeddingsDim * embeddingsDim);
             }
+            PerClassSigmaFactors.resize(numClasses);
+            UpdateSigmaFactors(Nothing());
         }
 
         static ui32 BaseFeatureCount(
@@ -87,6 +90,24 @@ namespace NCB {
             return true;
         }
 
+    private:
+        // Cholesky factorization of the covariance matrix, the same as dposv_ does before solving
+        struct TSigmaFactor {
+            TVector<double> Factor;
+            bool IsPositiveDefinite = false;
+        };
+
+        // only the changed class factor is recomputed, all of them if updatedClassId is not set
+        void UpdateSigmaFactors(TMaybe<ui32> updatedClassId);
+
+        static void Factorize(TConstArrayRef<double> sigma, TSigmaFactor* sigmaFactor);
+
+        static double LogProbNormal(
+            TConstArrayRef<float> x,
+            TConstArrayRef<double> mu,
+            const TSigmaFactor& sigmaFactor
+        );
+
     private:
         ui32 NumClasses;
         TEmbeddingPtr Embedding;
@@ -102,6 +123,10 @@ namespace NCB {
         TVector<TVector<double>> PerClassSigma;
         TVector<ui64> ClassSizes;
 
+        // factorized on update so that Compute solves only triangular systems for each text
+        TSigmaFactor TotalSigmaFactor;
+        TVector<TSigmaFactor> PerClassSigmaFactors;
+
         friend class TEmbeddingFeaturesVisitor;
     };
 
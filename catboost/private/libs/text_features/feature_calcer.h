@@ -12,6 +12,7 @@
 #include <library/object_factory/object_factory.h>
 #include <util/generic/ptr.h>
 #include <util/generic/guid.h>
+#include <util/generic/xrange.h>
 #include <util/stream/input.h>
 #include <util/system/mutex.h>
 
@@ -85,6 +86,14 @@ namespace NCB {
             return result;
         }
 
+        // features of a block of texts, result is laid out feature by feature: [featureIdx * texts.size() + textIdx]
+        virtual void Compute(TConstArrayRef<TText> texts, TArrayRef<float> result) const {
+            const ui64 docCount = texts.size();
+            for (ui64 docId : xrange(docCount)) {
+                Compute(texts[docId], TOutputFloatIterator(result.data() + docId, docCount, result.size()));
+            }
+        }
+
         void Save(IOutputStream* stream) const final;
         void Load(IInputStream* stream) final;
 
@@ -12,44 +12,43 @@
 #include <cstring>
 
 namespace NCB {
-    static void CalcFeatures(
-        const TVector<TVector<TStringBuf>>& tokens,
-        const TDictionaryProxy& dictionary,
-        const TTextFeatureCalcer& calcer,
-        TArrayRef<float> result
-    ) {
-        const ui64 docCount = tokens.size();
-        for (ui32 docId: xrange(docCount)) {
-            TText text = dictionary.Apply(tokens[docId]);
-
-            calcer.Compute(
-                text,
-                TOutputFloatIterator(result.data() + docId, docCount, result.size())
-            );
-        }
-    }
-
     void TTextProcessingCollection::CalcFeatures(
         TConstArrayRef<TStringBuf> textFeature,
         ui32 textFeatureIdx,
         size_t docCount,
-        TArrayRef<float> result
+        TArrayRef<float> result,
+        TTextProcessingBuffers* buffers
     ) const {
         CB_ENSURE(
             result.size() >= NumberOfOutputFeatures(textFeatureIdx) * docCount,
             "Proposed result buffer has size less than text processing produce"
         );
 
-        TVector<TVector<TStringBuf>> tokens;
-        tokens.yresize(docCount);
+        TTextProcessingBuffers localBuffers;
+        if (!buffers) {
+            buffers = &localBuffers;
+        }
+
+        auto& tokens = buffers->Tokens;
+        if (tokens.size() < docCount) {
+            tokens.resize(docCount);
+        }
         for (ui32 docId: xrange(docCount)) {
             Tokenizer->Tokenize(textFeature[docId], &tokens[docId]);
         }
 
+        auto& digitizedTexts = buffers->DigitizedTexts;
+        digitizedTexts.resize(docCount);
         for (ui32 dictionaryId: PerFeatureDictionaries[textFeatureIdx]) {
             const auto& dictionary = Dictionaries[dictionaryId];
             const ui32 tokenizedFeatureIdx = GetTokenizedFeatureId(textFeatureIdx, dictionaryId);
 
+            for (ui32 docId: xrange(docCount)) {
+                // texts are not reused: the hash layout and so the order of calcers' sums must be the same as in training
+                digitizedTexts[docId] = TText();
+                dictionary->Apply(tokens[docId], &digitizedTexts[docId], &buffers->TokenIds);
+            }
+
             for (ui32 calcerId: PerTokenizedFeatureCalcers[tokenizedFeatureIdx]) {
                 const auto& calcer = FeatureCalcers[calcerId];
 
@@ -60,7 +59,7 @@ namespace NCB {
                     result.data() + calcerOffset,
                     result.data() + calcerOffset + calculatedFeaturesSize
                 );
-                NCB::CalcFeatures(tokens, *dictionary, *calcer, currentResult);
+                calcer->Compute(MakeConstArrayRef(digitizedTexts), currentResult);
             }
         }
     }
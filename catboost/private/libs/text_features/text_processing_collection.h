@@ -26,6 +26,15 @@ namespace NCB {
         ui32 LocalId;
     };
 
+    /* Scratch buffers of block text processing, token vectors keep their capacity between blocks
+     */
+    struct TTextProcessingBuffers {
+        TVector<TStringBuf> Texts;
+        TVector<TVector<TStringBuf>> Tokens;
+        TVector<ui32> TokenIds;
+        TVector<TText> DigitizedTexts;
+    };
+
     class TTextProcessingCollection : public TThrRefBase {
     public:
         TTextProcessingCollection() = default;
@@ -49,7 +58,8 @@ namespace NCB {
             TTextFeatureAccessor featureAccessor,
             TConstArrayRef<ui32> textFeatureIds,
             ui32 docCount,
-            TArrayRef<float> result
+            TArrayRef<float> result,
+            TTextProcessingBuffers* buffers = nullptr
         ) const {
             const ui32 totalNumberOfFeatures = TotalNumberOfOutputFeatures() * docCount;
             CB_ENSURE(
@@ -58,7 +68,11 @@ namespace NCB {
                     << ") less than text processing produce (" << totalNumberOfFeatures << ')'
             );
 
-            TVector<TStringBuf> texts;
+            TTextProcessingBuffers localBuffers;
+            if (!buffers) {
+                buffers = &localBuffers;
+            }
+            auto& texts = buffers->Texts;
             texts.yresize(docCount);
 
             float* estimatedFeatureBegin = &result[0];
@@ -73,20 +87,26 @@ namespace NCB {
                 CalcFeatures(
                     MakeConstArrayRef(texts),
                     textFeatureId,
+                    docCount,
                     TArrayRef<float>(
                         estimatedFeatureBegin,
                         estimatedFeatureEnd
-                    )
+                    ),
+                    buffers
                 );
                 estimatedFeatureBegin = estimatedFeatureEnd;
             }
         }
 
+        /* Tokenizes the whole block at once, digitizes it once per dictionary
+         * and computes each calcer's features for the block
+         */
         void CalcFeatures(
             TConstArrayRef<TStringBuf> textFeature,
             ui32 textFeatureIdx,
             size_t docCount,
-            TArrayRef<float> result) const;
+            TArrayRef<float> result,
+            TTextProcessingBuffers* buffers = nullptr) const;
 
         ui32 GetAbsoluteCalcerOffset(const TGuid& calcerGuid) const;
         ui32 GetRelativeCalcerOffset(ui32 textFeatureIdx, const TGuid& calcerGuid) const;
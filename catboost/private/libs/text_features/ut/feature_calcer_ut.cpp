@@ -5,6 +5,7 @@
 
 #include <library/unittest/registar.h>
 #include <util/generic/ylimits.h>
+#include <util/stream/str.h>
 
 using namespace NCB;
 
@@ -82,6 +83,47 @@ Y_UNIT_TEST_SUITE(TestFeatureCalcer) {
         }
     }
 
+    Y_UNIT_TEST(TestBagOfWordsCalcerOnBlock) {
+        const ui32 numTokens = 1000;
+        const ui32 numSamples = 128;
+        const ui32 numTokensPerText = 11;
+
+        TVector<TText> texts;
+        for (ui32 docId : xrange(numSamples)) {
+            TText text;
+            for (ui32 idx : xrange(numTokensPerText)) {
+                text[(docId * 7 + idx * idx) % 30] = 1;
+            }
+            texts.push_back(text);
+        }
+
+        // token ids are feature indices without trimming, trimmed calcers use the token map built by trim and load
+        for (const TVector<ui32>& trimmedFeatures : {TVector<ui32>(), TVector<ui32>{0, 3, 20}}) {
+            TTextFeatureCalcerPtr calcer = MakeIntrusive<TBagOfWordsCalcer>(CreateGuid(), numTokens);
+            if (!trimmedFeatures.empty()) {
+                calcer->TrimFeatures(trimmedFeatures);
+            }
+            const ui32 featureCount = calcer->FeatureCount();
+
+            TVector<float> expected(numSamples * featureCount);
+            for (ui32 docId : xrange(numSamples)) {
+                calcer->Compute(texts[docId], TOutputFloatIterator(expected.data() + docId, numSamples, expected.size()));
+            }
+
+            TVector<float> features(numSamples * featureCount, -1.0f);
+            calcer->Compute(MakeConstArrayRef(texts), MakeArrayRef(features));
+            UNIT_ASSERT_VALUES_EQUAL(features, expected);
+
+            TStringStream stream;
+            calcer->Save(&stream);
+            TBagOfWordsCalcer loadedCalcer;
+            loadedCalcer.Load(&stream);
+            TVector<float> loadedFeatures(numSamples * featureCount, -1.0f);
+            loadedCalcer.Compute(MakeConstArrayRef(texts), MakeArrayRef(loadedFeatures));
+            UNIT_ASSERT_VALUES_EQUAL(loadedFeatures, expected);
+        }
+    }
+
     static void Log(TArrayRef<double> values) {
         for (double& value: values) {
             value = log(value);
@@ -173,6 +173,69 @@ Y_UNIT_TEST_SUITE(TestTextProcessingCollection) {
         );
     }
 
+    Y_UNIT_TEST(TestApplyInBlocksWithReusedBuffers) {
+        TVector<TTextFeature> features;
+        TVector<TTokenizedTextFeature> tokenizedFeatures;
+        TVector<TTextFeatureCalcerPtr> calcers;
+        TVector<TDictionaryPtr> dictionaries;
+        TTokenizerPtr tokenizer;
+        TVector<TVector<ui32>> perFeatureDictionaries;
+        TVector<TVector<ui32>> perTokenizedFeatureCalcers;
+
+        CreateTextDataForTest(
+            &features,
+            &tokenizedFeatures,
+            &calcers,
+            &dictionaries,
+            &tokenizer,
+            &perFeatureDictionaries,
+            &perTokenizedFeatureCalcers
+        );
+
+        TTextProcessingCollection textProcessingCollection = TTextProcessingCollection(
+            calcers,
+            dictionaries,
+            perFeatureDictionaries,
+            perTokenizedFeatureCalcers,
+            tokenizer
+        );
+
+        const ui32 docCount = features[0].size();
+        const ui32 featureCount = textProcessingCollection.TotalNumberOfOutputFeatures();
+        TVector<ui32> textFeatureIds = xrange(features.size());
+        const auto featureAccessor = [&] (ui32 blockStart) {
+            return [&features, blockStart] (ui32 textFeatureId, ui32 docId) {
+                return TStringBuf(features[textFeatureId][blockStart + docId]);
+            };
+        };
+
+        TVector<float> expected(featureCount * docCount);
+        textProcessingCollection.CalcFeatures(featureAccessor(0), textFeatureIds, docCount, MakeArrayRef(expected));
+
+        // decreasing block sizes check that leftovers of the previous blocks in the buffers are not used
+        TTextProcessingBuffers buffers;
+        const ui32 secondBlockStart = docCount / 2 + 1;
+        for (auto [blockStart, blockEnd] : {std::make_pair(0u, secondBlockStart), std::make_pair(secondBlockStart, docCount)}) {
+            const ui32 blockSize = blockEnd - blockStart;
+            TVector<float> result(featureCount * blockSize);
+            textProcessingCollection.CalcFeatures(
+                featureAccessor(blockStart),
+                textFeatureIds,
+                blockSize,
+                MakeArrayRef(result),
+                &buffers
+            );
+            for (ui32 featureIdx : xrange(featureCount)) {
+                for (ui32 docId : xrange(blockSize)) {
+                    UNIT_ASSERT_EQUAL(
+                        expected[featureIdx * docCount + blockStart + docId],
+                        result[featureIdx * blockSize + docId]
+                    );
+                }
+            }
+        }
+    }
+
     Y_UNIT_TEST(TestSerialization) {
         TVector<TTextFeature> features;
         TVector<TTokenizedTextFeature> tokenizedFeatures;
@@ -0,0 +1,106 @@
+#include <catboost/private/libs/text_processing/dictionary.h>
+#include <catboost/private/libs/text_processing/tokenizer.h>
+
+#include <library/testing/benchmark/bench.h>
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/singleton.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/system/info.h>
+
+using namespace NCB;
+
+const size_t TextColumnSize = 1ull << 30; // in bytes
+const size_t VocabularySize = 100000;
+const size_t WordsPerText = 30;
+
+namespace {
+    // word frequencies are skewed like in natural texts
+    struct TTextColumn {
+        TVector<TString> Texts;
+
+        TTextColumn() {
+            TReallyFastRng32 rng(0);
+
+            TVector<TString> vocabulary;
+            for (auto wordIdx : xrange(VocabularySize)) {
+                Y_UNUSED(wordIdx);
+                TString word;
+                for (auto letterIdx : xrange(2 + rng.Uniform(8))) {
+                    Y_UNUSED(letterIdx);
+                    word += 'a' + rng.Uniform(26);
+                }
+                vocabulary.push_back(word);
+            }
+
+            size_t size = 0;
+            while (size < TextColumnSize) {
+                TString text;
+                for (auto wordIdx : xrange(WordsPerText)) {
+                    Y_UNUSED(wordIdx);
+                    text += vocabulary[rng.Uniform(rng.Uniform(VocabularySize) + 1)];
+                    text += ' ';
+                }
+                size += text.size();
+                Texts.push_back(std::move(text));
+            }
+        }
+    };
+
+    struct TBenchExecutor : public NPar::TLocalExecutor {
+        TBenchExecutor() {
+            RunAdditionalThreads(NSystemInfo::CachedNumberOfCpus() - 1);
+        }
+    };
+}
+
+static NCatboostOptions::TTextColumnDictionaryOptions GetDictionaryOptions(ui32 gramOrder) {
+    NTextProcessing::NDictionary::TDictionaryOptions dictionaryOptions;
+    dictionaryOptions.GramOrder = gramOrder;
+    return NCatboostOptions::TTextColumnDictionaryOptions(
+        "dictionary",
+        dictionaryOptions,
+        NCatboostOptions::TDictionaryBuilderOptions{3, 50000}
+    );
+}
+
+static void CreateDictionaries(ui32 gramOrder, NPar::TLocalExecutor* localExecutor, size_t iterationCount) {
+    const auto& texts = Singleton<TTextColumn>()->Texts;
+    const auto options = GetDictionaryOptions(gramOrder);
+    const auto tokenizer = CreateTokenizer();
+    for (auto i : xrange(iterationCount)) {
+        Y_UNUSED(i);
+        if (localExecutor) {
+            Y_DO_NOT_OPTIMIZE_AWAY(CreateDictionary(TIterableTextFeature(texts), options, tokenizer, localExecutor));
+        } else {
+            Y_DO_NOT_OPTIMIZE_AWAY(CreateDictionary(TIterableTextFeature(texts), options, tokenizer));
+        }
+    }
+}
+
+Y_CPU_BENCHMARK(UnigramDictionary, iface) {
+    CreateDictionaries(1, nullptr, iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(ParallelUnigramDictionary, iface) {
+    CreateDictionaries(1, Singleton<TBenchExecutor>(), iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(BigramDictionary, iface) {
+    CreateDictionaries(2, nullptr, iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(ParallelBigramDictionary, iface) {
+    CreateDictionaries(2, Singleton<TBenchExecutor>(), iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(ParallelTokenize, iface) {
+    const auto& texts = Singleton<TTextColumn>()->Texts;
+    const TVector<TStringBuf> textBufs(texts.begin(), texts.end());
+    const auto tokenizer = CreateTokenizer();
+    for (auto i : xrange(iface.Iterations())) {
+        Y_UNUSED(i);
+        Y_DO_NOT_OPTIMIZE_AWAY(Tokenize(textBufs, tokenizer, Singleton<TBenchExecutor>()));
+    }
+}
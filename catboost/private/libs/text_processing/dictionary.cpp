@@ -11,11 +11,15 @@ namespace NCB {
     }
 
     void TDictionaryProxy::Apply(TConstArrayRef<TStringBuf> tokens, TText* text) const {
+        TVector<ui32> tokenIds;
+        Apply(tokens, text, &tokenIds);
+    }
+
+    void TDictionaryProxy::Apply(TConstArrayRef<TStringBuf> tokens, TText* text, TVector<ui32>* tokenIds) const {
         text->Clear();
 
-        TVector<ui32> tokenIds;
-        DictionaryImpl->Apply(tokens, &tokenIds);
-        for (const auto& tokenId : tokenIds) {
+        DictionaryImpl->Apply(tokens, tokenIds);
+        for (const auto& tokenId : *tokenIds) {
             (*text)[TTokenId(tokenId)]++;
         }
     }
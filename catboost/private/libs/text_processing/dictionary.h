@@ -12,6 +12,11 @@
 #include <library/text_processing/dictionary/dictionary_builder.h>
 #include <library/text_processing/dictionary/mmap_frequency_based_dictionary.h>
 
+#include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
+#include <util/generic/maybe.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
 #include <util/stream/input.h>
 #include <util/stream/output.h>
 
@@ -32,6 +37,8 @@ namespace NCB {
         TTokenId Apply(TStringBuf token) const;
         TText Apply(TConstArrayRef<TStringBuf> tokens) const;
         void Apply(TConstArrayRef<TStringBuf> tokens, TText* text) const;
+        // tokenIds is a scratch buffer that can be reused between calls
+        void Apply(TConstArrayRef<TStringBuf> tokens, TText* text, TVector<ui32>* tokenIds) const;
 
         ui32 Size() const;
 
@@ -132,4 +139,81 @@ namespace NCB {
 
         return new TDictionaryProxy(dictionaryBuilder.FinishBuilding());
     }
+
+    /* Builds the same dictionary as the function above: tokens of all texts are counted as one sequence.
+     * Texts are tokenized in parallel, then the token sequence is split into blocks counted by separate
+     * dictionary builders that are merged at the end.
+     * For word n-grams each block also gets n-gram span of preceding tokens, so n-grams crossing block
+     * boundaries are counted exactly once.
+     */
+    template <class TTextFeatureType>
+    inline TDictionaryPtr CreateDictionary(
+        TIterableTextFeature<TTextFeatureType> textFeature,
+        const NCatboostOptions::TTextColumnDictionaryOptions& dictionaryOptions,
+        const TTokenizerPtr& tokenizer,
+        NPar::TLocalExecutor* localExecutor) {
+
+        using namespace NTextProcessing::NDictionary;
+
+        TVector<TVector<TStringBuf>> textTokens(textFeature.Size());
+        textFeature.ForEach(
+            [&] (ui32 index, TStringBuf phrase) {
+                tokenizer->Tokenize(phrase, &textTokens[index]);
+            },
+            localExecutor
+        );
+
+        TVector<ui64> textTokensOffsets(textTokens.size() + 1, 0);
+        for (auto textIdx : xrange(textTokens.size())) {
+            textTokensOffsets[textIdx + 1] = textTokensOffsets[textIdx] + textTokens[textIdx].size();
+        }
+        TVector<TStringBuf> tokens;
+        tokens.yresize(textTokensOffsets.back());
+        NPar::ParallelFor(
+            *localExecutor,
+            0,
+            SafeIntegerCast<ui32>(textTokens.size()),
+            [&] (ui32 textIdx) {
+                Copy(textTokens[textIdx].begin(), textTokens[textIdx].end(), tokens.begin() + textTokensOffsets[textIdx]);
+                TVector<TStringBuf>().swap(textTokens[textIdx]);
+            }
+        );
+
+        const TDictionaryOptions& options = dictionaryOptions.DictionaryOptions.Get();
+        const bool isWordMultigram = (options.GramOrder > 1) && (options.TokenLevelType == ETokenLevelType::Word);
+        const ui64 nGramSpan = isWordMultigram ? (options.GramOrder - 1) * (options.SkipStep + 1) : 0;
+
+        const int blockCount = Max<ui64>(Min<ui64>(localExecutor->GetThreadCount() + 1, tokens.size()), 1);
+        const ui64 blockSize = CeilDiv<ui64>(tokens.size(), blockCount);
+
+        TVector<TMaybe<TDictionaryBuilder>> blockBuilders(blockCount);
+        localExecutor->ExecRangeWithThrow(
+            [&] (int blockIdx) {
+                TDictionaryOptions blockOptions = options;
+                if (blockIdx + 1 != blockCount) {
+                    // end of sentence token is added only after the last token
+                    blockOptions.EndOfSentenceTokenPolicy = EEndOfSentenceTokenPolicy::Skip;
+                }
+                blockBuilders[blockIdx].ConstructInPlace(dictionaryOptions.DictionaryBuilderOptions.Get(), blockOptions);
+
+                const ui64 blockBegin = Min<ui64>(blockIdx * blockSize, tokens.size());
+                const ui64 blockEnd = Min<ui64>(blockBegin + blockSize, tokens.size());
+                const ui64 sequenceBegin = blockBegin - Min(blockBegin, nGramSpan);
+                blockBuilders[blockIdx]->Add(
+                    TConstArrayRef<TStringBuf>(tokens.data() + sequenceBegin, blockEnd - sequenceBegin)
+                );
+            },
+            0,
+            blockCount,
+            NPar::TLocalExecutor::WAIT_COMPLETE
+        );
+
+        // the last builder has the original options
+        TDictionaryBuilder& dictionaryBuilder = *blockBuilders.back();
+        for (auto blockIdx : xrange(blockCount - 1)) {
+            dictionaryBuilder.Merge(std::move(*blockBuilders[blockIdx]));
+        }
+
+        return new TDictionaryProxy(dictionaryBuilder.FinishBuilding());
+    }
 }
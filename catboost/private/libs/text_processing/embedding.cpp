@@ -1,58 +1,243 @@
 #include "embedding.h"
 
+#include <catboost/libs/helpers/exception.h>
+
+#include <library/float16/float16.h>
+#include <library/sse/sse.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/buffer.h>
+#include <util/generic/cast.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+#include <util/stream/buffer.h>
+#include <util/stream/file.h>
+#include <util/stream/mem.h>
+
 using namespace NCB;
 
-class TEmbedding final : public IEmbedding {
-public:
-    explicit TEmbedding(TDenseHash<TTokenId, TVector<float>>&& embedding)
-    : Embedding(std::move(embedding)) {
 
+static constexpr size_t EmbeddingMatrixPrefixSize = sizeof(EmbeddingMatrixMagic) + 6 * sizeof(ui32);
+
+// row stride is a multiple of 8 elements so that rows of both precisions start at 16-byte boundaries
+static constexpr ui32 EmbeddingMatrixRowStrideAlignment = 8;
+
+
+static inline size_t GetRowsOffset(ui32 tokenCount) {
+    return CeilDiv<size_t>(EmbeddingMatrixPrefixSize + tokenCount * sizeof(ui32), EmbeddingMatrixAlignment)
+        * EmbeddingMatrixAlignment;
+}
+
+static inline size_t GetElementSize(EEmbeddingPrecision precision) {
+    return precision == EEmbeddingPrecision::Float16 ? sizeof(TFloat16) : sizeof(float);
+}
+
+static inline void AddVector(const float* what, float* to, ui32 size) {
+    ui32 i = 0;
+#ifdef ARCADIA_SSE
+    for (; i + 8 <= size; i += 8) {
+        _mm_storeu_ps(to + i, _mm_add_ps(_mm_loadu_ps(to + i), _mm_loadu_ps(what + i)));
+        _mm_storeu_ps(to + i + 4, _mm_add_ps(_mm_loadu_ps(to + i + 4), _mm_loadu_ps(what + i + 4)));
     }
+    for (; i + 4 <= size; i += 4) {
+        _mm_storeu_ps(to + i, _mm_add_ps(_mm_loadu_ps(to + i), _mm_loadu_ps(what + i)));
+    }
+#endif
+    for (; i < size; ++i) {
+        to[i] += what[i];
+    }
+}
 
-    ui64 Dim() const override {
-        return Embedding.begin()->second.size();
+
+static TBlob BuildEmbeddingMatrixData(
+    TDenseHash<TTokenId, TVector<float>>&& hash,
+    EEmbeddingPrecision precision
+) {
+    TVector<ui32> tokens;
+    tokens.reserve(hash.Size());
+    for (const auto& [token, vec] : hash) {
+        tokens.push_back(token);
     }
+    // sorted to make the data independent of the hash layout
+    Sort(tokens);
 
+    const ui32 dim = tokens.empty() ? 0 : hash.find(TTokenId(tokens[0]))->second.size();
+    const ui32 rowStride = CeilDiv(dim, EmbeddingMatrixRowStrideAlignment) * EmbeddingMatrixRowStrideAlignment;
+    const ui32 tokenCount = tokens.empty() ? 0 : tokens.back() + 1;
+    const ui32 rowCount = tokens.size();
 
-    void Apply(const TTextDataSet& ds, TVector<TVector<float>>* dst, NPar::TLocalExecutor* executor) const override {
-        dst->resize(ds.SamplesCount());
-        auto texts = ds.GetTexts();
-        NPar::ParallelFor(*executor, 0, static_cast<ui32>(texts.size()), [&](ui32 idx) {
-            Apply(texts[idx], &(*dst)[idx]);
-        });
+    TVector<ui32> rowByToken(tokenCount, Max<ui32>());
+    for (auto row : xrange(rowCount)) {
+        rowByToken[tokens[row]] = row;
     }
 
+    const size_t rowsOffset = GetRowsOffset(tokenCount);
+    const size_t elementSize = GetElementSize(precision);
 
-    void Apply(const TText& text, TVector<float>* dst) const {
-        dst->clear();
-        dst->resize(Dim());
-        auto& result = *dst;
-        double count = 0.5;
-        for (const auto& [token, tokenCount] : text) {
-            Y_UNUSED(tokenCount);
-            auto embedding = Embedding.find(token);
-            if (embedding != Embedding.end()) {
-                AddVector(embedding->second, result);
-                ++count;
-            }
-        }
-        for (ui64 i = 0; i < result.size(); ++i) {
-            result[i] /= count;
+    TBuffer buffer(rowsOffset + size_t(rowCount) * rowStride * elementSize);
+    TBufferOutput output(buffer);
+    output.Write(EmbeddingMatrixMagic, sizeof(EmbeddingMatrixMagic));
+    ::Save(&output, EmbeddingMatrixVersion);
+    ::Save(&output, static_cast<ui32>(precision));
+    ::Save(&output, dim);
+    ::Save(&output, rowStride);
+    ::Save(&output, tokenCount);
+    ::Save(&output, rowCount);
+    output.Write(rowByToken.data(), rowByToken.size() * sizeof(ui32));
+    const TVector<char> padding(rowsOffset - buffer.Size(), 0);
+    output.Write(padding.data(), padding.size());
+
+    TVector<float> row(rowStride, 0.0f);
+    TVector<TFloat16> halfRow(rowStride);
+    for (auto token : tokens) {
+        auto& vec = hash.find(TTokenId(token))->second;
+        CB_ENSURE(
+            vec.size() == dim,
+            "Error: embedding size should be equal for all words: " << dim << " ≠ " << vec.size()
+        );
+        Copy(vec.begin(), vec.end(), row.begin());
+        if (precision == EEmbeddingPrecision::Float16) {
+            NFloat16Ops::PackFloat16SequenceAuto(row.data(), halfRow.data(), rowStride);
+            output.Write(halfRow.data(), rowStride * sizeof(TFloat16));
+        } else {
+            output.Write(row.data(), rowStride * sizeof(float));
         }
+        TVector<float>().swap(vec);
+    }
+    output.Finish();
+
+    return TBlob::FromBuffer(buffer);
+}
+
+
+TEmbeddingMatrix::TEmbeddingMatrix(TBlob data)
+    : Data(std::move(data))
+{
+    CB_ENSURE(
+        Data.Size() >= EmbeddingMatrixPrefixSize
+            && TStringBuf(Data.AsCharPtr(), sizeof(EmbeddingMatrixMagic))
+                == TStringBuf(EmbeddingMatrixMagic, sizeof(EmbeddingMatrixMagic)),
+        "Data is not an embedding matrix"
+    );
+    TMemoryInput prefix(
+        Data.AsCharPtr() + sizeof(EmbeddingMatrixMagic),
+        EmbeddingMatrixPrefixSize - sizeof(EmbeddingMatrixMagic)
+    );
+    ui32 version;
+    ::Load(&prefix, version);
+    CB_ENSURE(version == EmbeddingMatrixVersion, "Unsupported embedding matrix version " << version);
+    ui32 precision;
+    ::Load(&prefix, precision);
+    CB_ENSURE(
+        precision <= static_cast<ui32>(EEmbeddingPrecision::Float16),
+        "Unknown embedding matrix precision " << precision
+    );
+    Precision = static_cast<EEmbeddingPrecision>(precision);
+    ::Load(&prefix, EmbeddingDim);
+    ::Load(&prefix, RowStride);
+    CB_ENSURE(RowStride >= EmbeddingDim, "Embedding matrix row stride is less than dim");
+    ui32 tokenCount;
+    ::Load(&prefix, tokenCount);
+    ui32 rowCount;
+    ::Load(&prefix, rowCount);
+
+    const size_t rowsOffset = GetRowsOffset(tokenCount);
+    CB_ENSURE(
+        Data.Size() == rowsOffset + size_t(rowCount) * RowStride * GetElementSize(Precision),
+        "Embedding matrix data has wrong size"
+    );
+
+    RowByToken = TConstArrayRef<ui32>(
+        reinterpret_cast<const ui32*>(Data.AsCharPtr() + EmbeddingMatrixPrefixSize),
+        tokenCount
+    );
+    CB_ENSURE(
+        AllOf(RowByToken, [=] (ui32 row) { return row == Max<ui32>() || row < rowCount; }),
+        "Embedding matrix has row index out of range"
+    );
+    Rows = Data.AsCharPtr() + rowsOffset;
+}
+
+void TEmbeddingMatrix::Apply(
+    const TTextDataSet& ds,
+    TVector<TVector<float>>* dst,
+    NPar::TLocalExecutor* executor
+) const {
+    dst->resize(ds.SamplesCount());
+    auto texts = ds.GetTexts();
+    if (texts.empty()) {
+        return;
+    }
+
+    NPar::TLocalExecutor::TExecRangeParams blockParams(0, SafeIntegerCast<int>(texts.size()));
+    blockParams.SetBlockCount(executor->GetThreadCount() + 1);
+    executor->ExecRange(
+        [&] (int blockIdx) {
+            TVector<float> rowBuffer;
+            rowBuffer.yresize(RowStride);
+            const int blockEnd = Min(blockParams.LastId, (blockIdx + 1) * blockParams.GetBlockSize());
+            for (int idx = blockIdx * blockParams.GetBlockSize(); idx < blockEnd; ++idx) {
+                Apply(texts[idx], rowBuffer, &(*dst)[idx]);
+            }
+        },
+        0,
+        blockParams.GetBlockCount(),
+        NPar::TLocalExecutor::WAIT_COMPLETE
+    );
+}
+
+void TEmbeddingMatrix::Apply(const TText& text, TVector<float>* dst) const {
+    TVector<float> rowBuffer;
+    if (Precision == EEmbeddingPrecision::Float16) {
+        rowBuffer.yresize(RowStride);
     }
-private:
+    Apply(text, rowBuffer, dst);
+}
 
-    void AddVector(TConstArrayRef<float> what, TArrayRef<float> to) const {
-        for (ui32 i = 0; i < to.size(); ++i) {
-            to[i] += what[i];
+void TEmbeddingMatrix::Apply(const TText& text, TArrayRef<float> rowBuffer, TVector<float>* dst) const {
+    dst->clear();
+    dst->resize(EmbeddingDim);
+    float* result = dst->data();
+    double count = 0.5;
+    for (const auto& [token, tokenCount] : text) {
+        Y_UNUSED(tokenCount);
+        const ui32 row = token.Id < RowByToken.size() ? RowByToken[token.Id] : Max<ui32>();
+        if (row == Max<ui32>()) {
+            continue;
+        }
+        const size_t rowOffset = size_t(row) * RowStride;
+        if (Precision == EEmbeddingPrecision::Float16) {
+            NFloat16Ops::UnpackFloat16SequenceAuto(
+                reinterpret_cast<const TFloat16*>(Rows) + rowOffset,
+                rowBuffer.data(),
+                EmbeddingDim
+            );
+            AddVector(rowBuffer.data(), result, EmbeddingDim);
+        } else {
+            AddVector(reinterpret_cast<const float*>(Rows) + rowOffset, result, EmbeddingDim);
         }
+        ++count;
     }
-private:
-    TDenseHash<TTokenId, TVector<float>> Embedding;
+    for (ui32 i = 0; i < EmbeddingDim; ++i) {
+        result[i] /= count;
+    }
+}
+
+void TEmbeddingMatrix::Save(IOutputStream* output) const {
+    output->Write(Data.Data(), Data.Size());
+}
 
 
-};
+TEmbeddingPtr NCB::CreateEmbedding(TDenseHash<TTokenId, TVector<float>>&& hash, EEmbeddingPrecision precision) {
+    return new TEmbeddingMatrix(BuildEmbeddingMatrixData(std::move(hash), precision));
+}
+
+TEmbeddingPtr NCB::LoadEmbeddingMatrix(const TString& path) {
+    return new TEmbeddingMatrix(TBlob::FromFile(path));
+}
 
-TEmbeddingPtr NCB::CreateEmbedding(TDenseHash<TTokenId, TVector<float>>&& hash) {
-    return new TEmbedding(std::move(hash));
+void NCB::SaveEmbeddingMatrix(const TEmbeddingMatrix& embedding, const TString& path) {
+    TOFStream output(path);
+    embedding.Save(&output);
+    output.Finish();
 }
@@ -4,8 +4,11 @@
 
 #include <library/threading/local_executor/local_executor.h>
 
-#include <util/system/types.h>
+#include <util/generic/array_ref.h>
 #include <util/generic/ptr.h>
+#include <util/memory/blob.h>
+#include <util/stream/output.h>
+#include <util/system/types.h>
 
 
 namespace NCB {
@@ -24,7 +27,72 @@ namespace NCB {
     using TEmbeddingPtr = TIntrusivePtr<IEmbedding>;
 
 
-    TEmbeddingPtr CreateEmbedding(TDenseHash<TTokenId, TVector<float>>&& hash);
-}
+    enum class EEmbeddingPrecision : ui32 {
+        Float32,
+        Float16
+    };
+
+    /* Embedding matrix file format
+     *
+     * 8 bytes                : EmbeddingMatrixMagic (with terminating zero)
+     * ui32                   : version
+     * ui32                   : precision (EEmbeddingPrecision)
+     * ui32                   : dim
+     * ui32                   : row stride (in elements)
+     * ui32                   : token count (max token id + 1)
+     * ui32                   : row count
+     * ui32[tokenCount]       : row index by token id (Max<ui32>() for tokens without embedding)
+     * padding                : rows start is aligned to EmbeddingMatrixAlignment bytes
+     * float[rowCount][stride]: rows, or ui16 (float16) if precision is Float16
+     *
+     * data is little-endian and used directly from mapped memory
+     */
+
+    constexpr char EmbeddingMatrixMagic[] = "CBEMBED";
+    constexpr ui32 EmbeddingMatrixVersion = 1;
+    constexpr ui32 EmbeddingMatrixAlignment = 32;
+
+    /* Embedding vectors stored in a single contiguous matrix, rows are addressed by token id
+     * with a flat index, so a text is pooled with one indexed load and one SIMD add per token.
+     */
+    class TEmbeddingMatrix final : public IEmbedding {
+    public:
+        explicit TEmbeddingMatrix(TBlob data);
+
+        ui64 Dim() const override {
+            return EmbeddingDim;
+        }
 
+        EEmbeddingPrecision GetPrecision() const {
+            return Precision;
+        }
 
+        void Apply(const TTextDataSet& ds, TVector<TVector<float>>* dst, NPar::TLocalExecutor* executor) const override;
+
+        void Apply(const TText& text, TVector<float>* dst) const override;
+
+        void Save(IOutputStream* output) const;
+
+    private:
+        // rowBuffer is used for float16 rows conversion, it must have at least Dim() elements
+        void Apply(const TText& text, TArrayRef<float> rowBuffer, TVector<float>* dst) const;
+
+    private:
+        TBlob Data;
+        EEmbeddingPrecision Precision = EEmbeddingPrecision::Float32;
+        ui32 EmbeddingDim = 0;
+        ui32 RowStride = 0;
+        TConstArrayRef<ui32> RowByToken;
+        const void* Rows = nullptr;
+    };
+
+    TEmbeddingPtr CreateEmbedding(
+        TDenseHash<TTokenId, TVector<float>>&& hash,
+        EEmbeddingPrecision precision = EEmbeddingPrecision::Float32
+    );
+
+    // the file is mapped, not read
+    TEmbeddingPtr LoadEmbeddingMatrix(const TString& path);
+
+    void SaveEmbeddingMatrix(const TEmbeddingMatrix& embedding, const TString& path);
+}
@@ -17,7 +17,8 @@ namespace NCB {
     }
 
     TEmbeddingPtr LoadEmbedding(const TString& path,
-                                const TDictionaryProxy& dictionary) {
+                                const TDictionaryProxy& dictionary,
+                                EEmbeddingPrecision precision) {
         const auto delim = '\t';
 
         TDenseHash<TTokenId, TVector<float>> embeddings;
@@ -45,6 +46,6 @@ namespace NCB {
         }
         Cout << embeddingDim << " " << lineIdx << Endl;
 
-        return CreateEmbedding(std::move(embeddings));
+        return CreateEmbedding(std::move(embeddings), precision);
     }
 }
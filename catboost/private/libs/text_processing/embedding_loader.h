@@ -5,6 +5,10 @@
 
 namespace NCB {
 
-    TEmbeddingPtr LoadEmbedding(const TString& path, const TDictionaryProxy& dictionary);
+    TEmbeddingPtr LoadEmbedding(
+        const TString& path,
+        const TDictionaryProxy& dictionary,
+        EEmbeddingPrecision precision = EEmbeddingPrecision::Float32
+    );
 
 }
@@ -60,26 +60,41 @@ namespace NCB {
             TDigitizedTextWriter&& digitizedTextWriter,
             NPar::TLocalExecutor* localExecutor
         ) const {
-            TVector<std::pair<ui32, ui32>> sourceToDestinationPairs;
             for (const auto& [sourceTextIdx, digitizedSetIndices]: SourceToDestinationIndexes) {
                 const auto sourceText = sourceTextAccessor(sourceTextIdx);
 
                 for (ui32 digitizedTextIdx: digitizedSetIndices) {
-                    const auto& dictionary = Dictionaries.at(digitizedTextIdx);
-
-                    TTextColumnBuilder textColumnBuilder(Tokenizer, dictionary, sourceText.Size());
-                    sourceText.ForEach(
-                        [&](ui32 index, TStringBuf phrase) {
-                            textColumnBuilder.AddText(index, phrase);
-                        },
-                        localExecutor
-                    );
+                    digitizedTextWriter(digitizedTextIdx, Digitize(sourceText, digitizedTextIdx, localExecutor));
+                }
+            }
+        }
 
-                    digitizedTextWriter(digitizedTextIdx, textColumnBuilder.Build());
+        // f args are (sourceTextIdx, digitizedTextIdx, dictionary)
+        template <class F>
+        void ForEachDigitizedText(F&& f) const {
+            for (const auto& [sourceTextIdx, digitizedSetIndices]: SourceToDestinationIndexes) {
+                for (ui32 digitizedTextIdx: digitizedSetIndices) {
+                    f(sourceTextIdx, digitizedTextIdx, Dictionaries.at(digitizedTextIdx));
                 }
             }
         }
 
+        template <class TSourceText>
+        TVector<TText> Digitize(
+            const TSourceText& sourceText,
+            ui32 digitizedTextIdx,
+            NPar::TLocalExecutor* localExecutor
+        ) const {
+            TTextColumnBuilder textColumnBuilder(Tokenizer, Dictionaries.at(digitizedTextIdx), sourceText.Size());
+            sourceText.ForEach(
+                [&](ui32 index, TStringBuf phrase) {
+                    textColumnBuilder.AddText(index, phrase);
+                },
+                localExecutor
+            );
+            return textColumnBuilder.Build();
+        }
+
         TVector<TDictionaryPtr> GetDictionaries() {
             TVector<TDictionaryPtr> dictionaries;
             dictionaries.resize(Dictionaries.size());
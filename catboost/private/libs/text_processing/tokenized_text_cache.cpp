@@ -0,0 +1,249 @@
+#include "tokenized_text_cache.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/logging/logging.h>
+
+#include <library/json/json_value.h>
+#include <library/json/json_writer.h>
+
+#include <util/digest/city.h>
+#include <util/digest/multi.h>
+#include <util/folder/path.h>
+#include <util/generic/cast.h>
+#include <util/generic/guid.h>
+#include <util/generic/xrange.h>
+#include <util/stream/file.h>
+#include <util/stream/mem.h>
+#include <util/string/builder.h>
+#include <util/string/hex.h>
+#include <util/system/fs.h>
+
+
+namespace NCB {
+
+    static constexpr size_t TokenizedTextColumnPrefixSize
+        = sizeof(TokenizedTextColumnMagic) + 2 * sizeof(ui32) + 2 * sizeof(ui64);
+
+    /* write to a uniquely named temporary file first so that interrupted or concurrent writes
+     * of the same entry don't leave broken data in the cache
+     */
+    template <class TWriteFunc>
+    static void WriteFileAtomically(const TString& path, TWriteFunc&& writeFunc) {
+        const TString tmpPath = TString::Join(path, ".", CreateGuidAsString(), ".tmp");
+        try {
+            TOFStream output(tmpPath);
+            writeFunc(&output);
+            output.Finish();
+        } catch (...) {
+            NFs::Remove(tmpPath);
+            throw;
+        }
+        CB_ENSURE(NFs::Rename(tmpPath, path), "Failed to rename " << tmpPath << " to " << path);
+    }
+
+    TTokenizedTextColumnView::TTokenizedTextColumnView(TBlob data)
+        : Data(std::move(data))
+    {
+        CB_ENSURE(
+            Data.Size() >= TokenizedTextColumnPrefixSize
+                && TStringBuf(Data.AsCharPtr(), sizeof(TokenizedTextColumnMagic))
+                    == TStringBuf(TokenizedTextColumnMagic, sizeof(TokenizedTextColumnMagic)),
+            "Data is not a tokenized text column"
+        );
+        TMemoryInput prefix(
+            Data.AsCharPtr() + sizeof(TokenizedTextColumnMagic),
+            TokenizedTextColumnPrefixSize - sizeof(TokenizedTextColumnMagic)
+        );
+        ui32 version;
+        ::Load(&prefix, version);
+        CB_ENSURE(
+            version == TokenizedTextColumnVersion,
+            "Unsupported tokenized text column version " << version
+        );
+        ui32 reserved;
+        ::Load(&prefix, reserved);
+        ui64 objectCount;
+        ::Load(&prefix, objectCount);
+        ui64 entryCount;
+        ::Load(&prefix, entryCount);
+
+        const ui64 offsetsSize = (objectCount + 1) * sizeof(ui64);
+        CB_ENSURE(
+            Data.Size() == TokenizedTextColumnPrefixSize + offsetsSize + 2 * entryCount * sizeof(ui32),
+            "Tokenized text column data has wrong size"
+        );
+
+        const char* dataPtr = Data.AsCharPtr() + TokenizedTextColumnPrefixSize;
+        Offsets = TConstArrayRef<ui64>(reinterpret_cast<const ui64*>(dataPtr), objectCount + 1);
+        dataPtr += offsetsSize;
+        TokenIds = TConstArrayRef<ui32>(reinterpret_cast<const ui32*>(dataPtr), entryCount);
+        dataPtr += entryCount * sizeof(ui32);
+        TokenCounts = TConstArrayRef<ui32>(reinterpret_cast<const ui32*>(dataPtr), entryCount);
+
+        CB_ENSURE(
+            Offsets.front() == 0 && Offsets.back() == entryCount,
+            "Tokenized text column has inconsistent offsets"
+        );
+    }
+
+    TText TTokenizedTextColumnView::GetText(ui32 objectIdx) const {
+        TText text;
+        for (auto entryIdx : xrange(Offsets[objectIdx], Offsets[objectIdx + 1])) {
+            text[TTokenId(TokenIds[entryIdx])] = TokenCounts[entryIdx];
+        }
+        return text;
+    }
+
+    TVector<TText> TTokenizedTextColumnView::ToTexts(NPar::TLocalExecutor* localExecutor) const {
+        TVector<TText> texts(GetObjectCount());
+        NPar::ParallelFor(
+            *localExecutor,
+            0,
+            GetObjectCount(),
+            [&] (ui32 objectIdx) {
+                texts[objectIdx] = GetText(objectIdx);
+            }
+        );
+        return texts;
+    }
+
+
+    void SaveTokenizedTextColumn(
+        TConstArrayRef<TText> texts,
+        const TString& path,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        const ui64 objectCount = texts.size();
+
+        TVector<ui64> offsets(objectCount + 1, 0);
+        for (auto objectIdx : xrange(objectCount)) {
+            offsets[objectIdx + 1] = offsets[objectIdx] + texts[objectIdx].Size();
+        }
+        const ui64 entryCount = offsets.back();
+
+        TVector<ui32> tokenIds;
+        tokenIds.yresize(entryCount);
+        TVector<ui32> tokenCounts;
+        tokenCounts.yresize(entryCount);
+        NPar::ParallelFor(
+            *localExecutor,
+            0,
+            SafeIntegerCast<ui32>(objectCount),
+            [&] (ui32 objectIdx) {
+                ui64 entryIdx = offsets[objectIdx];
+                for (const auto& [tokenId, count] : texts[objectIdx]) {
+                    tokenIds[entryIdx] = tokenId;
+                    tokenCounts[entryIdx] = count;
+                    ++entryIdx;
+                }
+            }
+        );
+
+        WriteFileAtomically(
+            path,
+            [&] (IOutputStream* output) {
+                output->Write(TokenizedTextColumnMagic, sizeof(TokenizedTextColumnMagic));
+                ::Save(output, TokenizedTextColumnVersion);
+                ::Save(output, ui32(0));
+                ::Save(output, objectCount);
+                ::Save(output, entryCount);
+                output->Write(offsets.data(), offsets.size() * sizeof(ui64));
+                output->Write(tokenIds.data(), tokenIds.size() * sizeof(ui32));
+                output->Write(tokenCounts.data(), tokenCounts.size() * sizeof(ui32));
+            }
+        );
+    }
+
+
+    TTokenizedTextCache::TTokenizedTextCache(const TString& dir)
+        : Dir(dir)
+    {
+        TFsPath(Dir).MkDirs();
+    }
+
+    ui64 TTokenizedTextCache::CalcTextDataHash(
+        const ITypedArraySubset<TString>& textData,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        TVector<ui64> hashes;
+        hashes.yresize(textData.GetSize());
+        textData.ParallelForEach(
+            [&] (ui32 idx, const TString& text) {
+                hashes[idx] = CityHash64(text);
+            },
+            localExecutor
+        );
+        return CityHash64(reinterpret_cast<const char*>(hashes.data()), hashes.size() * sizeof(ui64));
+    }
+
+    TDictionaryPtr TTokenizedTextCache::LoadDictionary(
+        ui64 textDataHash,
+        const NCatboostOptions::TTextColumnDictionaryOptions& dictionaryOptions
+    ) const {
+        const TString path = GetDictionaryPath(textDataHash, dictionaryOptions);
+        if (!NFs::Exists(path)) {
+            return nullptr;
+        }
+        CATBOOST_DEBUG_LOG << "Load dictionary from " << path << Endl;
+        TIFStream input(path);
+        auto dictionary = MakeIntrusive<TDictionaryProxy>();
+        dictionary->Load(&input);
+        return dictionary;
+    }
+
+    void TTokenizedTextCache::SaveDictionary(
+        ui64 textDataHash,
+        const NCatboostOptions::TTextColumnDictionaryOptions& dictionaryOptions,
+        const TDictionaryProxy& dictionary
+    ) const {
+        WriteFileAtomically(
+            GetDictionaryPath(textDataHash, dictionaryOptions),
+            [&] (IOutputStream* output) {
+                dictionary.Save(output);
+            }
+        );
+    }
+
+    TMaybe<TTokenizedTextColumnView> TTokenizedTextCache::LoadTokenizedColumn(
+        ui64 textDataHash,
+        const TGuid& dictionaryId
+    ) const {
+        const TString path = GetTokenizedColumnPath(textDataHash, dictionaryId);
+        if (!NFs::Exists(path)) {
+            return Nothing();
+        }
+        CATBOOST_DEBUG_LOG << "Load tokenized text column from " << path << Endl;
+        return TTokenizedTextColumnView(TBlob::FromFile(path));
+    }
+
+    void TTokenizedTextCache::SaveTokenizedColumn(
+        ui64 textDataHash,
+        const TGuid& dictionaryId,
+        TConstArrayRef<TText> texts,
+        NPar::TLocalExecutor* localExecutor
+    ) const {
+        SaveTokenizedTextColumn(texts, GetTokenizedColumnPath(textDataHash, dictionaryId), localExecutor);
+    }
+
+    TString TTokenizedTextCache::GetDictionaryPath(
+        ui64 textDataHash,
+        const NCatboostOptions::TTextColumnDictionaryOptions& dictionaryOptions
+    ) const {
+        // DictionaryId is just a name, it does not affect the dictionary content
+        NJson::TJsonValue optionsJson;
+        dictionaryOptions.Save(&optionsJson);
+        optionsJson.EraseValue("dictionary_id");
+
+        const ui64 key = MultiHash(textDataHash, CityHash64(NJson::WriteJson(optionsJson, false, true)));
+        return JoinFsPaths(Dir, TStringBuilder() << "dictionary_" << HexEncode(&key, sizeof(key)) << ".bin");
+    }
+
+    TString TTokenizedTextCache::GetTokenizedColumnPath(ui64 textDataHash, const TGuid& dictionaryId) const {
+        return JoinFsPaths(
+            Dir,
+            TStringBuilder() << "tokenized_" << HexEncode(&textDataHash, sizeof(textDataHash))
+                << '_' << dictionaryId << ".bin"
+        );
+    }
+
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "dictionary.h"
+
+#include <catboost/libs/helpers/guid.h>
+#include <catboost/libs/helpers/polymorphic_type_containers.h>
+#include <catboost/private/libs/data_types/text.h>
+#include <catboost/private/libs/options/text_processing_options.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/maybe.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/memory/blob.h>
+#include <util/system/types.h>
+
+
+namespace NCB {
+
+    /* Tokenized text column file format
+     *
+     * 8 bytes                : TokenizedTextColumnMagic (with terminating zero)
+     * ui32                   : version
+     * ui32                   : reserved
+     * ui64                   : object count
+     * ui64                   : entry count (sum of distinct tokens count over all objects)
+     * ui64[objectCount + 1]  : offsets of objects' entries
+     * ui32[entryCount]       : token ids
+     * ui32[entryCount]       : token counts
+     *
+     * data is little-endian and arrays are naturally aligned, so they are used directly from mapped memory
+     */
+
+    constexpr char TokenizedTextColumnMagic[] = "CBTOKTX";
+    constexpr ui32 TokenizedTextColumnVersion = 1;
+
+    class TTokenizedTextColumnView {
+    public:
+        explicit TTokenizedTextColumnView(TBlob data);
+
+        ui32 GetObjectCount() const {
+            return Offsets.size() - 1;
+        }
+
+        TText GetText(ui32 objectIdx) const;
+
+        TVector<TText> ToTexts(NPar::TLocalExecutor* localExecutor) const;
+
+    private:
+        TBlob Data;
+        TConstArrayRef<ui64> Offsets;
+        TConstArrayRef<ui32> TokenIds;
+        TConstArrayRef<ui32> TokenCounts;
+    };
+
+    void SaveTokenizedTextColumn(
+        TConstArrayRef<TText> texts,
+        const TString& path,
+        NPar::TLocalExecutor* localExecutor
+    );
+
+
+    /* Dictionaries and tokenized text columns saved in a directory to be reused in the following runs.
+     * Dictionary is identified by the source text data and dictionary options,
+     * tokenized column by the source text data and the dictionary Id (that is preserved by serialization),
+     * so tokenized eval sets are reused as long as the learn data dictionary is loaded from the cache.
+     */
+    class TTokenizedTextCache {
+    public:
+        explicit TTokenizedTextCache(const TString& dir);
+
+        static ui64 CalcTextDataHash(
+            const ITypedArraySubset<TString>& textData,
+            NPar::TLocalExecutor* localExecutor
+        );
+
+        // returns nullptr if there's no cached dictionary
+        TDictionaryPtr LoadDictionary(
+            ui64 textDataHash,
+            const NCatboostOptions::TTextColumnDictionaryOptions& dictionaryOptions
+        ) const;
+        void SaveDictionary(
+            ui64 textDataHash,
+            const NCatboostOptions::TTextColumnDictionaryOptions& dictionaryOptions,
+            const TDictionaryProxy& dictionary
+        ) const;
+
+        TMaybe<TTokenizedTextColumnView> LoadTokenizedColumn(ui64 textDataHash, const TGuid& dictionaryId) const;
+        void SaveTokenizedColumn(
+            ui64 textDataHash,
+            const TGuid& dictionaryId,
+            TConstArrayRef<TText> texts,
+            NPar::TLocalExecutor* localExecutor
+        ) const;
+
+    private:
+        TString GetDictionaryPath(
+            ui64 textDataHash,
+            const NCatboostOptions::TTextColumnDictionaryOptions& dictionaryOptions
+        ) const;
+        TString GetTokenizedColumnPath(ui64 textDataHash, const TGuid& dictionaryId) const;
+
+    private:
+        TString Dir;
+    };
+
+}
@@ -1,5 +1,6 @@
 #include "tokenizer.h"
 #include <catboost/libs/helpers/exception.h>
+#include <util/generic/cast.h>
 #include <util/generic/string.h>
 #include <util/string/split.h>
 
@@ -26,7 +27,7 @@ NCB::TTokenizerPtr NCB::CreateTokenizer(ETokenizerType tokenizerType) {
     }
 }
 
-TVector<TVector<TStringBuf>> Tokenize(TConstArrayRef<TStringBuf> textFeature, const TTokenizerPtr& tokenizer) {
+TVector<TVector<TStringBuf>> NCB::Tokenize(TConstArrayRef<TStringBuf> textFeature, const TTokenizerPtr& tokenizer) {
     TVector<TVector<TStringBuf>> tokens;
     tokens.yresize(textFeature.size());
 
@@ -36,3 +37,22 @@ TVector<TVector<TStringBuf>> Tokenize(TConstArrayRef<TStringBuf> textFeature, co
 
     return tokens;
 }
+
+TVector<TVector<TStringBuf>> NCB::Tokenize(
+    TConstArrayRef<TStringBuf> textFeature,
+    const TTokenizerPtr& tokenizer,
+    NPar::TLocalExecutor* localExecutor
+) {
+    TVector<TVector<TStringBuf>> tokens(textFeature.size());
+
+    NPar::ParallelFor(
+        *localExecutor,
+        0,
+        SafeIntegerCast<ui32>(textFeature.size()),
+        [&] (ui32 i) {
+            tokenizer->Tokenize(textFeature[i], &tokens[i]);
+        }
+    );
+
+    return tokens;
+}
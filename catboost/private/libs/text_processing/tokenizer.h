@@ -1,6 +1,9 @@
 #pragma once
 
 #include <catboost/private/libs/options/enums.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
 #include <util/generic/array_ref.h>
 #include <util/generic/fwd.h>
 #include <util/generic/maybe.h>
@@ -14,12 +17,18 @@ namespace NCB {
     //TODO(noxoomo, nikitxskv): move to library after text-processing tokenizer will be available
     class ITokenizer : public TThrRefBase {
     public:
+        // must be thread-safe
         virtual void Tokenize(TStringBuf inputString, TVector<TStringBuf>* tokens) const = 0;
     };
 
     using TTokenizerPtr = TIntrusivePtr<ITokenizer>;
 
     TVector<TVector<TStringBuf>> Tokenize(TConstArrayRef<TStringBuf> textFeature, const TTokenizerPtr& tokenizer);
+    TVector<TVector<TStringBuf>> Tokenize(
+        TConstArrayRef<TStringBuf> textFeature,
+        const TTokenizerPtr& tokenizer,
+        NPar::TLocalExecutor* localExecutor
+    );
 
     TTokenizerPtr CreateTokenizer(ETokenizerType tokenizerType = ETokenizerType::Naive);
 }
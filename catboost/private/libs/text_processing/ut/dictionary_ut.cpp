@@ -2,6 +2,9 @@
 
 #include <library/unittest/registar.h>
 
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
 Y_UNIT_TEST_SUITE(TestDictionary) {
     Y_UNIT_TEST(TestBasicProperties) {
         using namespace NCB;
@@ -44,4 +47,57 @@ Y_UNIT_TEST_SUITE(TestDictionary) {
         UNIT_ASSERT_EQUAL(1, topTokens[1]);
         UNIT_ASSERT_EQUAL(2, topTokens[2]);
     }
+
+    Y_UNIT_TEST(TestParallelCreateDictionaryIsSameAsSequential) {
+        using namespace NCB;
+        using namespace NCatboostOptions;
+        using namespace NTextProcessing::NDictionary;
+
+        TReallyFastRng32 rng(0);
+        TVector<TString> texts;
+        for (auto textIdx : xrange(500)) {
+            Y_UNUSED(textIdx);
+            TString text;
+            const ui32 wordCount = rng.Uniform(6); // some texts are empty
+            for (auto wordIdx : xrange(wordCount)) {
+                Y_UNUSED(wordIdx);
+                text += TString(1 + rng.Uniform(3), 'a' + rng.Uniform(5)) + " ";
+            }
+            texts.push_back(text);
+        }
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+        TTokenizerPtr tokenizer = CreateTokenizer();
+
+        auto createOptions = [] (ETokenLevelType tokenLevelType, ui32 gramOrder, ui32 skipStep, bool insertEndOfSentence) {
+            NTextProcessing::NDictionary::TDictionaryOptions dictionaryOptions;
+            dictionaryOptions.TokenLevelType = tokenLevelType;
+            dictionaryOptions.GramOrder = gramOrder;
+            dictionaryOptions.SkipStep = skipStep;
+            if (insertEndOfSentence) {
+                dictionaryOptions.EndOfSentenceTokenPolicy = EEndOfSentenceTokenPolicy::Insert;
+            }
+            return TTextColumnDictionaryOptions("dictionary", dictionaryOptions, TDictionaryBuilderOptions{1, 30});
+        };
+
+        const TVector<TTextColumnDictionaryOptions> allOptions = {
+            createOptions(ETokenLevelType::Word, 1, 0, false),
+            createOptions(ETokenLevelType::Word, 2, 0, false),
+            createOptions(ETokenLevelType::Word, 2, 1, true),
+            createOptions(ETokenLevelType::Word, 3, 0, true),
+            createOptions(ETokenLevelType::Letter, 3, 0, false)
+        };
+        for (const auto& options : allOptions) {
+            auto dictionary = CreateDictionary(TIterableTextFeature(texts), options, tokenizer);
+            auto parallelDictionary = CreateDictionary(TIterableTextFeature(texts), options, tokenizer, &localExecutor);
+
+            UNIT_ASSERT_VALUES_EQUAL(parallelDictionary->Size(), dictionary->Size());
+            TVector<TStringBuf> tokens;
+            for (const auto& text : texts) {
+                tokenizer->Tokenize(text, &tokens);
+                UNIT_ASSERT_VALUES_EQUAL(parallelDictionary->Apply(tokens), dictionary->Apply(tokens));
+            }
+        }
+    }
 }
@@ -0,0 +1,105 @@
+#include <catboost/private/libs/text_processing/embedding.h>
+
+#include <library/threading/local_executor/local_executor.h>
+#include <library/unittest/registar.h>
+
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+
+using namespace NCB;
+
+Y_UNIT_TEST_SUITE(TestEmbeddingMatrix) {
+    TDenseHash<TTokenId, TVector<float>> GenerateEmbedding(ui32 tokenCount, ui32 dim, TFastRng64* rng) {
+        TDenseHash<TTokenId, TVector<float>> embedding;
+        // every third token has no embedding
+        for (ui32 tokenId : xrange(tokenCount)) {
+            if (tokenId % 3 == 1) {
+                continue;
+            }
+            TVector<float> vector;
+            for (ui32 i : xrange(dim)) {
+                Y_UNUSED(i);
+                vector.push_back(rng->GenRandReal1() * 2 - 1);
+            }
+            embedding[TTokenId(tokenId)] = std::move(vector);
+        }
+        return embedding;
+    }
+
+    TVector<TText> GenerateTexts(ui32 textCount, ui32 tokenCount, TFastRng64* rng) {
+        TVector<TText> texts(textCount);
+        for (auto& text : texts) {
+            const ui32 length = rng->Uniform(20);
+            for (ui32 i : xrange(length)) {
+                Y_UNUSED(i);
+                // some tokens are out of the embedding range
+                ++text[TTokenId(rng->Uniform(tokenCount + 10))];
+            }
+        }
+        return texts;
+    }
+
+    TVector<float> CalcMeanEmbedding(const TDenseHash<TTokenId, TVector<float>>& embedding, ui32 dim, const TText& text) {
+        TVector<float> result(dim, 0.0f);
+        double count = 0.5;
+        for (const auto& [token, tokenCount] : text) {
+            Y_UNUSED(tokenCount);
+            auto it = embedding.find(token);
+            if (it != embedding.end()) {
+                for (ui32 i : xrange(dim)) {
+                    result[i] += it->second[i];
+                }
+                ++count;
+            }
+        }
+        for (auto& value : result) {
+            value /= count;
+        }
+        return result;
+    }
+
+    void CheckEmbeddingApply(EEmbeddingPrecision precision, double epsilon) {
+        TFastRng64 rng(0);
+        const ui32 tokenCount = 500;
+        const ui32 dim = 37;
+        auto embedding = GenerateEmbedding(tokenCount, dim, &rng);
+        const auto texts = GenerateTexts(100, tokenCount, &rng);
+
+        TEmbeddingPtr embeddingMatrix = CreateEmbedding(TDenseHash<TTokenId, TVector<float>>(embedding), precision);
+        UNIT_ASSERT_VALUES_EQUAL(embeddingMatrix->Dim(), dim);
+
+        const TString path = "embedding_matrix.bin";
+        SaveEmbeddingMatrix(dynamic_cast<const TEmbeddingMatrix&>(*embeddingMatrix), path);
+        TEmbeddingPtr mappedEmbeddingMatrix = LoadEmbeddingMatrix(path);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+        TVector<TVector<float>> batchResult;
+        mappedEmbeddingMatrix->Apply(
+            TTextDataSet(TTextColumn::CreateOwning(TVector<TText>(texts)), nullptr),
+            &batchResult,
+            &localExecutor
+        );
+        UNIT_ASSERT_VALUES_EQUAL(batchResult.size(), texts.size());
+
+        TVector<float> result;
+        for (auto textIdx : xrange(texts.size())) {
+            const auto expected = CalcMeanEmbedding(embedding, dim, texts[textIdx]);
+            embeddingMatrix->Apply(texts[textIdx], &result);
+            UNIT_ASSERT_VALUES_EQUAL(result.size(), dim);
+            UNIT_ASSERT_VALUES_EQUAL(batchResult[textIdx], result);
+            for (ui32 i : xrange(dim)) {
+                UNIT_ASSERT_DOUBLES_EQUAL(expected[i], result[i], epsilon);
+            }
+        }
+    }
+
+    Y_UNIT_TEST(TestFloat32IsSameAsScalarMean) {
+        CheckEmbeddingApply(EEmbeddingPrecision::Float32, 0.0);
+    }
+
+    Y_UNIT_TEST(TestFloat16) {
+        CheckEmbeddingApply(EEmbeddingPrecision::Float16, 1e-3);
+    }
+}
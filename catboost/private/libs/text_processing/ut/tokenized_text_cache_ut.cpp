@@ -0,0 +1,80 @@
+#include <catboost/private/libs/text_processing/text_column_builder.h>
+#include <catboost/private/libs/text_processing/tokenized_text_cache.h>
+
+#include <catboost/libs/helpers/array_subset.h>
+
+#include <library/unittest/registar.h>
+
+#include <util/folder/path.h>
+#include <util/folder/tempdir.h>
+#include <util/generic/xrange.h>
+
+
+using namespace NCB;
+
+Y_UNIT_TEST_SUITE(TestTokenizedTextCache) {
+    Y_UNIT_TEST(TestCache) {
+        TTempDir tempDir;
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(2);
+
+        TVector<TString> texts = {"a b a", "", "c d e", "b b b b", "e a"};
+        const ui32 objectCount = texts.size();
+        const TArraySubsetIndexing<ui32> fullSubset(TFullSubset<ui32>{objectCount});
+        const TTypeCastArraySubset<TString, TString> textData(
+            TMaybeOwningConstArrayHolder<TString>::CreateNonOwning(texts),
+            &fullSubset
+        );
+
+        const NCatboostOptions::TTextColumnDictionaryOptions dictionaryOptions(
+            "dictionary",
+            NTextProcessing::NDictionary::TDictionaryOptions(),
+            NCatboostOptions::TDictionaryBuilderOptions{1, -1}
+        );
+        const TTokenizerPtr tokenizer = CreateTokenizer();
+
+        TTokenizedTextCache cache(tempDir());
+        const ui64 textDataHash = TTokenizedTextCache::CalcTextDataHash(textData, &localExecutor);
+        UNIT_ASSERT(!cache.LoadDictionary(textDataHash, dictionaryOptions));
+
+        TDictionaryPtr dictionary = CreateDictionary(TIterableTextFeature(texts), dictionaryOptions, tokenizer);
+        cache.SaveDictionary(textDataHash, dictionaryOptions, *dictionary);
+
+        TDictionaryPtr loadedDictionary = cache.LoadDictionary(textDataHash, dictionaryOptions);
+        UNIT_ASSERT(loadedDictionary);
+        UNIT_ASSERT_EQUAL(loadedDictionary->Id(), dictionary->Id());
+        UNIT_ASSERT_VALUES_EQUAL(loadedDictionary->Size(), dictionary->Size());
+
+        TTextColumnBuilder textColumnBuilder(tokenizer, dictionary, objectCount);
+        for (auto i : xrange(objectCount)) {
+            textColumnBuilder.AddText(i, texts[i]);
+        }
+        const TVector<TText> tokenizedTexts = textColumnBuilder.Build();
+
+        UNIT_ASSERT(!cache.LoadTokenizedColumn(textDataHash, dictionary->Id()));
+        cache.SaveTokenizedColumn(textDataHash, dictionary->Id(), tokenizedTexts, &localExecutor);
+
+        const auto loadedColumn = cache.LoadTokenizedColumn(textDataHash, loadedDictionary->Id());
+        UNIT_ASSERT(loadedColumn);
+        UNIT_ASSERT_VALUES_EQUAL(loadedColumn->GetObjectCount(), objectCount);
+        const TVector<TText> loadedTexts = loadedColumn->ToTexts(&localExecutor);
+        for (auto i : xrange(objectCount)) {
+            UNIT_ASSERT_VALUES_EQUAL(loadedTexts[i], tokenizedTexts[i]);
+        }
+
+        // temporary files are renamed to cache entries
+        TVector<TString> cacheFiles;
+        TFsPath(tempDir()).ListNames(cacheFiles);
+        UNIT_ASSERT_VALUES_EQUAL(cacheFiles.size(), 2);
+        for (const auto& name : cacheFiles) {
+            UNIT_ASSERT(!name.EndsWith(".tmp"));
+        }
+
+        // other data is not found in the cache
+        texts[0] = "a b c";
+        const ui64 otherTextDataHash = TTokenizedTextCache::CalcTextDataHash(textData, &localExecutor);
+        UNIT_ASSERT_UNEQUAL(otherTextDataHash, textDataHash);
+        UNIT_ASSERT(!cache.LoadDictionary(otherTextDataHash, dictionaryOptions));
+        UNIT_ASSERT(!cache.LoadTokenizedColumn(otherTextDataHash, dictionary->Id()));
+    }
+}
@@ -7019,6 +7019,41 @@ def test_convert_model_to_json(pool):
     assert (compare_evals_with_precision(output_eval_path, formula_predict_path_json))
 
 
+
+@pytest.mark.parametrize('precision', ['Float32', 'Float16'])
+def test_model_leaf_values_precision(precision):
+    def fit_and_calc(leaf_values_precision_args):
+        output_model_path = yatest.common.test_output_path('model_' + str(len(leaf_values_precision_args)))
+        output_calc_path = yatest.common.test_output_path('calc_' + str(len(leaf_values_precision_args)) + '.eval')
+        cmd = (
+            CATBOOST_PATH,
+            'fit',
+            '--use-best-model', 'false',
+            '-f', data_file('adult', 'train_small'),
+            '--column-description', data_file('adult', 'train.cd'),
+            '-i', '20',
+            '-T', '4',
+            '-r', '0',
+            '-m', output_model_path,
+        ) + leaf_values_precision_args
+        yatest.common.execute(cmd)
+        calc_cmd = (
+            CATBOOST_PATH,
+            'calc',
+            '--input-path', data_file('adult', 'test_small'),
+            '--column-description', data_file('adult', 'train.cd'),
+            '-m', output_model_path,
+            '--output-path', output_calc_path
+        )
+        yatest.common.execute(calc_cmd)
+        return os.path.getsize(output_model_path), np.loadtxt(output_calc_path, delimiter='\t', skiprows=1, usecols=1)
+
+    model_size, prediction = fit_and_calc(())
+    reduced_model_size, reduced_prediction = fit_and_calc(('--model-leaf-values-precision', precision))
+    assert reduced_model_size < model_size
+    assert np.allclose(prediction, reduced_prediction, rtol=0, atol=1e-2 if precision == 'Float16' else 1e-5)
+
+
 LOSS_FUNCTIONS_NO_MAPE = ['RMSE', 'Logloss', 'MAE', 'CrossEntropy', 'Quantile', 'LogLinQuantile', 'Poisson']
 
 
@@ -7051,6 +7086,45 @@ def test_quantized_adult_pool(loss_function, boosting_type):
     return [local_canonical_file(output_eval_path, diff_tool=diff_tool())]
 
 
+@pytest.mark.parametrize('chunk_codec', ['None', 'Lz4', 'Zstd'])
+def test_convert_quantized_pool_to_compressed(chunk_codec):
+    quantized_train_file = data_file('quantized_adult', 'train.qbin')
+    compressed_train_file = yatest.common.test_output_path('train_compressed.qbin')
+    yatest.common.execute((
+        CATBOOST_PATH, 'convert-pool',
+        '-f', 'quantized://' + quantized_train_file,
+        '-o', compressed_train_file,
+        '--quantized-chunk-codec', chunk_codec,
+        '--quantized-pack-bits',
+        '-T', '4',
+    ))
+    if chunk_codec != 'None':
+        assert os.path.getsize(compressed_train_file) < os.path.getsize(quantized_train_file)
+
+    def fit_and_apply(train_file):
+        output_model_path = yatest.common.test_output_path('model.bin')
+        output_eval_path = yatest.common.test_output_path('test.eval')
+        yatest.common.execute((
+            CATBOOST_PATH, 'fit',
+            '--use-best-model', 'false',
+            '--loss-function', 'Logloss',
+            '-f', 'quantized://' + train_file,
+            '-i', '10',
+            '-w', '0.03',
+            '-T', '4',
+            '-m', output_model_path,
+        ))
+        apply_catboost(
+            output_model_path,
+            data_file('quantized_adult', 'test_small.tsv'),
+            data_file('quantized_adult', 'pool.cd'),
+            output_eval_path
+        )
+        return np.loadtxt(output_eval_path, delimiter='\t', skiprows=1)
+
+    assert np.array_equal(fit_and_apply(quantized_train_file), fit_and_apply(compressed_train_file))
+
+
 @pytest.mark.parametrize('boosting_type', BOOSTING_TYPE)
 def test_quantized_with_one_thread(boosting_type):
     output_model_path = yatest.common.test_output_path('model.bin')
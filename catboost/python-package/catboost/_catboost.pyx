@@ -576,7 +576,18 @@ cdef extern from "catboost/libs/data/data_provider.h" namespace "NCB":
 
 
 cdef extern from "catboost/private/libs/quantized_pool/serialization.h" namespace "NCB":
-    cdef void SaveQuantizedPool(const TDataProviderPtr& dataProvider, TString fileName) except +ProcessException
+    cdef cppclass EQuantizedPoolChunkCodec:
+        pass
+
+    cdef cppclass TSaveQuantizedPoolParameters:
+        EQuantizedPoolChunkCodec ChunkCodec
+        bool_t PackBits
+
+    cdef void SaveQuantizedPool(
+        const TDataProviderPtr& dataProvider,
+        TString fileName,
+        const TSaveQuantizedPoolParameters& params
+    ) except +ProcessException
 
 
 cdef extern from "catboost/private/libs/data_util/path_with_scheme.h" namespace "NCB":
@@ -741,6 +752,11 @@ cdef extern from "catboost/libs/model/ctr_provider.h":
         pass
 
 
+cdef extern from "catboost/libs/model/enums.h":
+    cdef cppclass ELeafValuesPrecision:
+        pass
+
+
 cdef extern from "catboost/libs/model/model.h":
     cdef cppclass TFeaturePosition:
         int Index
@@ -789,6 +805,7 @@ cdef extern from "catboost/libs/model/model.h":
         size_t GetDimensionsCount() nogil except +ProcessException
         void Truncate(size_t begin, size_t end) except +ProcessException
         bool_t IsOblivious() except +ProcessException
+        void SetLeafValuesPrecision(ELeafValuesPrecision precision) except +ProcessException
         TString GetLossFunctionName() except +ProcessException
         TVector[TString] GetModelClassNames() except +ProcessException
 
@@ -925,6 +942,7 @@ cdef extern from "catboost/private/libs/options/cross_validation_params.h":
         TMaybe[TVector[TVector[ui32]]] customTestSubsets
         double MaxTimeSpentOnFixedCostRatio
         ui32 DevMaxIterationsBatchSize
+        ui32 ParallelFoldCount
         bool_t IsCalledFromSearchHyperparameters
 
 cdef extern from "catboost/private/libs/options/split_params.h":
@@ -1275,6 +1293,10 @@ cdef extern from "catboost/private/libs/hyperparameter_tuning/hyperparameter_tun
         void* CustomData
         double (*EvalFunc)(void* customData) with gil
 
+    cdef cppclass THalvingSearchParams:
+        double ReductionFactor
+        ui32 MinIterations
+
     cdef cppclass TBestOptionValuesWithCvResult:
         TVector[TCVResult] CvResult
         THashMap[TString, bool_t] BoolOptions
@@ -1294,7 +1316,8 @@ cdef extern from "catboost/private/libs/hyperparameter_tuning/hyperparameter_tun
         TBestOptionValuesWithCvResult* results,
         bool_t isSearchUsingCV,
         bool_t isReturnCvResults,
-        int verbose) nogil except +ProcessException
+        int verbose,
+        const TMaybe[THalvingSearchParams]& halvingSearchParams) nogil except +ProcessException
 
     cdef void RandomizedSearch(
         ui32 numberOfTries,
@@ -1309,7 +1332,8 @@ cdef extern from "catboost/private/libs/hyperparameter_tuning/hyperparameter_tun
         TBestOptionValuesWithCvResult* results,
         bool_t isSearchUsingCV,
         bool_t isReturnCvResults,
-        int verbose) nogil except +ProcessException
+        int verbose,
+        const TMaybe[THalvingSearchParams]& halvingSearchParams) nogil except +ProcessException
 
 cdef inline float _FloatOrNan(object obj) except *:
     try:
@@ -1611,6 +1635,13 @@ cdef EModelType string_to_model_type(model_type_str) except *:
     return model_type
 
 
+cdef ELeafValuesPrecision string_to_leaf_values_precision(precision_str) except *:
+    cdef ELeafValuesPrecision precision
+    if not TryFromString[ELeafValuesPrecision](to_arcadia_string(precision_str), precision):
+        raise CatBoostError("Unknown leaf values precision {}.".format(precision_str))
+    return precision
+
+
 cdef EFstrType string_to_fstr_type(fstr_type_str) except *:
     cdef EFstrType fstr_type
     if not TryFromString[EFstrType](to_arcadia_string(fstr_type_str), fstr_type):
@@ -3332,9 +3363,14 @@ cdef class _PoolBase:
                 baseline
             )
 
-    cpdef _save(self, fname):
+    cpdef _save(self, fname, chunk_codec, pack_bits):
         cdef TString file_name = to_arcadia_string(fname)
-        SaveQuantizedPool(self.__pool, file_name)
+        cdef TSaveQuantizedPoolParameters params
+        if chunk_codec is not None:
+            if not TryFromString[EQuantizedPoolChunkCodec](to_arcadia_string(chunk_codec), params.ChunkCodec):
+                raise CatBoostError("Unknown chunk codec {}.".format(chunk_codec))
+        params.PackBits = pack_bits
+        SaveQuantizedPool(self.__pool, file_name, params)
 
 
     cpdef _set_pairs(self, pairs):
@@ -4010,9 +4046,16 @@ cdef class _CatBoost:
         tmp_model = ReadModel(to_arcadia_string(model_file), modelType)
         self.__model.Swap(tmp_model)
 
-    cpdef _save_model(self, output_file, format, export_parameters, _PoolBase pool):
+    cpdef _save_model(self, output_file, format, export_parameters, _PoolBase pool, leaf_values_precision):
         cdef EModelType modelType = string_to_model_type(format)
 
+        cdef TFullModel reduced_precision_model
+        cdef TFullModel* model = self.__model
+        if leaf_values_precision is not None:
+            reduced_precision_model = dereference(self.__model)
+            reduced_precision_model.SetLeafValuesPrecision(string_to_leaf_values_precision(leaf_values_precision))
+            model = &reduced_precision_model
+
         cdef TVector[TString] feature_id
         if pool:
             self._check_model_and_dataset_compatibility(pool)
@@ -4023,7 +4066,7 @@ cdef class _CatBoost:
             cat_features_hash_to_string = MergeCatFeaturesHashToString(pool.__pool.Get()[0].ObjectsData.Get()[0])
 
         ExportModel(
-            dereference(self.__model),
+            dereference(model),
             to_arcadia_string(output_file),
             modelType,
             to_arcadia_string(export_parameters),
@@ -4142,7 +4185,7 @@ cdef class _CatBoost:
     cpdef _tune_hyperparams(self, list grids_list, _PoolBase train_pool, dict params, int n_iter,
                           int fold_count, int partition_random_seed, bool_t shuffle, bool_t stratified,
                           double train_size, bool_t choose_by_train_test_split, bool_t return_cv_results,
-                          custom_folds, int verbose):
+                          custom_folds, int verbose, halving_factor=None):
 
         prep_params = _PreprocessParams(params)
         prep_grids = _PreprocessGrids(grids_list)
@@ -4171,6 +4214,12 @@ cdef class _CatBoost:
         ttParams.Stratified = False
         ttParams.TrainPart = train_size
 
+        cdef TMaybe[THalvingSearchParams] halvingParams
+        cdef THalvingSearchParams halvingParamsValue
+        if halving_factor is not None:
+            halvingParamsValue.ReductionFactor = halving_factor
+            halvingParams = halvingParamsValue
+
         cdef TBestOptionValuesWithCvResult results
         with nogil:
             SetPythonInterruptHandler()
@@ -4187,7 +4236,8 @@ cdef class _CatBoost:
                         &results,
                         choose_by_train_test_split,
                         return_cv_results,
-                        verbose
+                        verbose,
+                        halvingParams
                     )
                 else:
                     RandomizedSearch(
@@ -4203,7 +4253,8 @@ cdef class _CatBoost:
                         &results,
                         choose_by_train_test_split,
                         return_cv_results,
-                        verbose
+                        verbose,
+                        halvingParams
                     )
             finally:
                 ResetPythonInterruptHandler()
@@ -4466,7 +4517,7 @@ cdef TCustomTrainTestSubsets _make_train_test_subsets(_PoolBase pool, folds) exc
 
 
 cpdef _cv(dict params, _PoolBase pool, int fold_count, bool_t inverted, int partition_random_seed,
-          bool_t shuffle, bool_t stratified, bool_t as_pandas, folds, type):
+          bool_t shuffle, bool_t stratified, bool_t as_pandas, folds, type, int parallel_fold_count=1):
     prep_params = _PreprocessParams(params)
     cdef TCrossValidationParams cvParams
     cdef TVector[TCVResult] results
@@ -4475,6 +4526,7 @@ cpdef _cv(dict params, _PoolBase pool, int fold_count, bool_t inverted, int part
     cvParams.PartitionRandSeed = partition_random_seed
     cvParams.Shuffle = shuffle
     cvParams.Stratified = stratified
+    cvParams.ParallelFoldCount = parallel_fold_count
 
     if type == 'Classical':
         cvParams.Type = ECrossValidation_Classical
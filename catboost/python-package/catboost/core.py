@@ -639,7 +639,7 @@ class Pool(_PoolBase):
         self._set_pairs_weight(pairs_weight)
         return self
 
-    def save(self, fname):
+    def save(self, fname, chunk_codec=None, pack_bits=False):
         """
         Save the quantized pool to a file.
 
@@ -647,6 +647,15 @@ class Pool(_PoolBase):
         ----------
         fname : string
             Output file name.
+        chunk_codec : string, optional (default=None)
+            Compress pool chunks with a block codec.
+            Possible values:
+                * 'None'
+                * 'Lz4'
+                * 'Zstd'
+        pack_bits : bool, optional (default=False)
+            Store features with 1, 2 or 4 bits per object when all their values fit.
+        Pools saved with chunk_codec or pack_bits can't be read by older versions.
         """
         if not self.is_quantized():
             raise CatBoostError('Pool is not quantized')
@@ -654,7 +663,7 @@ class Pool(_PoolBase):
         if not isinstance(fname, STRING_TYPES):
             raise CatBoostError("Invalid fname type={}: must be str().".format(type(fname)))
 
-        self._save(fname)
+        self._save(fname, chunk_codec, pack_bits)
 
     def quantize(self, ignored_features=None, per_float_feature_quantization=None, border_count=None,
                  max_bin=None, feature_border_type=None, sparse_features_conflict_fraction=None, dev_efb_max_buckets=None,
@@ -1294,14 +1303,14 @@ class _CatBoostBase(object):
     def _base_drop_unused_features(self):
         self._object._base_drop_unused_features()
 
-    def _save_model(self, output_file, format, export_parameters, pool):
+    def _save_model(self, output_file, format, export_parameters, pool, leaf_values_precision=None):
         import json
         if self.is_fitted():
             params_string = ""
             if export_parameters:
                 params_string = json.dumps(export_parameters, cls=_NumpyAwareEncoder)
 
-            self._object._save_model(output_file, format, params_string, pool)
+            self._object._save_model(output_file, format, params_string, pool, leaf_values_precision)
 
     def _load_model(self, model_file, format):
         self._object._load_model(model_file, format)
@@ -2451,7 +2460,7 @@ class CatBoost(_CatBoostBase):
         """
         self._base_drop_unused_features()
 
-    def save_model(self, fname, format="cbm", export_parameters=None, pool=None):
+    def save_model(self, fname, format="cbm", export_parameters=None, pool=None, leaf_values_precision=None):
         """
         Save the model to a file.
 
@@ -2480,6 +2489,13 @@ class CatBoost(_CatBoostBase):
                 * pmml_model_version : string
         pool : catboost.Pool or list or numpy.array or pandas.DataFrame or pandas.Series or catboost.FeaturesData
             Training pool.
+        leaf_values_precision : string, optional (default=None)
+            Precision of leaf values in the saved model, the model itself is not changed.
+            Possible values:
+                * 'Double'
+                * 'Float32'
+                * 'Float16'
+            If None, the model precision is kept.
         """
         if not self.is_fitted():
             raise CatBoostError("There is no trained model to use save_model(). Use fit() to train model. Then use this method.")
@@ -2491,7 +2507,7 @@ class CatBoost(_CatBoostBase):
                 cat_features=self._get_cat_feature_indices() if not isinstance(pool, FeaturesData) else None,
                 text_features=self._get_text_feature_indices() if not isinstance(pool, FeaturesData) else None
             )
-        self._save_model(fname, format, export_parameters, pool)
+        self._save_model(fname, format, export_parameters, pool, leaf_values_precision)
 
     def load_model(self, fname, format='cbm'):
         """
@@ -2947,7 +2963,8 @@ class CatBoost(_CatBoostBase):
 
     def _tune_hyperparams(self, param_grid, X, y=None, cv=3, n_iter=10, partition_random_seed=0,
                           calc_cv_statistics=True, search_by_train_test_split=True,
-                          refit=True, shuffle=True, stratified=None, train_size=0.8, verbose=1, plot=False):
+                          refit=True, shuffle=True, stratified=None, train_size=0.8, verbose=1, plot=False,
+                          halving_factor=None):
 
         currently_not_supported_params = {
             'ignored_features',
@@ -3009,7 +3026,7 @@ class CatBoost(_CatBoostBase):
             cv_result = self._object._tune_hyperparams(
                 param_grid, train_params["train_pool"], params, n_iter,
                 fold_count, partition_random_seed, shuffle, stratified, train_size,
-                search_by_train_test_split, calc_cv_statistics, custom_folds, verbose
+                search_by_train_test_split, calc_cv_statistics, custom_folds, verbose, halving_factor
             )
 
         self.set_params(**cv_result['params'])
@@ -3019,7 +3036,8 @@ class CatBoost(_CatBoostBase):
 
     def grid_search(self, param_grid, X, y=None, cv=3, partition_random_seed=0,
                     calc_cv_statistics=True, search_by_train_test_split=True,
-                    refit=True, shuffle=True, stratified=None, train_size=0.8, verbose=True, plot=False):
+                    refit=True, shuffle=True, stratified=None, train_size=0.8, verbose=True, plot=False,
+                    halving_factor=None):
         """
         Exhaustive search over specified parameter values for a model.
         Aafter calling this method model is fitted and can be used, if not specified otherwise (refit=False).
@@ -3086,6 +3104,12 @@ class CatBoost(_CatBoostBase):
 
         plot : bool, optional (default=False)
             If True, draw train and eval error for every set of parameters in Jupyter notebook
+
+        halving_factor: float, optional (default=None)
+            If not None, successive halving is used: all parameter sets are trained with a small number
+            of iterations, only the best 1/halving_factor of them continue training in the next round
+            with halving_factor times more iterations, until the full iterations count is reached.
+            Should be greater than 1. Can be used only when search_by_train_test_split=True.
         Returns
         -------
         dict with two fields:
@@ -3106,12 +3130,14 @@ class CatBoost(_CatBoostBase):
             param_grid=param_grid, X=X, y=y, cv=cv, n_iter=-1,
             partition_random_seed=partition_random_seed, calc_cv_statistics=calc_cv_statistics,
             search_by_train_test_split=search_by_train_test_split, refit=refit, shuffle=shuffle,
-            stratified=stratified, train_size=train_size, verbose=verbose, plot=plot
+            stratified=stratified, train_size=train_size, verbose=verbose, plot=plot,
+            halving_factor=halving_factor
         )
 
     def randomized_search(self, param_distributions, X, y=None, cv=3, n_iter=10, partition_random_seed=0,
                           calc_cv_statistics=True, search_by_train_test_split=True, refit=True,
-                          shuffle=True, stratified=None, train_size=0.8, verbose=True, plot=False):
+                          shuffle=True, stratified=None, train_size=0.8, verbose=True, plot=False,
+                          halving_factor=None):
         """
         Randomized search on hyper parameters.
         After calling this method model is fitted and can be used, if not specified otherwise (refit=False).
@@ -3185,6 +3211,12 @@ class CatBoost(_CatBoostBase):
 
         plot : bool, optional (default=False)
             If True, draw train and eval error for every set of parameters in Jupyter notebook
+
+        halving_factor: float, optional (default=None)
+            If not None, successive halving is used: all parameter sets are trained with a small number
+            of iterations, only the best 1/halving_factor of them continue training in the next round
+            with halving_factor times more iterations, until the full iterations count is reached.
+            Should be greater than 1. Can be used only when search_by_train_test_split=True.
         Returns
         -------
         dict with two fields:
@@ -3204,7 +3236,8 @@ class CatBoost(_CatBoostBase):
             param_grid=param_distributions, X=X, y=y, cv=cv, n_iter=n_iter,
             partition_random_seed=partition_random_seed, calc_cv_statistics=calc_cv_statistics,
             search_by_train_test_split=search_by_train_test_split, refit=refit, shuffle=shuffle,
-            stratified=stratified, train_size=train_size, verbose=verbose, plot=plot
+            stratified=stratified, train_size=train_size, verbose=verbose, plot=plot,
+            halving_factor=halving_factor
         )
 
     def _convert_to_asymmetric_representation(self):
@@ -4479,7 +4512,8 @@ def cv(pool=None, params=None, dtrain=None, iterations=None, num_boost_round=Non
        fold_count=None, nfold=None, inverted=False, partition_random_seed=0, seed=None,
        shuffle=True, logging_level=None, stratified=None, as_pandas=True, metric_period=None,
        verbose=None, verbose_eval=None, plot=False, early_stopping_rounds=None,
-       save_snapshot=None, snapshot_file=None, snapshot_interval=None, folds=None, type='Classical'):
+       save_snapshot=None, snapshot_file=None, snapshot_interval=None, folds=None, type='Classical',
+       parallel_fold_count=None):
     """
     Cross-validate the CatBoost model.
 
@@ -4581,6 +4615,11 @@ def cv(pool=None, params=None, dtrain=None, iterations=None, num_boost_round=Non
         and have ``split`` method.
         if folds is not None, then all of fold_count, shuffle, partition_random_seed, inverted are None
 
+    parallel_fold_count : int, optional (default=1)
+        The number of folds to train concurrently, threads are split evenly between them.
+        Useful for small and medium datasets where a single fold can't load all threads.
+        Supported only for CPU.
+
     Returns
     -------
     cv results : pandas.core.frame.DataFrame with cross-validation results
@@ -4681,9 +4720,14 @@ def cv(pool=None, params=None, dtrain=None, iterations=None, num_boost_round=Non
     if 'text_features' in params:
         raise CatBoostError("Cv with text features is not implemented.")
 
+    if parallel_fold_count is None:
+        parallel_fold_count = 1
+    elif parallel_fold_count < 1:
+        raise CatBoostError("parallel_fold_count should be positive.")
+
     with log_fixup(), plot_wrapper(plot, [_get_train_dir(params)]):
         return _cv(params, pool, fold_count, inverted, partition_random_seed, shuffle, stratified,
-                   as_pandas, folds, type)
+                   as_pandas, folds, type, parallel_fold_count)
 
 
 class BatchMetricCalcer(_MetricCalcerBase):
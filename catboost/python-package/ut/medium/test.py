@@ -1415,6 +1415,33 @@ def test_save_model(task_type):
     assert _check_data(pred1, pred2)
 
 
+@pytest.mark.parametrize('precision', ['Float32', 'Float16'])
+def test_save_model_with_leaf_values_precision(precision):
+    train_pool = Pool(TRAIN_FILE, column_description=CD_FILE)
+    test_pool = Pool(TEST_FILE, column_description=CD_FILE)
+    model = CatBoost({'iterations': 20, 'random_seed': 0})
+    model.fit(train_pool)
+    output_model_path = test_output_path(OUTPUT_MODEL_PATH)
+    model.save_model(output_model_path)
+    reduced_model_path = test_output_path('reduced_' + OUTPUT_MODEL_PATH)
+    model.save_model(reduced_model_path, leaf_values_precision=precision)
+    assert os.path.getsize(reduced_model_path) < os.path.getsize(output_model_path)
+
+    reduced_model = CatBoost()
+    reduced_model.load_model(reduced_model_path)
+    pred = model.predict(test_pool)
+    reduced_pred = reduced_model.predict(test_pool)
+    assert np.allclose(pred, reduced_pred, rtol=0, atol=1e-2 if precision == 'Float16' else 1e-5)
+
+    # the model itself keeps its precision
+    same_model_path = test_output_path('same_' + OUTPUT_MODEL_PATH)
+    model.save_model(same_model_path)
+    assert open(same_model_path, 'rb').read() == open(output_model_path, 'rb').read()
+
+    with pytest.raises(CatBoostError):
+        model.save_model(reduced_model_path, leaf_values_precision='Float8')
+
+
 def test_multiclass(task_type):
     pool = Pool(CLOUDNESS_TRAIN_FILE, column_description=CLOUDNESS_CD_FILE)
     classifier = CatBoostClassifier(iterations=2, loss_function='MultiClass', thread_count=8, task_type=task_type, devices='0')
@@ -2151,6 +2178,22 @@ def test_cv(task_type):
     return local_canonical_file(remove_time_from_json(JSON_LOG_PATH))
 
 
+def test_cv_parallel_folds():
+    pool = Pool(TRAIN_FILE, column_description=CD_FILE)
+    params = {
+        "iterations": 20,
+        "learning_rate": 0.03,
+        "loss_function": "Logloss",
+        "eval_metric": "AUC",
+        "thread_count": 4,
+    }
+    results = cv(pool, params, fold_count=3, as_pandas=False)
+    parallel_results = cv(pool, params, fold_count=3, parallel_fold_count=3, as_pandas=False)
+    assert sorted(results.keys()) == sorted(parallel_results.keys())
+    for key in results:
+        assert np.allclose(results[key], parallel_results[key])
+
+
 def test_cv_query(task_type):
     pool = Pool(QUERYWISE_TRAIN_FILE, column_description=QUERYWISE_CD_FILE)
     results = cv(
@@ -2424,6 +2467,33 @@ def test_grid_search(task_type):
     assert results['params']['border_count'] in border_count_list, "wrong 'border_count_list' value"
 
 
+def test_grid_search_with_halving():
+    pool = Pool(TRAIN_FILE, column_description=CD_FILE)
+    model = CatBoost(
+        {
+            "iterations": 27,
+            "loss_function": "Logloss",
+        }
+    )
+    grid = {
+        "learning_rate": [0.01, 0.03, 0.1],
+        "depth": [4, 6, 8],
+        "l2_leaf_reg": [1, 3, 9],
+    }
+    results = model.grid_search(
+        grid,
+        pool,
+        calc_cv_statistics=False,
+        refit=False,
+        halving_factor=3
+    )
+    for key, value in results["params"].items():
+        assert value in grid[key]
+
+    with pytest.raises(CatBoostError):
+        model.grid_search(grid, pool, search_by_train_test_split=False, refit=False, halving_factor=3)
+
+
 def test_grid_search_for_multiclass():
     pool = Pool(CLOUDNESS_TRAIN_FILE, column_description=CLOUDNESS_CD_FILE)
     model = CatBoostClassifier(iterations=10)
@@ -5841,6 +5911,38 @@ def test_save_quantized_pool():
     assert all(predictions1 == predictions2)
 
 
+@pytest.mark.parametrize('chunk_codec', ['None', 'Lz4', 'Zstd'])
+@pytest.mark.parametrize('pack_bits', [False, True], ids=['pack_bits=False', 'pack_bits=True'])
+def test_save_compressed_quantized_pool(chunk_codec, pack_bits):
+    test_pool = Pool(QUERYWISE_TEST_FILE, column_description=QUERYWISE_CD_FILE)
+    train_quantized_pool = Pool(QUERYWISE_TRAIN_FILE, column_description=QUERYWISE_CD_FILE)
+    train_quantized_pool.quantize()
+    params = {
+        'task_type': 'CPU',
+        'loss_function': 'RMSE',
+        'iterations': 5,
+        'depth': 4,
+    }
+
+    pool_path = test_output_path(OUTPUT_QUANTIZED_POOL_PATH)
+    train_quantized_pool.save(pool_path)
+    compressed_pool_path = test_output_path('compressed_' + OUTPUT_QUANTIZED_POOL_PATH)
+    train_quantized_pool.save(compressed_pool_path, chunk_codec=chunk_codec, pack_bits=pack_bits)
+    if chunk_codec != 'None' or pack_bits:
+        assert os.path.getsize(compressed_pool_path) < os.path.getsize(pool_path)
+
+    predictions = CatBoost(params).fit(Pool(get_quantized_path(pool_path))).predict(test_pool)
+    compressed_predictions = CatBoost(params).fit(Pool(get_quantized_path(compressed_pool_path))).predict(test_pool)
+    assert all(predictions == compressed_predictions)
+
+
+def test_save_quantized_pool_unknown_chunk_codec():
+    train_quantized_pool = Pool(QUERYWISE_TRAIN_FILE, column_description=QUERYWISE_CD_FILE)
+    train_quantized_pool.quantize()
+    with pytest.raises(CatBoostError):
+        train_quantized_pool.save(test_output_path(OUTPUT_QUANTIZED_POOL_PATH), chunk_codec='Gzip')
+
+
 def test_save_quantized_pool_categorical():
     train_quantized_pool = Pool(SMALL_CATEGORIAL_FILE, column_description=SMALL_CATEGORIAL_CD_FILE)
     train_quantized_pool.quantize()
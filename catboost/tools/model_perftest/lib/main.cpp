@@ -23,6 +23,9 @@ struct TCMDOptions {
     size_t BlockSize = Max<size_t>();
     size_t RepetitionCount = 1;
     int ThreadCount = 1;
+    bool SingleDocLatency = false;
+    TMaybe<double> EarlyExitThreshold;
+    size_t EarlyExitTreeChunkSize = 16;
 };
 
 struct TTimingResult {
@@ -48,6 +51,13 @@ struct TTimingResult {
         return sum / Times.size();
     }
 
+    double Percentile(double level) const {
+        TVector<double> sorted = Times;
+        const size_t idx = ::Min<size_t>(sorted.size() - 1, level * sorted.size());
+        NthElement(sorted.begin(), sorted.begin() + idx, sorted.end());
+        return sorted[idx];
+    }
+
     void Output(const TTimingResult* ref = nullptr) const {
         auto myMin = Min();
         CATBOOST_INFO_LOG << "min:\t" << myMin;
@@ -69,6 +79,15 @@ struct TTimingResult {
             CATBOOST_INFO_LOG << "\t" << mymean / ref->Mean();
         }
         CATBOOST_INFO_LOG << Endl;
+
+        for (auto [name, level] : {std::make_pair("p50", 0.5), std::make_pair("p99", 0.99)}) {
+            auto myPercentile = Percentile(level);
+            CATBOOST_INFO_LOG << name << ":\t" << myPercentile;
+            if (ref) {
+                CATBOOST_INFO_LOG << "\t" << myPercentile / ref->Percentile(level);
+            }
+            CATBOOST_INFO_LOG << Endl;
+        }
     }
 
     NJson::TJsonValue GetJsonValue() const {
@@ -76,6 +95,8 @@ struct TTimingResult {
         result["min"] = Min();
         result["max"] = Max();
         result["mean"] = Mean();
+        result["p50"] = Percentile(0.5);
+        result["p99"] = Percentile(0.99);
         return result;
     }
 };
@@ -183,6 +204,18 @@ int DoMain(int argc, char** argv) {
     parser.AddLongOption("threads")
         .StoreResult(&options.ThreadCount)
         .Optional();
+    parser.AddLongOption("single-doc-latency", "also time CalcFlatSingle calls one by one (times are per call)")
+        .NoArgument()
+        .SetFlag(&options.SingleDocLatency)
+        .Optional();
+    parser.AddLongOption("early-exit-threshold", "also time CalcFlatWithEarlyExit with this raw formula value threshold")
+        .RequiredArgument("FLOAT")
+        .Handler1T<double>([&options](double threshold) {
+            options.EarlyExitThreshold = threshold;
+        });
+    parser.AddLongOption("early-exit-tree-chunk", "count of trees evaluated between early exit checks")
+        .StoreResult(&options.EarlyExitTreeChunkSize)
+        .Optional();
 
     NLastGetopt::TOptsParseResult parserResult{&parser, argc, argv};
     TFullModel model = ReadModel(options.ModelPath);
@@ -348,6 +381,48 @@ int DoMain(int argc, char** argv) {
             }
         }
     }
+    if (options.SingleDocLatency) {
+        auto evaluator = NCB::NModelEvaluation::CreateEvaluator(EFormulaEvaluatorType::CPU, model);
+        TVector<double> singleDocResult(evaluator->GetApproxDimension());
+        const TString resultName = "catboost cpu single doc";
+        THPTimer timer;
+        for (size_t i = 0; i < options.RepetitionCount; ++i) {
+            for (size_t blockId = 0; blockId < blockCount; ++blockId) {
+                for (const auto& docFeatures : nonTranspFactorsRef[blockId]) {
+                    timer.Reset();
+                    evaluator->CalcFlatSingle(docFeatures, singleDocResult);
+                    results.UpdateResult(resultName, timer.Passed());
+                }
+            }
+        }
+    }
+    if (options.EarlyExitThreshold) {
+        auto evaluator = NCB::NModelEvaluation::CreateEvaluator(EFormulaEvaluatorType::CPU, model);
+        TVector<double> blockResults;
+        TVector<ui32> evaluatedTreeCounts;
+        const TString resultName = "catboost cpu early exit";
+        ui64 evaluatedTreeCountSum = 0;
+        size_t evaluatedDocCount = 0;
+        for (size_t i = 0; i < options.RepetitionCount; ++i) {
+            for (size_t blockId = 0; blockId < blockCount; ++blockId) {
+                const auto& blockFeatures = nonTranspFactorsRef[blockId];
+                blockResults.yresize(blockFeatures.size());
+                evaluatedTreeCounts.yresize(blockFeatures.size());
+                THPTimer timer;
+                evaluator->CalcFlatWithEarlyExit(
+                    blockFeatures,
+                    *options.EarlyExitThreshold,
+                    options.EarlyExitTreeChunkSize,
+                    blockResults,
+                    evaluatedTreeCounts);
+                results.UpdateResult(resultName, timer.Passed());
+                evaluatedTreeCountSum += Accumulate(evaluatedTreeCounts, ui64(0));
+                evaluatedDocCount += evaluatedTreeCounts.size();
+            }
+        }
+        CATBOOST_INFO_LOG << "Early exit: " << (double)evaluatedTreeCountSum / Max<size_t>(evaluatedDocCount, 1)
+            << " trees evaluated per document on average of " << model.GetTreeCount() << Endl;
+    }
     results.OutputResults();
 
     return 0;
@@ -1,5 +1,7 @@
 #include "perftest_module.h"
 
+#include <util/string/cast.h>
+
 class TBaseCatboostModule : public TBasePerftestModule {
 public:
     TBaseCatboostModule() = default;
@@ -68,6 +70,22 @@ public:
 
 TPerftestModuleFactory::TRegistrator<TCPUCatboostAsymmetryModule> CPUCatboostAsymmetryModuleRegistar("CPUCatboostAsymmetry");
 
+template <ELeafValuesPrecision LeafValuesPrecision>
+class TCPUCatboostCompactLeavesModule : public TBaseCatboostModule {
+public:
+    TCPUCatboostCompactLeavesModule(const TFullModel& model) {
+        TFullModel compactModel = model;
+        compactModel.SetLeafValuesPrecision(LeafValuesPrecision);
+        ModelEvaluator = NCB::NModelEvaluation::CreateEvaluator(EFormulaEvaluatorType::CPU, compactModel);
+        BaseName = TString("catboost cpu ") + ToString(LeafValuesPrecision) + " leaves";
+    }
+};
+
+TPerftestModuleFactory::TRegistrator<TCPUCatboostCompactLeavesModule<ELeafValuesPrecision::Float32>>
+    CPUCatboostFloat32LeavesModuleRegistar("CPUCatboostFloat32Leaves");
+TPerftestModuleFactory::TRegistrator<TCPUCatboostCompactLeavesModule<ELeafValuesPrecision::Float16>>
+    CPUCatboostFloat16LeavesModuleRegistar("CPUCatboostFloat16Leaves");
+
 class TGPUCatboostModule : public TBaseCatboostModule {
 public:
     TGPUCatboostModule(const TFullModel& model) {
@@ -25,6 +25,7 @@ namespace NTextProcessing::NDictionary {
         }
         virtual void Add(TConstArrayRef<TString> tokens, ui64 weight) = 0;
         virtual void Add(TConstArrayRef<TStringBuf> tokens, ui64 weight) = 0;
+        virtual void MergeFrom(const IDictionaryBuilderImpl& other) = 0;
         virtual TIntrusivePtr<TDictionary> FinishBuilding() = 0;
 
         virtual ~IDictionaryBuilderImpl() = default;
@@ -54,6 +55,8 @@ namespace NTextProcessing::NDictionary {
             AddImpl(tokens, weight);
         }
 
+        void MergeFrom(const IDictionaryBuilderImpl& other) override;
+
         TIntrusivePtr<TDictionary> FinishBuilding() override;
     private:
         template <typename TTokenType>
@@ -87,12 +90,13 @@ namespace NTextProcessing::NDictionary {
             AddImpl(tokens, weight);
         }
 
+        void MergeFrom(const IDictionaryBuilderImpl& other) override;
+
         TIntrusivePtr<TDictionary> FinishBuilding() override;
     private:
         template <typename TTokenType>
         void AddImpl(TConstArrayRef<TTokenType> tokens, ui64 weight);
         void Filter();
-        void FilterInternalIdToTokenMapping();
 
         NFH::TFlatHashMap<TString, TInternalTokenId> TokenToInternalId;
         TInternalIdsMap<GramOrder, ui64> InternalIdsToCount;
@@ -101,8 +105,6 @@ namespace NTextProcessing::NDictionary {
         TInternalIdsMap<GramOrder, TTokenId> InternalIdsToId;
         TVector<const TMultiInternalTokenId<GramOrder>*> IdToInternalIds;
         TVector<ui64> IdToCount;
-
-        bool NeedToFilterInternalIdToTokenMapping = false;
     };
 
     // TUnigramDictionaryBuilderImpl
@@ -126,6 +128,18 @@ namespace NTextProcessing::NDictionary {
         }
     }
 
+    void TUnigramDictionaryBuilderImpl::MergeFrom(const IDictionaryBuilderImpl& other) {
+        Y_ENSURE(!IsBuildingFinish, "MergeFrom method should be called before FinishBuilding.");
+        const auto* otherUnigram = dynamic_cast<const TUnigramDictionaryBuilderImpl*>(&other);
+        Y_ENSURE(otherUnigram, "Only dictionary builders of the same type can be merged.");
+        Y_ENSURE(!otherUnigram->IsBuildingFinish, "Merged dictionary builder has been already finished.");
+
+        TokenToCount.reserve(Max(TokenToCount.size(), otherUnigram->TokenToCount.size()));
+        for (const auto& [token, count] : otherUnigram->TokenToCount) {
+            TokenToCount[token] += count;
+        }
+    }
+
     TIntrusivePtr<TDictionary> TUnigramDictionaryBuilderImpl::FinishBuilding() {
         Y_ENSURE(!IsBuildingFinish, "FinishBuilding method should be called only once.");
         IsBuildingFinish = true;
@@ -142,18 +156,19 @@ namespace NTextProcessing::NDictionary {
 
         const ui32 dictionarySize = tokens.size();
 
+        const auto maxDictionarySize = GetMaxDictionarySize(DictionaryBuilderOptions.MaxDictionarySize);
+        const auto finalDictonarySize = Min(dictionarySize, maxDictionarySize);
+
+        // only top finalDictonarySize tokens are needed
         TVector<ui32> indices(dictionarySize);
         Iota(indices.begin(), indices.end(), 0);
-        Sort(indices, [&](ui32 lhs, ui32 rhs) {
+        PartialSort(indices.begin(), indices.begin() + finalDictonarySize, indices.end(), [&](ui32 lhs, ui32 rhs) {
             return (
                 counts[lhs] > counts[rhs] ||
                 (counts[lhs] == counts[rhs] && tokens[lhs] < tokens[rhs]
             ));
         });
 
-        const auto maxDictionarySize = GetMaxDictionarySize(DictionaryBuilderOptions.MaxDictionarySize);
-        const auto finalDictonarySize = Min(dictionarySize, maxDictionarySize);
-
         TokenToId.reserve(finalDictonarySize);
         IdToCount.reserve(finalDictonarySize);
         TTokenId globalTokenId = DictionaryOptions.StartTokenId;
@@ -227,6 +242,30 @@ namespace NTextProcessing::NDictionary {
         }
     }
 
+    template <ui32 GramOrder>
+    void TMultigramDictionaryBuilderImpl<GramOrder>::MergeFrom(const IDictionaryBuilderImpl& other) {
+        Y_ENSURE(!IsBuildingFinish, "MergeFrom method should be called before FinishBuilding.");
+        const auto* otherMultigram = dynamic_cast<const TMultigramDictionaryBuilderImpl<GramOrder>*>(&other);
+        Y_ENSURE(otherMultigram, "Only dictionary builders of the same type can be merged.");
+        Y_ENSURE(!otherMultigram->IsBuildingFinish, "Merged dictionary builder has been already finished.");
+
+        // internal ids are local to each builder
+        NFH::TFlatHashMap<TInternalTokenId, TInternalTokenId> otherToThisInternalId;
+        otherToThisInternalId.reserve(otherMultigram->TokenToInternalId.size());
+        for (const auto& [token, otherInternalId] : otherMultigram->TokenToInternalId) {
+            otherToThisInternalId.emplace(otherInternalId, GetInternalWordTokenId(token, &TokenToInternalId));
+        }
+
+        InternalIdsToCount.reserve(Max(InternalIdsToCount.size(), otherMultigram->InternalIdsToCount.size()));
+        TMultiInternalTokenId<GramOrder> key;
+        for (const auto& [otherKey, count] : otherMultigram->InternalIdsToCount) {
+            for (ui32 gramIndex = 0; gramIndex < GramOrder; ++gramIndex) {
+                key[gramIndex] = otherToThisInternalId.at(otherKey[gramIndex]);
+            }
+            InternalIdsToCount[key] += count;
+        }
+    }
+
     template <ui32 GramOrder>
     static bool CompareNGram(
         const TMultiInternalTokenId<GramOrder>& leftNGram,
@@ -261,49 +300,59 @@ namespace NTextProcessing::NDictionary {
             InternalIdToToken[it.second] = it.first;
         }
 
+        const auto maxDictionarySize = GetMaxDictionarySize(DictionaryBuilderOptions.MaxDictionarySize);
+        const auto finalDictonarySize = Min(dictionarySize, maxDictionarySize);
+
+        // only top finalDictonarySize n-grams are needed
         TVector<ui32> indices(keys.size());
         Iota(indices.begin(), indices.end(), 0);
-        Sort(indices, [&](ui32 lhs, ui32 rhs) {
+        PartialSort(indices.begin(), indices.begin() + finalDictonarySize, indices.end(), [&](ui32 lhs, ui32 rhs) {
             return (
                 counts[lhs] > counts[rhs] ||
                 (counts[lhs] == counts[rhs] && CompareNGram(*(keys[lhs]), *(keys[rhs]), InternalIdToToken))
             );
         });
 
-        const auto maxDictionarySize = GetMaxDictionarySize(DictionaryBuilderOptions.MaxDictionarySize);
-        const auto finalDictonarySize = Min(dictionarySize, maxDictionarySize);
-
-        if (finalDictonarySize < InternalIdsToCount.size()) {
-            NeedToFilterInternalIdToTokenMapping = true;
+        /* Internal ids are given in the order of the first occurrence, so they depend on how the tokens
+         * were split between merged builders. Tokens of the kept n-grams are renumbered in lexicographical
+         * order, so the built dictionary (and its serialized form) doesn't depend on the number of threads.
+         */
+        TVector<bool> isUsedInternalId(TokenToInternalId.size(), false);
+        TVector<TStringBuf> usedTokens;
+        for (ui32 i : xrange(finalDictonarySize)) {
+            for (auto internalId : *keys[indices[i]]) {
+                if (!isUsedInternalId[internalId]) {
+                    isUsedInternalId[internalId] = true;
+                    usedTokens.push_back(InternalIdToToken.at(internalId));
+                }
+            }
+        }
+        Sort(usedTokens);
+        NFH::TFlatHashMap<TString, TInternalTokenId> tokenToInternalId;
+        tokenToInternalId.reserve(usedTokens.size());
+        for (TInternalTokenId internalId : xrange<TInternalTokenId>(usedTokens.size())) {
+            tokenToInternalId.emplace(usedTokens[internalId], internalId);
         }
 
         TTokenId globalTokenId = DictionaryOptions.StartTokenId;
         InternalIdsToId.reserve(finalDictonarySize);
         IdToCount.reserve(finalDictonarySize);
+        TVector<TMultiInternalTokenId<GramOrder>> sortedKeys(finalDictonarySize);
         for (ui32 i : xrange(finalDictonarySize)) {
-            InternalIdsToId[*keys[indices[i]]] = globalTokenId++;
+            for (ui32 gramIndex : xrange(GramOrder)) {
+                sortedKeys[i][gramIndex] = tokenToInternalId.at(InternalIdToToken.at((*keys[indices[i]])[gramIndex]));
+            }
+            InternalIdsToId[sortedKeys[i]] = globalTokenId++;
             IdToCount.push_back(counts[indices[i]]);
         }
 
         IdToInternalIds.reserve(finalDictonarySize);
         for (ui32 i : xrange(finalDictonarySize)) {
-            IdToInternalIds.push_back(&(InternalIdsToId.find(*keys[indices[i]])->first));
-        }
-    }
-
-    template <ui32 GramOrder>
-    void TMultigramDictionaryBuilderImpl<GramOrder>::FilterInternalIdToTokenMapping() {
-        NFH::TFlatHashMap<TString, TInternalTokenId> tokenToInternalId;
-        for (const auto& internalIds : IdToInternalIds) {
-            for (ui32 gramIndex : xrange(GramOrder)) {
-                TInternalTokenId id = (*internalIds)[gramIndex];
-                TStringBuf token = InternalIdToToken.at(id);
-                if (!tokenToInternalId.contains(token)) {
-                    tokenToInternalId.emplace(token, id);
-                }
-            }
+            IdToInternalIds.push_back(&(InternalIdsToId.find(sortedKeys[i])->first));
         }
 
+        // counts are not needed anymore, InternalIdToToken refers to the keys of the old mapping
+        InternalIdsToCount.clear();
         TokenToInternalId = std::move(tokenToInternalId);
         InternalIdToToken.clear();
         InternalIdToToken.reserve(TokenToInternalId.size());
@@ -318,9 +367,6 @@ namespace NTextProcessing::NDictionary {
         IsBuildingFinish = true;
 
         Filter();
-        if (NeedToFilterInternalIdToTokenMapping) {
-            FilterInternalIdToTokenMapping();
-        }
 
         THolder<IDictionaryImpl> dictionaryImpl = MakeHolder<TMultigramDictionaryImpl<GramOrder>>(
             DictionaryOptions,
@@ -383,6 +429,11 @@ namespace NTextProcessing::NDictionary {
         DictionaryBuilderImpl->Add(tokens, weight);
     }
 
+    void TDictionaryBuilder::Merge(TDictionaryBuilder&& other) {
+        DictionaryBuilderImpl->MergeFrom(*other.DictionaryBuilderImpl);
+        other.DictionaryBuilderImpl.Destroy();
+    }
+
     TIntrusivePtr<TDictionary> TDictionaryBuilder::FinishBuilding() {
         return DictionaryBuilderImpl->FinishBuilding();
     }
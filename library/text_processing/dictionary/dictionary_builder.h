@@ -36,6 +36,17 @@ namespace NTextProcessing::NDictionary {
         void Add(TConstArrayRef<TString> tokens, ui64 weight = 1);
         void Add(TConstArrayRef<TStringBuf> tokens, ui64 weight = 1);
 
+        /*
+         * This method adds token counts collected by other builder, so tokens can be counted in parallel
+         * by several builders with the same options and merged before FinishBuilding.
+         * Example:
+         *      TVector<TDictionaryBuilder> builders = ...; // one per thread
+         *      for (auto& builder : builders) {
+         *          dictionaryBuilder.Merge(std::move(builder));
+         *      }
+         * */
+        void Merge(TDictionaryBuilder&& other);
+
         TIntrusivePtr<TDictionary> FinishBuilding();
 
     private:
@@ -6,7 +6,9 @@
 #include <library/threading/local_executor/local_executor.h>
 #include <library/unittest/registar.h>
 
+#include <util/generic/xrange.h>
 #include <util/memory/blob.h>
+#include <util/stream/str.h>
 
 using NTextProcessing::NDictionary::IDictionary;
 using NTextProcessing::NDictionary::TBpeDictionary;
@@ -431,6 +433,58 @@ Y_UNIT_TEST_SUITE(DictionaryTests) {
 
     }
 
+    Y_UNIT_TEST(DictionaryMergeTest) {
+        const TVector<TVector<TString>> sentences = {
+            {"a", "b", "c", "a", "b"},
+            {"b", "c", "d", "b", "c", "a"},
+            {"d", "d", "a", "b"}
+        };
+
+        for (ui32 gramOrder : {1, 2, 3}) {
+            TDictionaryOptions dictionaryOptions;
+            dictionaryOptions.GramOrder = gramOrder;
+            dictionaryOptions.TokenLevelType = ETokenLevelType::Word;
+            TDictionaryBuilderOptions dictionaryBuilderOptions;
+            dictionaryBuilderOptions.OccurrenceLowerBound = 0;
+            dictionaryBuilderOptions.MaxDictionarySize = 4;
+
+            TDictionaryBuilder dictionaryBuilder(dictionaryBuilderOptions, dictionaryOptions);
+            for (const auto& sentence : sentences) {
+                dictionaryBuilder.Add(sentence);
+            }
+            const auto dictionary = dictionaryBuilder.FinishBuilding();
+
+            // each sentence is counted by its own builder, tokens are met in a different order
+            TDictionaryBuilder mergedDictionaryBuilder(dictionaryBuilderOptions, dictionaryOptions);
+            mergedDictionaryBuilder.Add(sentences.back());
+            for (auto i : xrange<size_t>(0, sentences.size() - 1)) {
+                TDictionaryBuilder partDictionaryBuilder(dictionaryBuilderOptions, dictionaryOptions);
+                partDictionaryBuilder.Add(sentences[i]);
+                mergedDictionaryBuilder.Merge(std::move(partDictionaryBuilder));
+            }
+            const auto mergedDictionary = mergedDictionaryBuilder.FinishBuilding();
+
+            UNIT_ASSERT_VALUES_EQUAL(mergedDictionary->Size(), dictionary->Size());
+            for (const auto& sentence : sentences) {
+                TVector<TTokenId> tokenIds;
+                dictionary->Apply(sentence, &tokenIds);
+                TVector<TTokenId> mergedTokenIds;
+                mergedDictionary->Apply(sentence, &mergedTokenIds);
+                UNIT_ASSERT_VALUES_EQUAL(mergedTokenIds, tokenIds);
+            }
+            for (auto tokenId : xrange(dictionary->Size())) {
+                UNIT_ASSERT_VALUES_EQUAL(mergedDictionary->GetCount(tokenId), dictionary->GetCount(tokenId));
+            }
+
+            // the serialized form doesn't depend on the order tokens were counted in
+            TStringStream serializedDictionary;
+            TMMapDictionary(dictionary).Save(&serializedDictionary);
+            TStringStream serializedMergedDictionary;
+            TMMapDictionary(mergedDictionary).Save(&serializedMergedDictionary);
+            UNIT_ASSERT_EQUAL(serializedMergedDictionary.Str(), serializedDictionary.Str());
+        }
+    }
+
     Y_UNIT_TEST(BpeDictionaryMainTest) {
 
         TVector<TString> firstSentence = {"abc", "bcd", "bcd", "abc", "bcd"};